@@ -10,6 +10,7 @@
 #include <jet/scalar_grid3.h>
 #include <limits>
 #include <memory>
+#include <vector>
 
 namespace jet {
 
@@ -35,7 +36,9 @@ class AdvectionSolver3 {
     //! \p output. The boundary interface is given by a signed-distance field.
     //! The field is negative inside the boundary. By default, a constant field
     //! with max double value (kMaxD or std::numeric_limists<double>::max())
-    //! is used, meaning no boundary.
+    //! is used, meaning no boundary. Every data point of \p output should be
+    //! written, and the points inside the boundary take the input values, so
+    //! the output grid does not need to be initialized.
     //!
     //! \param input Input scalar grid.
     //! \param flow Vector field that advects the input field.
@@ -62,7 +65,9 @@ class AdvectionSolver3 {
     //! \p output. The boundary interface is given by a signed-distance field.
     //! The field is negative inside the boundary. By default, a constant field
     //! with max double value (kMaxD or std::numeric_limists<double>::max())
-    //! is used, meaning no boundary.
+    //! is used, meaning no boundary. Every data point of \p output should be
+    //! written, and the points inside the boundary take the input values, so
+    //! the output grid does not need to be initialized.
     //!
     //! \param input Input vector grid.
     //! \param flow Vector field that advects the input field.
@@ -90,6 +95,9 @@ class AdvectionSolver3 {
     //! signed-distance field. The field is negative inside the boundary. By
     //! default, a constant field with max double value (kMaxD or
     //! std::numeric_limists<double>::max()) is used, meaning no boundary.
+    //! Every data point of \p output should be written, and the points inside
+    //! the boundary take the input values, so the output grid does not need to
+    //! be initialized.
     //!
     //! \param input Input vector grid.
     //! \param flow Vector field that advects the input field.
@@ -105,6 +113,41 @@ class AdvectionSolver3 {
         FaceCenteredGrid3* output,
         const ScalarField3& boundarySdf
             = ConstantScalarField3(kMaxD));
+
+    //!
+    //! \brief Solves advection equation for multiple grids at once.
+    //!
+    //! This function advects all the given grids with the same underlying
+    //! vector field \p flow and time-step \p dt. The i-th input of each type
+    //! is advected to the i-th output of the same type, and each output should
+    //! have the same shape as its input. Since all the grids are carried by the
+    //! same flow, the implementation can share the work that only depends on
+    //! the sample location, such as back-tracing, among the grids with the
+    //! same data layout. The \p flow can be one of the inputs, but not one of
+    //! the outputs. The default implementation advects the grids one by one.
+    //!
+    //! \param scalarInputs Input scalar grids.
+    //! \param collocatedInputs Input collocated vector grids.
+    //! \param faceCenteredInputs Input face-centered vector grids.
+    //! \param flow Vector field that advects the input fields.
+    //! \param dt Time-step for the advection.
+    //! \param scalarOutputs Output scalar grids.
+    //! \param collocatedOutputs Output collocated vector grids.
+    //! \param faceCenteredOutputs Output face-centered vector grids.
+    //! \param boundarySdf Boundary interface defined by signed-distance
+    //!     field.
+    //!
+    virtual void advectBatch(
+        const std::vector<const ScalarGrid3*>& scalarInputs,
+        const std::vector<const CollocatedVectorGrid3*>& collocatedInputs,
+        const std::vector<const FaceCenteredGrid3*>& faceCenteredInputs,
+        const VectorField3& flow,
+        double dt,
+        const std::vector<ScalarGrid3*>& scalarOutputs,
+        const std::vector<CollocatedVectorGrid3*>& collocatedOutputs,
+        const std::vector<FaceCenteredGrid3*>& faceCenteredOutputs,
+        const ScalarField3& boundarySdf
+            = ConstantScalarField3(kMaxD));
 };
 
 typedef std::shared_ptr<AdvectionSolver3> AdvectionSolver3Ptr;
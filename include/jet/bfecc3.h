@@ -0,0 +1,32 @@
+// Copyright (c) 2016 Doyub Kim
+
+#ifndef INCLUDE_JET_BFECC3_H_
+#define INCLUDE_JET_BFECC3_H_
+
+#include <jet/mac_cormack3.h>
+#include <memory>
+
+namespace jet {
+
+//!
+//! \brief Implementation of 3-D BFECC advection solver.
+//!
+//! This class implements 3-D back and forth error compensation and correction
+//! (BFECC) advection solver. Like MacCormack3, the solver advects the input
+//! forward and then backward in time to estimate the error of the
+//! semi-Lagrangian step. The input is compensated by half of the error, and
+//! then advected forward once more, which costs one more interpolation pass
+//! than MacCormack3. The same limiters as MacCormack3 are applied. See
+//! "Flowfixer: Using BFECC for fluid simulation" by Kim et al., 2005.
+//!
+class Bfecc3 final : public MacCormack3 {
+ public:
+    //! Constructs BFECC solver with clamp limiter.
+    Bfecc3();
+};
+
+typedef std::shared_ptr<Bfecc3> Bfecc3Ptr;
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_BFECC3_H_
@@ -80,6 +80,9 @@ class BoundingBox<T, 3> {
     //! Returns squared diagonal length of this box.
     T diagonalLengthSquared() const;
 
+    //! Returns true if this box is not empty and all the corners are finite.
+    bool isBounded() const;
+
 
     //! Resets this box to initial state (min=infinite, max=-infinite).
     void reset();
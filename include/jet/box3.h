@@ -49,9 +49,15 @@ class Box3 final : public Surface3 {
     //! Returns the bounding box of this box object.
     BoundingBox3D boundingBox() const override;
 
+    //! Returns true since the box is closed.
+    bool isClosed() const override;
+
  protected:
     Vector3D actualClosestNormal(const Vector3D& otherPoint) const override;
 
+    SurfaceClosestQueryResult3 actualClosestQuery(
+        const Vector3D& otherPoint) const override;
+
     SurfaceRayIntersection3 actualClosestIntersection(
         const Ray3D& ray) const override;
 };
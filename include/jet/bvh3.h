@@ -0,0 +1,137 @@
+// Copyright (c) 2016 Doyub Kim
+
+#ifndef INCLUDE_JET_BVH3_H_
+#define INCLUDE_JET_BVH3_H_
+
+#include <jet/bounding_box3.h>
+#include <jet/constants.h>
+#include <jet/ray3.h>
+#include <vector>
+
+namespace jet {
+
+//! Struct that represents the result of the nearest item query.
+struct BvhNearestQueryResult3 {
+    size_t item = kMaxSize;
+    double distance = kMaxD;
+};
+
+//! Struct that represents the result of the closest ray intersection query.
+struct BvhRayIntersection3 {
+    bool isIntersecting = false;
+    size_t item = kMaxSize;
+    double t = kMaxD;
+};
+
+//!
+//! \brief 3-D bounding volume hierarchy (BVH).
+//!
+//! This class builds a binary BVH over the bounding boxes of the items, such
+//! as the triangles of a mesh, and accelerates the nearest item and the ray
+//! intersection queries. The class does not own the items; it only stores the
+//! item indices, and the queries take callbacks that evaluate the actual
+//! geometry.
+//!
+//! The tree is built with the binned surface area heuristic (SAH). The top
+//! levels are split serially, and the subtrees below are built in parallel.
+//! The nodes are flattened into a single array in depth-first order, so the
+//! first child of a node is always the next node and only the second child
+//! index is stored. The result does not depend on the number of threads.
+//!
+//! The queries are read-only and thread-safe. When multiple items have the
+//! same distance (or ray parameter), the one with the smallest index is
+//! returned, which is the same as the brute-force search in index order.
+//!
+//! \see Wald, Ingo. "On fast construction of SAH-based bounding volume
+//!     hierarchies." IEEE Symposium on Interactive Ray Tracing (2007): 33-40.
+//!
+class Bvh3 final {
+ public:
+    //! Default constructor.
+    Bvh3();
+
+    //! Builds the hierarchy with the bounding boxes of the items.
+    void build(const std::vector<BoundingBox3D>& itemsBounds);
+
+    //! Clears all the contents.
+    void clear();
+
+    //! Returns the number of items.
+    size_t numberOfItems() const;
+
+    //! Returns the number of nodes.
+    size_t numberOfNodes() const;
+
+    //! Returns the bounding box of all the items.
+    BoundingBox3D boundingBox() const;
+
+    //!
+    //! \brief Returns the given item box padded for the queries.
+    //!
+    //! The box is expanded so that the rounding error of the closest point
+    //! and the intersection point computed from the item never leaves the box.
+    //!
+    static BoundingBox3D paddedBound(const BoundingBox3D& itemBound);
+
+    //!
+    //! \brief Returns the nearest item from the given point \p pt.
+    //!
+    //! The callback takes the item index and the query point, and returns the
+    //! distance from the point to the item. The nodes are visited from the
+    //! nearer child, and the nodes farther than the current nearest item are
+    //! pruned. Thus, the callback must not return a distance that is smaller
+    //! than the distance to the bounding box of the item.
+    //!
+    template <typename DistanceFunc>
+    BvhNearestQueryResult3 nearest(
+        const Vector3D& pt,
+        const DistanceFunc& distanceFunc) const;
+
+    //!
+    //! \brief Returns true if the given \p ray intersects with any item.
+    //!
+    //! The callback takes the item index and the ray, and returns true if the
+    //! ray intersects with the item. The traversal stops at the first hit.
+    //!
+    template <typename IntersectsFunc>
+    bool intersects(
+        const Ray3D& ray,
+        const IntersectsFunc& intersectsFunc) const;
+
+    //!
+    //! \brief Returns the closest intersection for the given \p ray.
+    //!
+    //! The callback takes the item index and the ray, and returns the ray
+    //! parameter t of the closest intersection with the item, or kMaxD if there
+    //! is no intersection.
+    //!
+    template <typename IntersectionFunc>
+    BvhRayIntersection3 closestIntersection(
+        const Ray3D& ray,
+        const IntersectionFunc& intersectionFunc) const;
+
+ private:
+    struct Node {
+        BoundingBox3D bound;
+
+        // The second child index for interior nodes, or the offset to the
+        // item list for leaf nodes.
+        size_t child = 0;
+
+        // Zero for interior nodes.
+        size_t numberOfItems = 0;
+
+        bool isLeaf() const;
+    };
+
+    class Builder;
+
+    std::vector<Node> _nodes;
+    std::vector<size_t> _items;
+};
+
+}  // namespace jet
+
+#include "detail/bvh3-inl.h"
+
+#endif  // INCLUDE_JET_BVH3_H_
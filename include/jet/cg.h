@@ -24,6 +24,24 @@ struct NullCgPreconditioner final {
     }
 };
 
+//!
+//! \brief No-op monitor for conjugate gradient.
+//!
+//! A monitor is notified when pcg() starts building the preconditioner and
+//! when it starts iterating. onIteration is called with the iteration count
+//! and the squared residual norm (r.M^-1r, the same measure that the tolerance
+//! is compared with) before the first iteration (count 0) and after each
+//! iteration. The iterations stop early if onIteration returns false. This
+//! monitor does nothing, so the calls are optimized out.
+//!
+struct NullCgMonitor final {
+    void beginPreconditionerBuild() {}
+
+    void beginIterations() {}
+
+    bool onIteration(unsigned int, double) { return true; }
+};
+
 //!
 //! \brief Solves conjugate gradient.
 //!
@@ -61,6 +79,90 @@ void pcg(
     unsigned int* lastNumberOfIterations,
     double* lastResidualNorm);
 
+//!
+//! \brief Solves conjugate gradient with the given monitor.
+//!
+template <
+    typename BlasType,
+    typename MonitorType>
+void cg(
+    const typename BlasType::MatrixType& A,
+    const typename BlasType::VectorType& b,
+    unsigned int maxNumberOfIterations,
+    double tolerance,
+    typename BlasType::VectorType* x,
+    typename BlasType::VectorType* r,
+    typename BlasType::VectorType* d,
+    typename BlasType::VectorType* q,
+    typename BlasType::VectorType* s,
+    unsigned int* lastNumberOfIterations,
+    double* lastResidualNorm,
+    MonitorType* monitor);
+
+//!
+//! \brief Solves pre-conditioned conjugate gradient with the given monitor.
+//!
+template <
+    typename BlasType,
+    typename PrecondType,
+    typename MonitorType>
+void pcg(
+    const typename BlasType::MatrixType& A,
+    const typename BlasType::VectorType& b,
+    unsigned int maxNumberOfIterations,
+    double tolerance,
+    PrecondType* M,
+    typename BlasType::VectorType* x,
+    typename BlasType::VectorType* r,
+    typename BlasType::VectorType* d,
+    typename BlasType::VectorType* q,
+    typename BlasType::VectorType* s,
+    unsigned int* lastNumberOfIterations,
+    double* lastResidualNorm,
+    MonitorType* monitor);
+
+//!
+//! \brief Solves conjugate gradient with fused vector operations.
+//!
+//! This function computes the same iterations as cg(), but uses the fused
+//! operations of \p BlasType to reduce the number of passes over the vectors
+//! per iteration. In addition to the operations that cg() requires,
+//! \p BlasType should provide mvmAndDot (q = Ad and returns d.q) and
+//! axpyAndSquaredL2Norm (r = ax + y and returns r.r).
+//!
+template <typename BlasType>
+void fusedCg(
+    const typename BlasType::MatrixType& A,
+    const typename BlasType::VectorType& b,
+    unsigned int maxNumberOfIterations,
+    double tolerance,
+    typename BlasType::VectorType* x,
+    typename BlasType::VectorType* r,
+    typename BlasType::VectorType* d,
+    typename BlasType::VectorType* q,
+    unsigned int* lastNumberOfIterations,
+    double* lastResidualNorm);
+
+//!
+//! \brief Solves conjugate gradient with fused vector operations and the
+//!        given monitor.
+//!
+template <
+    typename BlasType,
+    typename MonitorType>
+void fusedCg(
+    const typename BlasType::MatrixType& A,
+    const typename BlasType::VectorType& b,
+    unsigned int maxNumberOfIterations,
+    double tolerance,
+    typename BlasType::VectorType* x,
+    typename BlasType::VectorType* r,
+    typename BlasType::VectorType* d,
+    typename BlasType::VectorType* q,
+    unsigned int* lastNumberOfIterations,
+    double* lastResidualNorm,
+    MonitorType* monitor);
+
 }  // namespace jet
 
 #include "detail/cg-inl.h"
@@ -3,6 +3,8 @@
 #ifndef INCLUDE_JET_COLLIDER3_H_
 #define INCLUDE_JET_COLLIDER3_H_
 
+#include <jet/array_accessor1.h>
+#include <jet/cell_centered_scalar_grid3.h>
 #include <jet/surface3.h>
 
 namespace jet {
@@ -16,6 +18,10 @@ namespace jet {
 //! provide a Surface3 instance to define collider surface using
 //! Collider3::setSurface function.
 //!
+//! The collider also caches the signed-distance field of the surface
+//! rasterized on a cell-centered grid, so that the grid-based solvers can
+//! sample it with trilinear interpolation instead of querying the surface.
+//!
 class Collider3 {
  public:
     //! Default constructor.
@@ -41,6 +47,29 @@ class Collider3 {
         Vector3D* position,
         Vector3D* velocity);
 
+    //!
+    //! \brief Resolves collision for given points.
+    //!
+    //! This function gives the same result as calling
+    //! Collider3::resolveCollision for each point in parallel, but skips the
+    //! points that are farther than \p radius from the bounding box of the
+    //! surface without querying the surface. The skip requires the surface
+    //! to be closed with the outward normals, so it is only enabled for the
+    //! bounded surfaces that are not flipped and return true from
+    //! Surface3::isClosed. The query engine of the surface is updated first
+    //! (see Surface3::updateQueryEngine).
+    //!
+    //! \param radius Radius of the colliding points.
+    //! \param restitutionCoefficient Defines the restitution effect.
+    //! \param positions Input and output positions of the points.
+    //! \param velocities Input and output velocities of the points.
+    //!
+    void resolveCollisions(
+        double radius,
+        double restitutionCoefficient,
+        ArrayAccessor1<Vector3D> positions,
+        ArrayAccessor1<Vector3D> velocities);
+
     //! Returns friction coefficent.
     double frictionCoefficient() const;
 
@@ -55,6 +84,51 @@ class Collider3 {
     //! Returns the surface instance.
     const Surface3Ptr& surface() const;
 
+    //!
+    //! \brief Returns the signed-distance field of the surface on the grid.
+    //!
+    //! This function rasterizes the signed distance at the cell centers of
+    //! the grid with given resolution, spacing, and origin. The result is
+    //! cached and returned as is until the grid layout changes or the field
+    //! is invalidated, either by Collider3::invalidateSignedDistanceGrid or by
+    //! Collider3::updateSurface for a moving collider. The query engine of the
+    //! surface is updated first (see Surface3::updateQueryEngine).
+    //!
+    const CellCenteredScalarGrid3& signedDistanceGrid(
+        const Size3& resolution,
+        const Vector3D& gridSpacing,
+        const Vector3D& origin);
+
+    //!
+    //! \brief Invalidates the cached signed-distance field.
+    //!
+    //! Call this function after moving or editing the surface of a collider
+    //! that does not report its motion (see Collider3::updateSurface), so that
+    //! the next call to Collider3::signedDistanceGrid rasterizes it again.
+    //!
+    void invalidateSignedDistanceGrid();
+
+    //!
+    //! \brief Updates the surface for a new time step.
+    //!
+    //! The solvers call this function once at the beginning of each time
+    //! step. Collider3::resolveCollisions also calls it. The default
+    //! implementation updates the query engine of the surface. The subclasses
+    //! invalidate the signed-distance field here if their surfaces are moving,
+    //! such as RigidBodyCollider3 with non-zero velocities.
+    //!
+    virtual void updateSurface();
+
+    //!
+    //! \brief Returns the stamp of the surface.
+    //!
+    //! The stamp increases whenever the surface is replaced or the
+    //! signed-distance field is invalidated, so that the colliders containing
+    //! this collider, such as ColliderSet3, can tell if their cached
+    //! signed-distance fields are out of date.
+    //!
+    size_t surfaceStamp() const;
+
  protected:
     //! Internal query result structure.
     struct ColliderQueryResult final {
@@ -82,6 +156,9 @@ class Collider3 {
  private:
     Surface3Ptr _surface;
     double _frictionCoeffient = 0.0;
+    CellCenteredScalarGrid3 _sdfGrid;
+    bool _isSdfGridInvalid = true;
+    size_t _surfaceStamp = 0;
 };
 
 typedef std::shared_ptr<Collider3> Collider3Ptr;
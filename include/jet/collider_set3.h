@@ -21,8 +21,19 @@ class ColliderSet3 final : public Collider3 {
     //! Adds a collider to the set.
     void addCollider(const Collider3Ptr& collider);
 
+    //!
+    //! \brief Updates the colliders and the surface set for a new time step.
+    //!
+    //! The colliders in the set are updated first. Then the surface set is
+    //! rebuilt if any collider has replaced its surface, and the
+    //! signed-distance field is invalidated if any collider has invalidated
+    //! its own field.
+    //!
+    void updateSurface() override;
+
  private:
     std::vector<Collider3Ptr> _colliders;
+    std::vector<size_t> _colliderStamps;
 };
 
 typedef std::shared_ptr<ColliderSet3> ColliderSet3Ptr;
@@ -47,9 +47,15 @@ class Cylinder3 final : public Surface3 {
     //! Returns the bounding box of this cylinder object.
     BoundingBox3D boundingBox() const override;
 
+    //! Returns true since the cylinder is closed.
+    bool isClosed() const override;
+
  protected:
     Vector3D actualClosestNormal(const Vector3D& otherPoint) const override;
 
+    SurfaceClosestQueryResult3 actualClosestQuery(
+        const Vector3D& otherPoint) const override;
+
     SurfaceRayIntersection3 actualClosestIntersection(
         const Ray3D& ray) const override;
 };
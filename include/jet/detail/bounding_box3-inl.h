@@ -4,6 +4,7 @@
 #define INCLUDE_JET_DETAIL_BOUNDING_BOX3_INL_H_
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <utility>  // just make cpplint happy..
 
@@ -156,6 +157,20 @@ T BoundingBox<T, 3>::diagonalLengthSquared() const {
     return (upperCorner - lowerCorner).lengthSquared();
 }
 
+template <typename T>
+bool BoundingBox<T, 3>::isBounded() const {
+    static const T maxT = std::numeric_limits<T>::max();
+
+    for (int i = 0; i < 3; ++i) {
+        if (!(lowerCorner[i] <= upperCorner[i])
+            || !(std::fabs(lowerCorner[i]) < maxT)
+            || !(std::fabs(upperCorner[i]) < maxT)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 template <typename T>
 void BoundingBox<T, 3>::reset() {
     lowerCorner.x = std::numeric_limits<T>::max();
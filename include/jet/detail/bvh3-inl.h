@@ -0,0 +1,248 @@
+// Copyright (c) 2016 Doyub Kim
+
+#ifndef INCLUDE_JET_DETAIL_BVH3_INL_H_
+#define INCLUDE_JET_DETAIL_BVH3_INL_H_
+
+#include <jet/constants.h>
+#include <jet/macros.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace jet {
+
+namespace internal {
+
+// The builder limits the depth of the tree to this value, so the traversal
+// stack never overflows.
+const size_t kBvh3MaxStackSize = 128;
+
+// Ray-box tests are padded by this relative tolerance so that the rounding
+// error of the slab test never culls an item that the callback would hit.
+const double kBvh3RayTolerance = 1.0 + 4.0 * kEpsilonD;
+
+inline double bvh3DistanceToBox(
+    const BoundingBox3D& box,
+    const Vector3D& pt) {
+    // Evaluated in the same order as Vector3D::distanceTo so that the result
+    // does not exceed the distance to any point inside the box.
+    const double dx = std::max(
+        std::max(box.lowerCorner.x - pt.x, pt.x - box.upperCorner.x), 0.0);
+    const double dy = std::max(
+        std::max(box.lowerCorner.y - pt.y, pt.y - box.upperCorner.y), 0.0);
+    const double dz = std::max(
+        std::max(box.lowerCorner.z - pt.z, pt.z - box.upperCorner.z), 0.0);
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+inline bool bvh3IntersectsBox(
+    const BoundingBox3D& box,
+    const Ray3D& ray,
+    const Vector3D& rayInvDir,
+    double tLimit,
+    double* tNear) {
+    double tMin = 0.0;
+    double tMax = tLimit;
+
+    for (int i = 0; i < 3; ++i) {
+        double t0 = (box.lowerCorner[i] - ray.origin[i]) * rayInvDir[i];
+        double t1 = (box.upperCorner[i] - ray.origin[i]) * rayInvDir[i];
+
+        if (t0 > t1) std::swap(t0, t1);
+        t1 *= kBvh3RayTolerance;
+
+        // NaN from 0 * inf does not narrow the interval.
+        tMin = t0 > tMin ? t0 : tMin;
+        tMax = t1 < tMax ? t1 : tMax;
+
+        if (tMin > tMax) return false;
+    }
+
+    *tNear = tMin;
+    return true;
+}
+
+}  // namespace internal
+
+inline bool Bvh3::Node::isLeaf() const {
+    return numberOfItems > 0;
+}
+
+template <typename DistanceFunc>
+BvhNearestQueryResult3 Bvh3::nearest(
+    const Vector3D& pt,
+    const DistanceFunc& distanceFunc) const {
+    BvhNearestQueryResult3 result;
+
+    if (_nodes.empty()) {
+        return result;
+    }
+
+    std::pair<size_t, double> stack[internal::kBvh3MaxStackSize];
+    size_t stackSize = 0;
+    stack[stackSize++] = std::make_pair(
+        kZeroSize, internal::bvh3DistanceToBox(_nodes[0].bound, pt));
+
+    while (stackSize > 0) {
+        const std::pair<size_t, double> entry = stack[--stackSize];
+        if (entry.second > result.distance) {
+            continue;
+        }
+
+        const Node& node = _nodes[entry.first];
+
+        if (node.isLeaf()) {
+            for (size_t i = 0; i < node.numberOfItems; ++i) {
+                const size_t item = _items[node.child + i];
+                const double dist = distanceFunc(item, pt);
+                if (dist < result.distance
+                    || (dist == result.distance && item < result.item)) {
+                    result.distance = dist;
+                    result.item = item;
+                }
+            }
+        } else {
+            size_t first = entry.first + 1;
+            size_t second = node.child;
+            double firstDist
+                = internal::bvh3DistanceToBox(_nodes[first].bound, pt);
+            double secondDist
+                = internal::bvh3DistanceToBox(_nodes[second].bound, pt);
+
+            // Push the farther child first so the nearer one is visited first.
+            if (firstDist < secondDist) {
+                std::swap(first, second);
+                std::swap(firstDist, secondDist);
+            }
+
+            JET_ASSERT(stackSize + 2 <= internal::kBvh3MaxStackSize);
+
+            if (firstDist <= result.distance) {
+                stack[stackSize++] = std::make_pair(first, firstDist);
+            }
+            if (secondDist <= result.distance) {
+                stack[stackSize++] = std::make_pair(second, secondDist);
+            }
+        }
+    }
+
+    return result;
+}
+
+template <typename IntersectsFunc>
+bool Bvh3::intersects(
+    const Ray3D& ray,
+    const IntersectsFunc& intersectsFunc) const {
+    if (_nodes.empty()) {
+        return false;
+    }
+
+    const Vector3D rayInvDir = ray.direction.rdiv(1.0);
+    double tNear;
+
+    size_t stack[internal::kBvh3MaxStackSize];
+    size_t stackSize = 0;
+    stack[stackSize++] = kZeroSize;
+
+    while (stackSize > 0) {
+        const size_t nodeIndex = stack[--stackSize];
+        const Node& node = _nodes[nodeIndex];
+
+        if (!internal::bvh3IntersectsBox(
+                node.bound, ray, rayInvDir, kMaxD, &tNear)) {
+            continue;
+        }
+
+        if (node.isLeaf()) {
+            for (size_t i = 0; i < node.numberOfItems; ++i) {
+                if (intersectsFunc(_items[node.child + i], ray)) {
+                    return true;
+                }
+            }
+        } else {
+            JET_ASSERT(stackSize + 2 <= internal::kBvh3MaxStackSize);
+
+            stack[stackSize++] = node.child;
+            stack[stackSize++] = nodeIndex + 1;
+        }
+    }
+
+    return false;
+}
+
+template <typename IntersectionFunc>
+BvhRayIntersection3 Bvh3::closestIntersection(
+    const Ray3D& ray,
+    const IntersectionFunc& intersectionFunc) const {
+    BvhRayIntersection3 result;
+
+    if (_nodes.empty()) {
+        return result;
+    }
+
+    const Vector3D rayInvDir = ray.direction.rdiv(1.0);
+    double tNear;
+
+    if (!internal::bvh3IntersectsBox(
+            _nodes[0].bound, ray, rayInvDir, kMaxD, &tNear)) {
+        return result;
+    }
+
+    std::pair<size_t, double> stack[internal::kBvh3MaxStackSize];
+    size_t stackSize = 0;
+    stack[stackSize++] = std::make_pair(kZeroSize, tNear);
+
+    while (stackSize > 0) {
+        const std::pair<size_t, double> entry = stack[--stackSize];
+        if (entry.second > result.t) {
+            continue;
+        }
+
+        const Node& node = _nodes[entry.first];
+
+        if (node.isLeaf()) {
+            for (size_t i = 0; i < node.numberOfItems; ++i) {
+                const size_t item = _items[node.child + i];
+                const double t = intersectionFunc(item, ray);
+                if (t == kMaxD) {
+                    continue;
+                }
+                if (t < result.t || (t == result.t && item < result.item)) {
+                    result.isIntersecting = true;
+                    result.t = t;
+                    result.item = item;
+                }
+            }
+        } else {
+            size_t first = entry.first + 1;
+            size_t second = node.child;
+            double firstNear, secondNear;
+            bool hitFirst = internal::bvh3IntersectsBox(
+                _nodes[first].bound, ray, rayInvDir, result.t, &firstNear);
+            bool hitSecond = internal::bvh3IntersectsBox(
+                _nodes[second].bound, ray, rayInvDir, result.t, &secondNear);
+
+            // Push the farther child first so the nearer one is visited first.
+            if (hitFirst && hitSecond && firstNear < secondNear) {
+                std::swap(first, second);
+                std::swap(firstNear, secondNear);
+            }
+
+            JET_ASSERT(stackSize + 2 <= internal::kBvh3MaxStackSize);
+
+            if (hitFirst) {
+                stack[stackSize++] = std::make_pair(first, firstNear);
+            }
+            if (hitSecond) {
+                stack[stackSize++] = std::make_pair(second, secondNear);
+            }
+        }
+    }
+
+    return result;
+}
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_DETAIL_BVH3_INL_H_
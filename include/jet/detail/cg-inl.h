@@ -10,7 +10,8 @@ namespace jet {
 
 template <
     typename BlasType,
-    typename PrecondType>
+    typename PrecondType,
+    typename MonitorType>
 void pcg(
     const typename BlasType::MatrixType& A,
     const typename BlasType::VectorType& b,
@@ -23,14 +24,17 @@ void pcg(
     typename BlasType::VectorType* q,
     typename BlasType::VectorType* s,
     unsigned int* lastNumberOfIterations,
-    double* lastResidualNorm) {
+    double* lastResidualNorm,
+    MonitorType* monitor) {
     // Clear
     BlasType::set(0, r);
     BlasType::set(0, d);
     BlasType::set(0, q);
     BlasType::set(0, s);
 
+    monitor->beginPreconditionerBuild();
     M->build(A);
+    monitor->beginIterations();
 
     // r = b - Ax
     BlasType::residual(A, *x, b, r);
@@ -43,6 +47,7 @@ void pcg(
 
     unsigned int iter = 0;
     bool trigger = false;
+    monitor->onIteration(iter, sigmaNew);
     while (sigmaNew > square(tolerance) && iter < maxNumberOfIterations) {
         // q = Ad
         BlasType::mvm(A, *d, q);
@@ -83,12 +88,49 @@ void pcg(
         BlasType::axpy(beta, *d, *s, d);
 
         ++iter;
+
+        if (!monitor->onIteration(iter, sigmaNew)) {
+            break;
+        }
     }
 
     *lastNumberOfIterations = iter;
     *lastResidualNorm = std::sqrt(sigmaNew);
 }
 
+template <
+    typename BlasType,
+    typename PrecondType>
+void pcg(
+    const typename BlasType::MatrixType& A,
+    const typename BlasType::VectorType& b,
+    unsigned int maxNumberOfIterations,
+    double tolerance,
+    PrecondType* M,
+    typename BlasType::VectorType* x,
+    typename BlasType::VectorType* r,
+    typename BlasType::VectorType* d,
+    typename BlasType::VectorType* q,
+    typename BlasType::VectorType* s,
+    unsigned int* lastNumberOfIterations,
+    double* lastResidualNorm) {
+    NullCgMonitor monitor;
+    pcg<BlasType, PrecondType, NullCgMonitor>(
+        A,
+        b,
+        maxNumberOfIterations,
+        tolerance,
+        M,
+        x,
+        r,
+        d,
+        q,
+        s,
+        lastNumberOfIterations,
+        lastResidualNorm,
+        &monitor);
+}
+
 template <typename BlasType>
 void cg(
     const typename BlasType::MatrixType& A,
@@ -119,6 +161,145 @@ void cg(
         lastResidualNorm);
 }
 
+template <
+    typename BlasType,
+    typename MonitorType>
+void cg(
+    const typename BlasType::MatrixType& A,
+    const typename BlasType::VectorType& b,
+    unsigned int maxNumberOfIterations,
+    double tolerance,
+    typename BlasType::VectorType* x,
+    typename BlasType::VectorType* r,
+    typename BlasType::VectorType* d,
+    typename BlasType::VectorType* q,
+    typename BlasType::VectorType* s,
+    unsigned int* lastNumberOfIterations,
+    double* lastResidualNorm,
+    MonitorType* monitor) {
+    typedef NullCgPreconditioner<BlasType> PrecondType;
+    PrecondType precond;
+    pcg<BlasType, PrecondType, MonitorType>(
+        A,
+        b,
+        maxNumberOfIterations,
+        tolerance,
+        &precond,
+        x,
+        r,
+        d,
+        q,
+        s,
+        lastNumberOfIterations,
+        lastResidualNorm,
+        monitor);
+}
+
+template <
+    typename BlasType,
+    typename MonitorType>
+void fusedCg(
+    const typename BlasType::MatrixType& A,
+    const typename BlasType::VectorType& b,
+    unsigned int maxNumberOfIterations,
+    double tolerance,
+    typename BlasType::VectorType* x,
+    typename BlasType::VectorType* r,
+    typename BlasType::VectorType* d,
+    typename BlasType::VectorType* q,
+    unsigned int* lastNumberOfIterations,
+    double* lastResidualNorm,
+    MonitorType* monitor) {
+    // Clear
+    BlasType::set(0, q);
+
+    // No preconditioner to build
+    monitor->beginPreconditionerBuild();
+    monitor->beginIterations();
+
+    // r = b - Ax
+    BlasType::residual(A, *x, b, r);
+
+    // d = r
+    BlasType::set(*r, d);
+
+    // sigmaNew = r.r
+    double sigmaNew = BlasType::dot(*r, *r);
+
+    unsigned int iter = 0;
+    bool trigger = false;
+    monitor->onIteration(iter, sigmaNew);
+    while (sigmaNew > square(tolerance) && iter < maxNumberOfIterations) {
+        // q = Ad, and alpha = sigmaNew/d.q
+        double alpha = sigmaNew / BlasType::mvmAndDot(A, *d, q);
+
+        // x = x + alpha*d
+        BlasType::axpy(alpha, *d, *x, x);
+
+        // sigmaOld = sigmaNew
+        double sigmaOld = sigmaNew;
+
+        // if i is divisible by 50...
+        if (trigger || (iter % 50 == 0 && iter > 0)) {
+            // r = b - Ax
+            BlasType::residual(A, *x, b, r);
+
+            // sigmaNew = r.r
+            sigmaNew = BlasType::dot(*r, *r);
+            trigger = false;
+        } else {
+            // r = r - alpha*q, and sigmaNew = r.r
+            sigmaNew = BlasType::axpyAndSquaredL2Norm(-alpha, *q, *r, r);
+        }
+
+        if (sigmaNew > sigmaOld) {
+            trigger = true;
+        }
+
+        // beta = sigmaNew/sigmaOld
+        double beta = sigmaNew / sigmaOld;
+
+        // d = r + beta*d
+        BlasType::axpy(beta, *d, *r, d);
+
+        ++iter;
+
+        if (!monitor->onIteration(iter, sigmaNew)) {
+            break;
+        }
+    }
+
+    *lastNumberOfIterations = iter;
+    *lastResidualNorm = std::sqrt(sigmaNew);
+}
+
+template <typename BlasType>
+void fusedCg(
+    const typename BlasType::MatrixType& A,
+    const typename BlasType::VectorType& b,
+    unsigned int maxNumberOfIterations,
+    double tolerance,
+    typename BlasType::VectorType* x,
+    typename BlasType::VectorType* r,
+    typename BlasType::VectorType* d,
+    typename BlasType::VectorType* q,
+    unsigned int* lastNumberOfIterations,
+    double* lastResidualNorm) {
+    NullCgMonitor monitor;
+    fusedCg<BlasType, NullCgMonitor>(
+        A,
+        b,
+        maxNumberOfIterations,
+        tolerance,
+        x,
+        r,
+        d,
+        q,
+        lastNumberOfIterations,
+        lastResidualNorm,
+        &monitor);
+}
+
 }  // namespace jet
 
 #endif  // INCLUDE_JET_DETAIL_CG_INL_H_
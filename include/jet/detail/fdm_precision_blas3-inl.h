@@ -0,0 +1,254 @@
+// Copyright (c) 2016 Doyub Kim
+
+#ifndef INCLUDE_JET_DETAIL_FDM_PRECISION_BLAS3_INL_H_
+#define INCLUDE_JET_DETAIL_FDM_PRECISION_BLAS3_INL_H_
+
+#include <jet/constants.h>
+#include <jet/macros.h>
+#include <jet/math_utils.h>
+#include <jet/parallel.h>
+#include <cmath>
+
+namespace jet {
+
+namespace internal {
+
+// Calls func(j, k, begin, end) for each x-line of the flattened 3-D array,
+// where [begin, end) is the index range of the line. The z-slices run in
+// parallel.
+template <typename Callback>
+void forEachFdmLine(const Size3& size, const Callback& func) {
+    parallelFor(kZeroSize, size.z, [&](size_t k) {
+        for (size_t j = 0; j < size.y; ++j) {
+            size_t begin = size.x * (j + size.y * k);
+            func(j, k, begin, begin + size.x);
+        }
+    });
+}
+
+// Calls func(idx, (mv)[idx]) for each grid point with the flattened index
+// idx. The stencil is computed with the arithmetic type A.
+template <typename A, typename T, typename Callback>
+void fdmPrecisionMvm(
+    const Array3<FdmPrecisionMatrixRow3<T>>& m,
+    const Array3<T>& v,
+    const Callback& func) {
+    Size3 size = m.size();
+    size_t stride = size.x * size.y;
+    const FdmPrecisionMatrixRow3<T>* mData = m.data();
+    const T* vData = v.data();
+
+    forEachFdmLine(size, [&](size_t j, size_t k, size_t begin, size_t end) {
+        bool hasDown = j > 0;
+        bool hasUp = j + 1 < size.y;
+        bool hasBack = k > 0;
+        bool hasFront = k + 1 < size.z;
+
+        auto rowSum = [&](size_t idx) {
+            const FdmPrecisionMatrixRow3<T>& row = mData[idx];
+            A sum = A(row.center) * A(vData[idx]);
+
+            if (idx > begin) {
+                sum += A(mData[idx - 1].right) * A(vData[idx - 1]);
+            }
+            if (idx + 1 < end) {
+                sum += A(row.right) * A(vData[idx + 1]);
+            }
+            if (hasDown) {
+                sum += A(mData[idx - size.x].up) * A(vData[idx - size.x]);
+            }
+            if (hasUp) {
+                sum += A(row.up) * A(vData[idx + size.x]);
+            }
+            if (hasBack) {
+                sum += A(mData[idx - stride].front) * A(vData[idx - stride]);
+            }
+            if (hasFront) {
+                sum += A(row.front) * A(vData[idx + stride]);
+            }
+
+            return sum;
+        };
+
+        if (!(hasDown && hasUp && hasBack && hasFront) || end - begin < 2) {
+            for (size_t idx = begin; idx < end; ++idx) {
+                func(idx, rowSum(idx));
+            }
+            return;
+        }
+
+        // Interior lines have all the neighbors except for the both ends, so
+        // the loop in between has no branch
+        func(begin, rowSum(begin));
+        for (size_t idx = begin + 1; idx + 1 < end; ++idx) {
+            func(
+                idx,
+                A(mData[idx].center) * A(vData[idx])
+                + A(mData[idx - 1].right) * A(vData[idx - 1])
+                + A(mData[idx].right) * A(vData[idx + 1])
+                + A(mData[idx - size.x].up) * A(vData[idx - size.x])
+                + A(mData[idx].up) * A(vData[idx + size.x])
+                + A(mData[idx - stride].front) * A(vData[idx - stride])
+                + A(mData[idx].front) * A(vData[idx + stride]));
+        }
+        func(end - 1, rowSum(end - 1));
+    });
+}
+
+}  // namespace internal
+
+template <typename Policy>
+void FdmPrecisionBlas3<Policy>::set(ScalarType s, VectorType* result) {
+    result->set(static_cast<StorageType>(s));
+}
+
+template <typename Policy>
+void FdmPrecisionBlas3<Policy>::set(const VectorType& v, VectorType* result) {
+    result->set(v);
+}
+
+template <typename Policy>
+void FdmPrecisionBlas3<Policy>::set(ScalarType s, MatrixType* result) {
+    FdmPrecisionMatrixRow3<StorageType> row;
+    row.center = row.right = row.up = row.front = static_cast<StorageType>(s);
+    result->set(row);
+}
+
+template <typename Policy>
+void FdmPrecisionBlas3<Policy>::set(const MatrixType& m, MatrixType* result) {
+    result->set(m);
+}
+
+template <typename Policy>
+typename FdmPrecisionBlas3<Policy>::ScalarType
+FdmPrecisionBlas3<Policy>::dot(const VectorType& a, const VectorType& b) {
+    typedef AccumulationType A;
+
+    JET_THROW_INVALID_ARG_IF(a.size() != b.size());
+
+    const StorageType* aData = a.data();
+    const StorageType* bData = b.data();
+    size_t n = a.width() * a.height() * a.depth();
+
+    A result = 0;
+
+    for (size_t i = 0; i < n; ++i) {
+        result += A(aData[i]) * A(bData[i]);
+    }
+
+    return result;
+}
+
+template <typename Policy>
+void FdmPrecisionBlas3<Policy>::axpy(
+    ScalarType a,
+    const VectorType& x,
+    const VectorType& y,
+    VectorType* result) {
+    typedef AccumulationType A;
+
+    JET_THROW_INVALID_ARG_IF(x.size() != y.size());
+    JET_THROW_INVALID_ARG_IF(x.size() != result->size());
+
+    const StorageType* xData = x.data();
+    const StorageType* yData = y.data();
+    StorageType* resultData = result->data();
+
+    internal::forEachFdmLine(
+        x.size(), [&](size_t, size_t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                resultData[i] = StorageType(a * A(xData[i]) + A(yData[i]));
+            }
+        });
+}
+
+template <typename Policy>
+void FdmPrecisionBlas3<Policy>::mvm(
+    const MatrixType& m,
+    const VectorType& v,
+    VectorType* result) {
+    JET_THROW_INVALID_ARG_IF(m.size() != v.size());
+    JET_THROW_INVALID_ARG_IF(m.size() != result->size());
+
+    StorageType* resultData = result->data();
+
+    internal::fdmPrecisionMvm<StorageType>(
+        m, v, [&](size_t idx, StorageType mv) {
+            resultData[idx] = mv;
+        });
+}
+
+template <typename Policy>
+void FdmPrecisionBlas3<Policy>::residual(
+    const MatrixType& a,
+    const VectorType& x,
+    const VectorType& b,
+    VectorType* result) {
+    JET_THROW_INVALID_ARG_IF(a.size() != x.size());
+    JET_THROW_INVALID_ARG_IF(a.size() != b.size());
+    JET_THROW_INVALID_ARG_IF(a.size() != result->size());
+
+    const StorageType* bData = b.data();
+    StorageType* resultData = result->data();
+
+    internal::fdmPrecisionMvm<AccumulationType>(
+        a, x, [&](size_t idx, AccumulationType ax) {
+            resultData[idx] = StorageType(AccumulationType(bData[idx]) - ax);
+        });
+}
+
+template <typename Policy>
+typename FdmPrecisionBlas3<Policy>::ScalarType
+FdmPrecisionBlas3<Policy>::l2Norm(const VectorType& v) {
+    return std::sqrt(dot(v, v));
+}
+
+template <typename Policy>
+typename FdmPrecisionBlas3<Policy>::ScalarType
+FdmPrecisionBlas3<Policy>::lInfNorm(const VectorType& v) {
+    Size3 size = v.size();
+
+    AccumulationType result = 0;
+
+    for (size_t k = 0; k < size.z; ++k) {
+        for (size_t j = 0; j < size.y; ++j) {
+            for (size_t i = 0; i < size.x; ++i) {
+                result = absmax(
+                    result, static_cast<AccumulationType>(v(i, j, k)));
+            }
+        }
+    }
+
+    return std::fabs(result);
+}
+
+template <typename Policy>
+void FdmPrecisionBlas3<Policy>::convert(
+    const FdmMatrix3& m,
+    MatrixType* result) {
+    result->resize(m.size());
+
+    m.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        const FdmMatrixRow3& row = m(i, j, k);
+        FdmPrecisionMatrixRow3<StorageType>& resultRow = (*result)(i, j, k);
+        resultRow.center = static_cast<StorageType>(row.center);
+        resultRow.right = static_cast<StorageType>(row.right);
+        resultRow.up = static_cast<StorageType>(row.up);
+        resultRow.front = static_cast<StorageType>(row.front);
+    });
+}
+
+template <typename Policy>
+void FdmPrecisionBlas3<Policy>::convert(
+    const FdmVector3& v,
+    VectorType* result) {
+    result->resize(v.size());
+
+    v.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        (*result)(i, j, k) = static_cast<StorageType>(v(i, j, k));
+    });
+}
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_DETAIL_FDM_PRECISION_BLAS3_INL_H_
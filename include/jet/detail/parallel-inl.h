@@ -108,6 +108,14 @@ void parallelMergeSort(
 
 }  // namespace internal
 
+inline unsigned int maxNumberOfThreads() {
+    static const unsigned int numThreadsHint
+        = std::thread::hardware_concurrency();
+    static const unsigned int numThreads
+        = (numThreadsHint == 0u ? 8u : numThreadsHint);
+    return numThreads;
+}
+
 
 template <typename RandomIterator, typename T>
 void parallelFill(
@@ -134,10 +142,7 @@ void parallelFor(
     }
 
     // Estimate number of threads in the pool
-    static const unsigned int numThreadsHint
-        = std::thread::hardware_concurrency();
-    static const unsigned int numThreads
-        = (numThreadsHint == 0u ? 8u : numThreadsHint);
+    const unsigned int numThreads = maxNumberOfThreads();
 
     // Size of a slice for the range functions
     IndexType n = end - start + 1;
@@ -226,10 +231,7 @@ void parallelSort(
     std::vector<value_type> temp(size);
 
     // Estimate number of threads in the pool
-    static const unsigned int numThreadsHint
-        = std::thread::hardware_concurrency();
-    static const unsigned int numThreads
-        = (numThreadsHint == 0u ? 8u : numThreadsHint);
+    const unsigned int numThreads = maxNumberOfThreads();
 
     internal::parallelMergeSort(
         begin, size, temp.begin(), numThreads, compareFunction);
@@ -0,0 +1,172 @@
+// Copyright (c) 2016 Doyub Kim
+
+#ifndef INCLUDE_JET_DETAIL_SURFACE_BVH3_INL_H_
+#define INCLUDE_JET_DETAIL_SURFACE_BVH3_INL_H_
+
+#include <jet/constants.h>
+#include <vector>
+
+namespace jet {
+
+template <typename SurfaceType>
+SurfaceBvh3<SurfaceType>::SurfaceBvh3() : _isInvalid(true) {
+}
+
+template <typename SurfaceType>
+void SurfaceBvh3<SurfaceType>::invalidate() {
+    _isInvalid = true;
+}
+
+template <typename SurfaceType>
+void SurfaceBvh3<SurfaceType>::update(const SurfaceArray& surfaces) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_isInvalid) {
+        // Rebuilt by the next query anyway
+        return;
+    }
+
+    if (_surfaceBounds.size() != surfaces.size()) {
+        _isInvalid = true;
+        return;
+    }
+
+    for (size_t i = 0; i < surfaces.size(); ++i) {
+        BoundingBox3D box = surfaces[i]->boundingBox();
+        if (!(box.lowerCorner == _surfaceBounds[i].lowerCorner)
+            || !(box.upperCorner == _surfaceBounds[i].upperCorner)) {
+            _isInvalid = true;
+            return;
+        }
+    }
+}
+
+template <typename SurfaceType>
+const Bvh3& SurfaceBvh3<SurfaceType>::bvh(const SurfaceArray& surfaces) const {
+    if (_isInvalid) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_isInvalid) {
+            build(surfaces);
+            _isInvalid = false;
+        }
+    }
+    return _bvh;
+}
+
+template <typename SurfaceType>
+const std::vector<size_t>& SurfaceBvh3<SurfaceType>::boundedSurfaces() const {
+    return _boundedSurfaces;
+}
+
+template <typename SurfaceType>
+const std::vector<size_t>&
+SurfaceBvh3<SurfaceType>::unboundedSurfaces() const {
+    return _unboundedSurfaces;
+}
+
+template <typename SurfaceType>
+size_t SurfaceBvh3<SurfaceType>::closestSurface(
+    const SurfaceArray& surfaces,
+    const Vector3D& pt,
+    double* distance) const {
+    BvhNearestQueryResult3 result = bvh(surfaces).nearest(
+        pt,
+        [&](size_t i, const Vector3D& queryPt) {
+            return surfaces[_boundedSurfaces[i]]->closestDistance(queryPt);
+        });
+
+    size_t closest = (result.item != kMaxSize)
+        ? _boundedSurfaces[result.item] : kMaxSize;
+    double minimumDistance = result.distance;
+
+    for (size_t i : _unboundedSurfaces) {
+        double localDistance = surfaces[i]->closestDistance(pt);
+        if (localDistance < minimumDistance
+            || (localDistance == minimumDistance && i < closest)) {
+            closest = i;
+            minimumDistance = localDistance;
+        }
+    }
+
+    *distance = minimumDistance;
+    return closest;
+}
+
+template <typename SurfaceType>
+bool SurfaceBvh3<SurfaceType>::intersects(
+    const SurfaceArray& surfaces,
+    const Ray3D& ray) const {
+    bool hit = bvh(surfaces).intersects(
+        ray,
+        [&](size_t i, const Ray3D& r) {
+            return surfaces[_boundedSurfaces[i]]->intersects(r);
+        });
+    if (hit) {
+        return true;
+    }
+
+    for (size_t i : _unboundedSurfaces) {
+        if (surfaces[i]->intersects(ray)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+template <typename SurfaceType>
+size_t SurfaceBvh3<SurfaceType>::closestIntersection(
+    const SurfaceArray& surfaces,
+    const Ray3D& ray) const {
+    BvhRayIntersection3 result = bvh(surfaces).closestIntersection(
+        ray,
+        [&](size_t i, const Ray3D& r) {
+            SurfaceRayIntersection3 intersection
+                = surfaces[_boundedSurfaces[i]]->closestIntersection(r);
+            return intersection.isIntersecting ? intersection.t : kMaxD;
+        });
+
+    size_t closest = result.isIntersecting
+        ? _boundedSurfaces[result.item] : kMaxSize;
+    double tMin = result.t;
+
+    for (size_t i : _unboundedSurfaces) {
+        SurfaceRayIntersection3 localResult
+            = surfaces[i]->closestIntersection(ray);
+
+        if (localResult.isIntersecting
+            && (localResult.t < tMin
+                || (localResult.t == tMin && i < closest))) {
+            closest = i;
+            tMin = localResult.t;
+        }
+    }
+
+    return closest;
+}
+
+template <typename SurfaceType>
+void SurfaceBvh3<SurfaceType>::build(const SurfaceArray& surfaces) const {
+    _boundedSurfaces.clear();
+    _unboundedSurfaces.clear();
+    _surfaceBounds.resize(surfaces.size());
+
+    std::vector<BoundingBox3D> bounds;
+    for (size_t i = 0; i < surfaces.size(); ++i) {
+        _surfaceBounds[i] = surfaces[i]->boundingBox();
+
+        // Planes and empty surfaces are kept out of the hierarchy
+        if (!_surfaceBounds[i].isBounded()) {
+            _unboundedSurfaces.push_back(i);
+            continue;
+        }
+
+        _boundedSurfaces.push_back(i);
+        bounds.push_back(Bvh3::paddedBound(_surfaceBounds[i]));
+    }
+
+    _bvh.build(bounds);
+}
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_DETAIL_SURFACE_BVH3_INL_H_
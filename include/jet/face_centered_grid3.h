@@ -3,6 +3,7 @@
 #ifndef INCLUDE_JET_FACE_CENTERED_GRID3_H_
 #define INCLUDE_JET_FACE_CENTERED_GRID3_H_
 
+#include <jet/array1.h>
 #include <jet/array3.h>
 #include <jet/array_samplers3.h>
 #include <jet/vector_grid3.h>
@@ -238,9 +239,29 @@ class FaceCenteredGrid3 final : public VectorGrid3 {
 
     // VectorField3 implementations
 
-    //! Returns sampled value at given position \p x.
+    //!
+    //! \brief Returns sampled value at given position \p x.
+    //!
+    //! The u, v, and w components are linearly interpolated. The cell indices
+    //! and the weights are computed once per axis and shared among the
+    //! components.
+    //!
     Vector3D sample(const Vector3D& x) const override;
 
+    //!
+    //! \brief Samples the grid at multiple positions.
+    //!
+    //! This function is equivalent to calling sample(x[i]) for every position,
+    //! but avoids the per-point virtual call and the sampler function object.
+    //! The positions are processed in parallel.
+    //!
+    //! \param x The sample positions.
+    //! \param result The sampled values. Must be the same size as \p x.
+    //!
+    void sample(
+        const ConstArrayAccessor1<Vector3D>& x,
+        ArrayAccessor1<Vector3D> result) const;
+
     //! Returns divergence at given position \p x.
     double divergence(const Vector3D& x) const override;
 
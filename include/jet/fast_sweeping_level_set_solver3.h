@@ -0,0 +1,128 @@
+// Copyright (c) 2016 Doyub Kim
+
+#ifndef INCLUDE_JET_FAST_SWEEPING_LEVEL_SET_SOLVER3_H_
+#define INCLUDE_JET_FAST_SWEEPING_LEVEL_SET_SOLVER3_H_
+
+#include <jet/level_set_solver3.h>
+#include <memory>
+
+namespace jet {
+
+//!
+//! \brief Three-dimensional fast sweeping method (FSM) implementation.
+//!
+//! This class implements 3-D FSM which solves the Eikonal equation with
+//! Gauss-Seidel iterations alternating over the eight sweep orderings. Unlike
+//! FmmLevelSetSolver3, there is no priority queue, so the sweeps can run in
+//! parallel. The grid is partitioned into 8x8x8 blocks, and each sweep visits
+//! the blocks hyperplane by hyperplane (bi + bj + bk = const in the sweep
+//! ordering). The first-order upwind stencil only reads the face neighbors,
+//! which are in the same block or on the adjacent hyperplanes, so the blocks on
+//! a hyperplane are updated in parallel and the result is identical to the
+//! serial sweep.
+//!
+//! The front does not propagate beyond the max distance, and only the blocks
+//! that changed or have changed neighbors are revisited. Thus, the cost is
+//! proportional to the size of the band rather than the grid.
+//!
+//! \see Zhao, Hongkai. "A fast sweeping method for eikonal equations."
+//!     Mathematics of computation 74.250 (2005): 603-627.
+//! \see Detrixhe, Miles, Frederic Gibou, and Chohong Min. "A parallel fast
+//!     sweeping method for the Eikonal equation." Journal of Computational
+//!     Physics 237 (2013): 46-55.
+//!
+class FastSweepingLevelSetSolver3 final : public LevelSetSolver3 {
+ public:
+    //! Default constructor.
+    FastSweepingLevelSetSolver3();
+
+    //!
+    //! Reinitializes given scalar field to signed-distance field.
+    //!
+    //! \param inputSdf Input signed-distance field which can be distorted.
+    //! \param maxDistance Max range of reinitialization.
+    //! \param outputSdf Output signed-distance field.
+    //!
+    void reinitialize(
+        const ScalarGrid3& inputSdf,
+        double maxDistance,
+        ScalarGrid3* outputSdf) override;
+
+    //!
+    //! Extrapolates given scalar field from negative to positive SDF region.
+    //!
+    //! \param input Input scalar field to be extrapolated.
+    //! \param sdf Reference signed-distance field.
+    //! \param maxDistance Max range of extrapolation.
+    //! \param output Output scalar field.
+    //!
+    void extrapolate(
+        const ScalarGrid3& input,
+        const ScalarField3& sdf,
+        double maxDistance,
+        ScalarGrid3* output) override;
+
+    //!
+    //! Extrapolates given collocated vector field from negative to positive SDF
+    //! region.
+    //!
+    //! \param input Input collocated vector field to be extrapolated.
+    //! \param sdf Reference signed-distance field.
+    //! \param maxDistance Max range of extrapolation.
+    //! \param output Output collocated vector field.
+    //!
+    void extrapolate(
+        const CollocatedVectorGrid3& input,
+        const ScalarField3& sdf,
+        double maxDistance,
+        CollocatedVectorGrid3* output) override;
+
+    //!
+    //! Extrapolates given face-centered vector field from negative to positive
+    //! SDF region.
+    //!
+    //! \param input Input face-centered field to be extrapolated.
+    //! \param sdf Reference signed-distance field.
+    //! \param maxDistance Max range of extrapolation.
+    //! \param output Output face-centered vector field.
+    //!
+    void extrapolate(
+        const FaceCenteredGrid3& input,
+        const ScalarField3& sdf,
+        double maxDistance,
+        FaceCenteredGrid3* output) override;
+
+    //! Returns the max number of iterations.
+    unsigned int maxNumberOfIterations() const;
+
+    //!
+    //! \brief Sets the max number of iterations.
+    //!
+    //! An iteration consists of the eight sweeps. The solver stops when an
+    //! iteration does not change any value or the number of iterations reaches
+    //! this limit. The input will be clamped to 1 if it is zero.
+    //!
+    void setMaxNumberOfIterations(unsigned int n);
+
+    //! Returns the number of iterations performed by the last call.
+    unsigned int lastNumberOfIterations() const;
+
+ private:
+    unsigned int _maxNumberOfIterations = 8;
+    unsigned int _lastNumberOfIterations = 0;
+
+    template <typename T>
+    void extrapolate(
+        const ConstArrayAccessor3<T>& input,
+        const ConstArrayAccessor3<double>& sdf,
+        const Vector3D& gridSpacing,
+        double maxDistance,
+        ArrayAccessor3<T> output);
+};
+
+typedef std::shared_ptr<FastSweepingLevelSetSolver3>
+    FastSweepingLevelSetSolver3Ptr;
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_FAST_SWEEPING_LEVEL_SET_SOLVER3_H_
@@ -16,6 +16,23 @@ class FdmCgSolver3 final : public FdmLinearSystemSolver3 {
     //! Solves the given linear system.
     bool solve(FdmLinearSystem3* system) override;
 
+    //! Solves the given compressed linear system.
+    bool solveCompressed(FdmCompressedLinearSystem3* system) override;
+
+    //! Returns true since the compressed system is supported.
+    bool isSupportingCompressedSystem() const override { return true; }
+
+    //!
+    //! \brief Solves the given matrix-free linear system.
+    //!
+    //! This function uses fusedCg() which merges the matrix-vector product
+    //! with the following dot product, and the residual update with its norm.
+    //!
+    bool solveMatrixFree(FdmMatrixFreeSystem3* system) override;
+
+    //! Returns true since the matrix-free system is supported.
+    bool isSupportingMatrixFreeSystem() const override { return true; }
+
     //! Returns the max number of Jacobi iterations.
     unsigned int maxNumberOfIterations() const;
 
@@ -38,6 +55,11 @@ class FdmCgSolver3 final : public FdmLinearSystemSolver3 {
     FdmVector3 _d;
     FdmVector3 _q;
     FdmVector3 _s;
+
+    FdmCompressedVector3 _rComp;
+    FdmCompressedVector3 _dComp;
+    FdmCompressedVector3 _qComp;
+    FdmCompressedVector3 _sComp;
 };
 
 typedef std::shared_ptr<FdmCgSolver3> FdmCgSolver3Ptr;
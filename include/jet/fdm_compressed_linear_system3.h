@@ -0,0 +1,154 @@
+// Copyright (c) 2016 Doyub Kim
+
+#ifndef INCLUDE_JET_FDM_COMPRESSED_LINEAR_SYSTEM3_H_
+#define INCLUDE_JET_FDM_COMPRESSED_LINEAR_SYSTEM3_H_
+
+#include <jet/array1.h>
+#include <jet/array3.h>
+#include <jet/fdm_linear_system3.h>
+#include <jet/point3.h>
+#include <functional>
+
+namespace jet {
+
+//!
+//! \brief Compressed sparse row (CSR) matrix for 3-D finite differencing.
+//!
+//! Unlike FdmMatrix3 which stores a row for every grid point, this matrix only
+//! stores the rows of the active (unknown) grid points. Both upper and lower
+//! triangular elements are stored, and the column indices within a row are
+//! sorted in ascending order.
+//!
+struct FdmCompressedMatrix3 {
+    //! Non-zero elements of the matrix, stored row by row.
+    Array1<double> nonZeros;
+
+    //! Column index of each non-zero element.
+    Array1<size_t> columnIndices;
+
+    //! Offset to the first non-zero element of each row (size = rows + 1).
+    Array1<size_t> rowPointers;
+
+    //! Returns the number of rows.
+    size_t rows() const;
+
+    //! Clears the matrix.
+    void clear();
+};
+
+//! Vector type for compressed 3-D finite differencing.
+typedef Array1<double> FdmCompressedVector3;
+
+//!
+//! \brief Compressed linear system (Ax=b) for 3-D finite differencing.
+//!
+//! The system only contains the active grid points. The i-th row corresponds
+//! to the grid point indexToCoord[i], and coordToIndex maps the grid point
+//! back to its row. Inactive grid points are mapped to kMaxSize.
+//!
+struct FdmCompressedLinearSystem3 {
+    FdmCompressedMatrix3 A;
+    FdmCompressedVector3 x, b;
+
+    //! Grid point of each row.
+    Array1<Point3UI> indexToCoord;
+
+    //! Row index of each grid point.
+    Array3<size_t> coordToIndex;
+
+    //! Clears the system.
+    void clear();
+
+    //!
+    //! \brief Builds the index mapping from the grid points to the rows.
+    //!
+    //! This function builds indexToCoord and coordToIndex by visiting the grid
+    //! points in lexicographic order (i being the fastest). The grid point is
+    //! mapped to a row only if \p isActive returns true. Returns the number of
+    //! active grid points.
+    //!
+    size_t buildIndexMap(
+        const Size3& size,
+        const std::function<bool(size_t, size_t, size_t)>& isActive);
+
+    //!
+    //! \brief Builds the system from the 7-point stencils of active points.
+    //!
+    //! This function first builds the index mapping using \p isActive, and
+    //! then calls \p buildRow for each active grid point in parallel to get
+    //! its symmetric stencil (FdmMatrixRow3) and right-hand side. The stencil
+    //! uses the same convention as FdmMatrix3, so the off-diagonal elements
+    //! toward the (i - 1, j, k), (i, j - 1, k), and (i, j, k - 1) points are
+    //! taken from the stencils of those points. Couplings to inactive points
+    //! are ignored. The solution vector x is resized and filled with zero.
+    //!
+    void build(
+        const Size3& size,
+        const std::function<bool(size_t, size_t, size_t)>& isActive,
+        const std::function<
+            void(size_t, size_t, size_t, FdmMatrixRow3*, double*)>& buildRow);
+
+    //!
+    //! \brief Scatters the solution x back to the grid.
+    //!
+    //! The inactive grid points are filled with \p inactiveValue.
+    //!
+    void decompressSolution(
+        FdmVector3* result, double inactiveValue = 0.0) const;
+};
+
+//! BLAS operator wrapper for compressed 3-D finite differencing.
+struct FdmCompressedBlas3 {
+    typedef double ScalarType;
+    typedef FdmCompressedVector3 VectorType;
+    typedef FdmCompressedMatrix3 MatrixType;
+
+    //! Sets entire element of given vector \p result with scalar \p s.
+    static void set(double s, FdmCompressedVector3* result);
+
+    //! Copies entire element of given vector \p result with other vector \p v.
+    static void set(
+        const FdmCompressedVector3& v, FdmCompressedVector3* result);
+
+    //! Sets entire non-zero element of given matrix \p result with scalar \p s.
+    static void set(double s, FdmCompressedMatrix3* result);
+
+    //! Copies entire element of given matrix \p result with other matrix \p v.
+    static void set(
+        const FdmCompressedMatrix3& m, FdmCompressedMatrix3* result);
+
+    //! Performs dot product with vector \p a and \p b.
+    static double dot(
+        const FdmCompressedVector3& a, const FdmCompressedVector3& b);
+
+    //! Performs ax + y operation where \p a is a matrix and \p x and \p y are
+    //! vectors.
+    static void axpy(
+        double a,
+        const FdmCompressedVector3& x,
+        const FdmCompressedVector3& y,
+        FdmCompressedVector3* result);
+
+    //! Performs matrix-vector multiplication.
+    static void mvm(
+        const FdmCompressedMatrix3& m,
+        const FdmCompressedVector3& v,
+        FdmCompressedVector3* result);
+
+    //! Computes residual vector (b - ax).
+    static void residual(
+        const FdmCompressedMatrix3& a,
+        const FdmCompressedVector3& x,
+        const FdmCompressedVector3& b,
+        FdmCompressedVector3* result);
+
+    //! Returns L2-norm of the given vector \p v.
+    static double l2Norm(const FdmCompressedVector3& v);
+
+    //! Returns Linf-norm of the given vector \p v.
+    static double lInfNorm(const FdmCompressedVector3& v);
+};
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_FDM_COMPRESSED_LINEAR_SYSTEM3_H_
@@ -7,18 +7,50 @@
 
 namespace jet {
 
-//! 3-D finite difference-type linear system solver using Gauss-Seidel method.
+//!
+//! \brief 3-D finite difference-type linear system solver using Gauss-Seidel
+//!        method.
+//!
+//! By default, the grid points are relaxed in lexicographic order, which is
+//! inherently serial. With the red-black or multi-color ordering, the grid
+//! points are grouped into colors so that no two points of the same color are
+//! coupled by the 7-point stencil. Each color is then relaxed in parallel, one
+//! color after another. The solver also supports successive over-relaxation
+//! (SOR) by setting the relaxation factor other than 1.
+//!
 class FdmGaussSeidelSolver3 final : public FdmLinearSystemSolver3 {
  public:
+    //! Order of the grid points in a relaxation sweep.
+    enum Ordering {
+        //! Lexicographic order (i being the fastest). Runs serially.
+        Lexicographic = 0,
+
+        //! Two colors by the parity of i + j + k. Each color runs in parallel.
+        RedBlack = 1,
+
+        //! Eight colors by the parity of i, j, and k. Each color runs in
+        //! parallel, and the points of a color are at least two cells apart
+        //! along every axis.
+        MultiColor = 2
+    };
+
     //! Constructs the solver with given parameters.
     FdmGaussSeidelSolver3(
         unsigned int maxNumberOfIterations,
         unsigned int residualCheckInterval,
-        double tolerance);
+        double tolerance,
+        double sorFactor = 1.0,
+        Ordering ordering = Lexicographic);
 
     //! Solves the given linear system.
     bool solve(FdmLinearSystem3* system) override;
 
+    //! Solves the given compressed linear system.
+    bool solveCompressed(FdmCompressedLinearSystem3* system) override;
+
+    //! Returns true since the compressed system is supported.
+    bool isSupportingCompressedSystem() const override { return true; }
+
     //! Returns the max number of Gauss-Seidel iterations.
     unsigned int maxNumberOfIterations() const;
 
@@ -31,16 +63,28 @@ class FdmGaussSeidelSolver3 final : public FdmLinearSystemSolver3 {
     //! Returns the last residual after the Gauss-Seidel iterations.
     double lastResidual() const;
 
+    //! Returns the SOR relaxation factor (1 for plain Gauss-Seidel).
+    double sorFactor() const;
+
+    //! Returns the order of the grid points in a relaxation sweep.
+    Ordering ordering() const;
+
  private:
     unsigned int _maxNumberOfIterations;
     unsigned int _lastNumberOfIterations;
     unsigned int _residualCheckInterval;
     double _tolerance;
     double _lastResidual;
+    double _sorFactor;
+    Ordering _ordering;
 
     FdmVector3 _residual;
 
+    FdmCompressedVector3 _residualComp;
+
     void relax(FdmLinearSystem3* system);
+
+    void relax(FdmCompressedLinearSystem3* system);
 };
 
 typedef std::shared_ptr<FdmGaussSeidelSolver3> FdmGaussSeidelSolver3Ptr;
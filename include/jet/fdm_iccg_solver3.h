@@ -17,6 +17,12 @@ class FdmIccgSolver3 final : public FdmLinearSystemSolver3 {
     //! Solves the given linear system.
     bool solve(FdmLinearSystem3* system) override;
 
+    //! Solves the given compressed linear system.
+    bool solveCompressed(FdmCompressedLinearSystem3* system) override;
+
+    //! Returns true since the compressed system is supported.
+    bool isSupportingCompressedSystem() const override { return true; }
+
     //! Returns the max number of Jacobi iterations.
     unsigned int maxNumberOfIterations() const;
 
@@ -34,6 +40,7 @@ class FdmIccgSolver3 final : public FdmLinearSystemSolver3 {
         ConstArrayAccessor3<FdmMatrixRow3> A;
         FdmVector3 d;
         FdmVector3 y;
+        bool isReused = false;
 
         void build(const FdmMatrix3& matrix);
 
@@ -42,6 +49,19 @@ class FdmIccgSolver3 final : public FdmLinearSystemSolver3 {
             FdmVector3* x);
     };
 
+    struct PreconditionerCompressed final {
+        const FdmCompressedMatrix3* A;
+        FdmCompressedVector3 d;
+        FdmCompressedVector3 y;
+        bool isReused = false;
+
+        void build(const FdmCompressedMatrix3& matrix);
+
+        void solve(
+            const FdmCompressedVector3& b,
+            FdmCompressedVector3* x);
+    };
+
     unsigned int _maxNumberOfIterations;
     unsigned int _lastNumberOfIterations;
     double _tolerance;
@@ -52,6 +72,12 @@ class FdmIccgSolver3 final : public FdmLinearSystemSolver3 {
     FdmVector3 _q;
     FdmVector3 _s;
     Preconditioner _precond;
+
+    FdmCompressedVector3 _rComp;
+    FdmCompressedVector3 _dComp;
+    FdmCompressedVector3 _qComp;
+    FdmCompressedVector3 _sComp;
+    PreconditionerCompressed _precondComp;
 };
 
 typedef std::shared_ptr<FdmIccgSolver3> FdmIccgSolver3Ptr;
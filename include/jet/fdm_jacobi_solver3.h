@@ -19,6 +19,12 @@ class FdmJacobiSolver3 final : public FdmLinearSystemSolver3 {
     //! Solves the given linear system.
     bool solve(FdmLinearSystem3* system) override;
 
+    //! Solves the given compressed linear system.
+    bool solveCompressed(FdmCompressedLinearSystem3* system) override;
+
+    //! Returns true since the compressed system is supported.
+    bool isSupportingCompressedSystem() const override { return true; }
+
     //! Returns the max number of Jacobi iterations.
     unsigned int maxNumberOfIterations() const;
 
@@ -41,7 +47,14 @@ class FdmJacobiSolver3 final : public FdmLinearSystemSolver3 {
     FdmVector3 _xTemp;
     FdmVector3 _residual;
 
+    FdmCompressedVector3 _xTempComp;
+    FdmCompressedVector3 _residualComp;
+
     void relax(FdmLinearSystem3* system, FdmVector3* xTemp);
+
+    void relax(
+        FdmCompressedLinearSystem3* system,
+        FdmCompressedVector3* xTemp);
 };
 
 typedef std::shared_ptr<FdmJacobiSolver3> FdmJacobiSolver3Ptr;
@@ -3,16 +3,179 @@
 #ifndef INCLUDE_JET_FDM_LINEAR_SYSTEM_SOLVER3_H_
 #define INCLUDE_JET_FDM_LINEAR_SYSTEM_SOLVER3_H_
 
+#include <jet/fdm_compressed_linear_system3.h>
 #include <jet/fdm_linear_system3.h>
+#include <jet/fdm_matrix_free_system3.h>
+#include <jet/timer.h>
 #include <memory>
+#include <vector>
 
 namespace jet {
 
+//!
+//! \brief Convergence statistics of the last solve call.
+//!
+//! The residuals are the norms that the solver compares with its tolerance,
+//! and the times are wall-clock times in seconds.
+//!
+struct FdmLinearSystemSolverStats3 {
+    //! Number of iterations the solver made.
+    unsigned int numberOfIterations = 0;
+
+    //! Residual norm after the last iteration.
+    double residual = 0.0;
+
+    //! Residual norm before the first iteration and after each iteration.
+    std::vector<double> residualHistory;
+
+    //! Time spent before building the preconditioner (resizing the buffers).
+    double setupTime = 0.0;
+
+    //! Time spent building the preconditioner.
+    double preconditionerBuildTime = 0.0;
+
+    //! Time spent iterating.
+    double iterationTime = 0.0;
+
+    //! True if the solver stopped early because the residual stagnated.
+    bool isStagnated = false;
+};
+
 //! Abstract base class for 3-D finite difference-type linear system solver.
 class FdmLinearSystemSolver3 {
  public:
     //! Solves the given linear system.
     virtual bool solve(FdmLinearSystem3* system) = 0;
+
+    //!
+    //! \brief Solves the given compressed linear system.
+    //!
+    //! The compressed system only contains the active grid points. Solvers that
+    //! do not support the compressed format leave the system untouched and
+    //! return false. Check isSupportingCompressedSystem() before building the
+    //! compressed system since false is also returned when not converged.
+    //!
+    virtual bool solveCompressed(FdmCompressedLinearSystem3* system) {
+        (void)system;
+        return false;
+    }
+
+    //! Returns true if the solver implements solveCompressed().
+    virtual bool isSupportingCompressedSystem() const { return false; }
+
+    //!
+    //! \brief Solves the given matrix-free linear system.
+    //!
+    //! Solvers that do not support the matrix-free operator leave the system
+    //! untouched and return false. Check isSupportingMatrixFreeSystem() before
+    //! building the system since false is also returned when not converged.
+    //!
+    virtual bool solveMatrixFree(FdmMatrixFreeSystem3* system) {
+        (void)system;
+        return false;
+    }
+
+    //! Returns true if the solver implements solveMatrixFree().
+    virtual bool isSupportingMatrixFreeSystem() const { return false; }
+
+    //! Returns true if the solver starts from the current solution vector.
+    bool isUsingWarmStart() const;
+
+    //!
+    //! \brief Sets whether the solver starts from the current solution vector.
+    //!
+    //! By default, Krylov solvers reset the solution vector x to zero before
+    //! iterating. If enabled, the given x is used as the initial guess instead,
+    //! which is useful when the previous solution is close to the new one. The
+    //! stationary solvers (Jacobi and Gauss-Seidel) always start from x.
+    //!
+    void setIsUsingWarmStart(bool isUsing);
+
+    //! Returns true if the solver reuses the data built from the last matrix.
+    bool isReusingMatrix() const;
+
+    //!
+    //! \brief Sets whether the matrix is identical to the last solve call.
+    //!
+    //! If enabled, the solver skips rebuilding the matrix-dependent data such
+    //! as the preconditioner, and reuses the one from the last solve call. The
+    //! caller is responsible for enabling it only when the matrix has not been
+    //! changed. The data is rebuilt anyway if the size of the matrix differs.
+    //!
+    void setIsReusingMatrix(bool isReusing);
+
+    //! Returns true if the solver collects the stats of each solve call.
+    bool isCollectingStats() const;
+
+    //!
+    //! \brief Sets whether the solver collects the stats of each solve call.
+    //!
+    //! If enabled, the solver records the residual history and the time spent
+    //! on each phase into stats(). Only the solvers based on cg() and pcg()
+    //! record the stats. When disabled (default), the solver skips the
+    //! recording at the cost of a branch per iteration.
+    //!
+    void setIsCollectingStats(bool isCollecting);
+
+    //! Returns the number of iterations for the stagnation detection.
+    unsigned int stagnationWindow() const;
+
+    //!
+    //! \brief Sets the number of iterations for the stagnation detection.
+    //!
+    //! If the residual is not below stagnationRatio() times the residual
+    //! \p window iterations earlier, the solver stops early and marks the
+    //! stats as stagnated. Zero (default) disables the detection. Only the
+    //! solvers based on cg() and pcg() detect the stagnation.
+    //!
+    void setStagnationWindow(unsigned int window);
+
+    //! Returns the residual ratio for the stagnation detection.
+    double stagnationRatio() const;
+
+    //! Sets the residual ratio for the stagnation detection (default 0.99).
+    void setStagnationRatio(double ratio);
+
+    //! Returns the stats of the last solve call.
+    const FdmLinearSystemSolverStats3& stats() const;
+
+ protected:
+    //!
+    //! \brief Monitor for cg() and pcg() which records the stats and detects
+    //!        the stagnation.
+    //!
+    //! Construct the monitor at the beginning of the solve call, pass it to
+    //! cg() or pcg(), and then call end() with the result.
+    //!
+    class StatsMonitor final {
+     public:
+        //! Starts monitoring a solve call of the given solver.
+        explicit StatsMonitor(FdmLinearSystemSolver3* solver);
+
+        void beginPreconditionerBuild();
+
+        void beginIterations();
+
+        bool onIteration(unsigned int iter, double residualNormSquared);
+
+        //! Finishes monitoring with the result of the solve call.
+        void end(unsigned int numberOfIterations, double residual);
+
+     private:
+        FdmLinearSystemSolver3* _solver;
+        bool _isCollectingStats;
+        unsigned int _stagnationWindow;
+        Timer _timer;
+        std::vector<double> _recentResiduals;
+    };
+
+ private:
+    bool _isUsingWarmStart = false;
+    bool _isReusingMatrix = false;
+    bool _isCollectingStats = false;
+    unsigned int _stagnationWindow = 0;
+    double _stagnationRatio = 0.99;
+    FdmLinearSystemSolverStats3 _stats;
 };
 
 typedef std::shared_ptr<FdmLinearSystemSolver3> FdmLinearSystemSolver3Ptr;
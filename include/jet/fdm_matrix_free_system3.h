@@ -0,0 +1,112 @@
+// Copyright (c) 2016 Doyub Kim
+
+#ifndef INCLUDE_JET_FDM_MATRIX_FREE_SYSTEM3_H_
+#define INCLUDE_JET_FDM_MATRIX_FREE_SYSTEM3_H_
+
+#include <jet/array3.h>
+#include <jet/fdm_linear_system3.h>
+#include <jet/vector3.h>
+
+namespace jet {
+
+//!
+//! \brief Matrix-free 3-D Poisson operator for finite differencing.
+//!
+//! Instead of storing FdmMatrixRow3 (4 doubles) per grid point, this operator
+//! computes the 7-point Laplacian stencil on the fly from 1-byte cell type
+//! markers and the per-axis coefficients. A fluid cell is coupled with its
+//! fluid neighbors, an air neighbor only adds to the diagonal (Dirichlet), and
+//! a boundary neighbor or the end of the domain adds nothing (Neumann). Air
+//! and boundary cells are identity rows. This is the same matrix as the one
+//! GridSinglePhasePressureSolver3 builds for the blocked boundaries.
+//!
+struct FdmMatrixFreeMatrix3 {
+    //! Cell types for the markers.
+    enum CellType {
+        Fluid = 0,
+        Air = 1,
+        Boundary = 2
+    };
+
+    //! Cell type of each grid point.
+    Array3<char> markers;
+
+    //! Coefficient of the coupling along each axis (typically 1 / h^2).
+    Vector3D coefficients = Vector3D(1.0, 1.0, 1.0);
+
+    //! Returns the size of the matrix.
+    Size3 size() const;
+
+    //! Returns the matrix row at (i, j, k) computed from the markers.
+    FdmMatrixRow3 row(size_t i, size_t j, size_t k) const;
+
+    //! Computes (Ax)(i, j, k) with the stencil from the markers.
+    double apply(const FdmVector3& x, size_t i, size_t j, size_t k) const;
+};
+
+//! Matrix-free linear system (Ax=b) for 3-D finite differencing.
+struct FdmMatrixFreeSystem3 {
+    FdmMatrixFreeMatrix3 A;
+    FdmVector3 x, b;
+};
+
+//!
+//! \brief BLAS operator wrapper for matrix-free 3-D finite differencing.
+//!
+//! In addition to the operations that cg() and pcg() require, this wrapper
+//! provides fused kernels that fusedCg() uses to reduce the number of passes
+//! over the vectors per iteration. The reductions are computed per k-slice in
+//! parallel and summed in a fixed order, so the results are deterministic.
+//!
+struct FdmMatrixFreeBlas3 {
+    typedef double ScalarType;
+    typedef FdmVector3 VectorType;
+    typedef FdmMatrixFreeMatrix3 MatrixType;
+
+    //! Sets entire element of given vector \p result with scalar \p s.
+    static void set(double s, FdmVector3* result);
+
+    //! Copies entire element of given vector \p result with other vector \p v.
+    static void set(const FdmVector3& v, FdmVector3* result);
+
+    //! Performs dot product with vector \p a and \p b.
+    static double dot(const FdmVector3& a, const FdmVector3& b);
+
+    //! Performs ax + y operation where \p a is a matrix and \p x and \p y are
+    //! vectors.
+    static void axpy(
+        double a, const FdmVector3& x, const FdmVector3& y, FdmVector3* result);
+
+    //! Performs matrix-vector multiplication.
+    static void mvm(
+        const FdmMatrixFreeMatrix3& m,
+        const FdmVector3& v,
+        FdmVector3* result);
+
+    //! Computes residual vector (b - ax).
+    static void residual(
+        const FdmMatrixFreeMatrix3& a,
+        const FdmVector3& x,
+        const FdmVector3& b,
+        FdmVector3* result);
+
+    //! Returns L2-norm of the given vector \p v.
+    static double l2Norm(const FdmVector3& v);
+
+    //! Returns Linf-norm of the given vector \p v.
+    static double lInfNorm(const FdmVector3& v);
+
+    //! Performs matrix-vector multiplication and returns v.result.
+    static double mvmAndDot(
+        const FdmMatrixFreeMatrix3& m,
+        const FdmVector3& v,
+        FdmVector3* result);
+
+    //! Performs ax + y operation and returns the squared L2-norm of the result.
+    static double axpyAndSquaredL2Norm(
+        double a, const FdmVector3& x, const FdmVector3& y, FdmVector3* result);
+};
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_FDM_MATRIX_FREE_SYSTEM3_H_
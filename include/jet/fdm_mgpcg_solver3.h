@@ -0,0 +1,106 @@
+// Copyright (c) 2016 Doyub Kim
+
+#ifndef INCLUDE_JET_FDM_MGPCG_SOLVER3_H_
+#define INCLUDE_JET_FDM_MGPCG_SOLVER3_H_
+
+#include <jet/fdm_linear_system_solver3.h>
+#include <vector>
+
+namespace jet {
+
+//!
+//! \brief 3-D finite difference-type linear system solver using multigrid
+//!        preconditioned conjugate gradient (MGPCG).
+//!
+//! This class implements conjugate gradient solver with a geometric multigrid
+//! V-cycle as its preconditioner. Each coarser level is built by aggregating
+//! 2x2x2 cells of the finer level using Galerkin coarsening. Only the cells
+//! that are coupled with their neighbors (fluid cells) are aggregated, so the
+//! air and solid cells which are encoded as decoupled identity rows never leak
+//! into the coarse levels and are solved directly instead. Smoothing is done
+//! by damped Jacobi iterations which run in parallel. Since the V-cycle is
+//! symmetric, the number of CG iterations becomes nearly independent of the
+//! grid resolution.
+//!
+//! \see McAdams, Aleka, Eftychios Sifakis, and Joseph Teran.
+//!     "A parallel multigrid Poisson solver for fluids simulation on large
+//!     grids." Proceedings of the 2010 ACM SIGGRAPH/Eurographics Symposium on
+//!     Computer Animation. Eurographics Association, 2010.
+//!
+class FdmMgpcgSolver3 final : public FdmLinearSystemSolver3 {
+ public:
+    //! Constructs the solver with given parameters.
+    FdmMgpcgSolver3(
+        unsigned int maxNumberOfIterations,
+        double tolerance,
+        unsigned int maxNumberOfLevels = 8,
+        unsigned int numberOfSmoothingIterations = 2);
+
+    //! Solves the given linear system.
+    bool solve(FdmLinearSystem3* system) override;
+
+    //! Returns the max number of CG iterations.
+    unsigned int maxNumberOfIterations() const;
+
+    //! Returns the last number of CG iterations the solver made.
+    unsigned int lastNumberOfIterations() const;
+
+    //! Returns the max residual tolerance for the CG method.
+    double tolerance() const;
+
+    //! Returns the last residual after the CG iterations.
+    double lastResidual() const;
+
+    //! Returns the max number of multigrid levels including the finest one.
+    unsigned int maxNumberOfLevels() const;
+
+    //! Returns the number of pre- and post-smoothing iterations per level.
+    unsigned int numberOfSmoothingIterations() const;
+
+ private:
+    struct Level final {
+        FdmMatrix3 A;
+        Array3<char> coupled;
+        FdmVector3 x;
+        FdmVector3 b;
+        FdmVector3 r;
+        FdmVector3 xTemp;
+    };
+
+    struct Preconditioner final {
+        ConstArrayAccessor3<FdmMatrixRow3> A;
+        std::vector<Level> levels;
+        unsigned int maxNumberOfLevels = 1;
+        unsigned int numberOfSmoothingIterations = 1;
+        bool isReused = false;
+
+        void build(const FdmMatrix3& matrix);
+
+        void solve(
+            const FdmVector3& b,
+            FdmVector3* x);
+
+        ConstArrayAccessor3<FdmMatrixRow3> matrix(size_t level) const;
+
+        void relax(size_t level, unsigned int numberOfIterations);
+
+        void vcycle(size_t level);
+    };
+
+    unsigned int _maxNumberOfIterations;
+    unsigned int _lastNumberOfIterations;
+    double _tolerance;
+    double _lastResidualNorm;
+
+    FdmVector3 _r;
+    FdmVector3 _d;
+    FdmVector3 _q;
+    FdmVector3 _s;
+    Preconditioner _precond;
+};
+
+typedef std::shared_ptr<FdmMgpcgSolver3> FdmMgpcgSolver3Ptr;
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_FDM_MGPCG_SOLVER3_H_
@@ -0,0 +1,86 @@
+// Copyright (c) 2016 Doyub Kim
+
+#ifndef INCLUDE_JET_FDM_MIXED_PRECISION_CG_SOLVER3_H_
+#define INCLUDE_JET_FDM_MIXED_PRECISION_CG_SOLVER3_H_
+
+#include <jet/fdm_linear_system_solver3.h>
+#include <jet/fdm_precision_blas3.h>
+
+namespace jet {
+
+//!
+//! \brief 3-D finite difference-type linear system solver using mixed-precision
+//!        conjugate gradient.
+//!
+//! This solver runs conjugate gradient on a single-precision copy of the
+//! matrix and the search vectors (FdmPrecisionBlas3 with
+//! FdmMixedPrecisionPolicy), while the dot products are accumulated in double.
+//! The CG iterations are wrapped by iterative refinement: the residual of the
+//! double-precision system is recomputed in double, the single-precision CG
+//! solves for the correction, and the correction is added to the solution in
+//! double. Thus, the solver terminates with the same double-precision residual
+//! criterion as FdmCgSolver3, even though the tolerance is far below the
+//! precision of float. The refinement stops early if a correction does not
+//! reduce the residual, and solve() returns false in that case.
+//!
+//! The stats record the double-precision residual after each refinement step,
+//! and the stagnation window is counted in refinement steps.
+//!
+class FdmMixedPrecisionCgSolver3 final : public FdmLinearSystemSolver3 {
+ public:
+    typedef FdmPrecisionBlas3<FdmMixedPrecisionPolicy> BlasType;
+
+    //! Constructs the solver with given parameters.
+    FdmMixedPrecisionCgSolver3(
+        unsigned int maxNumberOfIterations,
+        double tolerance,
+        double innerTolerance = 1e-4);
+
+    //! Solves the given linear system.
+    bool solve(FdmLinearSystem3* system) override;
+
+    //! Returns the max number of CG iterations summed over the refinements.
+    unsigned int maxNumberOfIterations() const;
+
+    //! Returns the last number of CG iterations the solver made.
+    unsigned int lastNumberOfIterations() const;
+
+    //! Returns the max residual tolerance for the CG method.
+    double tolerance() const;
+
+    //! Returns the last residual computed in double precision.
+    double lastResidual() const;
+
+    //!
+    //! \brief Returns the relative residual reduction of each single-precision
+    //!        CG solve.
+    //!
+    double innerTolerance() const;
+
+    //! Returns the last number of refinement steps the solver made.
+    unsigned int lastNumberOfRefinements() const;
+
+ private:
+    unsigned int _maxNumberOfIterations;
+    unsigned int _lastNumberOfIterations;
+    unsigned int _lastNumberOfRefinements;
+    double _tolerance;
+    double _innerTolerance;
+    double _lastResidual;
+
+    BlasType::MatrixType _matrix;
+    BlasType::VectorType _b;
+    BlasType::VectorType _e;
+    BlasType::VectorType _r;
+    BlasType::VectorType _d;
+    BlasType::VectorType _q;
+    BlasType::VectorType _s;
+    FdmVector3 _residual;
+};
+
+typedef std::shared_ptr<FdmMixedPrecisionCgSolver3>
+    FdmMixedPrecisionCgSolver3Ptr;
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_FDM_MIXED_PRECISION_CG_SOLVER3_H_
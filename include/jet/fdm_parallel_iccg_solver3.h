@@ -0,0 +1,79 @@
+// Copyright (c) 2016 Doyub Kim
+
+#ifndef INCLUDE_JET_FDM_PARALLEL_ICCG_SOLVER3_H_
+#define INCLUDE_JET_FDM_PARALLEL_ICCG_SOLVER3_H_
+
+#include <jet/fdm_cg_solver3.h>
+
+namespace jet {
+
+//!
+//! \brief 3-D finite difference-type linear system solver using incomplete
+//!        Cholesky conjugate gradient with parallel preconditioner.
+//!
+//! This class computes the same IC(0) preconditioner as FdmIccgSolver3, but
+//! the factorization and the forward/backward substitutions are scheduled in
+//! wavefronts. Each (j, k) grid line is swept along the x-axis and depends only
+//! on the (j - 1, k) and (j, k - 1) lines (or (j + 1, k) and (j, k + 1) for the
+//! backward pass). The lines are grouped into blocks and the blocks on the same
+//! J + K hyperplane are processed in parallel. Since the dependencies are
+//! identical to the lexicographic order, the result and the convergence are
+//! the same as the serial version.
+//!
+class FdmParallelIccgSolver3 final : public FdmLinearSystemSolver3 {
+ public:
+    //! Constructs the solver with given parameters.
+    FdmParallelIccgSolver3(
+        unsigned int maxNumberOfIterations, double tolerance);
+
+    //! Solves the given linear system.
+    bool solve(FdmLinearSystem3* system) override;
+
+    //! Returns the max number of ICCG iterations.
+    unsigned int maxNumberOfIterations() const;
+
+    //! Returns the last number of ICCG iterations the solver made.
+    unsigned int lastNumberOfIterations() const;
+
+    //! Returns the max residual tolerance for the ICCG method.
+    double tolerance() const;
+
+    //! Returns the last residual after the ICCG iterations.
+    double lastResidual() const;
+
+ private:
+    struct Preconditioner final {
+        ConstArrayAccessor3<FdmMatrixRow3> A;
+        FdmVector3 d;
+        FdmVector3 y;
+        size_t blockSizeY = 1;
+        size_t blockSizeZ = 1;
+        bool isReused = false;
+
+        void build(const FdmMatrix3& matrix);
+
+        void solve(
+            const FdmVector3& b,
+            FdmVector3* x);
+
+        template <typename Callback>
+        void forEachLineInWavefront(bool reverse, const Callback& func);
+    };
+
+    unsigned int _maxNumberOfIterations;
+    unsigned int _lastNumberOfIterations;
+    double _tolerance;
+    double _lastResidualNorm;
+
+    FdmVector3 _r;
+    FdmVector3 _d;
+    FdmVector3 _q;
+    FdmVector3 _s;
+    Preconditioner _precond;
+};
+
+typedef std::shared_ptr<FdmParallelIccgSolver3> FdmParallelIccgSolver3Ptr;
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_FDM_PARALLEL_ICCG_SOLVER3_H_
@@ -96,9 +96,26 @@ class GridBackwardEulerDiffusionSolver3 final : public GridDiffusionSolver3 {
     //! Sets the linear system solver for this diffusion solver.
     void setLinearSystemSolver(const FdmLinearSystemSolver3Ptr& solver);
 
+    //! Returns true if the solver only builds the system for the fluid area.
+    bool isUsingCompressedLinearSystem() const;
+
+    //!
+    //! \brief Sets whether the solver only builds the system for the fluid
+    //!        area.
+    //!
+    //! If enabled, the matrix is built as FdmCompressedLinearSystem3 which
+    //! skips the air and boundary points, and the values at those points are
+    //! copied from the source. If the linear system solver does not support it
+    //! (see FdmLinearSystemSolver3::isSupportingCompressedSystem), the full
+    //! system is built and solved instead.
+    //!
+    void setIsUsingCompressedLinearSystem(bool isUsing);
+
  private:
     BoundaryType _boundaryType;
     FdmLinearSystem3 _system;
+    FdmCompressedLinearSystem3 _compSystem;
+    bool _isUsingCompressedLinearSystem = false;
     FdmLinearSystemSolver3Ptr _systemSolver;
     Array3<char> _markers;
 
@@ -112,6 +129,14 @@ class GridBackwardEulerDiffusionSolver3 final : public GridDiffusionSolver3 {
         const Size3& size,
         const Vector3D& c);
 
+    void buildMatrixRow(
+        const Size3& size,
+        const Vector3D& c,
+        size_t i,
+        size_t j,
+        size_t k,
+        FdmMatrixRow3* row) const;
+
     void buildVectors(
         const ConstArrayAccessor3<double>& f,
         const Vector3D& c);
@@ -120,6 +145,10 @@ class GridBackwardEulerDiffusionSolver3 final : public GridDiffusionSolver3 {
         const ConstArrayAccessor3<Vector3D>& f,
         const Vector3D& c,
         size_t component);
+
+    void solveSystem();
+
+    bool isSolvingCompressedSystem() const;
 };
 
 typedef std::shared_ptr<GridBackwardEulerDiffusionSolver3>
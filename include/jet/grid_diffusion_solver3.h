@@ -20,7 +20,8 @@ namespace jet {
 //! types of fields. The target equation can be written as
 //! \f$\frac{\partial f}{\partial t} = \mu\nabla^2 f\f$ where \f$\mu\f$ is
 //! the diffusion coefficient. The field \f$f\f$ can be either scalar or vector
-//! field.
+//! field. The implementations should write every data point of the output
+//! field, so the output does not need to be initialized.
 //!
 
 class GridDiffusionSolver3 {
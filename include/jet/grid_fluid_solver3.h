@@ -212,6 +212,16 @@ class GridFluidSolver3 : public PhysicsAnimation {
     //!
     virtual ScalarField3Ptr fluidSdf() const;
 
+    //!
+    //! \brief Returns the signed-distance field of the advection boundary.
+    //!
+    //! The advection solver only updates the data points in the positive
+    //! region of this field, and the back-traces are clipped by it. By
+    //! default, this will return the collider SDF. A subclass can override
+    //! this function to limit the advection to a sub-region of the domain.
+    //!
+    virtual const ScalarField3& advectionBoundarySdf() const;
+
     //! Computes the gravity term.
     void computeGravity(double timeIntervalInSeconds);
 
@@ -244,6 +254,8 @@ class GridFluidSolver3 : public PhysicsAnimation {
     GridSystemData3Ptr _grids;
     Collider3Ptr _collider;
     CellCenteredScalarGrid3 _colliderSdf;
+    Collider3Ptr _colliderSdfSource;
+    size_t _colliderSdfStamp = 0;
 
     AdvectionSolver3Ptr _advectionSolver;
     GridDiffusionSolver3Ptr _diffusionSolver;
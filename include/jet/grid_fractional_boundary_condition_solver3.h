@@ -50,6 +50,8 @@ class GridFractionalBoundaryConditionSolver3
 
  private:
     CellCenteredScalarGrid3 _colliderSdf;
+    Collider3Ptr _colliderSdfSource;
+    size_t _colliderSdfStamp = 0;
 };
 
 typedef std::shared_ptr<GridFractionalBoundaryConditionSolver3>
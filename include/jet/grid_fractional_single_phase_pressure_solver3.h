@@ -86,16 +86,66 @@ class GridFractionalSinglePhasePressureSolver3 : public GridPressureSolver3 {
     //! Sets the linear system solver.
     void setLinearSystemSolver(const FdmLinearSystemSolver3Ptr& solver);
 
+    //! Returns true if the solver only builds the system for the fluid cells.
+    bool isUsingCompressedLinearSystem() const;
+
+    //!
+    //! \brief Sets whether the solver only builds the system for the fluid
+    //!        cells.
+    //!
+    //! If enabled, the solver builds FdmCompressedLinearSystem3 which only
+    //! contains the fluid cells, instead of the full-grid FdmLinearSystem3.
+    //! If the linear system solver does not support it (see FdmLinearSystem-
+    //! Solver3::isSupportingCompressedSystem), the full system is built and
+    //! solved instead. The solution is scattered back to the
+    //! grid, so pressure() returns the same field in both modes.
+    //!
+    void setIsUsingCompressedLinearSystem(bool isUsing);
+
+    //! Returns true if the solver starts from the last pressure.
+    bool isUsingWarmStart() const;
+
+    //!
+    //! \brief Sets whether the solver starts from the last pressure.
+    //!
+    //! Between the sub-steps, the last pressure is usually a good initial
+    //! guess for the linear system solver.
+    //!
+    void setIsUsingWarmStart(bool isUsing);
+
+    //! Returns true if the solver reuses the matrix when it has not changed.
+    bool isReusingUnchangedMatrix() const;
+
+    //!
+    //! \brief Sets whether the solver reuses the matrix when it has not
+    //!        changed.
+    //!
+    //! If enabled, the solver keeps a copy of the face weights and the fluid
+    //! SDF used for the last matrix. When they are identical (for example,
+    //! smoke with static colliders), only the right-hand side is rebuilt and
+    //! the linear system solver is told to reuse its preconditioner.
+    //!
+    void setIsReusingUnchangedMatrix(bool isReusing);
+
     //! Returns the pressure field.
     const FdmVector3& pressure() const;
 
  private:
     FdmLinearSystem3 _system;
+    FdmCompressedLinearSystem3 _compSystem;
+    bool _isUsingCompressedLinearSystem = false;
+    bool _isUsingWarmStart = false;
+    bool _isReusingUnchangedMatrix = false;
     FdmLinearSystemSolver3Ptr _systemSolver;
     Array3<double> _uWeights;
     Array3<double> _vWeights;
     Array3<double> _wWeights;
     CellCenteredScalarGrid3 _fluidSdf;
+    Vector3D _lastGridSpacing;
+    Array3<double> _lastUWeights;
+    Array3<double> _lastVWeights;
+    Array3<double> _lastWWeights;
+    Array3<double> _lastFluidSdf;
 
     void buildWeights(
         const FaceCenteredGrid3& input,
@@ -104,6 +154,22 @@ class GridFractionalSinglePhasePressureSolver3 : public GridPressureSolver3 {
 
     virtual void buildSystem(const FaceCenteredGrid3& input);
 
+    void buildCompressedSystem(const FaceCenteredGrid3& input);
+
+    void buildRhs(const FaceCenteredGrid3& input);
+
+    bool isSolvingCompressedSystem() const;
+
+    bool detectMatrixChange(const FaceCenteredGrid3& input);
+
+    void buildRow(
+        const FaceCenteredGrid3& input,
+        size_t i,
+        size_t j,
+        size_t k,
+        FdmMatrixRow3* row,
+        double* rhs) const;
+
     virtual void applyPressureGradient(
         const FaceCenteredGrid3& input,
         FaceCenteredGrid3* output);
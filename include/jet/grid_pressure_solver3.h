@@ -41,7 +41,9 @@ class GridPressureSolver3 {
     //! specified, constant scalar field with kMaxD will be used for
     //! \p boundarySdf meaning that no boundary at all. Similarly, a constant
     //! field with -kMaxD will be used for \p fluidSdf which means it's fully
-    //! occupied with fluid without any atmosphere.
+    //! occupied with fluid without any atmosphere. The implementations should
+    //! support in-place update where \p input and \p output refer to the same
+    //! grid, which is how GridFluidSolver3 calls this function.
     //!
     //! \param[in]    input                 The input velocity field.
     //! \param[in]    timeIntervalInSeconds The time interval for the sim.
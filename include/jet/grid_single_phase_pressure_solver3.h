@@ -80,10 +80,71 @@ class GridSinglePhasePressureSolver3 : public GridPressureSolver3 {
     //! Returns the pressure field.
     const FdmVector3& pressure() const;
 
+    //! Returns true if the solver only builds the system for the fluid cells.
+    bool isUsingCompressedLinearSystem() const;
+
+    //!
+    //! \brief Sets whether the solver only builds the system for the fluid
+    //!        cells.
+    //!
+    //! If enabled, the solver builds FdmCompressedLinearSystem3 which skips
+    //! the air and boundary cells. If the linear system solver does not
+    //! support it (see FdmLinearSystemSolver3::isSupportingCompressedSystem),
+    //! the full system is built and solved instead.
+    //!
+    void setIsUsingCompressedLinearSystem(bool isUsing);
+
+    //! Returns true if the solver uses the matrix-free Poisson operator.
+    bool isUsingMatrixFreeSystem() const;
+
+    //!
+    //! \brief Sets whether the solver uses the matrix-free Poisson operator.
+    //!
+    //! If enabled, the solver builds FdmMatrixFreeSystem3 which computes the
+    //! matrix on the fly from the cell markers instead of storing it. This
+    //! option takes precedence over the compressed linear system. If the
+    //! linear system solver does not support it (see FdmLinearSystemSolver3::
+    //! isSupportingMatrixFreeSystem), the assembled system is solved instead.
+    //!
+    void setIsUsingMatrixFreeSystem(bool isUsing);
+
+    //! Returns true if the solver starts from the last pressure.
+    bool isUsingWarmStart() const;
+
+    //!
+    //! \brief Sets whether the solver starts from the last pressure.
+    //!
+    //! Between the sub-steps, the last pressure is usually a good initial
+    //! guess for the linear system solver.
+    //!
+    void setIsUsingWarmStart(bool isUsing);
+
+    //! Returns true if the solver reuses the matrix when it has not changed.
+    bool isReusingUnchangedMatrix() const;
+
+    //!
+    //! \brief Sets whether the solver reuses the matrix when it has not
+    //!        changed.
+    //!
+    //! If enabled, the solver keeps a copy of the cell markers used for the
+    //! last matrix. When the markers are identical, only the right-hand side
+    //! is rebuilt and the linear system solver is told to reuse its
+    //! preconditioner.
+    //!
+    void setIsReusingUnchangedMatrix(bool isReusing);
+
  private:
     FdmLinearSystem3 _system;
+    FdmCompressedLinearSystem3 _compSystem;
+    FdmMatrixFreeSystem3 _mfSystem;
+    bool _isUsingCompressedLinearSystem = false;
+    bool _isUsingMatrixFreeSystem = false;
+    bool _isUsingWarmStart = false;
+    bool _isReusingUnchangedMatrix = false;
     FdmLinearSystemSolver3Ptr _systemSolver;
     Array3<char> _markers;
+    Vector3D _lastGridSpacing;
+    Array3<char> _lastMarkers;
 
     void buildMarkers(
         const Size3& size,
@@ -93,6 +154,24 @@ class GridSinglePhasePressureSolver3 : public GridPressureSolver3 {
 
     virtual void buildSystem(const FaceCenteredGrid3& input);
 
+    void buildCompressedSystem(const FaceCenteredGrid3& input);
+
+    void buildMatrixFreeSystem(const FaceCenteredGrid3& input);
+
+    void buildRhs(const FaceCenteredGrid3& input);
+
+    bool isSolvingCompressedSystem() const;
+
+    bool detectMatrixChange(const FaceCenteredGrid3& input);
+
+    void buildRow(
+        const FaceCenteredGrid3& input,
+        size_t i,
+        size_t j,
+        size_t k,
+        FdmMatrixRow3* row,
+        double* rhs) const;
+
     virtual void applyPressureGradient(
         const FaceCenteredGrid3& input,
         FaceCenteredGrid3* output);
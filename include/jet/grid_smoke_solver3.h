@@ -41,11 +41,31 @@ class GridSmokeSolver3 : public GridFluidSolver3 {
 
     ScalarGrid3Ptr temperature() const;
 
+    bool isUsingActiveRegion() const;
+
+    void setIsUsingActiveRegion(bool isUsing);
+
+    double activeRegionThreshold() const;
+
+    void setActiveRegionThreshold(double newValue);
+
+    double activeRegionSpeedThreshold() const;
+
+    void setActiveRegionSpeedThreshold(double newValue);
+
+    const BoundingBox3D& activeRegion() const;
+
  protected:
+    void onBeginAdvanceTimeStep(double timeIntervalInSeconds) override;
+
     void onEndAdvanceTimeStep(double timeIntervalInSeconds) override;
 
     void computeExternalForces(double timeIntervalInSeconds) override;
 
+    ScalarField3Ptr fluidSdf() const override;
+
+    const ScalarField3& advectionBoundarySdf() const override;
+
  private:
     size_t _smokeDensityDataId;
     size_t _temperatureDataId;
@@ -55,10 +75,21 @@ class GridSmokeSolver3 : public GridFluidSolver3 {
     double _buoyancyTemperatureFactor = 5.0;
     double _smokeDecayFactor = 0.001;
     double _temperatureDecayFactor = 0.001;
+    bool _isUsingActiveRegion = false;
+    double _activeRegionThreshold = 1e-4;
+    double _activeRegionSpeedThreshold = 1e-2;
+    Point3UI _activeRegionLower;
+    Point3UI _activeRegionUpper;
+    BoundingBox3D _activeRegion;
+    double _ambientTemperature = 0.0;
+    ScalarField3Ptr _activeRegionSdf;
+    ScalarField3Ptr _activeRegionBoundarySdf;
 
     void computeDiffusion(double timeIntervalInSeconds);
 
     void computeBuoyancyForce(double timeIntervalInSeconds);
+
+    void updateActiveRegion();
 };
 
 }  // namespace jet
@@ -63,12 +63,32 @@ class GridSystemData3 {
 
     size_t numberOfAdvectableVectorData() const;
 
+    // The velocity and the advectable data are double-buffered. A solver step
+    // writes into the back buffer and then swaps it with the front buffer.
+    // Swapping exchanges the contents only, so the pointers returned by
+    // velocity() and advectable*DataAt() remain valid.
+
+    const FaceCenteredGrid3Ptr& velocityBackBuffer();
+
+    const ScalarGrid3Ptr& advectableScalarDataBackBufferAt(size_t idx);
+
+    const VectorGrid3Ptr& advectableVectorDataBackBufferAt(size_t idx);
+
+    void swapVelocityBuffers();
+
+    void swapAdvectableScalarDataBuffersAt(size_t idx);
+
+    void swapAdvectableVectorDataBuffersAt(size_t idx);
+
  private:
     FaceCenteredGrid3Ptr _velocity;
+    FaceCenteredGrid3Ptr _velocityBackBuffer;
     std::vector<ScalarGrid3Ptr> _scalarDataList;
     std::vector<VectorGrid3Ptr> _vectorDataList;
     std::vector<ScalarGrid3Ptr> _advectableScalarDataList;
     std::vector<VectorGrid3Ptr> _advectableVectorDataList;
+    std::vector<ScalarGrid3Ptr> _advectableScalarBackBufferList;
+    std::vector<VectorGrid3Ptr> _advectableVectorBackBufferList;
 };
 
 typedef std::shared_ptr<GridSystemData3> GridSystemData3Ptr;
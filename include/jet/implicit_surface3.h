@@ -24,6 +24,9 @@ class ImplicitSurface3 : public Surface3 {
 
     //! Returns closest distance from the given point \p otherPoint.
     double closestDistance(const Vector3D& otherPoint) const override;
+
+    //! Returns true since the signed distance defines the inside.
+    bool isClosed() const override;
 };
 
 typedef std::shared_ptr<ImplicitSurface3> ImplicitSurface3Ptr;
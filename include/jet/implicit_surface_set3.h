@@ -4,6 +4,7 @@
 #define INCLUDE_JET_IMPLICIT_SURFACE_SET3_H_
 
 #include <jet/implicit_surface3.h>
+#include <jet/surface_bvh3.h>
 #include <vector>
 
 namespace jet {
@@ -15,6 +16,14 @@ namespace jet {
 //! ImplicitSurface3 by overriding implicit surface-related quries. This is
 //! class can hold a collection of other implicit surface instances.
 //!
+//! The queries are accelerated by a bounding volume hierarchy (Bvh3) over the
+//! bounding boxes of the surfaces, and the surfaces with unbounded boxes, such
+//! as planes, are tested separately. The hierarchy is built lazily by the
+//! first query after a surface is added. Since the boxes of the surfaces are
+//! cached, call ImplicitSurfaceSet3::updateQueryEngine after moving or editing
+//! the surfaces in the set. Collider3 calls it before resolving the collisions
+//! and rasterizing the signed-distance field.
+//!
 class ImplicitSurfaceSet3 final : public ImplicitSurface3 {
  public:
     //! Constructs an empty implicit surface set.
@@ -35,6 +44,9 @@ class ImplicitSurfaceSet3 final : public ImplicitSurface3 {
     //! Adds an implicit surface instance.
     void addSurface(const ImplicitSurface3Ptr& surface);
 
+    //! Invalidates the bounding volume hierarchy of the surfaces.
+    void invalidateBvh();
+
     // Surface3 implementations
 
     //! Returns the closest point from the given point \p otherPoint to the
@@ -51,6 +63,15 @@ class ImplicitSurfaceSet3 final : public ImplicitSurface3 {
     //! Returns the bounding box of this box object.
     BoundingBox3D boundingBox() const override;
 
+    //! Returns true if all the surfaces in the set are closed and not flipped.
+    bool isClosed() const override;
+
+    //!
+    //! \brief Updates the query engines of the surfaces and rebuilds the
+    //!        bounding volume hierarchy if any surface has moved.
+    //!
+    void updateQueryEngine() override;
+
     // ImplicitSurface3 implementations
 
     //! Returns signed distance from the given point \p otherPoint.
@@ -59,11 +80,16 @@ class ImplicitSurfaceSet3 final : public ImplicitSurface3 {
  protected:
     Vector3D actualClosestNormal(const Vector3D& otherPoint) const override;
 
+    SurfaceClosestQueryResult3 actualClosestQuery(
+        const Vector3D& otherPoint) const override;
+
     SurfaceRayIntersection3 actualClosestIntersection(
         const Ray3D& ray) const override;
 
  private:
     std::vector<ImplicitSurface3Ptr> _surfaces;
+
+    SurfaceBvh3<ImplicitSurface3> _surfaceBvh;
 };
 
 typedef std::shared_ptr<ImplicitSurfaceSet3> ImplicitSurfaceSet3Ptr;
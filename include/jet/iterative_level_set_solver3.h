@@ -4,6 +4,8 @@
 #define INCLUDE_JET_ITERATIVE_LEVEL_SET_SOLVER3_H_
 
 #include <jet/level_set_solver3.h>
+#include <jet/point3.h>
+#include <vector>
 
 namespace jet {
 
@@ -93,6 +95,21 @@ class IterativeLevelSetSolver3 : public LevelSetSolver3 {
     //!
     void setMaxCfl(double newMaxCfl);
 
+    //! Returns true if the solver is using the narrow band mode.
+    bool isUsingNarrowBand() const;
+
+    //!
+    //! \brief Sets true to enable the narrow band mode.
+    //!
+    //! In the narrow band mode, the solver only updates the grid points within
+    //! the max distance from the interface instead of the entire grid. For the
+    //! reinitialization, the points with |phi| < maxDistance are updated and
+    //! the other points are clamped to +/-maxDistance. For the extrapolation,
+    //! the points with 0 <= sdf < maxDistance are updated and the other points
+    //! keep the input values. The default is false.
+    //!
+    void setIsUsingNarrowBand(bool isUsing);
+
  protected:
     //! Computes the derivatives for given grid point.
     virtual void getDerivatives(
@@ -107,6 +124,9 @@ class IterativeLevelSetSolver3 : public LevelSetSolver3 {
 
  private:
     double _maxCfl = 0.5;
+    bool _isUsingNarrowBand = false;
+    std::vector<Point3UI> _band;
+    std::vector<double> _bandValues;
 
     void extrapolate(
         const ConstArrayAccessor3<double>& input,
@@ -129,6 +149,12 @@ class IterativeLevelSetSolver3 : public LevelSetSolver3 {
     double pseudoTimeStep(
         ConstArrayAccessor3<double> sdf,
         const Vector3D& gridSpacing);
+
+    template <typename Callback>
+    void buildBand(const Size3& size, const Callback& isInBand);
+
+    template <typename Callback>
+    void iterateBand(const Callback& update, ArrayAccessor3<double> output);
 };
 
 }  // namespace jet
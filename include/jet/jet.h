@@ -18,12 +18,14 @@
 #include <jet/array_samplers3.h>
 #include <jet/array_utils.h>
 #include <jet/bcc_lattice_point_generator.h>
+#include <jet/bfecc3.h>
 #include <jet/blas.h>
 #include <jet/bounding_box.h>
 #include <jet/bounding_box2.h>
 #include <jet/bounding_box3.h>
 #include <jet/box2.h>
 #include <jet/box3.h>
+#include <jet/bvh3.h>
 #include <jet/cell_centered_scalar_grid2.h>
 #include <jet/cell_centered_scalar_grid3.h>
 #include <jet/cell_centered_vector_grid2.h>
@@ -51,9 +53,11 @@
 #include <jet/eno_level_set_solver3.h>
 #include <jet/face_centered_grid2.h>
 #include <jet/face_centered_grid3.h>
+#include <jet/fast_sweeping_level_set_solver3.h>
 #include <jet/fcc_lattice_point_generator.h>
 #include <jet/fdm_cg_solver2.h>
 #include <jet/fdm_cg_solver3.h>
+#include <jet/fdm_compressed_linear_system3.h>
 #include <jet/fdm_gauss_seidel_solver2.h>
 #include <jet/fdm_gauss_seidel_solver3.h>
 #include <jet/fdm_iccg_solver2.h>
@@ -64,6 +68,11 @@
 #include <jet/fdm_linear_system3.h>
 #include <jet/fdm_linear_system_solver2.h>
 #include <jet/fdm_linear_system_solver3.h>
+#include <jet/fdm_matrix_free_system3.h>
+#include <jet/fdm_mgpcg_solver3.h>
+#include <jet/fdm_mixed_precision_cg_solver3.h>
+#include <jet/fdm_parallel_iccg_solver3.h>
+#include <jet/fdm_precision_blas3.h>
 #include <jet/fdm_utils.h>
 #include <jet/field2.h>
 #include <jet/field3.h>
@@ -112,6 +121,7 @@
 #include <jet/level_set_solver3.h>
 #include <jet/level_set_utils.h>
 #include <jet/logging.h>
+#include <jet/mac_cormack3.h>
 #include <jet/macros.h>
 #include <jet/marching_cubes.h>
 #include <jet/math_utils.h>
@@ -126,6 +136,7 @@
 #include <jet/particle_system_data3.h>
 #include <jet/particle_system_solver2.h>
 #include <jet/particle_system_solver3.h>
+#include <jet/particles_to_sdf3.h>
 #include <jet/pci_sph_solver2.h>
 #include <jet/pci_sph_solver3.h>
 #include <jet/pde.h>
@@ -176,6 +187,7 @@
 #include <jet/sphere3.h>
 #include <jet/surface2.h>
 #include <jet/surface3.h>
+#include <jet/surface_bvh3.h>
 #include <jet/surface_set2.h>
 #include <jet/surface_set3.h>
 #include <jet/surface_to_implicit2.h>
@@ -0,0 +1,155 @@
+// Copyright (c) 2016 Doyub Kim
+
+#ifndef INCLUDE_JET_MAC_CORMACK3_H_
+#define INCLUDE_JET_MAC_CORMACK3_H_
+
+#include <jet/advection_solver3.h>
+#include <jet/array3.h>
+#include <jet/array_accessor3.h>
+#include <limits>
+#include <memory>
+
+namespace jet {
+
+//!
+//! \brief Implementation of 3-D MacCormack advection solver.
+//!
+//! This class implements 3-D MacCormack advection solver based on
+//! semi-Lagrangian steps. The solver advects the input forward in time, then
+//! advects the result backward in time, and uses half of the difference from
+//! the input to compensate the error of the forward step. The result is 2nd
+//! order accurate in space and time and much less dissipative than
+//! SemiLagrangian3, so the same amount of detail can be kept with a coarser
+//! grid. The back-tracing is shared with SemiLagrangian3, and the spatial
+//! interpolation is linear.
+//!
+//! Since the error compensation can create new extrema, a limiter is applied
+//! by default. See "An unconditionally stable MacCormack method" by Selle et
+//! al., 2008.
+//!
+class MacCormack3 : public AdvectionSolver3 {
+ public:
+    //! Limiter types for the error-compensated values.
+    enum Limiter {
+        //! No limiter.
+        kNoLimiter,
+
+        //! Clamps the value within the range of the input values around the
+        //! back-traced point.
+        kClampLimiter,
+
+        //! Reverts to the semi-Lagrangian value when the value is out of the
+        //! range of the input values around the back-traced point.
+        kRevertLimiter
+    };
+
+    //! Constructs MacCormack solver with clamp limiter.
+    MacCormack3();
+
+    virtual ~MacCormack3();
+
+    //! Returns the limiter type.
+    Limiter limiter() const;
+
+    //! Sets the limiter type.
+    void setLimiter(Limiter limiter);
+
+    //!
+    //! \brief Computes advection for given scalar grid.
+    //!
+    //! \param input Input scalar grid.
+    //! \param flow Vector field that advects the input field.
+    //! \param dt Time-step for the advection.
+    //! \param output Output scalar grid.
+    //! \param boundarySdf Boundary interface defined by signed-distance
+    //!     field.
+    //!
+    void advect(
+        const ScalarGrid3& input,
+        const VectorField3& flow,
+        double dt,
+        ScalarGrid3* output,
+        const ScalarField3& boundarySdf
+            = ConstantScalarField3(std::numeric_limits<double>::max())) final;
+
+    //!
+    //! \brief Computes advection for given collocated vector grid.
+    //!
+    //! \param input Input vector grid.
+    //! \param flow Vector field that advects the input field.
+    //! \param dt Time-step for the advection.
+    //! \param output Output vector grid.
+    //! \param boundarySdf Boundary interface defined by signed-distance
+    //!     field.
+    //!
+    void advect(
+        const CollocatedVectorGrid3& input,
+        const VectorField3& flow,
+        double dt,
+        CollocatedVectorGrid3* output,
+        const ScalarField3& boundarySdf
+            = ConstantScalarField3(std::numeric_limits<double>::max())) final;
+
+    //!
+    //! \brief Computes advection for given face-centered vector grid.
+    //!
+    //! Each component is advected independently on its own face positions.
+    //!
+    //! \param input Input vector grid.
+    //! \param flow Vector field that advects the input field.
+    //! \param dt Time-step for the advection.
+    //! \param output Output vector grid.
+    //! \param boundarySdf Boundary interface defined by signed-distance
+    //!     field.
+    //!
+    void advect(
+        const FaceCenteredGrid3& input,
+        const VectorField3& flow,
+        double dt,
+        FaceCenteredGrid3* output,
+        const ScalarField3& boundarySdf
+            = ConstantScalarField3(std::numeric_limits<double>::max())) final;
+
+ protected:
+    //!
+    //! \brief Constructs the solver with the BFECC correction.
+    //!
+    //! If \p isUsingBfecc is true, the compensated input is advected once
+    //! more instead of correcting the forward result. See Bfecc3.
+    //!
+    explicit MacCormack3(bool isUsingBfecc);
+
+ private:
+    //! Temporary arrays for advecting a data array. They are kept between
+    //! the calls and only resized when the size of the data changes.
+    template <typename T>
+    struct Buffers final {
+        Array3<Vector3D> points;
+        Array3<char> isTraced;
+        Array3<T> forward;
+        Array3<T> backward;
+    };
+
+    Limiter _limiter = kClampLimiter;
+    bool _isUsingBfecc = false;
+    Buffers<double> _scalarBuffers;
+    Buffers<Vector3D> _vectorBuffers;
+    Buffers<double> _faceBuffers[3];
+
+    template <typename T>
+    void advectData(
+        const ConstArrayAccessor3<T>& input,
+        const Vector3D& origin,
+        const Vector3D& gridSpacing,
+        const VectorField3& flow,
+        double dt,
+        ArrayAccessor3<T> output,
+        const ScalarField3& boundarySdf,
+        Buffers<T>* buffers) const;
+};
+
+typedef std::shared_ptr<MacCormack3> MacCormack3Ptr;
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_MAC_CORMACK3_H_
@@ -23,6 +23,21 @@ static const int kMarchingCubesBoundaryFlagAll
     | kMarchingCubesBoundaryFlagBack
     | kMarchingCubesBoundaryFlagFront;
 
+//!
+//! \brief Computes marching cubes and extracts triangle mesh from grid.
+//!
+//! This function extracts the iso-surface of \p grid and appends it to
+//! \p mesh. Only the blocks of cells that have grid points on both sides of
+//! the iso-surface are polygonized, and the z-slabs of the grid are processed
+//! in parallel. The output is the same regardless of the number of threads.
+//!
+//! \param grid The input scalar field at the grid points.
+//! \param gridSize The grid spacing.
+//! \param origin The position of the first grid point.
+//! \param mesh The output triangle mesh.
+//! \param isoValue The iso-value of the surface.
+//! \param bndFlag The boundaries to close the surface at.
+//!
 void marchingCubes(
     const ConstArrayAccessor3<double>& grid,
     const Vector3D& gridSize,
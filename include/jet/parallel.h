@@ -5,6 +5,17 @@
 
 namespace jet {
 
+//!
+//! \brief      Returns the number of threads for the parallel functions.
+//!
+//! This function returns the number of hardware threads, or 8 if the number
+//! is not available. The parallel functions split their work by this number,
+//! and the code that partitions its own work for them should do the same.
+//!
+//! \return     The number of threads.
+//!
+unsigned int maxNumberOfThreads();
+
 //!
 //! \brief      Fills from \p begin to \p end with \p value in parallel.
 //!
@@ -0,0 +1,92 @@
+// Copyright (c) 2016 Doyub Kim
+
+#ifndef INCLUDE_JET_PARTICLES_TO_SDF3_H_
+#define INCLUDE_JET_PARTICLES_TO_SDF3_H_
+
+#include <jet/array_accessor1.h>
+#include <jet/scalar_grid3.h>
+#include <jet/vector3.h>
+
+namespace jet {
+
+//!
+//! \brief 3-D particles to signed-distance field converter.
+//!
+//! This class rasterizes the implicit surface of given particles onto the data
+//! points of a scalar grid, where the negative values are inside the fluid.
+//! Instead of gathering the nearby particles for each grid point, every
+//! particle is scattered to the grid points within its kernel support. The
+//! grid is divided into tiles, the particles are binned into the tiles they
+//! touch, and the tiles are then filled in parallel without any
+//! synchronization. The particles are visited in the same order within each
+//! tile, so the result does not depend on the number of threads.
+//!
+class ParticlesToSdf3 {
+ public:
+    //! Kernel for blending the particles.
+    enum Kernel {
+        //! SPH interpolation of the unit field with the standard kernel. The
+        //! output is the cut-off density minus the interpolated value.
+        Sph = 0,
+
+        //! Zhu and Bridson's distance to the weighted average of the nearby
+        //! particle positions minus the particle radius.
+        ZhuBridson = 1,
+
+        //! Yu and Turk's anisotropic kernels, stretched along the principal
+        //! axes of the neighborhood of each particle. The output is the
+        //! cut-off density minus the interpolated value.
+        Anisotropic = 2
+    };
+
+    //! Constructs the converter with given kernel radius and kernel type.
+    explicit ParticlesToSdf3(double kernelRadius, Kernel kernel = Sph);
+
+    //! Returns the kernel radius.
+    double kernelRadius() const;
+
+    //! Sets the kernel radius.
+    void setKernelRadius(double kernelRadius);
+
+    //! Returns the kernel type.
+    Kernel kernel() const;
+
+    //! Sets the kernel type.
+    void setKernel(Kernel kernel);
+
+    //! Returns the density of the iso-surface for the SPH and anisotropic
+    //! kernels (default 0.5).
+    double cutOffDensity() const;
+
+    //! Sets the density of the iso-surface for the SPH and anisotropic
+    //! kernels.
+    void setCutOffDensity(double cutOffDensity);
+
+    //! Returns the particle radius relative to the kernel radius for the
+    //! Zhu-Bridson kernel (default 0.5).
+    double relativeParticleRadius() const;
+
+    //! Sets the particle radius relative to the kernel radius for the
+    //! Zhu-Bridson kernel.
+    void setRelativeParticleRadius(double relativeRadius);
+
+    //!
+    //! \brief Rasterizes the particles onto the data points of given grid.
+    //!
+    //! \param positions The particle positions.
+    //! \param sdf The output signed-distance field.
+    //!
+    void convert(
+        const ConstArrayAccessor1<Vector3D>& positions,
+        ScalarGrid3* sdf) const;
+
+ private:
+    double _kernelRadius;
+    Kernel _kernel;
+    double _cutOffDensity = 0.5;
+    double _relativeParticleRadius = 0.5;
+};
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_PARTICLES_TO_SDF3_H_
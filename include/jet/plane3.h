@@ -54,6 +54,9 @@ class Plane3 final : public Surface3 {
  protected:
     Vector3D actualClosestNormal(const Vector3D& otherPoint) const override;
 
+    SurfaceClosestQueryResult3 actualClosestQuery(
+        const Vector3D& otherPoint) const override;
+
     SurfaceRayIntersection3 actualClosestIntersection(
         const Ray3D& ray) const override;
 };
@@ -29,6 +29,14 @@ class RigidBodyCollider3 final : public Collider3 {
 
     //! Returns the velocity of the collider at given \p point.
     Vector3D velocityAt(const Vector3D& point) const override;
+
+    //!
+    //! \brief Updates the surface for a new time step.
+    //!
+    //! The surface is expected to follow the velocities of the rigid body, so
+    //! the signed-distance field is invalidated if any velocity is non-zero.
+    //!
+    void updateSurface() override;
 };
 
 typedef std::shared_ptr<RigidBodyCollider3> RigidBodyCollider3Ptr;
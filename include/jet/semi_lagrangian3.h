@@ -5,6 +5,7 @@
 
 #include <jet/advection_solver3.h>
 #include <limits>
+#include <vector>
 
 namespace jet {
 
@@ -104,6 +105,29 @@ class SemiLagrangian3 : public AdvectionSolver3 {
         const ScalarField3& boundarySdf
             = ConstantScalarField3(std::numeric_limits<double>::max())) final;
 
+    //!
+    //! \brief Computes semi-Lagrangian for multiple grids at once.
+    //!
+    //! This function groups the data points of the given grids by their
+    //! layout (cell-centered, vertex-centered, and u/v/w faces). For each
+    //! layout, every data point is back-traced only once, and the result is
+    //! used to interpolate all the channels stored on that layout in the same
+    //! pass. The output is identical to advecting the grids one by one.
+    //!
+    //! \see AdvectionSolver3::advectBatch
+    //!
+    void advectBatch(
+        const std::vector<const ScalarGrid3*>& scalarInputs,
+        const std::vector<const CollocatedVectorGrid3*>& collocatedInputs,
+        const std::vector<const FaceCenteredGrid3*>& faceCenteredInputs,
+        const VectorField3& flow,
+        double dt,
+        const std::vector<ScalarGrid3*>& scalarOutputs,
+        const std::vector<CollocatedVectorGrid3*>& collocatedOutputs,
+        const std::vector<FaceCenteredGrid3*>& faceCenteredOutputs,
+        const ScalarField3& boundarySdf
+            = ConstantScalarField3(std::numeric_limits<double>::max())) final;
+
  protected:
     //!
     //! \brief Returns spatial interpolation function object for given scalar
@@ -45,9 +45,15 @@ class Sphere3 final : public Surface3 {
     //! Returns the bounding box of this sphere object.
     BoundingBox3D boundingBox() const override;
 
+    //! Returns true since the sphere is closed.
+    bool isClosed() const override;
+
  protected:
     Vector3D actualClosestNormal(const Vector3D& otherPoint) const override;
 
+    SurfaceClosestQueryResult3 actualClosestQuery(
+        const Vector3D& otherPoint) const override;
+
     //! Note, the book has different name and interface. This function used to
     //! be getClosestIntersection, but now it is simply
     //! actualClosestIntersection. Also, the book's function do not return
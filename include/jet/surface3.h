@@ -18,6 +18,13 @@ struct SurfaceRayIntersection3 {
     Vector3D normal;
 };
 
+//! Struct that represents the closest point query result.
+struct SurfaceClosestQueryResult3 {
+    Vector3D point = Vector3D(kMaxD, kMaxD, kMaxD);
+    Vector3D normal = Vector3D(1, 0, 0);
+    double distance = kMaxD;
+};
+
 //! Abstract base class for 3-D surface.
 class Surface3 {
  public:
@@ -40,6 +47,16 @@ class Surface3 {
     //! Returns the bounding box of this surface object.
     virtual BoundingBox3D boundingBox() const = 0;
 
+    //!
+    //! \brief Returns true if the surface is closed.
+    //!
+    //! A closed surface separates the inside from the outside, so no point
+    //! outside of its bounding box is on the inner side of the surface (with
+    //! Surface3::isNormalFlipped set to false). Open surfaces, such as planes
+    //! and triangle meshes, return false, which is the default.
+    //!
+    virtual bool isClosed() const;
+
     //! Returns true if the given \p ray intersects with this surface object.
     virtual bool intersects(const Ray3D& ray) const;
 
@@ -54,6 +71,25 @@ class Surface3 {
     //! point \p otherPoint.
     Vector3D closestNormal(const Vector3D& otherPoint) const;
 
+    //!
+    //! \brief Returns the closest point, normal, and distance from the given
+    //! point \p otherPoint to the surface.
+    //!
+    //! This function gives the same answers as closestPoint, closestNormal,
+    //! and closestDistance, but shares the work among them, so prefer this
+    //! one when more than one of them is needed.
+    //!
+    SurfaceClosestQueryResult3 closestQuery(const Vector3D& otherPoint) const;
+
+    //!
+    //! \brief Updates the internal spatial query engine.
+    //!
+    //! The surfaces that cache the spatial data for the queries, such as
+    //! SurfaceSet3, rebuild the data here if the surface has been moved or
+    //! edited since the last update. The default implementation does nothing.
+    //!
+    virtual void updateQueryEngine();
+
  protected:
     //!
     //! \brief Returns the closest surface normal from the given point
@@ -65,6 +101,17 @@ class Surface3 {
     //!
     virtual Vector3D actualClosestNormal(const Vector3D& otherPoint) const = 0;
 
+    //!
+    //! \brief Returns the closest point, normal, and distance from the given
+    //! point \p otherPoint.
+    //!
+    //! Same as Surface3::actualClosestNormal, the normal is not flipped
+    //! regardless how Surface3::isNormalFlipped is set. The default
+    //! implementation calls the individual queries one by one.
+    //!
+    virtual SurfaceClosestQueryResult3 actualClosestQuery(
+        const Vector3D& otherPoint) const;
+
     //!
     //! \brief Returns the closest intersection point for given \p ray.
     //!
@@ -0,0 +1,93 @@
+// Copyright (c) 2016 Doyub Kim
+
+#ifndef INCLUDE_JET_SURFACE_BVH3_H_
+#define INCLUDE_JET_SURFACE_BVH3_H_
+
+#include <jet/bvh3.h>
+#include <jet/surface3.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace jet {
+
+//!
+//! \brief Bounding volume hierarchy over the surfaces of a surface set.
+//!
+//! This class accelerates the queries of SurfaceSet3 and ImplicitSurfaceSet3
+//! with Bvh3. The surfaces with unbounded boxes, such as planes, and the empty
+//! surfaces are kept out of the hierarchy and tested separately. The hierarchy
+//! is built lazily by the first query after invalidate() is called. Since the
+//! boxes of the surfaces are cached, call update() after moving or editing the
+//! surfaces so that the hierarchy is rebuilt if any box has changed.
+//!
+//! The class does not own the surfaces, so the same surface array should be
+//! passed to all the functions. When multiple surfaces have the same distance
+//! (or ray parameter), the one with the smallest index is returned.
+//!
+//! \tparam SurfaceType - Surface3 or its subclass.
+//!
+template <typename SurfaceType>
+class SurfaceBvh3 final {
+ public:
+    typedef std::vector<std::shared_ptr<SurfaceType>> SurfaceArray;
+
+    //! Constructs an invalid hierarchy.
+    SurfaceBvh3();
+
+    //! Marks the hierarchy to be rebuilt by the next query.
+    void invalidate();
+
+    //! Rebuilds the hierarchy if the box of any surface has changed.
+    void update(const SurfaceArray& surfaces);
+
+    //! Returns the hierarchy over the bounded surfaces.
+    const Bvh3& bvh(const SurfaceArray& surfaces) const;
+
+    //! Returns the surface indices of the items of the hierarchy.
+    const std::vector<size_t>& boundedSurfaces() const;
+
+    //! Returns the indices of the surfaces that are not in the hierarchy.
+    const std::vector<size_t>& unboundedSurfaces() const;
+
+    //!
+    //! \brief Returns the index of the closest surface from the given point.
+    //!
+    //! \param surfaces The surfaces of the set.
+    //! \param pt The query point.
+    //! \param distance The distance to the closest surface, or kMaxD if there
+    //!     is no surface.
+    //! \return The index of the closest surface, or kMaxSize if there is no
+    //!     surface.
+    //!
+    size_t closestSurface(
+        const SurfaceArray& surfaces,
+        const Vector3D& pt,
+        double* distance) const;
+
+    //! Returns true if the given \p ray intersects with any surface.
+    bool intersects(const SurfaceArray& surfaces, const Ray3D& ray) const;
+
+    //! Returns the index of the surface with the closest intersection for the
+    //! given \p ray, or kMaxSize if there is no intersection.
+    size_t closestIntersection(
+        const SurfaceArray& surfaces,
+        const Ray3D& ray) const;
+
+ private:
+    mutable Bvh3 _bvh;
+    mutable std::vector<size_t> _boundedSurfaces;
+    mutable std::vector<size_t> _unboundedSurfaces;
+    mutable std::vector<BoundingBox3D> _surfaceBounds;
+    mutable std::atomic<bool> _isInvalid;
+    mutable std::mutex _mutex;
+
+    void build(const SurfaceArray& surfaces) const;
+};
+
+}  // namespace jet
+
+#include "detail/surface_bvh3-inl.h"
+
+#endif  // INCLUDE_JET_SURFACE_BVH3_H_
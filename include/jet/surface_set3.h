@@ -4,6 +4,7 @@
 #define INCLUDE_JET_SURFACE_SET3_H_
 
 #include <jet/surface3.h>
+#include <jet/surface_bvh3.h>
 #include <vector>
 
 namespace jet {
@@ -15,6 +16,14 @@ namespace jet {
 //! surface-related quries. This is class can hold a collection of other surface
 //! instances.
 //!
+//! The queries are accelerated by a bounding volume hierarchy (Bvh3) over the
+//! bounding boxes of the surfaces, and the surfaces with unbounded boxes, such
+//! as planes, are tested separately. The hierarchy is built lazily by the
+//! first query after a surface is added. Since the boxes of the surfaces are
+//! cached, call SurfaceSet3::updateQueryEngine after moving or editing the
+//! surfaces in the set. Collider3 calls it before resolving the collisions and
+//! rasterizing the signed-distance field.
+//!
 class SurfaceSet3 final : public Surface3 {
  public:
     //! Constructs an empty surface set.
@@ -32,6 +41,9 @@ class SurfaceSet3 final : public Surface3 {
     //! Adds a surface instance.
     void addSurface(const Surface3Ptr& surface);
 
+    //! Invalidates the bounding volume hierarchy of the surfaces.
+    void invalidateBvh();
+
     // Surface3 implementations
 
     //! Returns the closest point from the given point \p otherPoint to the
@@ -48,14 +60,28 @@ class SurfaceSet3 final : public Surface3 {
     //! Returns the bounding box of this box object.
     BoundingBox3D boundingBox() const override;
 
+    //! Returns true if all the surfaces in the set are closed and not flipped.
+    bool isClosed() const override;
+
+    //!
+    //! \brief Updates the query engines of the surfaces and rebuilds the
+    //!        bounding volume hierarchy if any surface has moved.
+    //!
+    void updateQueryEngine() override;
+
  protected:
     Vector3D actualClosestNormal(const Vector3D& otherPoint) const override;
 
+    SurfaceClosestQueryResult3 actualClosestQuery(
+        const Vector3D& otherPoint) const override;
+
     SurfaceRayIntersection3 actualClosestIntersection(
         const Ray3D& ray) const override;
 
  private:
     std::vector<Surface3Ptr> _surfaces;
+
+    SurfaceBvh3<Surface3> _surfaceBvh;
 };
 
 typedef std::shared_ptr<SurfaceSet3> SurfaceSet3Ptr;
@@ -41,6 +41,12 @@ class SurfaceToImplicit3 final : public ImplicitSurface3 {
     //! Returns the bounding box of this box object.
     BoundingBox3D boundingBox() const override;
 
+    //! Returns true if the wrapped surface is closed and not flipped.
+    bool isClosed() const override;
+
+    //! Updates the query engine of the raw surface.
+    void updateQueryEngine() override;
+
     // ImplicitSurface3 implementations
 
     //! Returns signed distance from the given point \p otherPoint.
@@ -49,6 +55,9 @@ class SurfaceToImplicit3 final : public ImplicitSurface3 {
  protected:
     Vector3D actualClosestNormal(const Vector3D& otherPoint) const override;
 
+    SurfaceClosestQueryResult3 actualClosestQuery(
+        const Vector3D& otherPoint) const override;
+
     SurfaceRayIntersection3 actualClosestIntersection(
         const Ray3D& ray) const override;
 
@@ -65,6 +65,9 @@ class Triangle3 final : public Surface3 {
  protected:
     Vector3D actualClosestNormal(const Vector3D& otherPoint) const override;
 
+    SurfaceClosestQueryResult3 actualClosestQuery(
+        const Vector3D& otherPoint) const override;
+
     //! Note, the book has different name and interface. This function used to
     //! be getClosestIntersection, but now it is simply
     //! actualClosestIntersection. Also, the book's function do not return
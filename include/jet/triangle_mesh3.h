@@ -4,11 +4,14 @@
 #define INCLUDE_JET_TRIANGLE_MESH3_H_
 
 #include <jet/array1.h>
+#include <jet/bvh3.h>
 #include <jet/point3.h>
 #include <jet/quaternion.h>
 #include <jet/surface3.h>
 #include <jet/triangle3.h>
+#include <atomic>
 #include <iostream>
+#include <mutex>
 #include <utility>  // just make cpplint happy..
 
 namespace jet {
@@ -20,6 +23,14 @@ namespace jet {
 //! overriding surface-related queries. The mesh structure stores point,
 //! normals, and UV coordinates.
 //!
+//! The surface queries are accelerated by a bounding volume hierarchy (Bvh3)
+//! over the triangles. The hierarchy is built lazily by the first query after
+//! the geometry changes, and any function that can modify the points or the
+//! point indices, including the non-const accessors, invalidates it. Thus, the
+//! references returned by the non-const accessors should not be written after
+//! a query is made. The queries are thread-safe, but they should not run
+//! concurrently with the modifications.
+//!
 class TriangleMesh3 final : public Surface3 {
  public:
     typedef Array1<Vector2D> Vector2DArray;
@@ -64,7 +75,7 @@ class TriangleMesh3 final : public Surface3 {
     //! Returns constant reference to the i-th point.
     const Vector3D& point(size_t i) const;
 
-    //! Returns reference to the i-th point.
+    //! Returns reference to the i-th point and invalidates the hierarchy.
     Vector3D& point(size_t i);
 
     //! Returns constant reference to the i-th normal.
@@ -82,7 +93,8 @@ class TriangleMesh3 final : public Surface3 {
     //! Returns constant reference to the point indices of i-th triangle.
     const Point3UI& pointIndex(size_t i) const;
 
-    //! Returns reference to the point indices of i-th triangle.
+    //! Returns reference to the point indices of i-th triangle and invalidates
+    //! the hierarchy.
     Point3UI& pointIndex(size_t i);
 
     //! Returns constant reference to the normal indices of i-th triangle.
@@ -170,6 +182,9 @@ class TriangleMesh3 final : public Surface3 {
  protected:
     Vector3D actualClosestNormal(const Vector3D& otherPoint) const override;
 
+    SurfaceClosestQueryResult3 actualClosestQuery(
+        const Vector3D& otherPoint) const override;
+
     //! Note, the book has different name and interface. This function used to
     //! be getClosestIntersection, but now it is simply
     //! actualClosestIntersection. Also, the book's function do not return
@@ -185,6 +200,14 @@ class TriangleMesh3 final : public Surface3 {
     IndexArray _pointIndices;
     IndexArray _normalIndices;
     IndexArray _uvIndices;
+
+    mutable Bvh3 _bvh;
+    mutable std::atomic<bool> _isBvhInvalid;
+    mutable std::mutex _bvhMutex;
+
+    const Bvh3& bvh() const;
+
+    void invalidateBvh();
 };
 
 typedef std::shared_ptr<TriangleMesh3> TriangleMesh3Ptr;
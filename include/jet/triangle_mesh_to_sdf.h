@@ -28,13 +28,35 @@
 
 #include <jet/triangle_mesh3.h>
 #include <jet/scalar_grid3.h>
+#include <limits>
 
 namespace jet {
 
+//!
+//! \brief Generates signed-distance field out of given triangle mesh.
+//!
+//! This function computes the exact distances at the grid points near each
+//! triangle and propagates the closest triangles to the rest of the grid with
+//! fast sweeping. The sign is determined by the parity of the ray crossings
+//! along the x-axis, so the mesh should be closed. The initialization and the
+//! sweeps run in parallel, and the result does not depend on the number of
+//! threads.
+//!
+//! If \p narrowBand is given, the distances are computed only within that
+//! many cells from the mesh, and the values beyond are clamped to the band
+//! width. The cost is then proportional to the size of the band.
+//!
+//! \param mesh The triangle mesh.
+//! \param sdf The output signed-distance field.
+//! \param exactBand Number of cells around the bounding box of each triangle
+//!     where the exact distance is computed.
+//! \param narrowBand Width of the band in the number of cells.
+//!
 void triangleMeshToSdf(
     const TriangleMesh3& mesh,
     ScalarGrid3* sdf,
-    const unsigned int exactBand = 1);
+    const unsigned int exactBand = 1,
+    const unsigned int narrowBand = std::numeric_limits<unsigned int>::max());
 
 }  // namespace jet
 
@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <fstream>
+#include <limits>
 #include <string>
 
 using namespace jet;
@@ -13,11 +14,14 @@ using namespace jet;
 void printUsage() {
     printf(
         "Usage: obj2sdf "
-        "-i input_obj -o output_sdf -r resolution -m margin_scale\n"
+        "-i input_obj -o output_sdf -r resolution -m margin_scale "
+        "-b band_width\n"
         "   -i, --input: input obj filename\n"
         "   -o, --output: output sdf filename\n"
         "   -r, --resx: grid resolution in x-axis (default: 100)\n"
-        "   -m, --margin: margin scale around the sdf (default: 0.2)\n");
+        "   -m, --margin: margin scale around the sdf (default: 0.2)\n"
+        "   -b, --band: narrow band width in the number of cells; the values\n"
+        "               beyond are clamped (default: whole grid)\n");
 }
 
 void saveTriangleMeshData(
@@ -35,6 +39,7 @@ int main(int argc, char* argv[]) {
     std::string outputFilename;
     size_t resolutionX = 100;
     double marginScale = 0.2;
+    unsigned int bandWidth = std::numeric_limits<unsigned int>::max();
 
     // Parse options
     static struct option longOptions[] = {
@@ -42,13 +47,14 @@ int main(int argc, char* argv[]) {
         {"output",  required_argument,  0,  'o' },
         {"resx",    optional_argument,  0,  'r' },
         {"margin",  optional_argument,  0,  'm' },
+        {"band",    optional_argument,  0,  'b' },
         {0,         0,                  0,   0  }
     };
 
     int opt = 0;
     int long_index = 0;
     while ((opt = getopt_long(
-        argc, argv, "i:o:r:m:", longOptions, &long_index)) != -1) {
+        argc, argv, "i:o:r:m:b:", longOptions, &long_index)) != -1) {
         switch (opt) {
             case 'i':
                 inputFilename = optarg;
@@ -62,6 +68,10 @@ int main(int argc, char* argv[]) {
             case 'm':
                 marginScale = std::max(atof(optarg), 0.0);
                 break;
+            case 'b':
+                bandWidth = static_cast<unsigned int>(
+                    std::max(atoi(optarg), 1));
+                break;
             default:
                 printUsage();
                 exit(EXIT_FAILURE);
@@ -108,7 +118,7 @@ int main(int argc, char* argv[]) {
         domain.upperCorner.x, domain.upperCorner.y, domain.upperCorner.z);
     printf("Generating SDF...");
 
-    triangleMeshToSdf(triMesh, &grid);
+    triangleMeshToSdf(triMesh, &grid, 1, bandWidth);
 
     printf("done\n");
 
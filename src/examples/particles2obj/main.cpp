@@ -19,7 +19,8 @@ void printUsage() {
         "-r resx,resy,resz "
         "-g dx,dy,dz "
         "-n ox,oy,oz "
-        "-k kernel_radius\n"
+        "-k kernel_radius "
+        "-m method\n"
         "   -i, --input: input particle position filename\n"
         "   -o, --output: output obj filename\n"
         "   -r, --resolution: grid resolution in CSV format "
@@ -27,7 +28,9 @@ void printUsage() {
         "   -g, --gridspacing: grid spacing in CSV format "
             "(default: 0.01,0.01,0.01)\n"
         "   -n, --origin: domain origin in CSV format (default: 0,0,0)\n"
-        "   -k, --kernel: interpolation kernel radius (default: 0.2)\n");
+        "   -k, --kernel: interpolation kernel radius (default: 0.2)\n"
+        "   -m, --method: particle blending method, one of sph, zhu_bridson, "
+            "and anisotropic (default: sph)\n");
 }
 
 void printInfo(
@@ -77,26 +80,17 @@ void particlesToObj(
     const Vector3D& gridSpacing,
     const Vector3D& origin,
     double kernelRadius,
+    ParticlesToSdf3::Kernel kernel,
     const std::string& objFilename) {
-    SphSystemData3 sphParticles;
-    sphParticles.addParticles(positions);
-    sphParticles.setRelativeKernelRadius(2.0);
-    sphParticles.setTargetSpacing(kernelRadius / 2.0);
-    sphParticles.buildNeighborSearcher();
-    sphParticles.updateDensities();
-
     VertexCenteredScalarGrid3 sdf(resolution, gridSpacing, origin);
     printInfo(
         resolution,
         sdf.boundingBox(),
         gridSpacing,
-        sphParticles.numberOfParticles());
+        positions.size());
 
-    Array1<double> constData(sphParticles.numberOfParticles(), 1.0);
-    sdf.fill([&](const Vector3D& pt) {
-        double d = sphParticles.interpolate(pt, constData);
-        return 0.5 - d;
-    });
+    ParticlesToSdf3 converter(kernelRadius, kernel);
+    converter.convert(positions.constAccessor(), &sdf);
 
     triangulateAndSave(sdf, objFilename);
 }
@@ -108,6 +102,7 @@ int main(int argc, char* argv[]) {
     Vector3D gridSpacing(0.01, 0.01, 0.01);
     Vector3D origin;
     double kernelRadius = 0.2;
+    ParticlesToSdf3::Kernel kernel = ParticlesToSdf3::Sph;
 
     // Parse options
     static struct option longOptions[] = {
@@ -117,13 +112,14 @@ int main(int argc, char* argv[]) {
         {"gridspacing", optional_argument,  0,  'g' },
         {"origin",      optional_argument,  0,  'n' },
         {"kernel",      optional_argument,  0,  'k' },
+        {"method",      optional_argument,  0,  'm' },
         {0,             0,                  0,   0  }
     };
 
     int opt = 0;
     int long_index = 0;
     while ((opt = getopt_long(
-        argc, argv, "i:o:r:g:n:k:", longOptions, &long_index)) != -1) {
+        argc, argv, "i:o:r:g:n:k:m:", longOptions, &long_index)) != -1) {
         switch (opt) {
             case 'i':
                 inputFilename = optarg;
@@ -178,6 +174,20 @@ int main(int argc, char* argv[]) {
                 kernelRadius = atof(optarg);
                 break;
             }
+            case 'm': {
+                std::string method = optarg;
+                if (method == "sph") {
+                    kernel = ParticlesToSdf3::Sph;
+                } else if (method == "zhu_bridson") {
+                    kernel = ParticlesToSdf3::ZhuBridson;
+                } else if (method == "anisotropic") {
+                    kernel = ParticlesToSdf3::Anisotropic;
+                } else {
+                    printUsage();
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            }
             default:
                 printUsage();
                 exit(EXIT_FAILURE);
@@ -207,6 +217,7 @@ int main(int argc, char* argv[]) {
         gridSpacing,
         origin,
         kernelRadius,
+        kernel,
         outputFilename);
 
     return EXIT_SUCCESS;
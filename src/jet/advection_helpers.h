@@ -0,0 +1,62 @@
+// Copyright (c) 2016 Doyub Kim
+
+#ifndef SRC_JET_ADVECTION_HELPERS_H_
+#define SRC_JET_ADVECTION_HELPERS_H_
+
+#include <jet/constants.h>
+#include <jet/scalar_field3.h>
+#include <jet/vector_field3.h>
+#include <algorithm>
+#include <cmath>
+
+namespace jet {
+
+//
+// Traces the characteristic that arrives at \p startPt back in time by \p dt
+// using the mid-point rule with adaptive sub-stepping (CFL <= 1). A negative
+// \p dt traces forward in time. If the path crosses the boundary interface of
+// \p boundarySdf, the point is clipped at the crossing.
+//
+inline Vector3D backTraceMidPoint(
+    const VectorField3& flow,
+    double dt,
+    double h,
+    const Vector3D& startPt,
+    const ScalarField3& boundarySdf) {
+    const double direction = (dt < 0.0) ? -1.0 : 1.0;
+    double remainingT = std::fabs(dt);
+    Vector3D pt0 = startPt;
+    Vector3D pt1 = startPt;
+
+    while (remainingT > kEpsilonD) {
+        // Adaptive time-stepping
+        Vector3D vel0 = direction * flow.sample(pt0);
+        double numSubSteps
+            = std::max(std::ceil(vel0.length() * remainingT / h), 1.0);
+        dt = remainingT / numSubSteps;
+
+        // Mid-point rule
+        Vector3D midPt = pt0 - 0.5 * dt * vel0;
+        Vector3D midVel = direction * flow.sample(midPt);
+        pt1 = pt0 - dt * midVel;
+
+        // Boundary handling
+        double phi0 = boundarySdf.sample(pt0);
+        double phi1 = boundarySdf.sample(pt1);
+
+        if (phi0 * phi1 < 0.0) {
+            double w = std::fabs(phi1) / (std::fabs(phi0) + std::fabs(phi1));
+            pt1 = w * pt0 + (1.0 - w) * pt1;
+            break;
+        }
+
+        remainingT -= dt;
+        pt0 = pt1;
+    }
+
+    return pt1;
+}
+
+}  // namespace jet
+
+#endif  // SRC_JET_ADVECTION_HELPERS_H_
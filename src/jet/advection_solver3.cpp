@@ -3,6 +3,7 @@
 #include <pch.h>
 #include <jet/advection_solver3.h>
 #include <limits>
+#include <vector>
 
 using namespace jet;
 
@@ -37,3 +38,36 @@ void AdvectionSolver3::advect(
     UNUSED_VARIABLE(target);
     UNUSED_VARIABLE(boundarySdf);
 }
+
+void AdvectionSolver3::advectBatch(
+    const std::vector<const ScalarGrid3*>& scalarInputs,
+    const std::vector<const CollocatedVectorGrid3*>& collocatedInputs,
+    const std::vector<const FaceCenteredGrid3*>& faceCenteredInputs,
+    const VectorField3& flow,
+    double dt,
+    const std::vector<ScalarGrid3*>& scalarOutputs,
+    const std::vector<CollocatedVectorGrid3*>& collocatedOutputs,
+    const std::vector<FaceCenteredGrid3*>& faceCenteredOutputs,
+    const ScalarField3& boundarySdf) {
+    JET_THROW_INVALID_ARG_IF(scalarInputs.size() != scalarOutputs.size());
+    JET_THROW_INVALID_ARG_IF(
+        collocatedInputs.size() != collocatedOutputs.size());
+    JET_THROW_INVALID_ARG_IF(
+        faceCenteredInputs.size() != faceCenteredOutputs.size());
+
+    for (size_t i = 0; i < scalarInputs.size(); ++i) {
+        advect(*scalarInputs[i], flow, dt, scalarOutputs[i], boundarySdf);
+    }
+    for (size_t i = 0; i < collocatedInputs.size(); ++i) {
+        advect(
+            *collocatedInputs[i], flow, dt, collocatedOutputs[i], boundarySdf);
+    }
+    for (size_t i = 0; i < faceCenteredInputs.size(); ++i) {
+        advect(
+            *faceCenteredInputs[i],
+            flow,
+            dt,
+            faceCenteredOutputs[i],
+            boundarySdf);
+    }
+}
@@ -0,0 +1,9 @@
+// Copyright (c) 2016 Doyub Kim
+
+#include <pch.h>
+#include <jet/bfecc3.h>
+
+using namespace jet;
+
+Bfecc3::Bfecc3() : MacCormack3(true) {
+}
@@ -0,0 +1,213 @@
+// Copyright (c) 2016 Doyub Kim
+
+#ifndef SRC_JET_BLOCK_SWEEPER3_H_
+#define SRC_JET_BLOCK_SWEEPER3_H_
+
+#include <jet/array3.h>
+#include <jet/parallel.h>
+#include <jet/point3.h>
+#include <jet/size3.h>
+#include <algorithm>
+#include <vector>
+
+namespace jet {
+
+//
+// Performs Gauss-Seidel sweeps over the blocks of a grid.
+//
+// The blocks on the same hyperplane (bi + bj + bk = const in the sweep
+// ordering) are swept in parallel. Since the first-order stencil only reads
+// the face neighbors, which belong to the same block or to the blocks on the
+// previous/next hyperplane, each point sees the same neighbor values as the
+// serial sweep. The same holds for the upwind stencils that also read the
+// diagonal neighbors (offsets in {0, -1} along each axis in the sweep
+// ordering), which belong to the blocks on the previous hyperplanes.
+//
+// A block is visited only if it is dirty. The seed blocks are dirty at first,
+// and a block that changed makes itself and its face neighbors dirty. So the
+// region that the front has not reached costs nothing, and a block that
+// already converged is skipped until its neighbors change again.
+//
+// An upwind stencil reads different neighbors in each ordering, so a block
+// that did not change in one ordering may still change in another. In that
+// mode, a changed block makes all 26 neighbors dirty, and a dirty block stays
+// dirty until it is swept in all eight orderings without any change.
+//
+class BlockSweeper3 {
+ public:
+    // Edge length of the blocks that are swept as a unit
+    static const size_t kBlockSize = 8;
+
+    explicit BlockSweeper3(
+        const Size3& size,
+        bool isUsingUpwindStencil = false) :
+        _size(size),
+        _isUsingUpwindStencil(isUsingUpwindStencil) {
+        _numberOfBlocks = Size3(
+            (size.x + kBlockSize - 1) / kBlockSize,
+            (size.y + kBlockSize - 1) / kBlockSize,
+            (size.z + kBlockSize - 1) / kBlockSize);
+        _dirty.resize(_numberOfBlocks, 0);
+    }
+
+    // Marks the blocks that have at least one point where isSeed returns true
+    template <typename Callback>
+    void markSeedBlocks(const Callback& isSeed) {
+        _dirty.parallelForEachIndex([&](size_t bi, size_t bj, size_t bk) {
+            const size_t kEnd = std::min((bk + 1) * kBlockSize, _size.z);
+            const size_t jEnd = std::min((bj + 1) * kBlockSize, _size.y);
+            const size_t iEnd = std::min((bi + 1) * kBlockSize, _size.x);
+
+            for (size_t k = bk * kBlockSize; k < kEnd; ++k) {
+                for (size_t j = bj * kBlockSize; j < jEnd; ++j) {
+                    for (size_t i = bi * kBlockSize; i < iEnd; ++i) {
+                        if (isSeed(i, j, k)) {
+                            _dirty(bi, bj, bk) = dirtyCount();
+                            return;
+                        }
+                    }
+                }
+            }
+        });
+    }
+
+    // Sweeps the dirty blocks in the given ordering. The bits of the ordering
+    // flip the sweep direction along x, y, and z. Returns true if func
+    // returned true for any point.
+    template <typename Callback>
+    bool sweep(int ordering, const Callback& func) {
+        const bool flipX = (ordering & 1) != 0;
+        const bool flipY = (ordering & 2) != 0;
+        const bool flipZ = (ordering & 4) != 0;
+        const Size3& nb = _numberOfBlocks;
+
+        bool anyChanged = false;
+
+        for (size_t p = 0; p + 2 < nb.x + nb.y + nb.z; ++p) {
+            _blocks.clear();
+            for (size_t c = 0; c < nb.z && c <= p; ++c) {
+                for (size_t b = 0; b < nb.y && b + c <= p; ++b) {
+                    size_t a = p - b - c;
+                    if (a >= nb.x) {
+                        continue;
+                    }
+
+                    Point3UI block(
+                        flipX ? nb.x - 1 - a : a,
+                        flipY ? nb.y - 1 - b : b,
+                        flipZ ? nb.z - 1 - c : c);
+                    if (_dirty(block)) {
+                        _blocks.push_back(block);
+                    }
+                }
+            }
+
+            if (_blocks.empty()) {
+                continue;
+            }
+
+            _changed.assign(_blocks.size(), 0);
+
+            parallelFor(kZeroSize, _blocks.size(), [&](size_t n) {
+                const Point3UI& block = _blocks[n];
+                const size_t k0 = block.z * kBlockSize;
+                const size_t j0 = block.y * kBlockSize;
+                const size_t i0 = block.x * kBlockSize;
+                const size_t kEnd = std::min(k0 + kBlockSize, _size.z);
+                const size_t jEnd = std::min(j0 + kBlockSize, _size.y);
+                const size_t iEnd = std::min(i0 + kBlockSize, _size.x);
+                bool blockChanged = false;
+
+                for (size_t c = k0; c < kEnd; ++c) {
+                    const size_t k = flipZ ? k0 + kEnd - 1 - c : c;
+                    for (size_t b = j0; b < jEnd; ++b) {
+                        const size_t j = flipY ? j0 + jEnd - 1 - b : b;
+                        for (size_t a = i0; a < iEnd; ++a) {
+                            const size_t i = flipX ? i0 + iEnd - 1 - a : a;
+                            if (func(i, j, k)) {
+                                blockChanged = true;
+                            }
+                        }
+                    }
+                }
+
+                _changed[n] = blockChanged;
+            });
+
+            for (const Point3UI& block : _blocks) {
+                --_dirty(block);
+            }
+
+            for (size_t n = 0; n < _blocks.size(); ++n) {
+                if (_changed[n]) {
+                    markDirtyAround(_blocks[n]);
+                    anyChanged = true;
+                }
+            }
+        }
+
+        return anyChanged;
+    }
+
+ private:
+    Size3 _size;
+    bool _isUsingUpwindStencil;
+    Size3 _numberOfBlocks;
+    Array3<char> _dirty;
+    std::vector<Point3UI> _blocks;
+    std::vector<char> _changed;
+
+    // Number of the sweeps that a dirty block is visited without any change
+    // before it becomes clean
+    char dirtyCount() const {
+        return _isUsingUpwindStencil ? 8 : 1;
+    }
+
+    void markDirtyAround(const Point3UI& block) {
+        const Size3& nb = _numberOfBlocks;
+        const char count = dirtyCount();
+
+        if (_isUsingUpwindStencil) {
+            const size_t kBegin = (block.z > 0) ? block.z - 1 : 0;
+            const size_t jBegin = (block.y > 0) ? block.y - 1 : 0;
+            const size_t iBegin = (block.x > 0) ? block.x - 1 : 0;
+            const size_t kEnd = std::min(block.z + 2, nb.z);
+            const size_t jEnd = std::min(block.y + 2, nb.y);
+            const size_t iEnd = std::min(block.x + 2, nb.x);
+
+            for (size_t k = kBegin; k < kEnd; ++k) {
+                for (size_t j = jBegin; j < jEnd; ++j) {
+                    for (size_t i = iBegin; i < iEnd; ++i) {
+                        _dirty(i, j, k) = count;
+                    }
+                }
+            }
+            return;
+        }
+
+        _dirty(block) = count;
+        if (block.x > 0) {
+            _dirty(block.x - 1, block.y, block.z) = count;
+        }
+        if (block.x + 1 < nb.x) {
+            _dirty(block.x + 1, block.y, block.z) = count;
+        }
+        if (block.y > 0) {
+            _dirty(block.x, block.y - 1, block.z) = count;
+        }
+        if (block.y + 1 < nb.y) {
+            _dirty(block.x, block.y + 1, block.z) = count;
+        }
+        if (block.z > 0) {
+            _dirty(block.x, block.y, block.z - 1) = count;
+        }
+        if (block.z + 1 < nb.z) {
+            _dirty(block.x, block.y, block.z + 1) = count;
+        }
+    }
+};
+
+
+}  // namespace jet
+
+#endif  // SRC_JET_BLOCK_SWEEPER3_H_
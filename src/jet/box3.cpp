@@ -105,6 +105,60 @@ Vector3D Box3::actualClosestNormal(const Vector3D& otherPoint) const {
     }
 }
 
+SurfaceClosestQueryResult3 Box3::actualClosestQuery(
+    const Vector3D& otherPoint) const {
+    Plane3 planes[6] = {
+        Plane3(Vector3D(1, 0, 0), bound.upperCorner),
+        Plane3(Vector3D(0, 1, 0), bound.upperCorner),
+        Plane3(Vector3D(0, 0, 1), bound.upperCorner),
+        Plane3(Vector3D(-1, 0, 0), bound.lowerCorner),
+        Plane3(Vector3D(0, -1, 0), bound.lowerCorner),
+        Plane3(Vector3D(0, 0, -1), bound.lowerCorner)
+    };
+
+    SurfaceClosestQueryResult3 result;
+
+    if (bound.contains(otherPoint)) {
+        // The closest face gives both the point and the normal.
+        result.point = planes[0].closestPoint(otherPoint);
+        result.normal = planes[0].normal;
+        double distanceSquared = result.point.distanceSquaredTo(otherPoint);
+
+        for (int i = 1; i < 6; ++i) {
+            Vector3D localResult = planes[i].closestPoint(otherPoint);
+            double localDistanceSquared
+                = localResult.distanceSquaredTo(otherPoint);
+
+            if (localDistanceSquared < distanceSquared) {
+                result.point = localResult;
+                result.normal = planes[i].normal;
+                distanceSquared = localDistanceSquared;
+            }
+        }
+    } else {
+        result.point = clamp(
+            otherPoint,
+            bound.lowerCorner,
+            bound.upperCorner);
+        Vector3D closestPointToInputPoint = otherPoint - result.point;
+        result.normal = planes[0].normal;
+        double maxCosineAngle = result.normal.dot(closestPointToInputPoint);
+
+        for (int i = 1; i < 6; ++i) {
+            double cosineAngle
+                = planes[i].normal.dot(closestPointToInputPoint);
+
+            if (cosineAngle > maxCosineAngle) {
+                result.normal = planes[i].normal;
+                maxCosineAngle = cosineAngle;
+            }
+        }
+    }
+
+    result.distance = result.point.distanceTo(otherPoint);
+    return result;
+}
+
 double Box3::closestDistance(const Vector3D& otherPoint) const {
     return Box3::closestPoint(otherPoint).distanceTo(otherPoint);
 }
@@ -131,3 +185,7 @@ SurfaceRayIntersection3 Box3::actualClosestIntersection(
 BoundingBox3D Box3::boundingBox() const {
     return bound;
 }
+
+bool Box3::isClosed() const {
+    return true;
+}
@@ -0,0 +1,335 @@
+// Copyright (c) 2016 Doyub Kim
+
+#include <pch.h>
+#include <jet/bvh3.h>
+#include <jet/parallel.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+using namespace jet;
+
+namespace {
+
+// Number of bins for evaluating the SAH split candidates.
+const size_t kNumberOfBins = 16;
+
+// Ranges up to this size become leaves when splitting does not pay off.
+const size_t kMaxLeafSize = 8;
+
+// Cost of visiting a node relative to testing an item.
+const double kTraversalCost = 1.0;
+
+// Below this depth, the ranges are split at the median so that the depth of
+// the tree never exceeds the traversal stack size.
+const size_t kMaxSahDepth = 32;
+
+// The top levels are split serially until either limit is reached, and the
+// remaining subtrees are built in parallel.
+const size_t kMaxSerialDepth = 6;
+const size_t kMinParallelSize = 1024;
+
+// Marks a top-level node that is replaced by a subtree.
+const size_t kSubtreeMarker = kMaxSize;
+
+double surfaceArea(const BoundingBox3D& box) {
+    const Vector3D d = box.upperCorner - box.lowerCorner;
+    return 2.0 * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+}  // namespace
+
+class Bvh3::Builder {
+ public:
+    struct Subtree {
+        size_t begin;
+        size_t end;
+        size_t depth;
+    };
+
+    Builder(
+        const std::vector<BoundingBox3D>& itemsBounds,
+        std::vector<size_t>* items) :
+        _bounds(itemsBounds),
+        _centroids(itemsBounds.size()),
+        _items(*items) {
+        parallelFor(kZeroSize, _bounds.size(), [this](size_t i) {
+            _centroids[i] = _bounds[i].midPoint();
+        });
+    }
+
+    // Builds the top levels and leaves the rest as subtrees to build.
+    void buildTop(
+        size_t begin,
+        size_t end,
+        size_t depth,
+        std::vector<Node>* nodes,
+        std::vector<Subtree>* subtrees) const {
+        if (depth >= kMaxSerialDepth || end - begin <= kMinParallelSize) {
+            Node node;
+            node.child = subtrees->size();
+            node.numberOfItems = kSubtreeMarker;
+            nodes->push_back(node);
+            subtrees->push_back({begin, end, depth});
+            return;
+        }
+
+        Node node;
+        node.bound = computeBound(begin, end);
+
+        size_t mid = split(begin, end, depth, node.bound);
+        if (mid == end) {
+            node.child = begin;
+            node.numberOfItems = end - begin;
+            nodes->push_back(node);
+            return;
+        }
+
+        node.numberOfItems = 0;
+        nodes->push_back(node);
+        buildTop(begin, mid, depth + 1, nodes, subtrees);
+        buildTop(mid, end, depth + 1, nodes, subtrees);
+    }
+
+    // Builds the subtree of the items in [begin, end) in depth-first order.
+    void build(
+        size_t begin,
+        size_t end,
+        size_t depth,
+        std::vector<Node>* nodes) const {
+        Node node;
+        node.bound = computeBound(begin, end);
+
+        size_t mid = split(begin, end, depth, node.bound);
+        if (mid == end) {
+            node.child = begin;
+            node.numberOfItems = end - begin;
+            nodes->push_back(node);
+            return;
+        }
+
+        const size_t nodeIndex = nodes->size();
+        node.numberOfItems = 0;
+        nodes->push_back(node);
+        build(begin, mid, depth + 1, nodes);
+        (*nodes)[nodeIndex].child = nodes->size();
+        build(mid, end, depth + 1, nodes);
+    }
+
+ private:
+    const std::vector<BoundingBox3D>& _bounds;
+    std::vector<Vector3D> _centroids;
+    std::vector<size_t>& _items;
+
+    BoundingBox3D computeBound(size_t begin, size_t end) const {
+        BoundingBox3D bound;
+        for (size_t i = begin; i < end; ++i) {
+            bound.merge(_bounds[_items[i]]);
+        }
+        return bound;
+    }
+
+    // Reorders the items in [begin, end) and returns the split position, or
+    // end if the range should be a leaf.
+    size_t split(
+        size_t begin,
+        size_t end,
+        size_t depth,
+        const BoundingBox3D& bound) const {
+        const size_t n = end - begin;
+        if (n <= 2) {
+            return end;
+        }
+
+        BoundingBox3D centroidBound;
+        for (size_t i = begin; i < end; ++i) {
+            centroidBound.merge(_centroids[_items[i]]);
+        }
+
+        const Vector3D extents
+            = centroidBound.upperCorner - centroidBound.lowerCorner;
+        size_t axis = 0;
+        if (extents.y > extents[axis]) axis = 1;
+        if (extents.z > extents[axis]) axis = 2;
+
+        const double lower = centroidBound.lowerCorner[axis];
+        const double extent = extents[axis];
+
+        // All the centroids are at the same position.
+        if (!(extent > 0.0)) {
+            return (n <= kMaxLeafSize) ? end : begin + n / 2;
+        }
+
+        auto first = _items.begin() + begin;
+        auto last = _items.begin() + end;
+
+        if (depth >= kMaxSahDepth) {
+            auto middle = first + n / 2;
+            std::nth_element(first, middle, last, [&](size_t a, size_t b) {
+                return _centroids[a][axis] < _centroids[b][axis];
+            });
+            return begin + n / 2;
+        }
+
+        const double scale = kNumberOfBins / extent;
+        auto binIndex = [&](size_t item) {
+            size_t b = static_cast<size_t>(
+                (_centroids[item][axis] - lower) * scale);
+            return std::min(b, kNumberOfBins - 1);
+        };
+
+        size_t counts[kNumberOfBins] = {};
+        BoundingBox3D bins[kNumberOfBins];
+        for (size_t i = begin; i < end; ++i) {
+            size_t b = binIndex(_items[i]);
+            ++counts[b];
+            bins[b].merge(_bounds[_items[i]]);
+        }
+
+        // Sweep from the right to get the cost of the right halves.
+        double rightCosts[kNumberOfBins];
+        BoundingBox3D rightBound;
+        size_t rightCount = 0;
+        for (size_t b = kNumberOfBins - 1; b > 0; --b) {
+            rightBound.merge(bins[b]);
+            rightCount += counts[b];
+            rightCosts[b] = (rightCount > 0)
+                ? rightCount * surfaceArea(rightBound) : 0.0;
+        }
+
+        const double area = surfaceArea(bound);
+        const double invArea = (area > 0.0) ? 1.0 / area : 0.0;
+
+        double bestCost = kMaxD;
+        size_t bestBin = 0;
+        BoundingBox3D leftBound;
+        size_t leftCount = 0;
+        for (size_t b = 0; b + 1 < kNumberOfBins; ++b) {
+            leftBound.merge(bins[b]);
+            leftCount += counts[b];
+            double leftCost = (leftCount > 0)
+                ? leftCount * surfaceArea(leftBound) : 0.0;
+            double cost = kTraversalCost
+                + (leftCost + rightCosts[b + 1]) * invArea;
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestBin = b;
+            }
+        }
+
+        if (n <= kMaxLeafSize && bestCost >= static_cast<double>(n)) {
+            return end;
+        }
+
+        // The lowest and the highest bins are not empty, so both sides are
+        // never empty.
+        auto middle = std::partition(first, last, [&](size_t item) {
+            return binIndex(item) <= bestBin;
+        });
+        return static_cast<size_t>(middle - _items.begin());
+    }
+};
+
+namespace {
+
+template <typename Node>
+size_t appendNodes(
+    const std::vector<Node>& topNodes,
+    const std::vector<std::vector<Node>>& subtreeNodes,
+    size_t i,
+    std::vector<Node>* nodes) {
+    const Node& node = topNodes[i];
+
+    if (node.numberOfItems == kSubtreeMarker) {
+        const size_t offset = nodes->size();
+        for (Node subtreeNode : subtreeNodes[node.child]) {
+            if (!subtreeNode.isLeaf()) {
+                subtreeNode.child += offset;
+            }
+            nodes->push_back(subtreeNode);
+        }
+        return i + 1;
+    }
+
+    if (node.isLeaf()) {
+        nodes->push_back(node);
+        return i + 1;
+    }
+
+    const size_t nodeIndex = nodes->size();
+    nodes->push_back(node);
+    size_t next = appendNodes(topNodes, subtreeNodes, i + 1, nodes);
+    (*nodes)[nodeIndex].child = nodes->size();
+    return appendNodes(topNodes, subtreeNodes, next, nodes);
+}
+
+}  // namespace
+
+Bvh3::Bvh3() {
+}
+
+void Bvh3::build(const std::vector<BoundingBox3D>& itemsBounds) {
+    clear();
+
+    const size_t n = itemsBounds.size();
+    if (n == 0) {
+        return;
+    }
+
+    _items.resize(n);
+    std::iota(_items.begin(), _items.end(), kZeroSize);
+
+    Builder builder(itemsBounds, &_items);
+
+    std::vector<Node> topNodes;
+    std::vector<Builder::Subtree> subtrees;
+    builder.buildTop(kZeroSize, n, kZeroSize, &topNodes, &subtrees);
+
+    // Subtrees cover disjoint ranges of the item list, so they are reordered
+    // and built independently.
+    std::vector<std::vector<Node>> subtreeNodes(subtrees.size());
+    parallelFor(kZeroSize, subtrees.size(), [&](size_t i) {
+        const Builder::Subtree& subtree = subtrees[i];
+        builder.build(
+            subtree.begin, subtree.end, subtree.depth, &subtreeNodes[i]);
+    });
+
+    size_t numberOfNodes = topNodes.size();
+    for (const auto& s : subtreeNodes) {
+        numberOfNodes += s.size();
+    }
+
+    _nodes.reserve(numberOfNodes);
+    appendNodes(topNodes, subtreeNodes, kZeroSize, &_nodes);
+}
+
+void Bvh3::clear() {
+    _nodes.clear();
+    _items.clear();
+}
+
+size_t Bvh3::numberOfItems() const {
+    return _items.size();
+}
+
+size_t Bvh3::numberOfNodes() const {
+    return _nodes.size();
+}
+
+BoundingBox3D Bvh3::boundingBox() const {
+    if (_nodes.empty()) {
+        return BoundingBox3D();
+    }
+    return _nodes[0].bound;
+}
+
+BoundingBox3D Bvh3::paddedBound(const BoundingBox3D& itemBound) {
+    BoundingBox3D box = itemBound;
+    double scale = std::max(
+        std::fabs(box.lowerCorner.absmax()),
+        std::fabs(box.upperCorner.absmax()));
+    box.expand(8.0 * kEpsilonD * (1.0 + scale));
+    return box;
+}
@@ -2,6 +2,9 @@
 
 #include <pch.h>
 #include <jet/collider3.h>
+#include <jet/parallel.h>
+#include <jet/surface_to_implicit3.h>
+
 #include <algorithm>
 
 using namespace jet;
@@ -68,6 +71,39 @@ void Collider3::resolveCollision(
     }
 }
 
+void Collider3::resolveCollisions(
+    double radius,
+    double restitutionCoefficient,
+    ArrayAccessor1<Vector3D> positions,
+    ArrayAccessor1<Vector3D> velocities) {
+    JET_THROW_INVALID_ARG_IF(positions.size() != velocities.size());
+
+    updateSurface();
+
+    // Points outside of this box are farther than the radius from the
+    // surface and on its outer side, so they never collide.
+    BoundingBox3D bound = _surface->boundingBox();
+    const bool isCulling = bound.isBounded()
+        && !_surface->isNormalFlipped
+        && _surface->isClosed();
+    bound.expand(radius);
+
+    parallelFor(
+        kZeroSize,
+        positions.size(),
+        [&](size_t i) {
+            if (isCulling && !bound.contains(positions[i])) {
+                return;
+            }
+
+            resolveCollision(
+                radius,
+                restitutionCoefficient,
+                &positions[i],
+                &velocities[i]);
+        });
+}
+
 double Collider3::frictionCoefficient() const {
     return _frictionCoeffient;
 }
@@ -80,17 +116,69 @@ const Surface3Ptr& Collider3::surface() const {
     return _surface;
 }
 
+const CellCenteredScalarGrid3& Collider3::signedDistanceGrid(
+    const Size3& resolution,
+    const Vector3D& gridSpacing,
+    const Vector3D& origin) {
+    if (_surface != nullptr) {
+        _surface->updateQueryEngine();
+    }
+
+    if (_isSdfGridInvalid
+        || _sdfGrid.resolution() != resolution
+        || _sdfGrid.gridSpacing() != gridSpacing
+        || _sdfGrid.origin() != origin) {
+        _sdfGrid.resize(resolution, gridSpacing, origin);
+
+        if (_surface != nullptr) {
+            ImplicitSurface3Ptr implicitSurface
+                = std::dynamic_pointer_cast<ImplicitSurface3>(_surface);
+            if (implicitSurface == nullptr) {
+                implicitSurface
+                    = std::make_shared<SurfaceToImplicit3>(_surface);
+            }
+
+            _sdfGrid.fill([&](const Vector3D& pt) {
+                return implicitSurface->signedDistance(pt);
+            });
+        } else {
+            _sdfGrid.fill(kMaxD);
+        }
+
+        _isSdfGridInvalid = false;
+    }
+
+    return _sdfGrid;
+}
+
+void Collider3::invalidateSignedDistanceGrid() {
+    _isSdfGridInvalid = true;
+    ++_surfaceStamp;
+}
+
+size_t Collider3::surfaceStamp() const {
+    return _surfaceStamp;
+}
+
 void Collider3::setSurface(const Surface3Ptr& newSurface) {
     _surface = newSurface;
+    invalidateSignedDistanceGrid();
+}
+
+void Collider3::updateSurface() {
+    if (_surface != nullptr) {
+        _surface->updateQueryEngine();
+    }
 }
 
 void Collider3::getClosestPoint(
     const Surface3Ptr& surface,
     const Vector3D& queryPoint,
     ColliderQueryResult* result) const {
-    result->distance = surface->closestDistance(queryPoint);
-    result->point = surface->closestPoint(queryPoint);
-    result->normal = surface->closestNormal(queryPoint);
+    SurfaceClosestQueryResult3 query = surface->closestQuery(queryPoint);
+    result->distance = query.distance;
+    result->point = query.point;
+    result->normal = query.normal;
     result->velocity = velocityAt(queryPoint);
 }
 
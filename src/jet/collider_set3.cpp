@@ -29,5 +29,37 @@ Vector3D ColliderSet3::velocityAt(const Vector3D& point) const {
 void ColliderSet3::addCollider(const Collider3Ptr& collider) {
     auto surfaceSet = std::dynamic_pointer_cast<SurfaceSet3>(surface());
     _colliders.push_back(collider);
+    _colliderStamps.push_back(collider->surfaceStamp());
     surfaceSet->addSurface(collider->surface());
+    invalidateSignedDistanceGrid();
+}
+
+void ColliderSet3::updateSurface() {
+    auto surfaceSet = std::dynamic_pointer_cast<SurfaceSet3>(surface());
+
+    bool isSurfaceReplaced = false;
+    bool isStampChanged = false;
+    for (size_t i = 0; i < _colliders.size(); ++i) {
+        _colliders[i]->updateSurface();
+
+        if (_colliders[i]->surface() != surfaceSet->surfaceAt(i)) {
+            isSurfaceReplaced = true;
+        }
+        if (_colliders[i]->surfaceStamp() != _colliderStamps[i]) {
+            isStampChanged = true;
+        }
+        _colliderStamps[i] = _colliders[i]->surfaceStamp();
+    }
+
+    if (isSurfaceReplaced) {
+        auto newSurfaceSet = std::make_shared<SurfaceSet3>();
+        for (const auto& collider : _colliders) {
+            newSurfaceSet->addSurface(collider->surface());
+        }
+        setSurface(newSurfaceSet);
+    } else if (isStampChanged) {
+        invalidateSignedDistanceGrid();
+    }
+
+    Collider3::updateSurface();
 }
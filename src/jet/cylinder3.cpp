@@ -61,6 +61,34 @@ Vector3D Cylinder3::actualClosestNormal(const Vector3D& otherPoint) const {
     }
 }
 
+SurfaceClosestQueryResult3 Cylinder3::actualClosestQuery(
+    const Vector3D& otherPoint) const {
+    Vector3D r = otherPoint - center;
+    Vector2D rr(std::sqrt(r.x * r.x + r.z * r.z), r.y);
+    Box2 box(
+        Vector2D(-radius, -0.5 * height),
+        Vector2D(radius, 0.5 * height));
+
+    SurfaceClosestQueryResult3 result;
+
+    Vector2D cp = box.closestPoint(rr);
+    double angle = std::atan2(r.z, r.x);
+    result.point = Vector3D(
+        cp.x * std::cos(angle), cp.y, cp.x * std::sin(angle)) + center;
+
+    Vector2D cn = box.closestNormal(rr);
+    if (cn.y > 0) {
+        result.normal = Vector3D(0, 1, 0);
+    } else if (cn.y < 0) {
+        result.normal = Vector3D(0, -1, 0);
+    } else {
+        result.normal = Vector3D(r.x, 0, r.z).normalized();
+    }
+
+    result.distance = cp.distanceTo(rr);
+    return result;
+}
+
 bool Cylinder3::intersects(const Ray3D& ray) const {
     // Calculate intersection with infinite cylinder
     // (dx^2 + dz^2)t^2 + 2(ox.dx + oz.dz)t + ox^2 + oz^2 - r^2 = 0
@@ -224,3 +252,7 @@ BoundingBox3D Cylinder3::boundingBox() const {
         center - Vector3D(radius, 0.5 * height, radius),
         center + Vector3D(radius, 0.5 * height, radius));
 }
+
+bool Cylinder3::isClosed() const {
+    return true;
+}
@@ -3,6 +3,7 @@
 #include <pch.h>
 #include <jet/array_samplers3.h>
 #include <jet/face_centered_grid3.h>
+#include <jet/math_utils.h>
 #include <jet/parallel.h>
 #include <jet/serial.h>
 
@@ -11,6 +12,77 @@
 
 using namespace jet;
 
+namespace {
+
+struct AxisCoordinates {
+    ssize_t i;
+    ssize_t ip1;
+    double f;
+};
+
+inline AxisCoordinates getAxisCoordinates(
+    double x, double origin, double gridSpacing, size_t size) {
+    AxisCoordinates c;
+    ssize_t n = static_cast<ssize_t>(size);
+    getBarycentric((x - origin) / gridSpacing, 0, n, &c.i, &c.f);
+    c.ip1 = std::min(c.i + 1, n - 1);
+    return c;
+}
+
+inline double trilerpAt(
+    const ConstArrayAccessor3<double>& data,
+    const AxisCoordinates& cx,
+    const AxisCoordinates& cy,
+    const AxisCoordinates& cz) {
+    return trilerp(
+        data(cx.i, cy.i, cz.i),
+        data(cx.ip1, cy.i, cz.i),
+        data(cx.i, cy.ip1, cz.i),
+        data(cx.ip1, cy.ip1, cz.i),
+        data(cx.i, cy.i, cz.ip1),
+        data(cx.ip1, cy.i, cz.ip1),
+        data(cx.i, cy.ip1, cz.ip1),
+        data(cx.ip1, cy.ip1, cz.ip1),
+        cx.f,
+        cy.f,
+        cz.f);
+}
+
+// Linearly samples the staggered u, v, and w data at x. Along each axis, the
+// component normal to the axis is stored at the faces while the other two are
+// stored at the cell centers, so two sets of barycentric coordinates per axis
+// serve all three components. The result is identical to sampling each
+// component with its own LinearArraySampler3.
+inline Vector3D sampleStaggered(
+    const ConstArrayAccessor3<double>& u,
+    const ConstArrayAccessor3<double>& v,
+    const ConstArrayAccessor3<double>& w,
+    const Vector3D& originU,
+    const Vector3D& originV,
+    const Vector3D& originW,
+    const Vector3D& gridSpacing,
+    const Vector3D& x) {
+    AxisCoordinates xFace
+        = getAxisCoordinates(x.x, originU.x, gridSpacing.x, u.size().x);
+    AxisCoordinates xCenter
+        = getAxisCoordinates(x.x, originV.x, gridSpacing.x, v.size().x);
+    AxisCoordinates yFace
+        = getAxisCoordinates(x.y, originV.y, gridSpacing.y, v.size().y);
+    AxisCoordinates yCenter
+        = getAxisCoordinates(x.y, originU.y, gridSpacing.y, u.size().y);
+    AxisCoordinates zFace
+        = getAxisCoordinates(x.z, originW.z, gridSpacing.z, w.size().z);
+    AxisCoordinates zCenter
+        = getAxisCoordinates(x.z, originU.z, gridSpacing.z, u.size().z);
+
+    return Vector3D(
+        trilerpAt(u, xFace, yCenter, zCenter),
+        trilerpAt(v, xCenter, yFace, zCenter),
+        trilerpAt(w, xCenter, yCenter, zFace));
+}
+
+}  // namespace
+
 FaceCenteredGrid3::FaceCenteredGrid3() :
     _dataOriginU(0.0, 0.5, 0.5),
     _dataOriginV(0.5, 0.0, 0.5),
@@ -421,7 +493,31 @@ void FaceCenteredGrid3::deserialize(std::istream* strm) {
 }
 
 Vector3D FaceCenteredGrid3::sample(const Vector3D& x) const {
-    return _sampler(x);
+    return sampleStaggered(
+        _dataU.constAccessor(),
+        _dataV.constAccessor(),
+        _dataW.constAccessor(),
+        _dataOriginU,
+        _dataOriginV,
+        _dataOriginW,
+        gridSpacing(),
+        x);
+}
+
+void FaceCenteredGrid3::sample(
+    const ConstArrayAccessor1<Vector3D>& x,
+    ArrayAccessor1<Vector3D> result) const {
+    JET_THROW_INVALID_ARG_IF(x.size() != result.size());
+
+    auto u = _dataU.constAccessor();
+    auto v = _dataV.constAccessor();
+    auto w = _dataW.constAccessor();
+    const Vector3D h = gridSpacing();
+
+    parallelFor(kZeroSize, x.size(), [&](size_t i) {
+        result[i] = sampleStaggered(
+            u, v, w, _dataOriginU, _dataOriginV, _dataOriginW, h, x[i]);
+    });
 }
 
 std::function<Vector3D(const Vector3D&)> FaceCenteredGrid3::sampler() const {
@@ -547,11 +643,16 @@ void FaceCenteredGrid3::resetSampler() {
     _vLinearSampler = vSampler;
     _wLinearSampler = wSampler;
 
-    _sampler = [uSampler, vSampler, wSampler](const Vector3D& x) -> Vector3D {
-        double u = uSampler(x);
-        double v = vSampler(x);
-        double w = wSampler(x);
-        return Vector3D(u, v, w);
+    auto u = _dataU.constAccessor();
+    auto v = _dataV.constAccessor();
+    auto w = _dataW.constAccessor();
+    Vector3D originU = _dataOriginU;
+    Vector3D originV = _dataOriginV;
+    Vector3D originW = _dataOriginW;
+    Vector3D h = gridSpacing();
+
+    _sampler = [u, v, w, originU, originV, originW, h](const Vector3D& x) {
+        return sampleStaggered(u, v, w, originU, originV, originW, h, x);
     };
 }
 
@@ -0,0 +1,448 @@
+// Copyright (c) 2016 Doyub Kim
+
+#include <pch.h>
+#include <block_sweeper3.h>
+#include <jet/fast_sweeping_level_set_solver3.h>
+#include <jet/fdm_utils.h>
+#include <jet/level_set_utils.h>
+#include <jet/parallel.h>
+
+#include <algorithm>
+#include <array>
+#include <utility>
+#include <vector>
+
+using namespace jet;
+
+static const char kUnknown = 0;
+static const char kKnown = 1;
+static const char kFixed = 2;
+static const char kFar = 3;
+
+namespace {
+
+// Returns true if (i, j, k) is not fixed but one of its face neighbors is
+bool isNextToFixed(const Array3<char>& markers, size_t i, size_t j, size_t k) {
+    const Size3 size = markers.size();
+
+    return markers(i, j, k) != kFixed
+        && ((i > 0 && markers(i - 1, j, k) == kFixed)
+         || (i + 1 < size.x && markers(i + 1, j, k) == kFixed)
+         || (j > 0 && markers(i, j - 1, k) == kFixed)
+         || (j + 1 < size.y && markers(i, j + 1, k) == kFixed)
+         || (k > 0 && markers(i, j, k - 1) == kFixed)
+         || (k + 1 < size.z && markers(i, j, k + 1) == kFixed));
+}
+
+// Distance from phi0 to the zero crossing toward phi1, or kMaxD if the sign
+// does not change
+inline double crossingDistance(double phi0, double phi1, double h) {
+    if (isInsideSdf(phi0) == isInsideSdf(phi1)) {
+        return kMaxD;
+    }
+
+    return h * std::abs(phi0) / (std::abs(phi0) + std::abs(phi1));
+}
+
+// Solves the distance geometrically for the points next to the interface.
+// Returns kMaxD if none of the face neighbors has the opposite sign.
+double distanceToInterface(
+    const ConstArrayAccessor3<double>& phi,
+    const Vector3D& gridSpacing,
+    size_t i,
+    size_t j,
+    size_t k) {
+    const Size3 size = phi.size();
+    const double phi0 = phi(i, j, k);
+
+    std::array<double, 3> theta;
+    theta.fill(kMaxD);
+
+    if (i > 0) {
+        theta[0] = std::min(
+            theta[0], crossingDistance(phi0, phi(i - 1, j, k), gridSpacing.x));
+    }
+    if (i + 1 < size.x) {
+        theta[0] = std::min(
+            theta[0], crossingDistance(phi0, phi(i + 1, j, k), gridSpacing.x));
+    }
+    if (j > 0) {
+        theta[1] = std::min(
+            theta[1], crossingDistance(phi0, phi(i, j - 1, k), gridSpacing.y));
+    }
+    if (j + 1 < size.y) {
+        theta[1] = std::min(
+            theta[1], crossingDistance(phi0, phi(i, j + 1, k), gridSpacing.y));
+    }
+    if (k > 0) {
+        theta[2] = std::min(
+            theta[2], crossingDistance(phi0, phi(i, j, k - 1), gridSpacing.z));
+    }
+    if (k + 1 < size.z) {
+        theta[2] = std::min(
+            theta[2], crossingDistance(phi0, phi(i, j, k + 1), gridSpacing.z));
+    }
+
+    bool hasCrossing = false;
+    double denomSqr = 0.0;
+
+    for (double t : theta) {
+        if (t < kMaxD) {
+            if (t <= 0.0) {
+                return 0.0;
+            }
+
+            hasCrossing = true;
+            denomSqr += 1.0 / square(t);
+        }
+    }
+
+    return hasCrossing ? 1.0 / std::sqrt(denomSqr) : kMaxD;
+}
+
+// First-order Godunov upwind solution of |grad(d)| = 1 at (i, j, k)
+double solveEikonal(
+    const Array3<double>& dist,
+    const Vector3D& gridSpacing,
+    size_t i,
+    size_t j,
+    size_t k) {
+    const Size3 size = dist.size();
+
+    // Pairs of the smaller neighbor distance and the grid spacing of each axis
+    std::array<std::pair<double, double>, 3> neighbors = {{
+        std::make_pair(
+            std::min(
+                (i > 0) ? dist(i - 1, j, k) : kMaxD,
+                (i + 1 < size.x) ? dist(i + 1, j, k) : kMaxD),
+            gridSpacing.x),
+        std::make_pair(
+            std::min(
+                (j > 0) ? dist(i, j - 1, k) : kMaxD,
+                (j + 1 < size.y) ? dist(i, j + 1, k) : kMaxD),
+            gridSpacing.y),
+        std::make_pair(
+            std::min(
+                (k > 0) ? dist(i, j, k - 1) : kMaxD,
+                (k + 1 < size.z) ? dist(i, j, k + 1) : kMaxD),
+            gridSpacing.z)
+    }};
+
+    std::sort(neighbors.begin(), neighbors.end());
+
+    // Solve sum((d - phi_n)^2 / h_n^2) = 1 adding the axes in the increasing
+    // order of the neighbor distance until the solution becomes smaller than
+    // the next neighbor distance.
+    double a = 0.0;
+    double b = 0.0;
+    double c = -1.0;
+    double solution = kMaxD;
+
+    for (const auto& neighbor : neighbors) {
+        const double phi = neighbor.first;
+        if (phi >= solution) {
+            break;
+        }
+
+        const double invHSqr = 1.0 / square(neighbor.second);
+        a += invHSqr;
+        b += phi * invHSqr;
+        c += square(phi) * invHSqr;
+
+        const double det = b * b - a * c;
+        if (det < 0.0) {
+            break;
+        }
+
+        solution = (b + std::sqrt(det)) / a;
+    }
+
+    return solution;
+}
+
+}  // namespace
+
+FastSweepingLevelSetSolver3::FastSweepingLevelSetSolver3() {
+}
+
+void FastSweepingLevelSetSolver3::reinitialize(
+    const ScalarGrid3& inputSdf,
+    double maxDistance,
+    ScalarGrid3* outputSdf) {
+    JET_THROW_INVALID_ARG_IF(!inputSdf.hasSameShape(*outputSdf));
+
+    const Size3 size = inputSdf.dataSize();
+    const Vector3D gridSpacing = inputSdf.gridSpacing();
+    auto input = inputSdf.constDataAccessor();
+
+    // Unsigned distance. The points next to the interface are solved
+    // geometrically and stay fixed during the sweeps.
+    Array3<double> dist(size, kMaxD);
+    Array3<char> markers(size, kUnknown);
+    markers.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        double d = distanceToInterface(input, gridSpacing, i, j, k);
+        if (d < kMaxD) {
+            dist(i, j, k) = d;
+            markers(i, j, k) = kFixed;
+        }
+    });
+
+    // The points farther than maxDistance are never written, so the front
+    // stops propagating at the band boundary.
+    auto update = [&](size_t i, size_t j, size_t k) -> bool {
+        if (markers(i, j, k) == kFixed) {
+            return false;
+        }
+
+        double d = solveEikonal(dist, gridSpacing, i, j, k);
+        if (d < dist(i, j, k) && d <= maxDistance) {
+            dist(i, j, k) = d;
+            return true;
+        }
+
+        return false;
+    };
+
+    BlockSweeper3 sweeper(size);
+    sweeper.markSeedBlocks([&](size_t i, size_t j, size_t k) {
+        return isNextToFixed(markers, i, j, k);
+    });
+
+    _lastNumberOfIterations = 0;
+    bool changed = true;
+    while (changed && _lastNumberOfIterations < _maxNumberOfIterations) {
+        changed = false;
+        for (int ordering = 0; ordering < 8; ++ordering) {
+            changed |= sweeper.sweep(ordering, update);
+        }
+        ++_lastNumberOfIterations;
+    }
+
+    // Input and output can be the same grid since each point only reads its
+    // own input value here.
+    auto output = outputSdf->dataAccessor();
+    markers.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        const double d = dist(i, j, k);
+        if (d <= maxDistance) {
+            output(i, j, k) = isInsideSdf(input(i, j, k)) ? -d : d;
+        } else {
+            output(i, j, k) = input(i, j, k);
+        }
+    });
+}
+
+void FastSweepingLevelSetSolver3::extrapolate(
+    const ScalarGrid3& input,
+    const ScalarField3& sdf,
+    double maxDistance,
+    ScalarGrid3* output) {
+    JET_THROW_INVALID_ARG_IF(!input.hasSameShape(*output));
+
+    Array3<double> sdfGrid(input.dataSize());
+    auto pos = input.dataPosition();
+    sdfGrid.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        sdfGrid(i, j, k) = sdf.sample(pos(i, j, k));
+    });
+
+    extrapolate(
+        input.constDataAccessor(),
+        sdfGrid.constAccessor(),
+        input.gridSpacing(),
+        maxDistance,
+        output->dataAccessor());
+}
+
+void FastSweepingLevelSetSolver3::extrapolate(
+    const CollocatedVectorGrid3& input,
+    const ScalarField3& sdf,
+    double maxDistance,
+    CollocatedVectorGrid3* output) {
+    JET_THROW_INVALID_ARG_IF(!input.hasSameShape(*output));
+
+    Array3<double> sdfGrid(input.dataSize());
+    auto pos = input.dataPosition();
+    sdfGrid.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        sdfGrid(i, j, k) = sdf.sample(pos(i, j, k));
+    });
+
+    // The weights only depend on the SDF, so all three components are
+    // extrapolated in a single pass.
+    extrapolate(
+        input.constDataAccessor(),
+        sdfGrid.constAccessor(),
+        input.gridSpacing(),
+        maxDistance,
+        output->dataAccessor());
+}
+
+void FastSweepingLevelSetSolver3::extrapolate(
+    const FaceCenteredGrid3& input,
+    const ScalarField3& sdf,
+    double maxDistance,
+    FaceCenteredGrid3* output) {
+    JET_THROW_INVALID_ARG_IF(!input.hasSameShape(*output));
+
+    const Vector3D gridSpacing = input.gridSpacing();
+
+    auto u = input.uConstAccessor();
+    auto uPos = input.uPosition();
+    Array3<double> sdfAtU(u.size());
+    input.parallelForEachUIndex([&](size_t i, size_t j, size_t k) {
+        sdfAtU(i, j, k) = sdf.sample(uPos(i, j, k));
+    });
+
+    extrapolate(
+        u,
+        sdfAtU.constAccessor(),
+        gridSpacing,
+        maxDistance,
+        output->uAccessor());
+
+    auto v = input.vConstAccessor();
+    auto vPos = input.vPosition();
+    Array3<double> sdfAtV(v.size());
+    input.parallelForEachVIndex([&](size_t i, size_t j, size_t k) {
+        sdfAtV(i, j, k) = sdf.sample(vPos(i, j, k));
+    });
+
+    extrapolate(
+        v,
+        sdfAtV.constAccessor(),
+        gridSpacing,
+        maxDistance,
+        output->vAccessor());
+
+    auto w = input.wConstAccessor();
+    auto wPos = input.wPosition();
+    Array3<double> sdfAtW(w.size());
+    input.parallelForEachWIndex([&](size_t i, size_t j, size_t k) {
+        sdfAtW(i, j, k) = sdf.sample(wPos(i, j, k));
+    });
+
+    extrapolate(
+        w,
+        sdfAtW.constAccessor(),
+        gridSpacing,
+        maxDistance,
+        output->wAccessor());
+}
+
+unsigned int FastSweepingLevelSetSolver3::maxNumberOfIterations() const {
+    return _maxNumberOfIterations;
+}
+
+void FastSweepingLevelSetSolver3::setMaxNumberOfIterations(unsigned int n) {
+    _maxNumberOfIterations = std::max(n, 1u);
+}
+
+unsigned int FastSweepingLevelSetSolver3::lastNumberOfIterations() const {
+    return _lastNumberOfIterations;
+}
+
+template <typename T>
+void FastSweepingLevelSetSolver3::extrapolate(
+    const ConstArrayAccessor3<T>& input,
+    const ConstArrayAccessor3<double>& sdf,
+    const Vector3D& gridSpacing,
+    double maxDistance,
+    ArrayAccessor3<T> output) {
+    const Size3 size = input.size();
+    const Vector3D invGridSpacing = 1.0 / gridSpacing;
+
+    // Build markers
+    Array3<char> markers(size);
+    markers.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        if (isInsideSdf(sdf(i, j, k))) {
+            markers(i, j, k) = kFixed;
+        } else if (sdf(i, j, k) > maxDistance) {
+            markers(i, j, k) = kFar;
+        } else {
+            markers(i, j, k) = kUnknown;
+        }
+        output(i, j, k) = input(i, j, k);
+    });
+
+    // Solves grad(f) . grad(sdf) = 0 with upwind differencing. Same as
+    // FmmLevelSetSolver3, the weights of the known neighbors are the upwind
+    // normal components. A point only reads the neighbors with smaller SDF
+    // and is assigned once all of them are known, so each point is solved
+    // exactly once and the result does not depend on the sweep ordering.
+    auto update = [&](size_t i, size_t j, size_t k) -> bool {
+        if (markers(i, j, k) != kUnknown) {
+            return false;
+        }
+
+        Vector3D normal = gradient3(sdf, gridSpacing, i, j, k);
+        const double length = normal.length();
+        if (length > 0.0) {
+            normal /= length;
+        }
+
+        const double phi = sdf(i, j, k);
+        T sum = T();
+        double weightSum = 0.0;
+        bool isWaiting = false;
+
+        auto addValue = [&](size_t ni, size_t nj, size_t nk, double weight) {
+            // The fixed points are also upwind since their SDF is negative
+            if (sdf(ni, nj, nk) >= phi) {
+                return;
+            }
+
+            if (markers(ni, nj, nk) == kUnknown) {
+                isWaiting = true;
+                return;
+            }
+
+            // If gradient is zero, then just assign 1 to weight
+            if (weight < kEpsilonD) {
+                weight = 1.0;
+            }
+
+            sum += weight * output(ni, nj, nk);
+            weightSum += weight;
+        };
+
+        if (i > 0) {
+            addValue(i - 1, j, k, std::max(normal.x, 0.0) * invGridSpacing.x);
+        }
+        if (i + 1 < size.x) {
+            addValue(i + 1, j, k, -std::min(normal.x, 0.0) * invGridSpacing.x);
+        }
+        if (j > 0) {
+            addValue(i, j - 1, k, std::max(normal.y, 0.0) * invGridSpacing.y);
+        }
+        if (j + 1 < size.y) {
+            addValue(i, j + 1, k, -std::min(normal.y, 0.0) * invGridSpacing.y);
+        }
+        if (k > 0) {
+            addValue(i, j, k - 1, std::max(normal.z, 0.0) * invGridSpacing.z);
+        }
+        if (k + 1 < size.z) {
+            addValue(i, j, k + 1, -std::min(normal.z, 0.0) * invGridSpacing.z);
+        }
+
+        if (isWaiting || weightSum == 0.0) {
+            return false;
+        }
+
+        output(i, j, k) = sum / weightSum;
+        markers(i, j, k) = kKnown;
+        return true;
+    };
+
+    BlockSweeper3 sweeper(size);
+    sweeper.markSeedBlocks([&](size_t i, size_t j, size_t k) {
+        return isNextToFixed(markers, i, j, k);
+    });
+
+    _lastNumberOfIterations = 0;
+    bool changed = true;
+    while (changed && _lastNumberOfIterations < _maxNumberOfIterations) {
+        changed = false;
+        for (int ordering = 0; ordering < 8; ++ordering) {
+            changed |= sweeper.sweep(ordering, update);
+        }
+        ++_lastNumberOfIterations;
+    }
+}
@@ -16,6 +16,8 @@ FdmCgSolver3::FdmCgSolver3(
 }
 
 bool FdmCgSolver3::solve(FdmLinearSystem3* system) {
+    StatsMonitor monitor(this);
+
     FdmMatrix3& matrix = system->A;
     FdmVector3& solution = system->x;
     FdmVector3& rhs = system->b;
@@ -29,7 +31,9 @@ bool FdmCgSolver3::solve(FdmLinearSystem3* system) {
     _q.resize(size);
     _s.resize(size);
 
-    system->x.set(0.0);
+    if (!isUsingWarmStart()) {
+        system->x.set(0.0);
+    }
     _r.set(0.0);
     _d.set(0.0);
     _q.set(0.0);
@@ -46,10 +50,98 @@ bool FdmCgSolver3::solve(FdmLinearSystem3* system) {
         &_q,
         &_s,
         &_lastNumberOfIterations,
-        &_lastResidual);
+        &_lastResidual,
+        &monitor);
+
+    monitor.end(_lastNumberOfIterations, _lastResidual);
+
+    return _lastResidual <= _tolerance
+        || (_lastNumberOfIterations < _maxNumberOfIterations
+            && !stats().isStagnated);
+}
+
+bool FdmCgSolver3::solveCompressed(FdmCompressedLinearSystem3* system) {
+    StatsMonitor monitor(this);
+
+    FdmCompressedMatrix3& matrix = system->A;
+    FdmCompressedVector3& solution = system->x;
+    FdmCompressedVector3& rhs = system->b;
+
+    JET_ASSERT(matrix.rows() == rhs.size());
+    JET_ASSERT(matrix.rows() == solution.size());
+
+    size_t size = matrix.rows();
+    _rComp.resize(size);
+    _dComp.resize(size);
+    _qComp.resize(size);
+    _sComp.resize(size);
+
+    if (!isUsingWarmStart()) {
+        system->x.set(0.0);
+    }
+    _rComp.set(0.0);
+    _dComp.set(0.0);
+    _qComp.set(0.0);
+    _sComp.set(0.0);
+
+    cg<FdmCompressedBlas3>(
+        matrix,
+        rhs,
+        _maxNumberOfIterations,
+        _tolerance,
+        &solution,
+        &_rComp,
+        &_dComp,
+        &_qComp,
+        &_sComp,
+        &_lastNumberOfIterations,
+        &_lastResidual,
+        &monitor);
+
+    monitor.end(_lastNumberOfIterations, _lastResidual);
+
+    return _lastResidual <= _tolerance
+        || (_lastNumberOfIterations < _maxNumberOfIterations
+            && !stats().isStagnated);
+}
+
+bool FdmCgSolver3::solveMatrixFree(FdmMatrixFreeSystem3* system) {
+    StatsMonitor monitor(this);
+
+    FdmMatrixFreeMatrix3& matrix = system->A;
+    FdmVector3& solution = system->x;
+    FdmVector3& rhs = system->b;
+
+    JET_ASSERT(matrix.size() == rhs.size());
+    JET_ASSERT(matrix.size() == solution.size());
+
+    Size3 size = matrix.size();
+    _r.resize(size);
+    _d.resize(size);
+    _q.resize(size);
+
+    if (!isUsingWarmStart()) {
+        system->x.set(0.0);
+    }
+
+    fusedCg<FdmMatrixFreeBlas3>(
+        matrix,
+        rhs,
+        _maxNumberOfIterations,
+        _tolerance,
+        &solution,
+        &_r,
+        &_d,
+        &_q,
+        &_lastNumberOfIterations,
+        &_lastResidual,
+        &monitor);
+
+    monitor.end(_lastNumberOfIterations, _lastResidual);
 
     return _lastResidual <= _tolerance
-        || _lastNumberOfIterations < _maxNumberOfIterations;
+        || (_lastNumberOfIterations < _maxNumberOfIterations
+            && !stats().isStagnated);
 }
 
 unsigned int FdmCgSolver3::maxNumberOfIterations() const {
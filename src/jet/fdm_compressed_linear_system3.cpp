@@ -0,0 +1,243 @@
+// Copyright (c) 2016 Doyub Kim
+
+#include <pch.h>
+#include <jet/constants.h>
+#include <jet/fdm_compressed_linear_system3.h>
+#include <jet/math_utils.h>
+#include <jet/parallel.h>
+
+using namespace jet;
+
+size_t FdmCompressedMatrix3::rows() const {
+    return (rowPointers.size() > 0) ? rowPointers.size() - 1 : 0;
+}
+
+void FdmCompressedMatrix3::clear() {
+    nonZeros.clear();
+    columnIndices.clear();
+    rowPointers.clear();
+}
+
+void FdmCompressedLinearSystem3::clear() {
+    A.clear();
+    x.clear();
+    b.clear();
+    indexToCoord.clear();
+    coordToIndex.clear();
+}
+
+size_t FdmCompressedLinearSystem3::buildIndexMap(
+    const Size3& size,
+    const std::function<bool(size_t, size_t, size_t)>& isActive) {
+    coordToIndex.resize(size);
+    indexToCoord.clear();
+
+    coordToIndex.forEachIndex([&](size_t i, size_t j, size_t k) {
+        if (isActive(i, j, k)) {
+            coordToIndex(i, j, k) = indexToCoord.size();
+            indexToCoord.append(Point3UI(i, j, k));
+        } else {
+            coordToIndex(i, j, k) = kMaxSize;
+        }
+    });
+
+    return indexToCoord.size();
+}
+
+void FdmCompressedLinearSystem3::build(
+    const Size3& size,
+    const std::function<bool(size_t, size_t, size_t)>& isActive,
+    const std::function<
+        void(size_t, size_t, size_t, FdmMatrixRow3*, double*)>& buildRow) {
+    size_t n = buildIndexMap(size, isActive);
+
+    Array1<FdmMatrixRow3> rows(n);
+    b.resize(n, 0.0);
+    x.resize(n, 0.0);
+    x.set(0.0);
+
+    indexToCoord.parallelForEachIndex([&](size_t idx) {
+        const Point3UI& pt = indexToCoord[idx];
+        buildRow(pt.x, pt.y, pt.z, &rows[idx], &b[idx]);
+    });
+
+    // Gathers the columns of the given row in ascending order
+    auto gather = [&](size_t idx, size_t* cols, double* vals) {
+        const Point3UI& pt = indexToCoord[idx];
+        size_t i = pt.x;
+        size_t j = pt.y;
+        size_t k = pt.z;
+        size_t cnt = 0;
+
+        auto addElement = [&](size_t col, double val) {
+            if (col != kMaxSize && val != 0.0) {
+                cols[cnt] = col;
+                vals[cnt] = val;
+                ++cnt;
+            }
+        };
+
+        if (k > 0) {
+            size_t col = coordToIndex(i, j, k - 1);
+            addElement(col, (col != kMaxSize) ? rows[col].front : 0.0);
+        }
+        if (j > 0) {
+            size_t col = coordToIndex(i, j - 1, k);
+            addElement(col, (col != kMaxSize) ? rows[col].up : 0.0);
+        }
+        if (i > 0) {
+            size_t col = coordToIndex(i - 1, j, k);
+            addElement(col, (col != kMaxSize) ? rows[col].right : 0.0);
+        }
+
+        // Always keep the diagonal element
+        cols[cnt] = idx;
+        vals[cnt] = rows[idx].center;
+        ++cnt;
+
+        if (i + 1 < size.x) {
+            addElement(coordToIndex(i + 1, j, k), rows[idx].right);
+        }
+        if (j + 1 < size.y) {
+            addElement(coordToIndex(i, j + 1, k), rows[idx].up);
+        }
+        if (k + 1 < size.z) {
+            addElement(coordToIndex(i, j, k + 1), rows[idx].front);
+        }
+
+        return cnt;
+    };
+
+    // Count the number of non-zeros per row, and then compute the offsets
+    A.rowPointers.resize(n + 1, 0);
+    indexToCoord.parallelForEachIndex([&](size_t idx) {
+        size_t cols[7];
+        double vals[7];
+        A.rowPointers[idx + 1] = gather(idx, cols, vals);
+    });
+
+    A.rowPointers[0] = 0;
+    for (size_t idx = 0; idx < n; ++idx) {
+        A.rowPointers[idx + 1] += A.rowPointers[idx];
+    }
+
+    A.nonZeros.resize(A.rowPointers[n]);
+    A.columnIndices.resize(A.rowPointers[n]);
+    indexToCoord.parallelForEachIndex([&](size_t idx) {
+        size_t offset = A.rowPointers[idx];
+        gather(idx, &A.columnIndices[offset], &A.nonZeros[offset]);
+    });
+}
+
+void FdmCompressedLinearSystem3::decompressSolution(
+    FdmVector3* result,
+    double inactiveValue) const {
+    result->resize(coordToIndex.size());
+    coordToIndex.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        size_t idx = coordToIndex(i, j, k);
+        (*result)(i, j, k) = (idx != kMaxSize) ? x[idx] : inactiveValue;
+    });
+}
+
+void FdmCompressedBlas3::set(double s, FdmCompressedVector3* result) {
+    result->set(s);
+}
+
+void FdmCompressedBlas3::set(
+    const FdmCompressedVector3& v,
+    FdmCompressedVector3* result) {
+    result->set(v);
+}
+
+void FdmCompressedBlas3::set(double s, FdmCompressedMatrix3* result) {
+    result->nonZeros.set(s);
+}
+
+void FdmCompressedBlas3::set(
+    const FdmCompressedMatrix3& m,
+    FdmCompressedMatrix3* result) {
+    *result = m;
+}
+
+double FdmCompressedBlas3::dot(
+    const FdmCompressedVector3& a,
+    const FdmCompressedVector3& b) {
+    JET_THROW_INVALID_ARG_IF(a.size() != b.size());
+
+    double result = 0.0;
+
+    for (size_t i = 0; i < a.size(); ++i) {
+        result += a[i] * b[i];
+    }
+
+    return result;
+}
+
+void FdmCompressedBlas3::axpy(
+    double a,
+    const FdmCompressedVector3& x,
+    const FdmCompressedVector3& y,
+    FdmCompressedVector3* result) {
+    JET_THROW_INVALID_ARG_IF(x.size() != y.size());
+    JET_THROW_INVALID_ARG_IF(x.size() != result->size());
+
+    x.parallelForEachIndex([&](size_t i) {
+        (*result)[i] = a * x[i] + y[i];
+    });
+}
+
+void FdmCompressedBlas3::mvm(
+    const FdmCompressedMatrix3& m,
+    const FdmCompressedVector3& v,
+    FdmCompressedVector3* result) {
+    JET_THROW_INVALID_ARG_IF(m.rows() != v.size());
+    JET_THROW_INVALID_ARG_IF(m.rows() != result->size());
+
+    const auto& rp = m.rowPointers;
+    const auto& ci = m.columnIndices;
+    const auto& nnz = m.nonZeros;
+
+    v.parallelForEachIndex([&](size_t i) {
+        double sum = 0.0;
+        for (size_t n = rp[i]; n < rp[i + 1]; ++n) {
+            sum += nnz[n] * v[ci[n]];
+        }
+        (*result)[i] = sum;
+    });
+}
+
+void FdmCompressedBlas3::residual(
+    const FdmCompressedMatrix3& a,
+    const FdmCompressedVector3& x,
+    const FdmCompressedVector3& b,
+    FdmCompressedVector3* result) {
+    JET_THROW_INVALID_ARG_IF(a.rows() != x.size());
+    JET_THROW_INVALID_ARG_IF(a.rows() != b.size());
+    JET_THROW_INVALID_ARG_IF(a.rows() != result->size());
+
+    const auto& rp = a.rowPointers;
+    const auto& ci = a.columnIndices;
+    const auto& nnz = a.nonZeros;
+
+    x.parallelForEachIndex([&](size_t i) {
+        double sum = b[i];
+        for (size_t n = rp[i]; n < rp[i + 1]; ++n) {
+            sum -= nnz[n] * x[ci[n]];
+        }
+        (*result)[i] = sum;
+    });
+}
+
+double FdmCompressedBlas3::l2Norm(const FdmCompressedVector3& v) {
+    return std::sqrt(dot(v, v));
+}
+
+double FdmCompressedBlas3::lInfNorm(const FdmCompressedVector3& v) {
+    double result = 0.0;
+
+    for (size_t i = 0; i < v.size(); ++i) {
+        result = absmax(result, v[i]);
+    }
+
+    return std::fabs(result);
+}
@@ -3,19 +3,50 @@
 #include <pch.h>
 #include <jet/constants.h>
 #include <jet/fdm_gauss_seidel_solver3.h>
+#include <jet/parallel.h>
 #include <jet/serial.h>
 
 using namespace jet;
 
+// Returns the color of the grid point for the given ordering.
+static size_t colorOf(
+    FdmGaussSeidelSolver3::Ordering ordering,
+    size_t i,
+    size_t j,
+    size_t k) {
+    if (ordering == FdmGaussSeidelSolver3::RedBlack) {
+        return (i + j + k) % 2;
+    } else if (ordering == FdmGaussSeidelSolver3::MultiColor) {
+        return (i % 2) + 2 * (j % 2) + 4 * (k % 2);
+    } else {
+        return 0;
+    }
+}
+
+// Returns the number of colors for the given ordering.
+static size_t numberOfColors(FdmGaussSeidelSolver3::Ordering ordering) {
+    if (ordering == FdmGaussSeidelSolver3::RedBlack) {
+        return 2;
+    } else if (ordering == FdmGaussSeidelSolver3::MultiColor) {
+        return 8;
+    } else {
+        return 1;
+    }
+}
+
 FdmGaussSeidelSolver3::FdmGaussSeidelSolver3(
     unsigned int maxNumberOfIterations,
     unsigned int residualCheckInterval,
-    double tolerance) :
+    double tolerance,
+    double sorFactor,
+    Ordering ordering) :
     _maxNumberOfIterations(maxNumberOfIterations),
     _lastNumberOfIterations(0),
     _residualCheckInterval(residualCheckInterval),
     _tolerance(tolerance),
-    _lastResidual(kMaxD) {
+    _lastResidual(kMaxD),
+    _sorFactor(sorFactor),
+    _ordering(ordering) {
 }
 
 bool FdmGaussSeidelSolver3::solve(FdmLinearSystem3* system) {
@@ -42,6 +73,33 @@ bool FdmGaussSeidelSolver3::solve(FdmLinearSystem3* system) {
     return _lastResidual < _tolerance;
 }
 
+bool FdmGaussSeidelSolver3::solveCompressed(
+    FdmCompressedLinearSystem3* system) {
+    _residualComp.resize(system->x.size());
+
+    _lastNumberOfIterations = _maxNumberOfIterations;
+
+    for (unsigned int iter = 0; iter < _maxNumberOfIterations; ++iter) {
+        relax(system);
+
+        if (iter != 0 && iter % _residualCheckInterval == 0) {
+            FdmCompressedBlas3::residual(
+                system->A, system->x, system->b, &_residualComp);
+
+            if (FdmCompressedBlas3::l2Norm(_residualComp) < _tolerance) {
+                _lastNumberOfIterations = iter + 1;
+                break;
+            }
+        }
+    }
+
+    FdmCompressedBlas3::residual(
+        system->A, system->x, system->b, &_residualComp);
+    _lastResidual = FdmCompressedBlas3::l2Norm(_residualComp);
+
+    return _lastResidual < _tolerance;
+}
+
 unsigned int FdmGaussSeidelSolver3::maxNumberOfIterations() const {
     return _maxNumberOfIterations;
 }
@@ -58,13 +116,22 @@ double FdmGaussSeidelSolver3::lastResidual() const {
     return _lastResidual;
 }
 
+double FdmGaussSeidelSolver3::sorFactor() const {
+    return _sorFactor;
+}
+
+FdmGaussSeidelSolver3::Ordering FdmGaussSeidelSolver3::ordering() const {
+    return _ordering;
+}
+
 void FdmGaussSeidelSolver3::relax(FdmLinearSystem3* system) {
     Size3 size = system->x.size();
     FdmMatrix3& A = system->A;
     FdmVector3& x = system->x;
     FdmVector3& b = system->b;
+    double w = _sorFactor;
 
-    A.forEachIndex([&](size_t i, size_t j, size_t k) {
+    auto relaxPoint = [&](size_t i, size_t j, size_t k) {
         double r
             = ((i > 0) ? A(i - 1, j, k).right * x(i - 1, j, k) : 0.0)
             + ((i + 1 < size.x) ? A(i, j, k).right * x(i + 1, j, k) : 0.0)
@@ -73,6 +140,79 @@ void FdmGaussSeidelSolver3::relax(FdmLinearSystem3* system) {
             + ((k > 0) ? A(i, j, k - 1).front * x(i, j, k - 1) : 0.0)
             + ((k + 1 < size.z) ? A(i, j, k).front * x(i, j, k + 1) : 0.0);
 
-        x(i, j, k) = (b(i, j, k) - r) / A(i, j, k).center;
-    });
+        x(i, j, k)
+            = (1.0 - w) * x(i, j, k) + w * (b(i, j, k) - r) / A(i, j, k).center;
+    };
+
+    if (_ordering == RedBlack) {
+        for (size_t color = 0; color < 2; ++color) {
+            parallelFor(kZeroSize, size.z, [&](size_t k) {
+                for (size_t j = 0; j < size.y; ++j) {
+                    for (size_t i = (j + k + color) % 2; i < size.x; i += 2) {
+                        relaxPoint(i, j, k);
+                    }
+                }
+            });
+        }
+    } else if (_ordering == MultiColor) {
+        for (size_t color = 0; color < 8; ++color) {
+            size_t ci = color % 2;
+            size_t cj = (color / 2) % 2;
+            size_t ck = color / 4;
+
+            // Every other k-slice starting from ck
+            parallelFor(kZeroSize, (size.z + 1 - ck) / 2, [&](size_t kk) {
+                size_t k = ck + 2 * kk;
+                for (size_t j = cj; j < size.y; j += 2) {
+                    for (size_t i = ci; i < size.x; i += 2) {
+                        relaxPoint(i, j, k);
+                    }
+                }
+            });
+        }
+    } else {
+        A.forEachIndex(relaxPoint);
+    }
+}
+
+void FdmGaussSeidelSolver3::relax(FdmCompressedLinearSystem3* system) {
+    const auto& rp = system->A.rowPointers;
+    const auto& ci = system->A.columnIndices;
+    const auto& nnz = system->A.nonZeros;
+    const auto& indexToCoord = system->indexToCoord;
+    FdmCompressedVector3& x = system->x;
+    FdmCompressedVector3& b = system->b;
+    double w = _sorFactor;
+
+    auto relaxRow = [&](size_t i) {
+        double r = 0.0;
+        double diag = 1.0;
+
+        for (size_t n = rp[i]; n < rp[i + 1]; ++n) {
+            if (ci[n] == i) {
+                diag = nnz[n];
+            } else {
+                r += nnz[n] * x[ci[n]];
+            }
+        }
+
+        x[i] = (1.0 - w) * x[i] + w * (b[i] - r) / diag;
+    };
+
+    // The colors are taken from the grid points of the rows
+    if (_ordering == Lexicographic || indexToCoord.size() != x.size()) {
+        for (size_t i = 0; i < x.size(); ++i) {
+            relaxRow(i);
+        }
+        return;
+    }
+
+    for (size_t color = 0; color < numberOfColors(_ordering); ++color) {
+        parallelFor(kZeroSize, x.size(), [&](size_t i) {
+            const Point3UI& pt = indexToCoord[i];
+            if (colorOf(_ordering, pt.x, pt.y, pt.z) == color) {
+                relaxRow(i);
+            }
+        });
+    }
 }
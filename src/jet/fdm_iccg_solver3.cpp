@@ -11,6 +11,10 @@ void FdmIccgSolver3::Preconditioner::build(const FdmMatrix3& matrix) {
     Size3 size = matrix.size();
     A = matrix.constAccessor();
 
+    if (isReused) {
+        return;
+    }
+
     d.resize(size, 0.0);
     y.resize(size, 0.0);
 
@@ -66,6 +70,76 @@ void FdmIccgSolver3::Preconditioner::solve(
     }
 }
 
+// Since the rows are sorted in lexicographic order of the grid points, the
+// lower (or upper) triangular elements of a row are the elements whose column
+// index is smaller (or larger) than the row index. This is exactly the same
+// factorization as the full-grid preconditioner above.
+void FdmIccgSolver3::PreconditionerCompressed::build(
+    const FdmCompressedMatrix3& matrix) {
+    size_t size = matrix.rows();
+    A = &matrix;
+
+    if (isReused) {
+        return;
+    }
+
+    d.resize(size, 0.0);
+    y.resize(size, 0.0);
+
+    const auto& rp = matrix.rowPointers;
+    const auto& ci = matrix.columnIndices;
+    const auto& nnz = matrix.nonZeros;
+
+    for (size_t i = 0; i < size; ++i) {
+        double denom = 0.0;
+
+        for (size_t n = rp[i]; n < rp[i + 1]; ++n) {
+            size_t c = ci[n];
+            if (c < i) {
+                denom -= square(nnz[n]) * d[c];
+            } else if (c == i) {
+                denom += nnz[n];
+            }
+        }
+
+        if (std::fabs(denom) > 0.0) {
+            d[i] = 1.0 / denom;
+        } else {
+            d[i] = 0.0;
+        }
+    }
+}
+
+void FdmIccgSolver3::PreconditionerCompressed::solve(
+    const FdmCompressedVector3& b,
+    FdmCompressedVector3* x) {
+    size_t size = b.size();
+    const auto& rp = A->rowPointers;
+    const auto& ci = A->columnIndices;
+    const auto& nnz = A->nonZeros;
+
+    for (size_t i = 0; i < size; ++i) {
+        double sum = b[i];
+
+        for (size_t n = rp[i]; n < rp[i + 1] && ci[n] < i; ++n) {
+            sum -= nnz[n] * y[ci[n]];
+        }
+
+        y[i] = sum * d[i];
+    }
+
+    for (size_t i = size; i > 0; --i) {
+        size_t row = i - 1;
+        double sum = y[row];
+
+        for (size_t n = rp[row + 1]; n > rp[row] && ci[n - 1] > row; --n) {
+            sum -= nnz[n - 1] * (*x)[ci[n - 1]];
+        }
+
+        (*x)[row] = sum * d[row];
+    }
+}
+
 FdmIccgSolver3::FdmIccgSolver3(
     unsigned int maxNumberOfIterations,
     double tolerance) :
@@ -76,6 +150,8 @@ FdmIccgSolver3::FdmIccgSolver3(
 }
 
 bool FdmIccgSolver3::solve(FdmLinearSystem3* system) {
+    StatsMonitor monitor(this);
+
     FdmMatrix3& matrix = system->A;
     FdmVector3& solution = system->x;
     FdmVector3& rhs = system->b;
@@ -89,13 +165,16 @@ bool FdmIccgSolver3::solve(FdmLinearSystem3* system) {
     _q.resize(size);
     _s.resize(size);
 
-    system->x.set(0.0);
+    if (!isUsingWarmStart()) {
+        system->x.set(0.0);
+    }
     _r.set(0.0);
     _d.set(0.0);
     _q.set(0.0);
     _s.set(0.0);
 
-    _precond.build(matrix);
+    // pcg() builds the preconditioner unless it can be reused
+    _precond.isReused = isReusingMatrix() && _precond.d.size() == size;
 
     pcg<FdmBlas3, Preconditioner>(
         matrix,
@@ -109,13 +188,72 @@ bool FdmIccgSolver3::solve(FdmLinearSystem3* system) {
         &_q,
         &_s,
         &_lastNumberOfIterations,
-        &_lastResidualNorm);
+        &_lastResidualNorm,
+        &monitor);
+
+    monitor.end(_lastNumberOfIterations, _lastResidualNorm);
 
     JET_INFO << "Residual norm after solving ICCG: " << _lastResidualNorm
              << " Number of ICCG iterations: " << _lastNumberOfIterations;
 
     return _lastResidualNorm <= _tolerance
-        || _lastNumberOfIterations < _maxNumberOfIterations;
+        || (_lastNumberOfIterations < _maxNumberOfIterations
+            && !stats().isStagnated);
+}
+
+bool FdmIccgSolver3::solveCompressed(FdmCompressedLinearSystem3* system) {
+    StatsMonitor monitor(this);
+
+    FdmCompressedMatrix3& matrix = system->A;
+    FdmCompressedVector3& solution = system->x;
+    FdmCompressedVector3& rhs = system->b;
+
+    JET_ASSERT(matrix.rows() == rhs.size());
+    JET_ASSERT(matrix.rows() == solution.size());
+
+    size_t size = matrix.rows();
+    _rComp.resize(size);
+    _dComp.resize(size);
+    _qComp.resize(size);
+    _sComp.resize(size);
+
+    if (!isUsingWarmStart()) {
+        system->x.set(0.0);
+    }
+    _rComp.set(0.0);
+    _dComp.set(0.0);
+    _qComp.set(0.0);
+    _sComp.set(0.0);
+
+    // pcg() builds the preconditioner unless it can be reused
+    _precondComp.isReused
+        = isReusingMatrix() && _precondComp.d.size() == size;
+
+    pcg<FdmCompressedBlas3, PreconditionerCompressed>(
+        matrix,
+        rhs,
+        _maxNumberOfIterations,
+        _tolerance,
+        &_precondComp,
+        &solution,
+        &_rComp,
+        &_dComp,
+        &_qComp,
+        &_sComp,
+        &_lastNumberOfIterations,
+        &_lastResidualNorm,
+        &monitor);
+
+    monitor.end(_lastNumberOfIterations, _lastResidualNorm);
+
+    JET_INFO << "Residual norm after solving compressed ICCG: "
+             << _lastResidualNorm
+             << " Number of compressed ICCG iterations: "
+             << _lastNumberOfIterations;
+
+    return _lastResidualNorm <= _tolerance
+        || (_lastNumberOfIterations < _maxNumberOfIterations
+            && !stats().isStagnated);
 }
 
 unsigned int FdmIccgSolver3::maxNumberOfIterations() const {
@@ -45,6 +45,35 @@ bool FdmJacobiSolver3::solve(FdmLinearSystem3* system) {
     return _lastResidual < _tolerance;
 }
 
+bool FdmJacobiSolver3::solveCompressed(FdmCompressedLinearSystem3* system) {
+    _xTempComp.resize(system->x.size());
+    _residualComp.resize(system->x.size());
+
+    _lastNumberOfIterations = _maxNumberOfIterations;
+
+    for (unsigned int iter = 0; iter < _maxNumberOfIterations; ++iter) {
+        relax(system, &_xTempComp);
+
+        _xTempComp.swap(system->x);
+
+        if (iter != 0 && iter % _residualCheckInterval == 0) {
+            FdmCompressedBlas3::residual(
+                system->A, system->x, system->b, &_residualComp);
+
+            if (FdmCompressedBlas3::l2Norm(_residualComp) < _tolerance) {
+                _lastNumberOfIterations = iter + 1;
+                break;
+            }
+        }
+    }
+
+    FdmCompressedBlas3::residual(
+        system->A, system->x, system->b, &_residualComp);
+    _lastResidual = FdmCompressedBlas3::l2Norm(_residualComp);
+
+    return _lastResidual < _tolerance;
+}
+
 unsigned int FdmJacobiSolver3::maxNumberOfIterations() const {
     return _maxNumberOfIterations;
 }
@@ -79,3 +108,28 @@ void FdmJacobiSolver3::relax(FdmLinearSystem3* system, FdmVector3* xTemp) {
         (*xTemp)(i, j, k) = (b(i, j, k) - r) / A(i, j, k).center;
     });
 }
+
+void FdmJacobiSolver3::relax(
+    FdmCompressedLinearSystem3* system,
+    FdmCompressedVector3* xTemp) {
+    const auto& rp = system->A.rowPointers;
+    const auto& ci = system->A.columnIndices;
+    const auto& nnz = system->A.nonZeros;
+    FdmCompressedVector3& x = system->x;
+    FdmCompressedVector3& b = system->b;
+
+    x.parallelForEachIndex([&](size_t i) {
+        double r = 0.0;
+        double diag = 1.0;
+
+        for (size_t n = rp[i]; n < rp[i + 1]; ++n) {
+            if (ci[n] == i) {
+                diag = nnz[n];
+            } else {
+                r += nnz[n] * x[ci[n]];
+            }
+        }
+
+        (*xTemp)[i] = (b[i] - r) / diag;
+    });
+}
@@ -0,0 +1,123 @@
+// Copyright (c) 2016 Doyub Kim
+
+#include <pch.h>
+#include <jet/fdm_linear_system_solver3.h>
+#include <cmath>
+
+using namespace jet;
+
+bool FdmLinearSystemSolver3::isUsingWarmStart() const {
+    return _isUsingWarmStart;
+}
+
+void FdmLinearSystemSolver3::setIsUsingWarmStart(bool isUsing) {
+    _isUsingWarmStart = isUsing;
+}
+
+bool FdmLinearSystemSolver3::isReusingMatrix() const {
+    return _isReusingMatrix;
+}
+
+void FdmLinearSystemSolver3::setIsReusingMatrix(bool isReusing) {
+    _isReusingMatrix = isReusing;
+}
+
+bool FdmLinearSystemSolver3::isCollectingStats() const {
+    return _isCollectingStats;
+}
+
+void FdmLinearSystemSolver3::setIsCollectingStats(bool isCollecting) {
+    _isCollectingStats = isCollecting;
+}
+
+unsigned int FdmLinearSystemSolver3::stagnationWindow() const {
+    return _stagnationWindow;
+}
+
+void FdmLinearSystemSolver3::setStagnationWindow(unsigned int window) {
+    _stagnationWindow = window;
+}
+
+double FdmLinearSystemSolver3::stagnationRatio() const {
+    return _stagnationRatio;
+}
+
+void FdmLinearSystemSolver3::setStagnationRatio(double ratio) {
+    _stagnationRatio = ratio;
+}
+
+const FdmLinearSystemSolverStats3& FdmLinearSystemSolver3::stats() const {
+    return _stats;
+}
+
+FdmLinearSystemSolver3::StatsMonitor::StatsMonitor(
+    FdmLinearSystemSolver3* solver) :
+    _solver(solver),
+    _isCollectingStats(solver->_isCollectingStats),
+    _stagnationWindow(solver->_stagnationWindow) {
+    FdmLinearSystemSolverStats3& stats = _solver->_stats;
+    stats.numberOfIterations = 0;
+    stats.residual = 0.0;
+    stats.residualHistory.clear();
+    stats.setupTime = 0.0;
+    stats.preconditionerBuildTime = 0.0;
+    stats.iterationTime = 0.0;
+    stats.isStagnated = false;
+
+    if (_stagnationWindow > 0) {
+        _recentResiduals.resize(_stagnationWindow);
+    }
+}
+
+void FdmLinearSystemSolver3::StatsMonitor::beginPreconditionerBuild() {
+    if (_isCollectingStats) {
+        _solver->_stats.setupTime = _timer.durationInSeconds();
+        _timer.reset();
+    }
+}
+
+void FdmLinearSystemSolver3::StatsMonitor::beginIterations() {
+    if (_isCollectingStats) {
+        _solver->_stats.preconditionerBuildTime = _timer.durationInSeconds();
+        _timer.reset();
+    }
+}
+
+bool FdmLinearSystemSolver3::StatsMonitor::onIteration(
+    unsigned int iter,
+    double residualNormSquared) {
+    if (!_isCollectingStats && _stagnationWindow == 0) {
+        return true;
+    }
+
+    double residual = std::sqrt(residualNormSquared);
+
+    if (_isCollectingStats) {
+        _solver->_stats.residualHistory.push_back(residual);
+    }
+
+    if (_stagnationWindow > 0) {
+        // The slot holds the residual from _stagnationWindow iterations ago
+        double& slot = _recentResiduals[iter % _stagnationWindow];
+        if (iter >= _stagnationWindow
+            && residual > _solver->_stagnationRatio * slot) {
+            _solver->_stats.isStagnated = true;
+            return false;
+        }
+        slot = residual;
+    }
+
+    return true;
+}
+
+void FdmLinearSystemSolver3::StatsMonitor::end(
+    unsigned int numberOfIterations,
+    double residual) {
+    FdmLinearSystemSolverStats3& stats = _solver->_stats;
+    stats.numberOfIterations = numberOfIterations;
+    stats.residual = residual;
+
+    if (_isCollectingStats) {
+        stats.iterationTime = _timer.durationInSeconds();
+    }
+}
@@ -0,0 +1,371 @@
+// Copyright (c) 2016 Doyub Kim
+
+#include <pch.h>
+#include <jet/constants.h>
+#include <jet/fdm_matrix_free_system3.h>
+#include <jet/math_utils.h>
+#include <jet/parallel.h>
+#include <vector>
+
+using namespace jet;
+
+// Sums up func(i, j, k) over the grid. Each k-slice is summed in parallel and
+// the partial sums are added in order, so the result does not depend on the
+// number of threads.
+template <typename Callback>
+static double parallelSum(const Size3& size, const Callback& func) {
+    std::vector<double> partialSums(size.z, 0.0);
+
+    parallelFor(kZeroSize, size.z, [&](size_t k) {
+        double sum = 0.0;
+        for (size_t j = 0; j < size.y; ++j) {
+            for (size_t i = 0; i < size.x; ++i) {
+                sum += func(i, j, k);
+            }
+        }
+        partialSums[k] = sum;
+    });
+
+    double result = 0.0;
+    for (double sum : partialSums) {
+        result += sum;
+    }
+
+    return result;
+}
+
+// A neighbor adds to the diagonal unless it is a boundary, and only a fluid
+// neighbor is coupled. These return 0 or 1 so that the stencil of the cells
+// next to the air or boundary cells has no branch.
+inline double isOpen(char marker) {
+    return (marker != FdmMatrixFreeMatrix3::Boundary) ? 1.0 : 0.0;
+}
+
+inline double isFluid(char marker) {
+    return (marker == FdmMatrixFreeMatrix3::Fluid) ? 1.0 : 0.0;
+}
+
+// Applies the operator to the (j, k) line of x, and calls
+// func(i, (Ax)(i, j, k)). This is the same as FdmMatrixFreeMatrix3::apply,
+// but walks the line with raw pointers.
+template <typename Callback>
+static void applyLine(
+    const FdmMatrixFreeMatrix3& m,
+    const FdmVector3& x,
+    const std::vector<char>& boundaryLine,
+    const std::vector<double>& zeroLine,
+    size_t j,
+    size_t k,
+    const Callback& func) {
+    Size3 size = m.size();
+    const char* m0 = &m.markers(0, j, k);
+    const double* x0 = &x(0, j, k);
+
+    // Neighbor lines outside the domain are treated as boundaries
+    const char* mDown
+        = (j > 0) ? &m.markers(0, j - 1, k) : boundaryLine.data();
+    const char* mUp
+        = (j + 1 < size.y) ? &m.markers(0, j + 1, k) : boundaryLine.data();
+    const char* mBack
+        = (k > 0) ? &m.markers(0, j, k - 1) : boundaryLine.data();
+    const char* mFront
+        = (k + 1 < size.z) ? &m.markers(0, j, k + 1) : boundaryLine.data();
+    const double* xDown = (j > 0) ? &x(0, j - 1, k) : zeroLine.data();
+    const double* xUp = (j + 1 < size.y) ? &x(0, j + 1, k) : zeroLine.data();
+    const double* xBack = (k > 0) ? &x(0, j, k - 1) : zeroLine.data();
+    const double* xFront
+        = (k + 1 < size.z) ? &x(0, j, k + 1) : zeroLine.data();
+
+    // Coefficients are copied so that the stores in func do not reload them
+    const double cx = m.coefficients.x;
+    const double cy = m.coefficients.y;
+    const double cz = m.coefficients.z;
+    const double interiorCenter = 2.0 * (cx + cy + cz);
+
+    for (size_t i = 0; i < size.x; ++i) {
+        // Air and boundary cells are identity rows
+        if (m0[i] != FdmMatrixFreeMatrix3::Fluid) {
+            func(i, x0[i]);
+            continue;
+        }
+
+        // Fast path for the fluid cells surrounded by fluid cells, which are
+        // the majority of the fluid cells. Since Fluid is zero, OR-ing the
+        // markers tests all six neighbors at once.
+        if (i > 0 && i + 1 < size.x
+            && (m0[i - 1] | m0[i + 1] | mDown[i] | mUp[i] | mBack[i]
+                | mFront[i]) == FdmMatrixFreeMatrix3::Fluid) {
+            func(
+                i,
+                interiorCenter * x0[i]
+                - cx * (x0[i - 1] + x0[i + 1])
+                - cy * (xDown[i] + xUp[i])
+                - cz * (xBack[i] + xFront[i]));
+            continue;
+        }
+
+        char mLeft = (i > 0) ? m0[i - 1] : FdmMatrixFreeMatrix3::Boundary;
+        char mRight
+            = (i + 1 < size.x) ? m0[i + 1] : FdmMatrixFreeMatrix3::Boundary;
+        double xLeft = (i > 0) ? x0[i - 1] : 0.0;
+        double xRight = (i + 1 < size.x) ? x0[i + 1] : 0.0;
+
+        double center
+            = cx * (isOpen(mLeft) + isOpen(mRight))
+            + cy * (isOpen(mDown[i]) + isOpen(mUp[i]))
+            + cz * (isOpen(mBack[i]) + isOpen(mFront[i]));
+        double offDiagonal
+            = cx * (isFluid(mLeft) * xLeft + isFluid(mRight) * xRight)
+            + cy * (isFluid(mDown[i]) * xDown[i] + isFluid(mUp[i]) * xUp[i])
+            + cz
+            * (isFluid(mBack[i]) * xBack[i] + isFluid(mFront[i]) * xFront[i]);
+
+        func(i, center * x0[i] - offDiagonal);
+    }
+}
+
+// Applies the operator to every (j, k) line of x in parallel over k.
+template <typename Callback>
+static void applyLines(
+    const FdmMatrixFreeMatrix3& m,
+    const FdmVector3& x,
+    const Callback& func) {
+    Size3 size = m.size();
+    std::vector<char> boundaryLine(size.x, FdmMatrixFreeMatrix3::Boundary);
+    std::vector<double> zeroLine(size.x, 0.0);
+
+    parallelFor(kZeroSize, size.z, [&](size_t k) {
+        for (size_t j = 0; j < size.y; ++j) {
+            applyLine(
+                m, x, boundaryLine, zeroLine, j, k, [&](size_t i, double v) {
+                    func(i, j, k, v);
+                });
+        }
+    });
+}
+
+Size3 FdmMatrixFreeMatrix3::size() const {
+    return markers.size();
+}
+
+FdmMatrixRow3 FdmMatrixFreeMatrix3::row(size_t i, size_t j, size_t k) const {
+    Size3 size = markers.size();
+    FdmMatrixRow3 result;
+
+    if (markers(i, j, k) != Fluid) {
+        result.center = 1.0;
+        return result;
+    }
+
+    if (i > 0 && markers(i - 1, j, k) != Boundary) {
+        result.center += coefficients.x;
+    }
+    if (i + 1 < size.x && markers(i + 1, j, k) != Boundary) {
+        result.center += coefficients.x;
+        if (markers(i + 1, j, k) == Fluid) {
+            result.right -= coefficients.x;
+        }
+    }
+
+    if (j > 0 && markers(i, j - 1, k) != Boundary) {
+        result.center += coefficients.y;
+    }
+    if (j + 1 < size.y && markers(i, j + 1, k) != Boundary) {
+        result.center += coefficients.y;
+        if (markers(i, j + 1, k) == Fluid) {
+            result.up -= coefficients.y;
+        }
+    }
+
+    if (k > 0 && markers(i, j, k - 1) != Boundary) {
+        result.center += coefficients.z;
+    }
+    if (k + 1 < size.z && markers(i, j, k + 1) != Boundary) {
+        result.center += coefficients.z;
+        if (markers(i, j, k + 1) == Fluid) {
+            result.front -= coefficients.z;
+        }
+    }
+
+    return result;
+}
+
+double FdmMatrixFreeMatrix3::apply(
+    const FdmVector3& x,
+    size_t i,
+    size_t j,
+    size_t k) const {
+    if (markers(i, j, k) != Fluid) {
+        return x(i, j, k);
+    }
+
+    Size3 size = markers.size();
+    double center = 0.0;
+    double offDiagonal = 0.0;
+
+    auto couple = [&](size_t ni, size_t nj, size_t nk, double c) {
+        char marker = markers(ni, nj, nk);
+        if (marker != Boundary) {
+            center += c;
+            if (marker == Fluid) {
+                offDiagonal += c * x(ni, nj, nk);
+            }
+        }
+    };
+
+    if (i > 0) {
+        couple(i - 1, j, k, coefficients.x);
+    }
+    if (i + 1 < size.x) {
+        couple(i + 1, j, k, coefficients.x);
+    }
+    if (j > 0) {
+        couple(i, j - 1, k, coefficients.y);
+    }
+    if (j + 1 < size.y) {
+        couple(i, j + 1, k, coefficients.y);
+    }
+    if (k > 0) {
+        couple(i, j, k - 1, coefficients.z);
+    }
+    if (k + 1 < size.z) {
+        couple(i, j, k + 1, coefficients.z);
+    }
+
+    return center * x(i, j, k) - offDiagonal;
+}
+
+void FdmMatrixFreeBlas3::set(double s, FdmVector3* result) {
+    result->set(s);
+}
+
+void FdmMatrixFreeBlas3::set(const FdmVector3& v, FdmVector3* result) {
+    result->set(v);
+}
+
+double FdmMatrixFreeBlas3::dot(const FdmVector3& a, const FdmVector3& b) {
+    Size3 size = a.size();
+
+    JET_THROW_INVALID_ARG_IF(size != b.size());
+
+    return parallelSum(size, [&](size_t i, size_t j, size_t k) {
+        return a(i, j, k) * b(i, j, k);
+    });
+}
+
+void FdmMatrixFreeBlas3::axpy(
+    double a,
+    const FdmVector3& x,
+    const FdmVector3& y,
+    FdmVector3* result) {
+    Size3 size = x.size();
+
+    JET_THROW_INVALID_ARG_IF(size != y.size());
+    JET_THROW_INVALID_ARG_IF(size != result->size());
+
+    x.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        (*result)(i, j, k) = a * x(i, j, k) + y(i, j, k);
+    });
+}
+
+void FdmMatrixFreeBlas3::mvm(
+    const FdmMatrixFreeMatrix3& m,
+    const FdmVector3& v,
+    FdmVector3* result) {
+    Size3 size = m.size();
+
+    JET_THROW_INVALID_ARG_IF(size != v.size());
+    JET_THROW_INVALID_ARG_IF(size != result->size());
+
+    applyLines(m, v, [&](size_t i, size_t j, size_t k, double mv) {
+        (*result)(i, j, k) = mv;
+    });
+}
+
+void FdmMatrixFreeBlas3::residual(
+    const FdmMatrixFreeMatrix3& a,
+    const FdmVector3& x,
+    const FdmVector3& b,
+    FdmVector3* result) {
+    Size3 size = a.size();
+
+    JET_THROW_INVALID_ARG_IF(size != x.size());
+    JET_THROW_INVALID_ARG_IF(size != b.size());
+    JET_THROW_INVALID_ARG_IF(size != result->size());
+
+    applyLines(a, x, [&](size_t i, size_t j, size_t k, double ax) {
+        (*result)(i, j, k) = b(i, j, k) - ax;
+    });
+}
+
+double FdmMatrixFreeBlas3::l2Norm(const FdmVector3& v) {
+    return std::sqrt(dot(v, v));
+}
+
+double FdmMatrixFreeBlas3::lInfNorm(const FdmVector3& v) {
+    Size3 size = v.size();
+
+    double result = 0.0;
+
+    for (size_t k = 0; k < size.z; ++k) {
+        for (size_t j = 0; j < size.y; ++j) {
+            for (size_t i = 0; i < size.x; ++i) {
+                result = absmax(result, v(i, j, k));
+            }
+        }
+    }
+
+    return std::fabs(result);
+}
+
+double FdmMatrixFreeBlas3::mvmAndDot(
+    const FdmMatrixFreeMatrix3& m,
+    const FdmVector3& v,
+    FdmVector3* result) {
+    Size3 size = m.size();
+
+    JET_THROW_INVALID_ARG_IF(size != v.size());
+    JET_THROW_INVALID_ARG_IF(size != result->size());
+
+    std::vector<char> boundaryLine(size.x, FdmMatrixFreeMatrix3::Boundary);
+    std::vector<double> zeroLine(size.x, 0.0);
+    std::vector<double> partialSums(size.z, 0.0);
+
+    parallelFor(kZeroSize, size.z, [&](size_t k) {
+        double sum = 0.0;
+        for (size_t j = 0; j < size.y; ++j) {
+            double* r = &(*result)(0, j, k);
+            const double* v0 = &v(0, j, k);
+            applyLine(
+                m, v, boundaryLine, zeroLine, j, k, [&](size_t i, double mv) {
+                    r[i] = mv;
+                    sum += v0[i] * mv;
+                });
+        }
+        partialSums[k] = sum;
+    });
+
+    double vDotMv = 0.0;
+    for (double sum : partialSums) {
+        vDotMv += sum;
+    }
+
+    return vDotMv;
+}
+
+double FdmMatrixFreeBlas3::axpyAndSquaredL2Norm(
+    double a,
+    const FdmVector3& x,
+    const FdmVector3& y,
+    FdmVector3* result) {
+    Size3 size = x.size();
+
+    JET_THROW_INVALID_ARG_IF(size != y.size());
+    JET_THROW_INVALID_ARG_IF(size != result->size());
+
+    return parallelSum(size, [&](size_t i, size_t j, size_t k) {
+        double r = a * x(i, j, k) + y(i, j, k);
+        (*result)(i, j, k) = r;
+        return r * r;
+    });
+}
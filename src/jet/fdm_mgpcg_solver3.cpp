@@ -0,0 +1,340 @@
+// Copyright (c) 2016 Doyub Kim
+
+#include <pch.h>
+#include <jet/constants.h>
+#include <jet/cg.h>
+#include <jet/fdm_mgpcg_solver3.h>
+#include <algorithm>
+
+using namespace jet;
+
+static const double kDampingFactor = 2.0 / 3.0;
+static const double kCoarseningScale = 0.5;
+static const unsigned int kNumberOfCoarsestIterations = 20;
+static const size_t kMinCoarsestResolution = 4;
+
+// A cell is coupled if it has at least one non-zero off-diagonal entry. Air and
+// solid cells are stored as identity rows, so they are never coupled.
+inline bool isCoupled(
+    const ConstArrayAccessor3<FdmMatrixRow3>& A,
+    size_t i,
+    size_t j,
+    size_t k) {
+    const FdmMatrixRow3& row = A(i, j, k);
+    return row.right != 0.0 || row.up != 0.0 || row.front != 0.0
+        || (i > 0 && A(i - 1, j, k).right != 0.0)
+        || (j > 0 && A(i, j - 1, k).up != 0.0)
+        || (k > 0 && A(i, j, k - 1).front != 0.0);
+}
+
+inline double residualAt(
+    const ConstArrayAccessor3<FdmMatrixRow3>& A,
+    const FdmVector3& x,
+    const FdmVector3& b,
+    size_t i,
+    size_t j,
+    size_t k) {
+    Size3 size = A.size();
+    return b(i, j, k)
+        - A(i, j, k).center * x(i, j, k)
+        - ((i > 0) ? A(i - 1, j, k).right * x(i - 1, j, k) : 0.0)
+        - ((i + 1 < size.x) ? A(i, j, k).right * x(i + 1, j, k) : 0.0)
+        - ((j > 0) ? A(i, j - 1, k).up * x(i, j - 1, k) : 0.0)
+        - ((j + 1 < size.y) ? A(i, j, k).up * x(i, j + 1, k) : 0.0)
+        - ((k > 0) ? A(i, j, k - 1).front * x(i, j, k - 1) : 0.0)
+        - ((k + 1 < size.z) ? A(i, j, k).front * x(i, j, k + 1) : 0.0);
+}
+
+static void markCoupledCells(
+    const ConstArrayAccessor3<FdmMatrixRow3>& A,
+    Array3<char>* coupled) {
+    coupled->resize(A.size());
+    A.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        (*coupled)(i, j, k) = isCoupled(A, i, j, k) ? 1 : 0;
+    });
+}
+
+// Builds the Galerkin coarse matrix (P^T A P) where P injects each coarse cell
+// to its coupled 2x2x2 fine cells. Piecewise-constant aggregation makes the
+// coarse operator twice as stiff as the rediscretized one, so the result is
+// scaled by kCoarseningScale.
+static void buildCoarseMatrix(
+    const ConstArrayAccessor3<FdmMatrixRow3>& fineA,
+    const Array3<char>& fineCoupled,
+    FdmMatrix3* coarseA) {
+    Size3 fineSize = fineA.size();
+    coarseA->parallelForEachIndex([&](size_t ci, size_t cj, size_t ck) {
+        FdmMatrixRow3 coarseRow;
+
+        for (size_t k = 2 * ck; k < std::min(2 * ck + 2, fineSize.z); ++k) {
+            for (size_t j = 2 * cj; j < std::min(2 * cj + 2, fineSize.y); ++j) {
+                for (size_t i = 2 * ci;
+                     i < std::min(2 * ci + 2, fineSize.x); ++i) {
+                    if (!fineCoupled(i, j, k)) {
+                        continue;
+                    }
+
+                    const FdmMatrixRow3& row = fineA(i, j, k);
+                    coarseRow.center += row.center;
+
+                    if (i + 1 < fineSize.x && fineCoupled(i + 1, j, k)) {
+                        if ((i + 1) / 2 == ci) {
+                            coarseRow.center += 2.0 * row.right;
+                        } else {
+                            coarseRow.right += row.right;
+                        }
+                    }
+
+                    if (j + 1 < fineSize.y && fineCoupled(i, j + 1, k)) {
+                        if ((j + 1) / 2 == cj) {
+                            coarseRow.center += 2.0 * row.up;
+                        } else {
+                            coarseRow.up += row.up;
+                        }
+                    }
+
+                    if (k + 1 < fineSize.z && fineCoupled(i, j, k + 1)) {
+                        if ((k + 1) / 2 == ck) {
+                            coarseRow.center += 2.0 * row.front;
+                        } else {
+                            coarseRow.front += row.front;
+                        }
+                    }
+                }
+            }
+        }
+
+        coarseRow.center *= kCoarseningScale;
+        coarseRow.right *= kCoarseningScale;
+        coarseRow.up *= kCoarseningScale;
+        coarseRow.front *= kCoarseningScale;
+
+        // Coarse cell without any coupled fine cell
+        if (coarseRow.center == 0.0) {
+            coarseRow.center = 1.0;
+        }
+
+        (*coarseA)(ci, cj, ck) = coarseRow;
+    });
+}
+
+void FdmMgpcgSolver3::Preconditioner::build(const FdmMatrix3& matrix) {
+    A = matrix.constAccessor();
+
+    if (isReused) {
+        return;
+    }
+
+    Size3 size = matrix.size();
+    size_t numberOfLevels = 1;
+    while (numberOfLevels < maxNumberOfLevels
+           && std::max(std::max(size.x, size.y), size.z)
+               > kMinCoarsestResolution) {
+        size.x = (size.x + 1) / 2;
+        size.y = (size.y + 1) / 2;
+        size.z = (size.z + 1) / 2;
+        ++numberOfLevels;
+    }
+
+    levels.resize(numberOfLevels);
+
+    size = matrix.size();
+    for (size_t l = 0; l < numberOfLevels; ++l) {
+        Level& level = levels[l];
+
+        if (l > 0) {
+            Level& finer = levels[l - 1];
+
+            size.x = (size.x + 1) / 2;
+            size.y = (size.y + 1) / 2;
+            size.z = (size.z + 1) / 2;
+
+            level.A.resize(size);
+            buildCoarseMatrix(
+                this->matrix(l - 1), finer.coupled, &level.A);
+        }
+
+        markCoupledCells(this->matrix(l), &level.coupled);
+
+        level.x.resize(size, 0.0);
+        level.b.resize(size, 0.0);
+        level.r.resize(size, 0.0);
+        level.xTemp.resize(size, 0.0);
+    }
+}
+
+void FdmMgpcgSolver3::Preconditioner::solve(
+    const FdmVector3& b,
+    FdmVector3* x) {
+    levels[0].b.set(b);
+    vcycle(0);
+    x->set(levels[0].x);
+}
+
+ConstArrayAccessor3<FdmMatrixRow3>
+FdmMgpcgSolver3::Preconditioner::matrix(size_t level) const {
+    return (level == 0) ? A : levels[level].A.constAccessor();
+}
+
+void FdmMgpcgSolver3::Preconditioner::relax(
+    size_t level,
+    unsigned int numberOfIterations) {
+    Level& lv = levels[level];
+    auto m = matrix(level);
+
+    for (unsigned int iter = 0; iter < numberOfIterations; ++iter) {
+        const FdmVector3& x = lv.x;
+        FdmVector3& xTemp = lv.xTemp;
+        const FdmVector3& b = lv.b;
+
+        m.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+            if (!lv.coupled(i, j, k)) {
+                // Decoupled rows can be solved exactly
+                xTemp(i, j, k) = b(i, j, k) / m(i, j, k).center;
+                return;
+            }
+
+            double r = residualAt(m, x, b, i, j, k);
+            xTemp(i, j, k)
+                = x(i, j, k) + kDampingFactor * r / m(i, j, k).center;
+        });
+
+        lv.x.swap(lv.xTemp);
+    }
+}
+
+void FdmMgpcgSolver3::Preconditioner::vcycle(size_t level) {
+    Level& lv = levels[level];
+    lv.x.set(0.0);
+
+    // Coarsest level
+    if (level + 1 == levels.size()) {
+        relax(level, kNumberOfCoarsestIterations);
+        return;
+    }
+
+    // Pre-smoothing
+    relax(level, numberOfSmoothingIterations);
+
+    // Restrict the residual to the coarser level
+    auto m = matrix(level);
+    lv.r.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        lv.r(i, j, k) = residualAt(m, lv.x, lv.b, i, j, k);
+    });
+
+    Level& coarser = levels[level + 1];
+    Size3 size = lv.x.size();
+    coarser.b.parallelForEachIndex([&](size_t ci, size_t cj, size_t ck) {
+        double sum = 0.0;
+        for (size_t k = 2 * ck; k < std::min(2 * ck + 2, size.z); ++k) {
+            for (size_t j = 2 * cj; j < std::min(2 * cj + 2, size.y); ++j) {
+                for (size_t i = 2 * ci; i < std::min(2 * ci + 2, size.x); ++i) {
+                    if (lv.coupled(i, j, k)) {
+                        sum += lv.r(i, j, k);
+                    }
+                }
+            }
+        }
+        coarser.b(ci, cj, ck) = sum;
+    });
+
+    vcycle(level + 1);
+
+    // Prolongate the coarse correction
+    lv.x.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        if (lv.coupled(i, j, k)) {
+            lv.x(i, j, k) += coarser.x(i / 2, j / 2, k / 2);
+        }
+    });
+
+    // Post-smoothing
+    relax(level, numberOfSmoothingIterations);
+}
+
+FdmMgpcgSolver3::FdmMgpcgSolver3(
+    unsigned int maxNumberOfIterations,
+    double tolerance,
+    unsigned int maxNumberOfLevels,
+    unsigned int numberOfSmoothingIterations) :
+    _maxNumberOfIterations(maxNumberOfIterations),
+    _lastNumberOfIterations(0),
+    _tolerance(tolerance),
+    _lastResidualNorm(kMaxD) {
+    _precond.maxNumberOfLevels = std::max(maxNumberOfLevels, 1u);
+    _precond.numberOfSmoothingIterations = numberOfSmoothingIterations;
+}
+
+bool FdmMgpcgSolver3::solve(FdmLinearSystem3* system) {
+    StatsMonitor monitor(this);
+
+    FdmMatrix3& matrix = system->A;
+    FdmVector3& solution = system->x;
+    FdmVector3& rhs = system->b;
+
+    JET_ASSERT(matrix.size() == rhs.size());
+    JET_ASSERT(matrix.size() == solution.size());
+
+    Size3 size = matrix.size();
+    _r.resize(size);
+    _d.resize(size);
+    _q.resize(size);
+    _s.resize(size);
+
+    if (!isUsingWarmStart()) {
+        system->x.set(0.0);
+    }
+
+    // pcg() builds the hierarchy unless it can be reused
+    _precond.isReused
+        = isReusingMatrix()
+        && !_precond.levels.empty()
+        && _precond.levels[0].x.size() == size;
+
+    pcg<FdmBlas3, Preconditioner>(
+        matrix,
+        rhs,
+        _maxNumberOfIterations,
+        _tolerance,
+        &_precond,
+        &solution,
+        &_r,
+        &_d,
+        &_q,
+        &_s,
+        &_lastNumberOfIterations,
+        &_lastResidualNorm,
+        &monitor);
+
+    monitor.end(_lastNumberOfIterations, _lastResidualNorm);
+
+    JET_INFO << "Residual norm after solving MGPCG: " << _lastResidualNorm
+             << " Number of MGPCG iterations: " << _lastNumberOfIterations;
+
+    return _lastResidualNorm <= _tolerance
+        || (_lastNumberOfIterations < _maxNumberOfIterations
+            && !stats().isStagnated);
+}
+
+unsigned int FdmMgpcgSolver3::maxNumberOfIterations() const {
+    return _maxNumberOfIterations;
+}
+
+unsigned int FdmMgpcgSolver3::lastNumberOfIterations() const {
+    return _lastNumberOfIterations;
+}
+
+double FdmMgpcgSolver3::tolerance() const {
+    return _tolerance;
+}
+
+double FdmMgpcgSolver3::lastResidual() const {
+    return _lastResidualNorm;
+}
+
+unsigned int FdmMgpcgSolver3::maxNumberOfLevels() const {
+    return _precond.maxNumberOfLevels;
+}
+
+unsigned int FdmMgpcgSolver3::numberOfSmoothingIterations() const {
+    return _precond.numberOfSmoothingIterations;
+}
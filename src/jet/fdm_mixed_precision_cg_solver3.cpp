@@ -0,0 +1,144 @@
+// Copyright (c) 2016 Doyub Kim
+
+#include <pch.h>
+#include <jet/constants.h>
+#include <jet/cg.h>
+#include <jet/fdm_mixed_precision_cg_solver3.h>
+#include <algorithm>
+
+using namespace jet;
+
+FdmMixedPrecisionCgSolver3::FdmMixedPrecisionCgSolver3(
+    unsigned int maxNumberOfIterations,
+    double tolerance,
+    double innerTolerance) :
+    _maxNumberOfIterations(maxNumberOfIterations),
+    _lastNumberOfIterations(0),
+    _lastNumberOfRefinements(0),
+    _tolerance(tolerance),
+    _innerTolerance(innerTolerance),
+    _lastResidual(kMaxD) {
+}
+
+bool FdmMixedPrecisionCgSolver3::solve(FdmLinearSystem3* system) {
+    StatsMonitor monitor(this);
+
+    FdmMatrix3& matrix = system->A;
+    FdmVector3& solution = system->x;
+    FdmVector3& rhs = system->b;
+
+    JET_ASSERT(matrix.size() == rhs.size());
+    JET_ASSERT(matrix.size() == solution.size());
+
+    Size3 size = matrix.size();
+    _b.resize(size);
+    _e.resize(size);
+    _r.resize(size);
+    _d.resize(size);
+    _q.resize(size);
+    _s.resize(size);
+    _residual.resize(size);
+
+    if (!isUsingWarmStart()) {
+        system->x.set(0.0);
+    }
+
+    if (!isReusingMatrix() || _matrix.size() != size) {
+        BlasType::convert(matrix, &_matrix);
+    }
+
+    // There is no preconditioner, so the iterations begin right away
+    monitor.beginPreconditionerBuild();
+    monitor.beginIterations();
+
+    _lastNumberOfIterations = 0;
+    _lastNumberOfRefinements = 0;
+
+    FdmBlas3::residual(matrix, solution, rhs, &_residual);
+    _lastResidual = FdmBlas3::l2Norm(_residual);
+
+    while (_lastResidual > _tolerance
+        && _lastNumberOfIterations < _maxNumberOfIterations) {
+        // Normalize the residual so that the single-precision solve always
+        // works with the values around one
+        double scale = _lastResidual;
+        _residual.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+            _b(i, j, k) = static_cast<float>(_residual(i, j, k) / scale);
+        });
+        _e.set(0.0f);
+
+        // Ae = r / scale
+        unsigned int numberOfIterations = 0;
+        double innerResidual = 0.0;
+        cg<BlasType>(
+            _matrix,
+            _b,
+            _maxNumberOfIterations - _lastNumberOfIterations,
+            std::max(_innerTolerance, _tolerance / scale),
+            &_e,
+            &_r,
+            &_d,
+            &_q,
+            &_s,
+            &numberOfIterations,
+            &innerResidual);
+
+        _lastNumberOfIterations += numberOfIterations;
+        ++_lastNumberOfRefinements;
+
+        // x = x + scale * e
+        solution.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+            solution(i, j, k) += scale * static_cast<double>(_e(i, j, k));
+        });
+
+        // r = b - Ax in double precision
+        FdmBlas3::residual(matrix, solution, rhs, &_residual);
+        _lastResidual = FdmBlas3::l2Norm(_residual);
+
+        // Stop if the single-precision solve cannot reduce the residual
+        if (numberOfIterations == 0 || _lastResidual >= scale) {
+            break;
+        }
+
+        if (!monitor.onIteration(
+                _lastNumberOfRefinements, _lastResidual * _lastResidual)) {
+            break;
+        }
+    }
+
+    monitor.end(_lastNumberOfIterations, _lastResidual);
+
+    JET_INFO << "Residual norm after solving mixed-precision CG: "
+             << _lastResidual
+             << " Number of mixed-precision CG iterations: "
+             << _lastNumberOfIterations
+             << " Number of refinements: " << _lastNumberOfRefinements;
+
+    // Unlike FdmCgSolver3, running out of refinements before the max number
+    // of iterations means the residual has stalled, so it is not a success
+    return _lastResidual <= _tolerance;
+}
+
+unsigned int FdmMixedPrecisionCgSolver3::maxNumberOfIterations() const {
+    return _maxNumberOfIterations;
+}
+
+unsigned int FdmMixedPrecisionCgSolver3::lastNumberOfIterations() const {
+    return _lastNumberOfIterations;
+}
+
+double FdmMixedPrecisionCgSolver3::tolerance() const {
+    return _tolerance;
+}
+
+double FdmMixedPrecisionCgSolver3::lastResidual() const {
+    return _lastResidual;
+}
+
+double FdmMixedPrecisionCgSolver3::innerTolerance() const {
+    return _innerTolerance;
+}
+
+unsigned int FdmMixedPrecisionCgSolver3::lastNumberOfRefinements() const {
+    return _lastNumberOfRefinements;
+}
@@ -0,0 +1,199 @@
+// Copyright (c) 2016 Doyub Kim
+
+#include <pch.h>
+#include <jet/constants.h>
+#include <jet/cg.h>
+#include <jet/fdm_parallel_iccg_solver3.h>
+#include <jet/parallel.h>
+#include <algorithm>
+
+using namespace jet;
+
+template <typename Callback>
+void FdmParallelIccgSolver3::Preconditioner::forEachLineInWavefront(
+    bool reverse,
+    const Callback& func) {
+    Size3 size = A.size();
+    if (size.x == 0 || size.y == 0 || size.z == 0) {
+        return;
+    }
+
+    size_t numberOfBlocksY = (size.y + blockSizeY - 1) / blockSizeY;
+    size_t numberOfBlocksZ = (size.z + blockSizeZ - 1) / blockSizeZ;
+    size_t numberOfPlanes = numberOfBlocksY + numberOfBlocksZ - 1;
+
+    for (size_t n = 0; n < numberOfPlanes; ++n) {
+        size_t plane = reverse ? numberOfPlanes - 1 - n : n;
+        size_t kbBegin
+            = (plane + 1 > numberOfBlocksY) ? plane + 1 - numberOfBlocksY : 0;
+        size_t kbEnd = std::min(plane + 1, numberOfBlocksZ);
+
+        // Blocks on the same hyperplane do not depend on each other
+        parallelFor(kbBegin, kbEnd, [&](size_t kb) {
+            size_t jb = plane - kb;
+            size_t jBegin = jb * blockSizeY;
+            size_t jEnd = std::min(jBegin + blockSizeY, size.y);
+            size_t kBegin = kb * blockSizeZ;
+            size_t kEnd = std::min(kBegin + blockSizeZ, size.z);
+
+            if (reverse) {
+                for (size_t k = kEnd; k > kBegin; --k) {
+                    for (size_t j = jEnd; j > jBegin; --j) {
+                        func(j - 1, k - 1);
+                    }
+                }
+            } else {
+                for (size_t k = kBegin; k < kEnd; ++k) {
+                    for (size_t j = jBegin; j < jEnd; ++j) {
+                        func(j, k);
+                    }
+                }
+            }
+        });
+    }
+}
+
+void FdmParallelIccgSolver3::Preconditioner::build(const FdmMatrix3& matrix) {
+    Size3 size = matrix.size();
+    A = matrix.constAccessor();
+
+    if (isReused) {
+        return;
+    }
+
+    d.resize(size, 0.0);
+    y.resize(size, 0.0);
+
+    // Make roughly twice as many blocks as the threads along each axis so that
+    // the hyperplanes in the middle can keep all the threads busy.
+    size_t numberOfBlocks = 2 * static_cast<size_t>(maxNumberOfThreads());
+    blockSizeY = std::max(
+        (size.y + numberOfBlocks - 1) / numberOfBlocks, kOneSize);
+    blockSizeZ = std::max(
+        (size.z + numberOfBlocks - 1) / numberOfBlocks, kOneSize);
+
+    forEachLineInWavefront(false, [&](size_t j, size_t k) {
+        for (size_t i = 0; i < size.x; ++i) {
+            double denom
+                = matrix(i, j, k).center
+                - ((i > 0) ?
+                    square(matrix(i - 1, j, k).right) * d(i - 1, j, k) : 0.0)
+                - ((j > 0) ?
+                    square(matrix(i, j - 1, k).up)    * d(i, j - 1, k) : 0.0)
+                - ((k > 0) ?
+                    square(matrix(i, j, k - 1).front) * d(i, j, k - 1) : 0.0);
+
+            if (std::fabs(denom) > 0.0) {
+                d(i, j, k) = 1.0 / denom;
+            } else {
+                d(i, j, k) = 0.0;
+            }
+        }
+    });
+}
+
+void FdmParallelIccgSolver3::Preconditioner::solve(
+    const FdmVector3& b,
+    FdmVector3* x) {
+    Size3 size = b.size();
+
+    forEachLineInWavefront(false, [&](size_t j, size_t k) {
+        for (size_t i = 0; i < size.x; ++i) {
+            y(i, j, k)
+                = (b(i, j, k)
+                - ((i > 0) ? A(i - 1, j, k).right * y(i - 1, j, k) : 0.0)
+                - ((j > 0) ? A(i, j - 1, k).up    * y(i, j - 1, k) : 0.0)
+                - ((k > 0) ? A(i, j, k - 1).front * y(i, j, k - 1) : 0.0))
+                * d(i, j, k);
+        }
+    });
+
+    forEachLineInWavefront(true, [&](size_t j, size_t k) {
+        for (size_t i = size.x; i > 0; --i) {
+            (*x)(i - 1, j, k)
+                = (y(i - 1, j, k)
+                - ((i < size.x) ?
+                    A(i - 1, j, k).right * (*x)(i, j, k) : 0.0)
+                - ((j + 1 < size.y) ?
+                    A(i - 1, j, k).up    * (*x)(i - 1, j + 1, k) : 0.0)
+                - ((k + 1 < size.z) ?
+                    A(i - 1, j, k).front * (*x)(i - 1, j, k + 1) : 0.0))
+                * d(i - 1, j, k);
+        }
+    });
+}
+
+FdmParallelIccgSolver3::FdmParallelIccgSolver3(
+    unsigned int maxNumberOfIterations,
+    double tolerance) :
+    _maxNumberOfIterations(maxNumberOfIterations),
+    _lastNumberOfIterations(0),
+    _tolerance(tolerance),
+    _lastResidualNorm(kMaxD) {
+}
+
+bool FdmParallelIccgSolver3::solve(FdmLinearSystem3* system) {
+    StatsMonitor monitor(this);
+
+    FdmMatrix3& matrix = system->A;
+    FdmVector3& solution = system->x;
+    FdmVector3& rhs = system->b;
+
+    JET_ASSERT(matrix.size() == rhs.size());
+    JET_ASSERT(matrix.size() == solution.size());
+
+    Size3 size = matrix.size();
+    _r.resize(size);
+    _d.resize(size);
+    _q.resize(size);
+    _s.resize(size);
+
+    if (!isUsingWarmStart()) {
+        system->x.set(0.0);
+    }
+
+    // pcg() builds the preconditioner unless it can be reused
+    _precond.isReused = isReusingMatrix() && _precond.d.size() == size;
+
+    pcg<FdmBlas3, Preconditioner>(
+        matrix,
+        rhs,
+        _maxNumberOfIterations,
+        _tolerance,
+        &_precond,
+        &solution,
+        &_r,
+        &_d,
+        &_q,
+        &_s,
+        &_lastNumberOfIterations,
+        &_lastResidualNorm,
+        &monitor);
+
+    monitor.end(_lastNumberOfIterations, _lastResidualNorm);
+
+    JET_INFO << "Residual norm after solving parallel ICCG: "
+             << _lastResidualNorm
+             << " Number of parallel ICCG iterations: "
+             << _lastNumberOfIterations;
+
+    return _lastResidualNorm <= _tolerance
+        || (_lastNumberOfIterations < _maxNumberOfIterations
+            && !stats().isStagnated);
+}
+
+unsigned int FdmParallelIccgSolver3::maxNumberOfIterations() const {
+    return _maxNumberOfIterations;
+}
+
+unsigned int FdmParallelIccgSolver3::lastNumberOfIterations() const {
+    return _lastNumberOfIterations;
+}
+
+double FdmParallelIccgSolver3::tolerance() const {
+    return _tolerance;
+}
+
+double FdmParallelIccgSolver3::lastResidual() const {
+    return _lastResidualNorm;
+}
@@ -25,6 +25,15 @@ void GridBackwardEulerDiffusionSolver3::solve(
     ScalarGrid3* dest,
     const ScalarField3& boundarySdf,
     const ScalarField3& fluidSdf) {
+    if (_systemSolver == nullptr) {
+        // Nothing to solve, so pass the source through
+        source.parallelForEachDataPointIndex(
+            [&](size_t i, size_t j, size_t k) {
+                (*dest)(i, j, k) = source(i, j, k);
+            });
+        return;
+    }
+
     auto pos = source.dataPosition();
     Vector3D h = source.gridSpacing();
     Vector3D c = timeIntervalInSeconds * diffusionCoefficient / (h * h);
@@ -35,7 +44,7 @@ void GridBackwardEulerDiffusionSolver3::solve(
 
     if (_systemSolver != nullptr) {
         // Solve the system
-        _systemSolver->solve(&_system);
+        solveSystem();
 
         // Assign the solution
         source.parallelForEachDataPointIndex(
@@ -52,6 +61,15 @@ void GridBackwardEulerDiffusionSolver3::solve(
     CollocatedVectorGrid3* dest,
     const ScalarField3& boundarySdf,
     const ScalarField3& fluidSdf) {
+    if (_systemSolver == nullptr) {
+        // Nothing to solve, so pass the source through
+        source.parallelForEachDataPointIndex(
+            [&](size_t i, size_t j, size_t k) {
+                (*dest)(i, j, k) = source(i, j, k);
+            });
+        return;
+    }
+
     auto pos = source.dataPosition();
     Vector3D h = source.gridSpacing();
     Vector3D c = timeIntervalInSeconds * diffusionCoefficient / (h * h);
@@ -64,7 +82,7 @@ void GridBackwardEulerDiffusionSolver3::solve(
 
     if (_systemSolver != nullptr) {
         // Solve the system
-        _systemSolver->solve(&_system);
+        solveSystem();
 
         // Assign the solution
         source.parallelForEachDataPointIndex(
@@ -78,7 +96,7 @@ void GridBackwardEulerDiffusionSolver3::solve(
 
     if (_systemSolver != nullptr) {
         // Solve the system
-        _systemSolver->solve(&_system);
+        solveSystem();
 
         // Assign the solution
         source.parallelForEachDataPointIndex(
@@ -92,7 +110,7 @@ void GridBackwardEulerDiffusionSolver3::solve(
 
     if (_systemSolver != nullptr) {
         // Solve the system
-        _systemSolver->solve(&_system);
+        solveSystem();
 
         // Assign the solution
         source.parallelForEachDataPointIndex(
@@ -109,6 +127,20 @@ void GridBackwardEulerDiffusionSolver3::solve(
     FaceCenteredGrid3* dest,
     const ScalarField3& boundarySdf,
     const ScalarField3& fluidSdf) {
+    if (_systemSolver == nullptr) {
+        // Nothing to solve, so pass the source through
+        source.parallelForEachUIndex([&](size_t i, size_t j, size_t k) {
+            dest->u(i, j, k) = source.u(i, j, k);
+        });
+        source.parallelForEachVIndex([&](size_t i, size_t j, size_t k) {
+            dest->v(i, j, k) = source.v(i, j, k);
+        });
+        source.parallelForEachWIndex([&](size_t i, size_t j, size_t k) {
+            dest->w(i, j, k) = source.w(i, j, k);
+        });
+        return;
+    }
+
     Vector3D h = source.gridSpacing();
     Vector3D c = timeIntervalInSeconds * diffusionCoefficient / (h * h);
 
@@ -120,7 +152,7 @@ void GridBackwardEulerDiffusionSolver3::solve(
 
     if (_systemSolver != nullptr) {
         // Solve the system
-        _systemSolver->solve(&_system);
+        solveSystem();
 
         // Assign the solution
         source.parallelForEachUIndex(
@@ -137,7 +169,7 @@ void GridBackwardEulerDiffusionSolver3::solve(
 
     if (_systemSolver != nullptr) {
         // Solve the system
-        _systemSolver->solve(&_system);
+        solveSystem();
 
         // Assign the solution
         source.parallelForEachVIndex(
@@ -154,7 +186,7 @@ void GridBackwardEulerDiffusionSolver3::solve(
 
     if (_systemSolver != nullptr) {
         // Solve the system
-        _systemSolver->solve(&_system);
+        solveSystem();
 
         // Assign the solution
         source.parallelForEachWIndex(
@@ -169,6 +201,15 @@ void GridBackwardEulerDiffusionSolver3::setLinearSystemSolver(
     _systemSolver = solver;
 }
 
+bool GridBackwardEulerDiffusionSolver3::isUsingCompressedLinearSystem() const {
+    return _isUsingCompressedLinearSystem;
+}
+
+void GridBackwardEulerDiffusionSolver3::setIsUsingCompressedLinearSystem(
+    bool isUsing) {
+    _isUsingCompressedLinearSystem = isUsing;
+}
+
 void GridBackwardEulerDiffusionSolver3::buildMarkers(
     const Size3& size,
     const std::function<Vector3D(size_t, size_t, size_t)>& pos,
@@ -190,72 +231,98 @@ void GridBackwardEulerDiffusionSolver3::buildMarkers(
 void GridBackwardEulerDiffusionSolver3::buildMatrix(
     const Size3& size,
     const Vector3D& c) {
-    _system.A.resize(size);
+    if (isSolvingCompressedSystem()) {
+        // Build linear system for the fluid points only
+        _compSystem.build(
+            size,
+            [&](size_t i, size_t j, size_t k) {
+                return _markers(i, j, k) == kFluid;
+            },
+            [&](size_t i,
+                size_t j,
+                size_t k,
+                FdmMatrixRow3* row,
+                double* rhs) {
+                buildMatrixRow(size, c, i, j, k, row);
+                *rhs = 0.0;
+            });
+        return;
+    }
 
-    bool isDirichlet = (_boundaryType == Dirichlet);
+    _system.A.resize(size);
 
     // Build linear system
     _system.A.parallelForEachIndex(
         [&](size_t i, size_t j, size_t k) {
-            auto& row = _system.A(i, j, k);
-
-            // Initialize
-            row.center = 1.0;
-            row.right = row.up = row.front = 0.0;
-
-            if (_markers(i, j, k) == kFluid) {
-                if (i + 1 < size.x) {
-                    if ((isDirichlet && _markers(i + 1, j, k) != kAir)
-                         || _markers(i + 1, j, k) == kFluid) {
-                        row.center += c.x;
-                    }
-
-                    if (_markers(i + 1, j, k) == kFluid) {
-                        row.right -=  c.x;
-                    }
-                }
+            buildMatrixRow(size, c, i, j, k, &_system.A(i, j, k));
+        });
+}
 
-                if (i > 0
-                    && ((isDirichlet && _markers(i - 1, j, k) != kAir)
-                        || _markers(i - 1, j, k) == kFluid)) {
-                    row.center += c.x;
-                }
+void GridBackwardEulerDiffusionSolver3::buildMatrixRow(
+    const Size3& size,
+    const Vector3D& c,
+    size_t i,
+    size_t j,
+    size_t k,
+    FdmMatrixRow3* row) const {
+    bool isDirichlet = (_boundaryType == Dirichlet);
 
-                if (j + 1 < size.y) {
-                    if ((isDirichlet && _markers(i, j + 1, k) != kAir)
-                         || _markers(i, j + 1, k) == kFluid) {
-                        row.center += c.y;
-                    }
+    // Initialize
+    row->center = 1.0;
+    row->right = row->up = row->front = 0.0;
 
-                    if (_markers(i, j + 1, k) == kFluid) {
-                        row.up -=  c.y;
-                    }
-                }
+    if (_markers(i, j, k) == kFluid) {
+        if (i + 1 < size.x) {
+            if ((isDirichlet && _markers(i + 1, j, k) != kAir)
+                 || _markers(i + 1, j, k) == kFluid) {
+                row->center += c.x;
+            }
 
-                if (j > 0
-                    && ((isDirichlet && _markers(i, j - 1, k) != kAir)
-                        || _markers(i, j - 1, k) == kFluid)) {
-                    row.center += c.y;
-                }
+            if (_markers(i + 1, j, k) == kFluid) {
+                row->right -=  c.x;
+            }
+        }
 
-                if (k + 1 < size.z) {
-                    if ((isDirichlet && _markers(i, j, k + 1) != kAir)
-                         || _markers(i, j, k + 1) == kFluid) {
-                        row.center += c.z;
-                    }
+        if (i > 0
+            && ((isDirichlet && _markers(i - 1, j, k) != kAir)
+                || _markers(i - 1, j, k) == kFluid)) {
+            row->center += c.x;
+        }
 
-                    if (_markers(i, j, k + 1) == kFluid) {
-                        row.front -=  c.z;
-                    }
-                }
+        if (j + 1 < size.y) {
+            if ((isDirichlet && _markers(i, j + 1, k) != kAir)
+                 || _markers(i, j + 1, k) == kFluid) {
+                row->center += c.y;
+            }
 
-                if (k > 0
-                    && ((isDirichlet && _markers(i, j, k - 1) != kAir)
-                        || _markers(i, j, k - 1) == kFluid)) {
-                    row.center += c.z;
-                }
+            if (_markers(i, j + 1, k) == kFluid) {
+                row->up -=  c.y;
             }
-        });
+        }
+
+        if (j > 0
+            && ((isDirichlet && _markers(i, j - 1, k) != kAir)
+                || _markers(i, j - 1, k) == kFluid)) {
+            row->center += c.y;
+        }
+
+        if (k + 1 < size.z) {
+            if ((isDirichlet && _markers(i, j, k + 1) != kAir)
+                 || _markers(i, j, k + 1) == kFluid) {
+                row->center += c.z;
+            }
+
+            if (_markers(i, j, k + 1) == kFluid) {
+                row->front -=  c.z;
+            }
+        }
+
+        if (k > 0
+            && ((isDirichlet && _markers(i, j, k - 1) != kAir)
+                || _markers(i, j, k - 1) == kFluid)) {
+            row->center += c.z;
+        }
+    }
 }
 
 void GridBackwardEulerDiffusionSolver3::buildVectors(
@@ -340,3 +407,31 @@ void GridBackwardEulerDiffusionSolver3::buildVectors(
             }
         });
 }
+
+void GridBackwardEulerDiffusionSolver3::solveSystem() {
+    if (isSolvingCompressedSystem()) {
+        const auto& coords = _compSystem.indexToCoord;
+        coords.parallelForEachIndex([&](size_t idx) {
+            const Point3UI& pt = coords[idx];
+            _compSystem.b[idx] = _system.b(pt.x, pt.y, pt.z);
+            _compSystem.x[idx] = _system.x(pt.x, pt.y, pt.z);
+        });
+
+        _systemSolver->solveCompressed(&_compSystem);
+
+        // Non-fluid points keep the source values (identity rows)
+        coords.parallelForEachIndex([&](size_t idx) {
+            const Point3UI& pt = coords[idx];
+            _system.x(pt.x, pt.y, pt.z) = _compSystem.x[idx];
+        });
+        return;
+    }
+
+    _systemSolver->solve(&_system);
+}
+
+bool GridBackwardEulerDiffusionSolver3::isSolvingCompressedSystem() const {
+    return _isUsingCompressedLinearSystem
+        && _systemSolver != nullptr
+        && _systemSolver->isSupportingCompressedSystem();
+}
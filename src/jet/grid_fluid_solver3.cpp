@@ -10,9 +10,9 @@
 #include <jet/grid_fluid_solver3.h>
 #include <jet/grid_fractional_single_phase_pressure_solver3.h>
 #include <jet/level_set_utils.h>
-#include <jet/surface_to_implicit3.h>
 #include <jet/timer.h>
 #include <algorithm>
+#include <vector>
 
 using namespace jet;
 
@@ -205,26 +205,28 @@ void GridFluidSolver3::computeExternalForces(double timeIntervalInSeconds) {
 void GridFluidSolver3::computeViscosity(double timeIntervalInSeconds) {
     if (_diffusionSolver != nullptr && _viscosityCoefficient > kEpsilonD) {
         auto vel = velocity();
-        auto vel0 = std::dynamic_pointer_cast<FaceCenteredGrid3>(vel->clone());
+        auto vel1 = _grids->velocityBackBuffer();
 
         _diffusionSolver->solve(
-            *vel0,
+            *vel,
             _viscosityCoefficient,
             timeIntervalInSeconds,
-            vel.get(),
+            vel1.get(),
             _colliderSdf,
             *fluidSdf());
+        _grids->swapVelocityBuffers();
         applyBoundaryCondition();
     }
 }
 
 void GridFluidSolver3::computePressure(double timeIntervalInSeconds) {
     if (_pressureSolver != nullptr) {
+        // The pressure gradient only updates each face from its own value, so
+        // the projection runs in place.
         auto vel = velocity();
-        auto vel0 = std::dynamic_pointer_cast<FaceCenteredGrid3>(vel->clone());
 
         _pressureSolver->solve(
-            *vel0,
+            *vel,
             timeIntervalInSeconds,
             vel.get(),
             _colliderSdf,
@@ -236,65 +238,89 @@ void GridFluidSolver3::computePressure(double timeIntervalInSeconds) {
 void GridFluidSolver3::computeAdvection(double timeIntervalInSeconds) {
     auto vel = velocity();
     if (_advectionSolver != nullptr) {
-        // Solve advections for custom scalar fields
+        std::vector<const ScalarGrid3*> scalarInputs;
+        std::vector<ScalarGrid3*> scalarOutputs;
+        std::vector<const CollocatedVectorGrid3*> collocatedInputs;
+        std::vector<CollocatedVectorGrid3*> collocatedOutputs;
+        std::vector<const FaceCenteredGrid3*> faceCenteredInputs;
+        std::vector<FaceCenteredGrid3*> faceCenteredOutputs;
+        std::vector<size_t> vectorDataIds;
+
+        // Custom scalar fields
         size_t n = _grids->numberOfAdvectableScalarData();
         for (size_t i = 0; i < n; ++i) {
-            auto grid = _grids->advectableScalarDataAt(i);
-            auto grid0 = grid->clone();
-            _advectionSolver->advect(
-                *grid0,
-                *vel,
-                timeIntervalInSeconds,
-                grid.get(),
-                _colliderSdf);
-            extrapolateIntoCollider(grid.get());
+            scalarInputs.push_back(_grids->advectableScalarDataAt(i).get());
+            scalarOutputs.push_back(
+                _grids->advectableScalarDataBackBufferAt(i).get());
         }
 
-        // Solve advections for custom vector fields
+        // Custom vector fields
         n = _grids->numberOfAdvectableVectorData();
         for (size_t i = 0; i < n; ++i) {
             auto grid = _grids->advectableVectorDataAt(i);
-            auto grid0 = grid->clone();
+            auto grid1 = _grids->advectableVectorDataBackBufferAt(i);
 
             auto collocated
                 = std::dynamic_pointer_cast<CollocatedVectorGrid3>(grid);
-            auto collocated0
-                = std::dynamic_pointer_cast<CollocatedVectorGrid3>(grid0);
-            if (collocated != nullptr) {
-                _advectionSolver->advect(
-                    *collocated0,
-                    *vel,
-                    timeIntervalInSeconds,
-                    collocated.get(),
-                    _colliderSdf);
-                extrapolateIntoCollider(collocated.get());
+            auto collocated1
+                = std::dynamic_pointer_cast<CollocatedVectorGrid3>(grid1);
+            if (collocated != nullptr && collocated1 != nullptr) {
+                collocatedInputs.push_back(collocated.get());
+                collocatedOutputs.push_back(collocated1.get());
+                vectorDataIds.push_back(i);
                 continue;
             }
 
             auto faceCentered
                 = std::dynamic_pointer_cast<FaceCenteredGrid3>(grid);
-            auto faceCentered0
-                = std::dynamic_pointer_cast<FaceCenteredGrid3>(grid0);
-            if (faceCentered != nullptr && faceCentered0 != nullptr) {
-                _advectionSolver->advect(
-                    *faceCentered0,
-                    *vel,
-                    timeIntervalInSeconds,
-                    faceCentered.get(),
-                    _colliderSdf);
-                extrapolateIntoCollider(faceCentered.get());
+            auto faceCentered1
+                = std::dynamic_pointer_cast<FaceCenteredGrid3>(grid1);
+            if (faceCentered != nullptr && faceCentered1 != nullptr) {
+                faceCenteredInputs.push_back(faceCentered.get());
+                faceCenteredOutputs.push_back(faceCentered1.get());
+                vectorDataIds.push_back(i);
                 continue;
             }
         }
 
-        // Solve velocity advection
-        auto vel0 = std::dynamic_pointer_cast<FaceCenteredGrid3>(vel->clone());
-        _advectionSolver->advect(
-            *vel0,
-            *vel0,
+        // Velocity field itself
+        faceCenteredInputs.push_back(vel.get());
+        faceCenteredOutputs.push_back(_grids->velocityBackBuffer().get());
+
+        // Advect all the fields together so that the solver can share the
+        // back-tracing among the fields with the same data layout.
+        _advectionSolver->advectBatch(
+            scalarInputs,
+            collocatedInputs,
+            faceCenteredInputs,
+            *vel,
             timeIntervalInSeconds,
-            vel.get(),
-            _colliderSdf);
+            scalarOutputs,
+            collocatedOutputs,
+            faceCenteredOutputs,
+            advectionBoundarySdf());
+
+        n = _grids->numberOfAdvectableScalarData();
+        for (size_t i = 0; i < n; ++i) {
+            _grids->swapAdvectableScalarDataBuffersAt(i);
+            extrapolateIntoCollider(_grids->advectableScalarDataAt(i).get());
+        }
+
+        for (size_t i : vectorDataIds) {
+            _grids->swapAdvectableVectorDataBuffersAt(i);
+
+            auto grid = _grids->advectableVectorDataAt(i);
+            auto collocated
+                = std::dynamic_pointer_cast<CollocatedVectorGrid3>(grid);
+            if (collocated != nullptr) {
+                extrapolateIntoCollider(collocated.get());
+            } else {
+                extrapolateIntoCollider(
+                    std::dynamic_pointer_cast<FaceCenteredGrid3>(grid).get());
+            }
+        }
+
+        _grids->swapVelocityBuffers();
         applyBoundaryCondition();
     }
 }
@@ -303,6 +329,10 @@ ScalarField3Ptr GridFluidSolver3::fluidSdf() const {
     return std::make_shared<ConstantScalarField3>(-kMaxD);
 }
 
+const ScalarField3& GridFluidSolver3::advectionBoundarySdf() const {
+    return _colliderSdf;
+}
+
 void GridFluidSolver3::computeGravity(double timeIntervalInSeconds) {
     if (_gravity.lengthSquared() > kEpsilonD) {
         auto vel = _grids->velocity();
@@ -424,24 +454,23 @@ void GridFluidSolver3::beginAdvanceTimeStep(double timeIntervalInSeconds) {
     Vector3D h = _grids->gridSpacing();
     Vector3D o = _grids->origin();
 
-    // Reserve memory
-    _colliderSdf.resize(res, h, o);
-
-    // Rasterize collider into SDF
+    // Rasterize collider into SDF, which the collider caches until it moves.
+    // The cached field is copied only when it has changed.
     if (_collider != nullptr) {
-        auto pos = _colliderSdf.dataPosition();
-        Surface3Ptr surface = _collider->surface();
-        ImplicitSurface3Ptr implicitSurface
-            = std::dynamic_pointer_cast<ImplicitSurface3>(surface);
-        if (implicitSurface == nullptr) {
-            implicitSurface = std::make_shared<SurfaceToImplicit3>(surface);
+        _collider->updateSurface();
+        const CellCenteredScalarGrid3& sdf
+            = _collider->signedDistanceGrid(res, h, o);
+        if (_collider != _colliderSdfSource
+            || _collider->surfaceStamp() != _colliderSdfStamp
+            || !_colliderSdf.hasSameShape(sdf)) {
+            _colliderSdf.set(sdf);
+            _colliderSdfSource = _collider;
+            _colliderSdfStamp = _collider->surfaceStamp();
         }
-
-        _colliderSdf.fill([&](const Vector3D& pt) {
-            return implicitSurface->signedDistance(pt);
-        });
     } else {
+        _colliderSdf.resize(res, h, o);
         _colliderSdf.fill(kMaxD);
+        _colliderSdfSource = nullptr;
     }
 
     // Update boundary condition solver
@@ -5,7 +5,6 @@
 #include <jet/array_utils.h>
 #include <jet/grid_fractional_boundary_condition_solver3.h>
 #include <jet/level_set_utils.h>
-#include <jet/surface_to_implicit3.h>
 #include <algorithm>
 
 using namespace jet;
@@ -216,20 +215,20 @@ void GridFractionalBoundaryConditionSolver3::onColliderUpdated(
     const Size3& gridSize,
     const Vector3D& gridSpacing,
     const Vector3D& gridOrigin) {
-    _colliderSdf.resize(gridSize, gridSpacing, gridOrigin);
-
+    // The cached field of the collider is copied only when it has changed
     if (collider() != nullptr) {
-        Surface3Ptr surface = collider()->surface();
-        ImplicitSurface3Ptr implicitSurface
-            = std::dynamic_pointer_cast<ImplicitSurface3>(surface);
-        if (implicitSurface == nullptr) {
-            implicitSurface = std::make_shared<SurfaceToImplicit3>(surface);
+        const CellCenteredScalarGrid3& sdf = collider()->signedDistanceGrid(
+            gridSize, gridSpacing, gridOrigin);
+        if (collider() != _colliderSdfSource
+            || collider()->surfaceStamp() != _colliderSdfStamp
+            || !_colliderSdf.hasSameShape(sdf)) {
+            _colliderSdf.set(sdf);
+            _colliderSdfSource = collider();
+            _colliderSdfStamp = collider()->surfaceStamp();
         }
-
-        _colliderSdf.fill([&](const Vector3D& pt) {
-            return implicitSurface->signedDistance(pt);
-        });
     } else {
+        _colliderSdf.resize(gridSize, gridSpacing, gridOrigin);
         _colliderSdf.fill(kMaxD);
+        _colliderSdfSource = nullptr;
     }
 }
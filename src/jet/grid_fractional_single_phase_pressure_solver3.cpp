@@ -16,6 +16,16 @@ using namespace jet;
 const double kDefaultTolerance = 1e-6;
 const double kMinWeight = 0.01;
 
+template <typename T>
+static bool isSameArray(const ConstArrayAccessor3<T>& a, const Array3<T>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+
+    size_t n = a.width() * a.height() * a.depth();
+    return std::equal(a.data(), a.data() + n, b.data());
+}
+
 GridFractionalSinglePhasePressureSolver3
 ::GridFractionalSinglePhasePressureSolver3() {
     _systemSolver = std::make_shared<FdmIccgSolver3>(100, kDefaultTolerance);
@@ -37,11 +47,38 @@ void GridFractionalSinglePhasePressureSolver3::solve(
         input,
         boundarySdf,
         fluidSdf);
-    buildSystem(input);
+
+    bool isMatrixUnchanged
+        = _isReusingUnchangedMatrix && !detectMatrixChange(input);
+
+    if (isMatrixUnchanged) {
+        buildRhs(input);
+    } else if (isSolvingCompressedSystem()) {
+        buildCompressedSystem(input);
+    } else {
+        buildSystem(input);
+    }
 
     if (_systemSolver != nullptr) {
+        _systemSolver->setIsUsingWarmStart(_isUsingWarmStart);
+        _systemSolver->setIsReusingMatrix(isMatrixUnchanged);
+
         // Solve the system
-        _systemSolver->solve(&_system);
+        if (isSolvingCompressedSystem()) {
+            if (_isUsingWarmStart && _system.x.size() == input.resolution()) {
+                // Start from the last pressure
+                const auto& coords = _compSystem.indexToCoord;
+                coords.parallelForEachIndex([&](size_t idx) {
+                    const Point3UI& pt = coords[idx];
+                    _compSystem.x[idx] = _system.x(pt.x, pt.y, pt.z);
+                });
+            }
+
+            _systemSolver->solveCompressed(&_compSystem);
+            _compSystem.decompressSolution(&_system.x);
+        } else {
+            _systemSolver->solve(&_system);
+        }
 
         // Apply pressure gradient
         applyPressureGradient(input, output);
@@ -58,6 +95,41 @@ GridFractionalSinglePhasePressureSolver3
 void GridFractionalSinglePhasePressureSolver3::setLinearSystemSolver(
     const FdmLinearSystemSolver3Ptr& solver) {
     _systemSolver = solver;
+
+    // The new solver may solve the other system
+    _lastUWeights.clear();
+}
+
+bool GridFractionalSinglePhasePressureSolver3
+::isUsingCompressedLinearSystem() const {
+    return _isUsingCompressedLinearSystem;
+}
+
+void GridFractionalSinglePhasePressureSolver3::setIsUsingCompressedLinearSystem(
+    bool isUsing) {
+    _isUsingCompressedLinearSystem = isUsing;
+
+    // The other system has not been built yet
+    _lastUWeights.clear();
+}
+
+bool GridFractionalSinglePhasePressureSolver3::isUsingWarmStart() const {
+    return _isUsingWarmStart;
+}
+
+void GridFractionalSinglePhasePressureSolver3::setIsUsingWarmStart(
+    bool isUsing) {
+    _isUsingWarmStart = isUsing;
+}
+
+bool GridFractionalSinglePhasePressureSolver3
+::isReusingUnchangedMatrix() const {
+    return _isReusingUnchangedMatrix;
+}
+
+void GridFractionalSinglePhasePressureSolver3::setIsReusingUnchangedMatrix(
+    bool isReusing) {
+    _isReusingUnchangedMatrix = isReusing;
 }
 
 const FdmVector3& GridFractionalSinglePhasePressureSolver3::pressure() const {
@@ -141,127 +213,199 @@ void GridFractionalSinglePhasePressureSolver3::buildSystem(
     _system.x.resize(size);
     _system.b.resize(size);
 
+    // Build linear system
+    _system.A.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        buildRow(input, i, j, k, &_system.A(i, j, k), &_system.b(i, j, k));
+    });
+}
+
+void GridFractionalSinglePhasePressureSolver3::buildCompressedSystem(
+    const FaceCenteredGrid3& input) {
+    // Build linear system for the fluid cells only
+    _compSystem.build(
+        input.resolution(),
+        [&](size_t i, size_t j, size_t k) {
+            return isInsideSdf(_fluidSdf(i, j, k));
+        },
+        [&](size_t i, size_t j, size_t k, FdmMatrixRow3* row, double* rhs) {
+            buildRow(input, i, j, k, row, rhs);
+        });
+}
+
+void GridFractionalSinglePhasePressureSolver3::buildRhs(
+    const FaceCenteredGrid3& input) {
+    // Only the right-hand side is updated since the matrix is unchanged
+    if (isSolvingCompressedSystem()) {
+        const auto& coords = _compSystem.indexToCoord;
+        coords.parallelForEachIndex([&](size_t idx) {
+            const Point3UI& pt = coords[idx];
+            FdmMatrixRow3 row;
+            buildRow(input, pt.x, pt.y, pt.z, &row, &_compSystem.b[idx]);
+        });
+    } else {
+        _system.b.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+            FdmMatrixRow3 row;
+            buildRow(input, i, j, k, &row, &_system.b(i, j, k));
+        });
+    }
+}
+
+bool GridFractionalSinglePhasePressureSolver3::isSolvingCompressedSystem()
+    const {
+    return _isUsingCompressedLinearSystem
+        && _systemSolver != nullptr
+        && _systemSolver->isSupportingCompressedSystem();
+}
+
+bool GridFractionalSinglePhasePressureSolver3::detectMatrixChange(
+    const FaceCenteredGrid3& input) {
+    auto fluidSdf = _fluidSdf.constDataAccessor();
+
+    bool isChanged
+        = !(_lastGridSpacing == input.gridSpacing())
+        || !isSameArray(_uWeights.constAccessor(), _lastUWeights)
+        || !isSameArray(_vWeights.constAccessor(), _lastVWeights)
+        || !isSameArray(_wWeights.constAccessor(), _lastWWeights)
+        || !isSameArray(fluidSdf, _lastFluidSdf);
+
+    if (isChanged) {
+        _lastGridSpacing = input.gridSpacing();
+        _lastUWeights.set(_uWeights);
+        _lastVWeights.set(_vWeights);
+        _lastWWeights.set(_wWeights);
+        _lastFluidSdf.resize(fluidSdf.size());
+        fluidSdf.forEachIndex([&](size_t i, size_t j, size_t k) {
+            _lastFluidSdf(i, j, k) = fluidSdf(i, j, k);
+        });
+    }
+
+    return isChanged;
+}
+
+void GridFractionalSinglePhasePressureSolver3::buildRow(
+    const FaceCenteredGrid3& input,
+    size_t i,
+    size_t j,
+    size_t k,
+    FdmMatrixRow3* row,
+    double* rhs) const {
+    Size3 size = input.resolution();
     Vector3D invH = 1.0 / input.gridSpacing();
     Vector3D invHSqr = invH * invH;
 
-    // Build linear system
-    _system.A.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        auto& row = _system.A(i, j, k);
+    // initialize
+    row->center = row->right = row->up = row->front = 0.0;
+    *rhs = 0.0;
 
-        // initialize
-        row.center = row.right = row.up = row.front = 0.0;
-        _system.b(i, j, k) = 0.0;
+    double centerPhi = _fluidSdf(i, j, k);
 
-        double centerPhi = _fluidSdf(i, j, k);
+    if (isInsideSdf(centerPhi)) {
+        double term;
 
-        if (isInsideSdf(centerPhi)) {
-            double term;
-
-            if (i + 1 < size.x) {
-                term = _uWeights(i + 1, j, k) * invHSqr.x;
-                double rightPhi = _fluidSdf(i + 1, j, k);
-                if (isInsideSdf(rightPhi)) {
-                    row.center += term;
-                    row.right -= term;
-                } else {
-                    double theta = fractionInsideSdf(centerPhi, rightPhi);
-                    theta = std::max(theta, 0.01);
-                    row.center += term / theta;
-                }
-                _system.b(i, j, k)
-                    += _uWeights(i + 1, j, k)
-                    * input.u(i + 1, j, k) * invH.x;
+        if (i + 1 < size.x) {
+            term = _uWeights(i + 1, j, k) * invHSqr.x;
+            double rightPhi = _fluidSdf(i + 1, j, k);
+            if (isInsideSdf(rightPhi)) {
+                row->center += term;
+                row->right -= term;
             } else {
-                _system.b(i, j, k) += input.u(i + 1, j, k) * invH.x;
+                double theta = fractionInsideSdf(centerPhi, rightPhi);
+                theta = std::max(theta, 0.01);
+                row->center += term / theta;
             }
+            *rhs
+                += _uWeights(i + 1, j, k)
+                * input.u(i + 1, j, k) * invH.x;
+        } else {
+            *rhs += input.u(i + 1, j, k) * invH.x;
+        }
 
-            if (i > 0) {
-                term = _uWeights(i, j, k) * invHSqr.x;
-                double leftPhi = _fluidSdf(i - 1, j, k);
-                if (isInsideSdf(leftPhi)) {
-                    row.center += term;
-                } else {
-                    double theta = fractionInsideSdf(centerPhi, leftPhi);
-                    theta = std::max(theta, 0.01);
-                    row.center += term / theta;
-                }
-                _system.b(i, j, k)
-                    -= _uWeights(i, j, k) * input.u(i, j, k) * invH.x;
+        if (i > 0) {
+            term = _uWeights(i, j, k) * invHSqr.x;
+            double leftPhi = _fluidSdf(i - 1, j, k);
+            if (isInsideSdf(leftPhi)) {
+                row->center += term;
             } else {
-                _system.b(i, j, k) -= input.u(i, j, k) * invH.x;
+                double theta = fractionInsideSdf(centerPhi, leftPhi);
+                theta = std::max(theta, 0.01);
+                row->center += term / theta;
             }
+            *rhs
+                -= _uWeights(i, j, k) * input.u(i, j, k) * invH.x;
+        } else {
+            *rhs -= input.u(i, j, k) * invH.x;
+        }
 
-            if (j + 1 < size.y) {
-                term = _vWeights(i, j + 1, k) * invHSqr.y;
-                double upPhi = _fluidSdf(i, j + 1, k);
-                if (isInsideSdf(upPhi)) {
-                    row.center += term;
-                    row.up -= term;
-                } else {
-                    double theta = fractionInsideSdf(centerPhi, upPhi);
-                    theta = std::max(theta, 0.01);
-                    row.center += term / theta;
-                }
-                _system.b(i, j, k)
-                    += _vWeights(i, j + 1, k)
-                    * input.v(i, j + 1, k) * invH.y;
+        if (j + 1 < size.y) {
+            term = _vWeights(i, j + 1, k) * invHSqr.y;
+            double upPhi = _fluidSdf(i, j + 1, k);
+            if (isInsideSdf(upPhi)) {
+                row->center += term;
+                row->up -= term;
             } else {
-                _system.b(i, j, k) += input.v(i, j + 1, k) * invH.y;
+                double theta = fractionInsideSdf(centerPhi, upPhi);
+                theta = std::max(theta, 0.01);
+                row->center += term / theta;
             }
+            *rhs
+                += _vWeights(i, j + 1, k)
+                * input.v(i, j + 1, k) * invH.y;
+        } else {
+            *rhs += input.v(i, j + 1, k) * invH.y;
+        }
 
-            if (j > 0) {
-                term = _vWeights(i, j, k) * invHSqr.y;
-                double downPhi = _fluidSdf(i, j - 1, k);
-                if (isInsideSdf(downPhi)) {
-                    row.center += term;
-                } else {
-                    double theta = fractionInsideSdf(centerPhi, downPhi);
-                    theta = std::max(theta, 0.01);
-                    row.center += term / theta;
-                }
-                _system.b(i, j, k)
-                    -= _vWeights(i, j, k) * input.v(i, j, k) * invH.y;
+        if (j > 0) {
+            term = _vWeights(i, j, k) * invHSqr.y;
+            double downPhi = _fluidSdf(i, j - 1, k);
+            if (isInsideSdf(downPhi)) {
+                row->center += term;
             } else {
-                _system.b(i, j, k) -= input.v(i, j, k) * invH.y;
+                double theta = fractionInsideSdf(centerPhi, downPhi);
+                theta = std::max(theta, 0.01);
+                row->center += term / theta;
             }
+            *rhs
+                -= _vWeights(i, j, k) * input.v(i, j, k) * invH.y;
+        } else {
+            *rhs -= input.v(i, j, k) * invH.y;
+        }
 
-            if (k + 1 < size.z) {
-                term = _wWeights(i, j, k + 1) * invHSqr.z;
-                double frontPhi = _fluidSdf(i, j, k + 1);
-                if (isInsideSdf(frontPhi)) {
-                    row.center += term;
-                    row.front -= term;
-                } else {
-                    double theta = fractionInsideSdf(centerPhi, frontPhi);
-                    theta = std::max(theta, 0.01);
-                    row.center += term / theta;
-                }
-                _system.b(i, j, k)
-                    += _wWeights(i, j, k + 1)
-                    * input.w(i, j, k + 1) * invH.z;
+        if (k + 1 < size.z) {
+            term = _wWeights(i, j, k + 1) * invHSqr.z;
+            double frontPhi = _fluidSdf(i, j, k + 1);
+            if (isInsideSdf(frontPhi)) {
+                row->center += term;
+                row->front -= term;
             } else {
-                _system.b(i, j, k) += input.w(i, j, k + 1) * invH.z;
+                double theta = fractionInsideSdf(centerPhi, frontPhi);
+                theta = std::max(theta, 0.01);
+                row->center += term / theta;
             }
+            *rhs
+                += _wWeights(i, j, k + 1)
+                * input.w(i, j, k + 1) * invH.z;
+        } else {
+            *rhs += input.w(i, j, k + 1) * invH.z;
+        }
 
-            if (k > 0) {
-                term = _wWeights(i, j, k) * invHSqr.z;
-                double backPhi = _fluidSdf(i, j, k - 1);
-                if (isInsideSdf(backPhi)) {
-                    row.center += term;
-                } else {
-                    double theta = fractionInsideSdf(centerPhi, backPhi);
-                    theta = std::max(theta, 0.01);
-                    row.center += term / theta;
-                }
-                _system.b(i, j, k)
-                    -= _wWeights(i, j, k) * input.w(i, j, k) * invH.z;
+        if (k > 0) {
+            term = _wWeights(i, j, k) * invHSqr.z;
+            double backPhi = _fluidSdf(i, j, k - 1);
+            if (isInsideSdf(backPhi)) {
+                row->center += term;
             } else {
-                _system.b(i, j, k) -= input.w(i, j, k) * invH.z;
+                double theta = fractionInsideSdf(centerPhi, backPhi);
+                theta = std::max(theta, 0.01);
+                row->center += term / theta;
             }
+            *rhs
+                -= _wWeights(i, j, k) * input.w(i, j, k) * invH.z;
         } else {
-            row.center = 1.0;
+            *rhs -= input.w(i, j, k) * invH.z;
         }
-    });
+    } else {
+        row->center = 1.0;
+    }
 }
 
 void GridFractionalSinglePhasePressureSolver3::applyPressureGradient(
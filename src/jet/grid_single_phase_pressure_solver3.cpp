@@ -6,6 +6,7 @@
 #include <jet/grid_blocked_boundary_condition_solver3.h>
 #include <jet/grid_single_phase_pressure_solver3.h>
 #include <jet/level_set_utils.h>
+#include <algorithm>
 
 using namespace jet;
 
@@ -36,11 +37,57 @@ void GridSinglePhasePressureSolver3::solve(
         pos,
         boundarySdf,
         fluidSdf);
-    buildSystem(input);
+
+    if (_isUsingMatrixFreeSystem
+        && _systemSolver != nullptr
+        && _systemSolver->isSupportingMatrixFreeSystem()) {
+        buildMatrixFreeSystem(input);
+
+        _systemSolver->setIsUsingWarmStart(_isUsingWarmStart);
+        _systemSolver->setIsReusingMatrix(false);
+
+        // Solve the system
+        _systemSolver->solveMatrixFree(&_mfSystem);
+
+        // Move the solution back to the pressure field
+        _system.x.swap(_mfSystem.x);
+
+        // Apply pressure gradient
+        applyPressureGradient(input, output);
+        return;
+    }
+
+    bool isMatrixUnchanged
+        = _isReusingUnchangedMatrix && !detectMatrixChange(input);
+
+    if (isMatrixUnchanged) {
+        buildRhs(input);
+    } else if (isSolvingCompressedSystem()) {
+        buildCompressedSystem(input);
+    } else {
+        buildSystem(input);
+    }
 
     if (_systemSolver != nullptr) {
+        _systemSolver->setIsUsingWarmStart(_isUsingWarmStart);
+        _systemSolver->setIsReusingMatrix(isMatrixUnchanged);
+
         // Solve the system
-        _systemSolver->solve(&_system);
+        if (isSolvingCompressedSystem()) {
+            if (_isUsingWarmStart && _system.x.size() == input.resolution()) {
+                // Start from the last pressure
+                const auto& coords = _compSystem.indexToCoord;
+                coords.parallelForEachIndex([&](size_t idx) {
+                    const Point3UI& pt = coords[idx];
+                    _compSystem.x[idx] = _system.x(pt.x, pt.y, pt.z);
+                });
+            }
+
+            _systemSolver->solveCompressed(&_compSystem);
+            _compSystem.decompressSolution(&_system.x);
+        } else {
+            _systemSolver->solve(&_system);
+        }
 
         // Apply pressure gradient
         applyPressureGradient(input, output);
@@ -55,6 +102,49 @@ GridSinglePhasePressureSolver3::suggestedBoundaryConditionSolver() const {
 void GridSinglePhasePressureSolver3::setLinearSystemSolver(
     const FdmLinearSystemSolver3Ptr& solver) {
     _systemSolver = solver;
+
+    // The new solver may solve the other system
+    _lastMarkers.clear();
+}
+
+bool GridSinglePhasePressureSolver3::isUsingCompressedLinearSystem() const {
+    return _isUsingCompressedLinearSystem;
+}
+
+void GridSinglePhasePressureSolver3::setIsUsingCompressedLinearSystem(
+    bool isUsing) {
+    _isUsingCompressedLinearSystem = isUsing;
+
+    // The other system has not been built yet
+    _lastMarkers.clear();
+}
+
+bool GridSinglePhasePressureSolver3::isUsingMatrixFreeSystem() const {
+    return _isUsingMatrixFreeSystem;
+}
+
+void GridSinglePhasePressureSolver3::setIsUsingMatrixFreeSystem(bool isUsing) {
+    _isUsingMatrixFreeSystem = isUsing;
+
+    // The other system has not been built yet
+    _lastMarkers.clear();
+}
+
+bool GridSinglePhasePressureSolver3::isUsingWarmStart() const {
+    return _isUsingWarmStart;
+}
+
+void GridSinglePhasePressureSolver3::setIsUsingWarmStart(bool isUsing) {
+    _isUsingWarmStart = isUsing;
+}
+
+bool GridSinglePhasePressureSolver3::isReusingUnchangedMatrix() const {
+    return _isReusingUnchangedMatrix;
+}
+
+void GridSinglePhasePressureSolver3::setIsReusingUnchangedMatrix(
+    bool isReusing) {
+    _isReusingUnchangedMatrix = isReusing;
 }
 
 const FdmVector3& GridSinglePhasePressureSolver3::pressure() const {
@@ -86,56 +176,148 @@ void GridSinglePhasePressureSolver3::buildSystem(
     _system.x.resize(size);
     _system.b.resize(size);
 
-    Vector3D invH = 1.0 / input.gridSpacing();
-    Vector3D invHSqr = invH * invH;
-
     // Build linear system
     _system.A.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        auto& row = _system.A(i, j, k);
+        buildRow(input, i, j, k, &_system.A(i, j, k), &_system.b(i, j, k));
+    });
+}
+
+void GridSinglePhasePressureSolver3::buildCompressedSystem(
+    const FaceCenteredGrid3& input) {
+    // Build linear system for the fluid cells only
+    _compSystem.build(
+        input.resolution(),
+        [&](size_t i, size_t j, size_t k) {
+            return _markers(i, j, k) == kFluid;
+        },
+        [&](size_t i, size_t j, size_t k, FdmMatrixRow3* row, double* rhs) {
+            buildRow(input, i, j, k, row, rhs);
+        });
+}
 
-        // initialize
-        row.center = row.right = row.up = row.front = 0.0;
-        _system.b(i, j, k) = 0.0;
+void GridSinglePhasePressureSolver3::buildMatrixFreeSystem(
+    const FaceCenteredGrid3& input) {
+    Size3 size = input.resolution();
+    Vector3D invH = 1.0 / input.gridSpacing();
+
+    auto& markers = _mfSystem.A.markers;
+    markers.resize(size);
+    _mfSystem.A.coefficients = invH * invH;
+    _mfSystem.b.resize(size);
+
+    // Start from the last pressure for warm start
+    _system.x.resize(size);
+    _mfSystem.x.swap(_system.x);
 
+    _mfSystem.b.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
         if (_markers(i, j, k) == kFluid) {
-            _system.b(i, j, k) = input.divergenceAtCellCenter(i, j, k);
+            markers(i, j, k) = FdmMatrixFreeMatrix3::Fluid;
+        } else if (_markers(i, j, k) == kAir) {
+            markers(i, j, k) = FdmMatrixFreeMatrix3::Air;
+        } else {
+            markers(i, j, k) = FdmMatrixFreeMatrix3::Boundary;
+        }
 
-            if (i + 1 < size.x && _markers(i + 1, j, k) != kBoundary) {
-                row.center += invHSqr.x;
-                if (_markers(i + 1, j, k) == kFluid) {
-                    row.right -= invHSqr.x;
-                }
-            }
+        FdmMatrixRow3 row;
+        buildRow(input, i, j, k, &row, &_mfSystem.b(i, j, k));
+    });
+}
 
-            if (i > 0 && _markers(i - 1, j, k) != kBoundary) {
-                row.center += invHSqr.x;
-            }
+void GridSinglePhasePressureSolver3::buildRhs(
+    const FaceCenteredGrid3& input) {
+    // Only the right-hand side is updated since the matrix is unchanged
+    if (isSolvingCompressedSystem()) {
+        const auto& coords = _compSystem.indexToCoord;
+        coords.parallelForEachIndex([&](size_t idx) {
+            const Point3UI& pt = coords[idx];
+            FdmMatrixRow3 row;
+            buildRow(input, pt.x, pt.y, pt.z, &row, &_compSystem.b[idx]);
+        });
+    } else {
+        _system.b.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+            FdmMatrixRow3 row;
+            buildRow(input, i, j, k, &row, &_system.b(i, j, k));
+        });
+    }
+}
 
-            if (j + 1 < size.y && _markers(i, j + 1, k) != kBoundary) {
-                row.center += invHSqr.y;
-                if (_markers(i, j + 1, k) == kFluid) {
-                    row.up -= invHSqr.y;
-                }
-            }
+bool GridSinglePhasePressureSolver3::isSolvingCompressedSystem() const {
+    return _isUsingCompressedLinearSystem
+        && _systemSolver != nullptr
+        && _systemSolver->isSupportingCompressedSystem();
+}
+
+bool GridSinglePhasePressureSolver3::detectMatrixChange(
+    const FaceCenteredGrid3& input) {
+    size_t n = _markers.width() * _markers.height() * _markers.depth();
 
-            if (j > 0 && _markers(i, j - 1, k) != kBoundary) {
-                row.center += invHSqr.y;
+    bool isChanged
+        = !(_lastGridSpacing == input.gridSpacing())
+        || _markers.size() != _lastMarkers.size()
+        || !std::equal(
+            _markers.data(), _markers.data() + n, _lastMarkers.data());
+
+    if (isChanged) {
+        _lastGridSpacing = input.gridSpacing();
+        _lastMarkers.set(_markers);
+    }
+
+    return isChanged;
+}
+
+void GridSinglePhasePressureSolver3::buildRow(
+    const FaceCenteredGrid3& input,
+    size_t i,
+    size_t j,
+    size_t k,
+    FdmMatrixRow3* row,
+    double* rhs) const {
+    Size3 size = input.resolution();
+    Vector3D invH = 1.0 / input.gridSpacing();
+    Vector3D invHSqr = invH * invH;
+
+    // initialize
+    row->center = row->right = row->up = row->front = 0.0;
+    *rhs = 0.0;
+
+    if (_markers(i, j, k) == kFluid) {
+        *rhs = input.divergenceAtCellCenter(i, j, k);
+
+        if (i + 1 < size.x && _markers(i + 1, j, k) != kBoundary) {
+            row->center += invHSqr.x;
+            if (_markers(i + 1, j, k) == kFluid) {
+                row->right -= invHSqr.x;
             }
+        }
 
-            if (k + 1 < size.z && _markers(i, j, k + 1) != kBoundary) {
-                row.center += invHSqr.z;
-                if (_markers(i, j, k + 1) == kFluid) {
-                    row.front -= invHSqr.z;
-                }
+        if (i > 0 && _markers(i - 1, j, k) != kBoundary) {
+            row->center += invHSqr.x;
+        }
+
+        if (j + 1 < size.y && _markers(i, j + 1, k) != kBoundary) {
+            row->center += invHSqr.y;
+            if (_markers(i, j + 1, k) == kFluid) {
+                row->up -= invHSqr.y;
             }
+        }
+
+        if (j > 0 && _markers(i, j - 1, k) != kBoundary) {
+            row->center += invHSqr.y;
+        }
 
-            if (k > 0 && _markers(i, j, k - 1) != kBoundary) {
-                row.center += invHSqr.z;
+        if (k + 1 < size.z && _markers(i, j, k + 1) != kBoundary) {
+            row->center += invHSqr.z;
+            if (_markers(i, j, k + 1) == kFluid) {
+                row->front -= invHSqr.z;
             }
-        } else {
-            row.center = 1.0;
         }
-    });
+
+        if (k > 0 && _markers(i, j, k - 1) != kBoundary) {
+            row->center += invHSqr.z;
+        }
+    } else {
+        row->center = 1.0;
+    }
 }
 
 void GridSinglePhasePressureSolver3::applyPressureGradient(
@@ -1,11 +1,32 @@
 // Copyright (c) 2016 Doyub Kim
 
 #include <pch.h>
+#include <jet/custom_scalar_field3.h>
 #include <jet/grid_smoke_solver3.h>
+#include <jet/parallel.h>
 #include <algorithm>
+#include <vector>
 
 using namespace jet;
 
+// Returns the signed distance to the box, which is negative inside. An empty
+// box is considered to be infinitely far away.
+inline double boxSignedDistance(
+    const BoundingBox3D& box, const Vector3D& x) {
+    if (box.lowerCorner.x > box.upperCorner.x) {
+        return kMaxD;
+    }
+
+    Vector3D q(
+        std::max(box.lowerCorner.x - x.x, x.x - box.upperCorner.x),
+        std::max(box.lowerCorner.y - x.y, x.y - box.upperCorner.y),
+        std::max(box.lowerCorner.z - x.z, x.z - box.upperCorner.z));
+    Vector3D outside(
+        std::max(q.x, 0.0), std::max(q.y, 0.0), std::max(q.z, 0.0));
+
+    return outside.length() + std::min(max3(q.x, q.y, q.z), 0.0);
+}
+
 GridSmokeSolver3::GridSmokeSolver3() {
     auto grids = gridSystemData();
 
@@ -13,6 +34,20 @@ GridSmokeSolver3::GridSmokeSolver3() {
         CellCenteredScalarGrid3::builder(), 0.0);
     _temperatureDataId = grids->addAdvectableScalarData(
         CellCenteredScalarGrid3::builder(), 0.0);
+
+    // The cells outside of the active region are treated as open air by the
+    // pressure and diffusion solves, so the flow can enter and leave the
+    // region. The advection only updates the data points inside of the region.
+    _activeRegionSdf = std::make_shared<CustomScalarField3>(
+        [this](const Vector3D& x) {
+            return boxSignedDistance(_activeRegion, x);
+        });
+    _activeRegionBoundarySdf = std::make_shared<CustomScalarField3>(
+        [this](const Vector3D& x) {
+            return std::min(
+                colliderSdf().sample(x),
+                -boxSignedDistance(_activeRegion, x));
+        });
 }
 
 GridSmokeSolver3::~GridSmokeSolver3() {
@@ -74,6 +109,40 @@ ScalarGrid3Ptr GridSmokeSolver3::temperature() const {
     return gridSystemData()->advectableScalarDataAt(_temperatureDataId);
 }
 
+bool GridSmokeSolver3::isUsingActiveRegion() const {
+    return _isUsingActiveRegion;
+}
+
+void GridSmokeSolver3::setIsUsingActiveRegion(bool isUsing) {
+    _isUsingActiveRegion = isUsing;
+}
+
+double GridSmokeSolver3::activeRegionThreshold() const {
+    return _activeRegionThreshold;
+}
+
+void GridSmokeSolver3::setActiveRegionThreshold(double newValue) {
+    _activeRegionThreshold = std::max(newValue, 0.0);
+}
+
+double GridSmokeSolver3::activeRegionSpeedThreshold() const {
+    return _activeRegionSpeedThreshold;
+}
+
+void GridSmokeSolver3::setActiveRegionSpeedThreshold(double newValue) {
+    _activeRegionSpeedThreshold = std::max(newValue, 0.0);
+}
+
+const BoundingBox3D& GridSmokeSolver3::activeRegion() const {
+    return _activeRegion;
+}
+
+void GridSmokeSolver3::onBeginAdvanceTimeStep(double timeIntervalInSeconds) {
+    UNUSED_VARIABLE(timeIntervalInSeconds);
+
+    updateActiveRegion();
+}
+
 void GridSmokeSolver3::onEndAdvanceTimeStep(double timeIntervalInSeconds) {
     computeDiffusion(timeIntervalInSeconds);
 }
@@ -82,45 +151,68 @@ void GridSmokeSolver3::computeExternalForces(double timeIntervalInSeconds) {
     computeBuoyancyForce(timeIntervalInSeconds);
 }
 
+ScalarField3Ptr GridSmokeSolver3::fluidSdf() const {
+    if (_isUsingActiveRegion) {
+        return _activeRegionSdf;
+    } else {
+        return GridFluidSolver3::fluidSdf();
+    }
+}
+
+const ScalarField3& GridSmokeSolver3::advectionBoundarySdf() const {
+    if (_isUsingActiveRegion) {
+        return *_activeRegionBoundarySdf;
+    } else {
+        return GridFluidSolver3::advectionBoundarySdf();
+    }
+}
+
 void GridSmokeSolver3::computeDiffusion(double timeIntervalInSeconds) {
     if (diffusionSolver() != nullptr) {
+        auto grids = gridSystemData();
+
         if (_smokeDiffusionCoefficient > kEpsilonD) {
             auto den = smokeDensity();
-            auto den0 = std::dynamic_pointer_cast<CellCenteredScalarGrid3>(
-                den->clone());
+            auto den1 = grids->advectableScalarDataBackBufferAt(
+                _smokeDensityDataId);
 
             diffusionSolver()->solve(
-                *den0,
+                *den,
                 _smokeDiffusionCoefficient,
                 timeIntervalInSeconds,
-                den0.get(),
-                colliderSdf());
+                den1.get(),
+                colliderSdf(),
+                *fluidSdf());
+            grids->swapAdvectableScalarDataBuffersAt(_smokeDensityDataId);
             extrapolateIntoCollider(den.get());
         }
 
         if (_temperatureDiffusionCoefficient > kEpsilonD) {
-            auto temp = smokeDensity();
-            auto temp0 = std::dynamic_pointer_cast<CellCenteredScalarGrid3>(
-                temp->clone());
+            auto temp = temperature();
+            auto temp1 = grids->advectableScalarDataBackBufferAt(
+                _temperatureDataId);
 
             diffusionSolver()->solve(
-                *temp0,
+                *temp,
                 _temperatureDiffusionCoefficient,
                 timeIntervalInSeconds,
-                temp.get(),
-                colliderSdf());
+                temp1.get(),
+                colliderSdf(),
+                *fluidSdf());
+            grids->swapAdvectableScalarDataBuffersAt(_temperatureDataId);
             extrapolateIntoCollider(temp.get());
         }
     }
 
+    const Point3UI& lower = _activeRegionLower;
+    const Point3UI& upper = _activeRegionUpper;
+
     auto den = smokeDensity();
-    den->parallelForEachDataPointIndex(
-        [&](size_t i, size_t j, size_t k) {
-            (*den)(i, j, k) *= 1.0 - _smokeDecayFactor;
-        });
     auto temp = temperature();
-    temp->parallelForEachDataPointIndex(
+    parallelFor(
+        lower.x, upper.x, lower.y, upper.y, lower.z, upper.z,
         [&](size_t i, size_t j, size_t k) {
+            (*den)(i, j, k) *= 1.0 - _smokeDecayFactor;
             (*temp)(i, j, k) *= 1.0 - _temperatureDecayFactor;
         });
 }
@@ -134,17 +226,30 @@ void GridSmokeSolver3::computeBuoyancyForce(double timeIntervalInSeconds) {
         up = -gravity().normalized();
     }
 
+    const Point3UI& lower = _activeRegionLower;
+    const Point3UI& upper = _activeRegionUpper;
+    if (lower.x >= upper.x || lower.y >= upper.y || lower.z >= upper.z) {
+        return;
+    }
+
     if (std::abs(_buoyancySmokeDensityFactor) > kEpsilonD ||
         std::abs(_buoyancyTemperatureFactor) > kEpsilonD) {
         auto den = smokeDensity();
         auto temp = temperature();
 
-        double tAmb = 0.0;
-        temp->forEachCellIndex([&](size_t i, size_t j, size_t k) {
-            tAmb += (*temp)(i, j, k);
-        });
-        tAmb /= static_cast<double>(
-            temp->resolution().x * temp->resolution().y * temp->resolution().z);
+        // The ambient temperature is averaged over the entire domain while
+        // searching for the active region.
+        double tAmb = _ambientTemperature;
+        if (!_isUsingActiveRegion) {
+            tAmb = 0.0;
+            temp->forEachCellIndex([&](size_t i, size_t j, size_t k) {
+                tAmb += (*temp)(i, j, k);
+            });
+            tAmb /= static_cast<double>(
+                temp->resolution().x
+                * temp->resolution().y
+                * temp->resolution().z);
+        }
 
         auto u = vel->uAccessor();
         auto v = vel->vAccessor();
@@ -154,35 +259,126 @@ void GridSmokeSolver3::computeBuoyancyForce(double timeIntervalInSeconds) {
         auto wPos = vel->wPosition();
 
         if (std::abs(up.x) > kEpsilonD) {
-            vel->parallelForEachUIndex([&](size_t i, size_t j, size_t k) {
-                Vector3D pt = uPos(i, j, k);
-                double fBuoy
-                    = _buoyancySmokeDensityFactor * den->sample(pt)
-                    + _buoyancyTemperatureFactor * (temp->sample(pt) - tAmb);
-                u(i, j, k) += timeIntervalInSeconds * fBuoy * up.x;
-            });
+            parallelFor(
+                lower.x, upper.x + 1, lower.y, upper.y, lower.z, upper.z,
+                [&](size_t i, size_t j, size_t k) {
+                    Vector3D pt = uPos(i, j, k);
+                    double fBuoy
+                        = _buoyancySmokeDensityFactor * den->sample(pt)
+                        + _buoyancyTemperatureFactor
+                        * (temp->sample(pt) - tAmb);
+                    u(i, j, k) += timeIntervalInSeconds * fBuoy * up.x;
+                });
         }
 
         if (std::abs(up.y) > kEpsilonD) {
-            vel->parallelForEachVIndex([&](size_t i, size_t j, size_t k) {
-                Vector3D pt = vPos(i, j, k);
-                double fBuoy
-                    = _buoyancySmokeDensityFactor * den->sample(pt)
-                    + _buoyancyTemperatureFactor * (temp->sample(pt) - tAmb);
-                v(i, j, k) += timeIntervalInSeconds * fBuoy * up.y;
-            });
+            parallelFor(
+                lower.x, upper.x, lower.y, upper.y + 1, lower.z, upper.z,
+                [&](size_t i, size_t j, size_t k) {
+                    Vector3D pt = vPos(i, j, k);
+                    double fBuoy
+                        = _buoyancySmokeDensityFactor * den->sample(pt)
+                        + _buoyancyTemperatureFactor
+                        * (temp->sample(pt) - tAmb);
+                    v(i, j, k) += timeIntervalInSeconds * fBuoy * up.y;
+                });
         }
 
         if (std::abs(up.z) > kEpsilonD) {
-            vel->parallelForEachWIndex([&](size_t i, size_t j, size_t k) {
-                Vector3D pt = wPos(i, j, k);
-                double fBuoy
-                    = _buoyancySmokeDensityFactor * den->sample(pt)
-                    + _buoyancyTemperatureFactor * (temp->sample(pt) - tAmb);
-                w(i, j, k) += timeIntervalInSeconds * fBuoy * up.z;
-            });
+            parallelFor(
+                lower.x, upper.x, lower.y, upper.y, lower.z, upper.z + 1,
+                [&](size_t i, size_t j, size_t k) {
+                    Vector3D pt = wPos(i, j, k);
+                    double fBuoy
+                        = _buoyancySmokeDensityFactor * den->sample(pt)
+                        + _buoyancyTemperatureFactor
+                        * (temp->sample(pt) - tAmb);
+                    w(i, j, k) += timeIntervalInSeconds * fBuoy * up.z;
+                });
         }
 
         applyBoundaryCondition();
     }
 }
+
+void GridSmokeSolver3::updateActiveRegion() {
+    auto grids = gridSystemData();
+    Size3 res = grids->resolution();
+
+    if (!_isUsingActiveRegion) {
+        _activeRegionLower = Point3UI(0, 0, 0);
+        _activeRegionUpper = Point3UI(res.x, res.y, res.z);
+        _activeRegion = grids->boundingBox();
+        return;
+    }
+
+    auto den = smokeDensity();
+    auto temp = temperature();
+    auto vel = velocity();
+    double speedThreshold2
+        = _activeRegionSpeedThreshold * _activeRegionSpeedThreshold;
+
+    // Find the cell-index bounds of the smoke and the moving air, and the sum
+    // of the temperature per z-slice in parallel. Including the moving air
+    // lets the region follow the flow that the smoke induces, so the velocity
+    // left outside of the region stays below the speed threshold.
+    std::vector<Point3UI> slabLower(res.z, Point3UI(kMaxSize, kMaxSize, 0));
+    std::vector<Point3UI> slabUpper(res.z, Point3UI(0, 0, 0));
+    std::vector<double> slabTemperature(res.z, 0.0);
+    parallelFor(kZeroSize, res.z, [&](size_t k) {
+        for (size_t j = 0; j < res.y; ++j) {
+            for (size_t i = 0; i < res.x; ++i) {
+                slabTemperature[k] += (*temp)(i, j, k);
+                if (std::fabs((*den)(i, j, k)) > _activeRegionThreshold
+                    || std::fabs((*temp)(i, j, k)) > _activeRegionThreshold
+                    || vel->valueAtCellCenter(i, j, k).lengthSquared()
+                        > speedThreshold2) {
+                    slabLower[k].x = std::min(slabLower[k].x, i);
+                    slabLower[k].y = std::min(slabLower[k].y, j);
+                    slabUpper[k].x = std::max(slabUpper[k].x, i + 1);
+                    slabUpper[k].y = std::max(slabUpper[k].y, j + 1);
+                }
+            }
+        }
+    });
+
+    Point3UI lower(kMaxSize, kMaxSize, kMaxSize);
+    Point3UI upper(0, 0, 0);
+    _ambientTemperature = 0.0;
+    for (size_t k = 0; k < res.z; ++k) {
+        _ambientTemperature += slabTemperature[k];
+        if (slabLower[k].x < slabUpper[k].x) {
+            lower.x = std::min(lower.x, slabLower[k].x);
+            lower.y = std::min(lower.y, slabLower[k].y);
+            lower.z = std::min(lower.z, k);
+            upper.x = std::max(upper.x, slabUpper[k].x);
+            upper.y = std::max(upper.y, slabUpper[k].y);
+            upper.z = std::max(upper.z, k + 1);
+        }
+    }
+
+    _ambientTemperature /= static_cast<double>(res.x * res.y * res.z);
+
+    if (lower.x >= upper.x) {
+        _activeRegionLower = Point3UI(0, 0, 0);
+        _activeRegionUpper = Point3UI(0, 0, 0);
+        _activeRegion.reset();
+        return;
+    }
+
+    // Dilate by the max distance the smoke can travel during a sub-step, plus
+    // the half-width of the cubic interpolation stencil.
+    size_t margin = static_cast<size_t>(std::ceil(maxCfl())) + 2;
+    for (size_t axis = 0; axis < 3; ++axis) {
+        lower[axis] = (lower[axis] > margin) ? lower[axis] - margin : 0;
+        upper[axis] = std::min(upper[axis] + margin, res[axis]);
+    }
+
+    Vector3D h = grids->gridSpacing();
+    Vector3D o = grids->origin();
+    _activeRegionLower = lower;
+    _activeRegionUpper = upper;
+    _activeRegion = BoundingBox3D(
+        o + h * Vector3D(lower.x, lower.y, lower.z),
+        o + h * Vector3D(upper.x, upper.y, upper.z));
+}
@@ -7,6 +7,7 @@ using namespace jet;
 
 GridSystemData3::GridSystemData3() {
     _velocity = std::make_shared<FaceCenteredGrid3>();
+    _velocityBackBuffer = std::make_shared<FaceCenteredGrid3>();
 }
 
 GridSystemData3::~GridSystemData3() {
@@ -17,6 +18,7 @@ void GridSystemData3::resize(
     const Vector3D& gridSpacing,
     const Vector3D& origin) {
     _velocity->resize(resolution, gridSpacing, origin);
+    _velocityBackBuffer->resize(resolution, gridSpacing, origin);
     for (auto& data : _scalarDataList) {
         data->resize(resolution, gridSpacing, origin);
     }
@@ -29,6 +31,12 @@ void GridSystemData3::resize(
     for (auto& data : _advectableVectorDataList) {
         data->resize(resolution, gridSpacing, origin);
     }
+    for (auto& data : _advectableScalarBackBufferList) {
+        data->resize(resolution, gridSpacing, origin);
+    }
+    for (auto& data : _advectableVectorBackBufferList) {
+        data->resize(resolution, gridSpacing, origin);
+    }
 }
 
 Size3 GridSystemData3::resolution() const {
@@ -71,6 +79,8 @@ size_t GridSystemData3::addAdvectableScalarData(
     size_t attrIdx = _advectableScalarDataList.size();
     _advectableScalarDataList.push_back(
         builder->build(resolution(), gridSpacing(), origin(), initialVal));
+    _advectableScalarBackBufferList.push_back(
+        builder->build(resolution(), gridSpacing(), origin(), initialVal));
     return attrIdx;
 }
 
@@ -80,6 +90,8 @@ size_t GridSystemData3::addAdvectableVectorData(
     size_t attrIdx = _advectableVectorDataList.size();
     _advectableVectorDataList.push_back(
         builder->build(resolution(), gridSpacing(), origin(), initialVal));
+    _advectableVectorBackBufferList.push_back(
+        builder->build(resolution(), gridSpacing(), origin(), initialVal));
     return attrIdx;
 }
 
@@ -120,3 +132,50 @@ size_t GridSystemData3::numberOfAdvectableScalarData() const {
 size_t GridSystemData3::numberOfAdvectableVectorData() const {
     return _advectableVectorDataList.size();
 }
+
+const FaceCenteredGrid3Ptr& GridSystemData3::velocityBackBuffer() {
+    // The front buffer can be resized directly by the user.
+    if (!_velocityBackBuffer->hasSameShape(*_velocity)) {
+        _velocityBackBuffer->resize(
+            _velocity->resolution(),
+            _velocity->gridSpacing(),
+            _velocity->origin());
+    }
+    return _velocityBackBuffer;
+}
+
+const ScalarGrid3Ptr&
+GridSystemData3::advectableScalarDataBackBufferAt(size_t idx) {
+    const ScalarGrid3Ptr& front = _advectableScalarDataList[idx];
+    const ScalarGrid3Ptr& back = _advectableScalarBackBufferList[idx];
+    if (!back->hasSameShape(*front)) {
+        back->resize(
+            front->resolution(), front->gridSpacing(), front->origin());
+    }
+    return back;
+}
+
+const VectorGrid3Ptr&
+GridSystemData3::advectableVectorDataBackBufferAt(size_t idx) {
+    const VectorGrid3Ptr& front = _advectableVectorDataList[idx];
+    const VectorGrid3Ptr& back = _advectableVectorBackBufferList[idx];
+    if (!back->hasSameShape(*front)) {
+        back->resize(
+            front->resolution(), front->gridSpacing(), front->origin());
+    }
+    return back;
+}
+
+void GridSystemData3::swapVelocityBuffers() {
+    _velocity->swap(_velocityBackBuffer.get());
+}
+
+void GridSystemData3::swapAdvectableScalarDataBuffersAt(size_t idx) {
+    _advectableScalarDataList[idx]->swap(
+        _advectableScalarBackBufferList[idx].get());
+}
+
+void GridSystemData3::swapAdvectableVectorDataBuffersAt(size_t idx) {
+    _advectableVectorDataList[idx]->swap(
+        _advectableVectorBackBufferList[idx].get());
+}
@@ -18,3 +18,7 @@ ImplicitSurface3::~ImplicitSurface3() {
 double ImplicitSurface3::closestDistance(const Vector3D& otherPoint) const {
     return std::fabs(signedDistance(otherPoint));
 }
+
+bool ImplicitSurface3::isClosed() const {
+    return true;
+}
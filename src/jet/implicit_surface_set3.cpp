@@ -27,89 +27,93 @@ const ImplicitSurface3Ptr& ImplicitSurfaceSet3::surfaceAt(size_t i) const {
 
 void ImplicitSurfaceSet3::addExplicitSurface(const Surface3Ptr& surface) {
     _surfaces.push_back(std::make_shared<SurfaceToImplicit3>(surface));
+    invalidateBvh();
 }
 
 void ImplicitSurfaceSet3::addSurface(const ImplicitSurface3Ptr& surface) {
     _surfaces.push_back(surface);
+    invalidateBvh();
 }
 
-Vector3D ImplicitSurfaceSet3::closestPoint(const Vector3D& otherPoint) const {
-    Vector3D result(
-        kMaxD,
-        kMaxD,
-        kMaxD);
-
-    double minimumDistance = kMaxD;
-
-    for (const auto& surface : _surfaces) {
-        Vector3D localClosestPoint = surface->closestPoint(otherPoint);
-        double localDistance = surface->closestDistance(otherPoint);
+void ImplicitSurfaceSet3::invalidateBvh() {
+    _surfaceBvh.invalidate();
+}
 
-        if (localDistance < minimumDistance) {
-            result = localClosestPoint;
-            minimumDistance = localDistance;
-        }
+Vector3D ImplicitSurfaceSet3::closestPoint(const Vector3D& otherPoint) const {
+    double distance;
+    size_t i = _surfaceBvh.closestSurface(_surfaces, otherPoint, &distance);
+    if (i == kMaxSize) {
+        return Vector3D(kMaxD, kMaxD, kMaxD);
     }
 
-    return result;
+    return _surfaces[i]->closestPoint(otherPoint);
 }
 
-double ImplicitSurfaceSet3::closestDistance(const Vector3D& otherPoint) const {
-    double minimumDistance = kMaxD;
-
-    for (const auto& surface : _surfaces) {
-        double localDistance = surface->closestDistance(otherPoint);
-        minimumDistance = std::min(localDistance, minimumDistance);
+Vector3D ImplicitSurfaceSet3::actualClosestNormal(
+    const Vector3D& otherPoint) const {
+    double distance;
+    size_t i = _surfaceBvh.closestSurface(_surfaces, otherPoint, &distance);
+    if (i == kMaxSize) {
+        return Vector3D(1, 0, 0);
     }
 
-    return minimumDistance;
+    return _surfaces[i]->closestNormal(otherPoint);
 }
 
-Vector3D ImplicitSurfaceSet3::actualClosestNormal(
+SurfaceClosestQueryResult3 ImplicitSurfaceSet3::actualClosestQuery(
     const Vector3D& otherPoint) const {
-    Vector3D result(1, 0, 0);
+    double distance;
+    size_t i = _surfaceBvh.closestSurface(_surfaces, otherPoint, &distance);
+    if (i == kMaxSize) {
+        return SurfaceClosestQueryResult3();
+    }
 
-    double minimumDistance = kMaxD;
+    SurfaceClosestQueryResult3 result = _surfaces[i]->closestQuery(otherPoint);
+    result.distance = distance;
+    return result;
+}
 
-    for (const auto& surface : _surfaces) {
-        Vector3D localClosestNormal = surface->closestNormal(otherPoint);
-        double localDistance = surface->closestDistance(otherPoint);
+double ImplicitSurfaceSet3::closestDistance(const Vector3D& otherPoint) const {
+    double distance;
+    _surfaceBvh.closestSurface(_surfaces, otherPoint, &distance);
+    return distance;
+}
 
-        if (localDistance < minimumDistance) {
-            result = localClosestNormal;
-            minimumDistance = localDistance;
-        }
+double ImplicitSurfaceSet3::signedDistance(const Vector3D& otherPoint) const {
+    double sdf = kMaxD;
+
+    // The clamped distance never goes below the distance to the box, so the
+    // nodes that are farther than the minimum are pruned. Once the point is
+    // inside any surface, only the boxes that contain the point are visited.
+    const Bvh3& bvh = _surfaceBvh.bvh(_surfaces);
+    const auto& bounded = _surfaceBvh.boundedSurfaces();
+    bvh.nearest(
+        otherPoint,
+        [&](size_t i, const Vector3D& pt) {
+            double d = _surfaces[bounded[i]]->signedDistance(pt);
+            sdf = std::min(sdf, d);
+            return std::max(d, 0.0);
+        });
+
+    for (size_t i : _surfaceBvh.unboundedSurfaces()) {
+        sdf = std::min(sdf, _surfaces[i]->signedDistance(otherPoint));
     }
 
-    return result;
+    return sdf;
 }
 
 bool ImplicitSurfaceSet3::intersects(const Ray3D& ray) const {
-    for (const auto& surface : _surfaces) {
-        if (surface->intersects(ray)) {
-            return true;
-        }
-    }
-
-    return false;
+    return _surfaceBvh.intersects(_surfaces, ray);
 }
 
 SurfaceRayIntersection3 ImplicitSurfaceSet3::actualClosestIntersection(
     const Ray3D& ray) const {
-    SurfaceRayIntersection3 intersection;
-    double tMin = kMaxD;
-
-    for (const auto& surface : _surfaces) {
-        SurfaceRayIntersection3 localResult =
-            surface->closestIntersection(ray);
-
-        if (localResult.isIntersecting && localResult.t < tMin) {
-            intersection = localResult;
-            tMin = localResult.t;
-        }
+    size_t i = _surfaceBvh.closestIntersection(_surfaces, ray);
+    if (i == kMaxSize) {
+        return SurfaceRayIntersection3();
     }
 
-    return intersection;
+    return _surfaces[i]->closestIntersection(ray);
 }
 
 BoundingBox3D ImplicitSurfaceSet3::boundingBox() const {
@@ -121,11 +125,20 @@ BoundingBox3D ImplicitSurfaceSet3::boundingBox() const {
     return bbox;
 }
 
-double ImplicitSurfaceSet3::signedDistance(const Vector3D& otherPoint) const {
-    double sdf = kMaxD;
+bool ImplicitSurfaceSet3::isClosed() const {
     for (const auto& surface : _surfaces) {
-        sdf = std::min(sdf, surface->signedDistance(otherPoint));
+        if (surface->isNormalFlipped || !surface->isClosed()) {
+            return false;
+        }
     }
 
-    return sdf;
+    return true;
+}
+
+void ImplicitSurfaceSet3::updateQueryEngine() {
+    for (const auto& surface : _surfaces) {
+        surface->updateQueryEngine();
+    }
+
+    _surfaceBvh.update(_surfaces);
 }
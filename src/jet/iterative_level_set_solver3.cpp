@@ -4,7 +4,9 @@
 #include <jet/array_utils.h>
 #include <jet/fdm_utils.h>
 #include <jet/iterative_level_set_solver3.h>
+#include <jet/level_set_utils.h>
 #include <jet/parallel.h>
+#include <jet/serial.h>
 
 #include <algorithm>
 #include <limits>
@@ -37,38 +39,64 @@ void IterativeLevelSetSolver3::reinitialize(
     copyRange3(
         inputSdf.constDataAccessor(), size.x, size.y, size.z, &outputAcc);
 
-    Array3<double> temp(size);
-    ArrayAccessor3<double> tempAcc = temp.accessor();
-
     JET_INFO << "Reinitializing with pseudoTimeStep: " << dtau
              << " numberOfIterations: " << numberOfIterations;
 
+    auto update = [&](size_t i, size_t j, size_t k) {
+        double s = sign(outputAcc, gridSpacing, i, j, k);
+
+        std::array<double, 2> dx, dy, dz;
+
+        getDerivatives(outputAcc, gridSpacing, i, j, k, &dx, &dy, &dz);
+
+        // Explicit Euler step
+        return outputAcc(i, j, k)
+            - dtau * std::max(s, 0.0)
+                * (std::sqrt(square(std::max(dx[0], 0.0))
+                           + square(std::min(dx[1], 0.0))
+                           + square(std::max(dy[0], 0.0))
+                           + square(std::min(dy[1], 0.0))
+                           + square(std::max(dz[0], 0.0))
+                           + square(std::min(dz[1], 0.0))) - 1.0)
+            - dtau * std::min(s, 0.0)
+                * (std::sqrt(square(std::min(dx[0], 0.0))
+                           + square(std::max(dx[1], 0.0))
+                           + square(std::min(dy[0], 0.0))
+                           + square(std::max(dy[1], 0.0))
+                           + square(std::min(dz[0], 0.0))
+                           + square(std::max(dz[1], 0.0))) - 1.0);
+    };
+
+    if (_isUsingNarrowBand) {
+        // Clamp the points outside of the band
+        outputSdf->parallelForEachDataPointIndex(
+            [&](size_t i, size_t j, size_t k) {
+                if (std::abs(outputAcc(i, j, k)) >= maxDistance) {
+                    outputAcc(i, j, k) = isInsideSdf(outputAcc(i, j, k))
+                        ? -maxDistance : maxDistance;
+                }
+            });
+
+        buildBand(size, [&](size_t i, size_t j, size_t k) {
+            return std::abs(outputAcc(i, j, k)) < maxDistance;
+        });
+
+        JET_INFO << "Number of points in the narrow band: " << _band.size();
+
+        for (unsigned int n = 0; n < numberOfIterations; ++n) {
+            iterateBand(update, outputAcc);
+        }
+
+        return;
+    }
+
+    Array3<double> temp(size);
+    ArrayAccessor3<double> tempAcc = temp.accessor();
+
     for (unsigned int n = 0; n < numberOfIterations; ++n) {
         inputSdf.parallelForEachDataPointIndex(
             [&](size_t i, size_t j, size_t k) {
-                double s = sign(outputAcc, gridSpacing, i, j, k);
-
-                std::array<double, 2> dx, dy, dz;
-
-                getDerivatives(outputAcc, gridSpacing, i, j, k, &dx, &dy, &dz);
-
-                // Explicit Euler step
-                double val = outputAcc(i, j, k)
-                    - dtau * std::max(s, 0.0)
-                        * (std::sqrt(square(std::max(dx[0], 0.0))
-                                   + square(std::min(dx[1], 0.0))
-                                   + square(std::max(dy[0], 0.0))
-                                   + square(std::min(dy[1], 0.0))
-                                   + square(std::max(dz[0], 0.0))
-                                   + square(std::min(dz[1], 0.0))) - 1.0)
-                    - dtau * std::min(s, 0.0)
-                        * (std::sqrt(square(std::min(dx[0], 0.0))
-                                   + square(std::max(dx[1], 0.0))
-                                   + square(std::min(dy[0], 0.0))
-                                   + square(std::max(dy[1], 0.0))
-                                   + square(std::min(dz[0], 0.0))
-                                   + square(std::max(dz[1], 0.0))) - 1.0);
-                tempAcc(i, j, k) = val;
+                tempAcc(i, j, k) = update(i, j, k);
             });
 
         std::swap(tempAcc, outputAcc);
@@ -223,6 +251,33 @@ void IterativeLevelSetSolver3::extrapolate(
 
     copyRange3(input, size.x, size.y, size.z, &outputAcc);
 
+    auto update = [&](size_t i, size_t j, size_t k) {
+        std::array<double, 2> dx, dy, dz;
+        Vector3D grad = gradient3(sdf, gridSpacing, i, j, k);
+
+        getDerivatives(outputAcc, gridSpacing, i, j, k, &dx, &dy, &dz);
+
+        return outputAcc(i, j, k)
+            - dtau * (std::max(grad.x, 0.0) * dx[0]
+                    + std::min(grad.x, 0.0) * dx[1]
+                    + std::max(grad.y, 0.0) * dy[0]
+                    + std::min(grad.y, 0.0) * dy[1]
+                    + std::max(grad.z, 0.0) * dz[0]
+                    + std::min(grad.z, 0.0) * dz[1]);
+    };
+
+    if (_isUsingNarrowBand) {
+        buildBand(size, [&](size_t i, size_t j, size_t k) {
+            return sdf(i, j, k) >= 0 && sdf(i, j, k) < maxDistance;
+        });
+
+        for (unsigned int n = 0; n < numberOfIterations; ++n) {
+            iterateBand(update, outputAcc);
+        }
+
+        return;
+    }
+
     Array3<double> temp(size);
     ArrayAccessor3<double> tempAcc = temp.accessor();
 
@@ -231,19 +286,7 @@ void IterativeLevelSetSolver3::extrapolate(
             kZeroSize, size.x, kZeroSize, size.y, kZeroSize, size.z,
             [&](size_t i, size_t j, size_t k) {
                 if (sdf(i, j, k) >= 0) {
-                    std::array<double, 2> dx, dy, dz;
-                    Vector3D grad = gradient3(sdf, gridSpacing, i, j, k);
-
-                    getDerivatives(
-                        outputAcc, gridSpacing, i, j, k, &dx, &dy, &dz);
-
-                    tempAcc(i, j, k) = outputAcc(i, j, k)
-                        - dtau * (std::max(grad.x, 0.0) * dx[0]
-                                + std::min(grad.x, 0.0) * dx[1]
-                                + std::max(grad.y, 0.0) * dy[0]
-                                + std::min(grad.y, 0.0) * dy[1]
-                                + std::max(grad.z, 0.0) * dz[0]
-                                + std::min(grad.z, 0.0) * dz[1]);
+                    tempAcc(i, j, k) = update(i, j, k);
                 } else {
                     tempAcc(i, j, k) = outputAcc(i, j, k);
                 }
@@ -263,6 +306,14 @@ void IterativeLevelSetSolver3::setMaxCfl(double newMaxCfl) {
     _maxCfl = std::max(newMaxCfl, 0.0);
 }
 
+bool IterativeLevelSetSolver3::isUsingNarrowBand() const {
+    return _isUsingNarrowBand;
+}
+
+void IterativeLevelSetSolver3::setIsUsingNarrowBand(bool isUsing) {
+    _isUsingNarrowBand = isUsing;
+}
+
 unsigned int IterativeLevelSetSolver3::distanceToNumberOfIterations(
     double distance,
     double dtau) {
@@ -305,3 +356,34 @@ double IterativeLevelSetSolver3::pseudoTimeStep(
 
     return dtau;
 }
+
+template <typename Callback>
+void IterativeLevelSetSolver3::buildBand(
+    const Size3& size,
+    const Callback& isInBand) {
+    _band.clear();
+    serialFor(
+        kZeroSize, size.x, kZeroSize, size.y, kZeroSize, size.z,
+        [&](size_t i, size_t j, size_t k) {
+            if (isInBand(i, j, k)) {
+                _band.push_back(Point3UI(i, j, k));
+            }
+        });
+    _bandValues.resize(_band.size());
+}
+
+template <typename Callback>
+void IterativeLevelSetSolver3::iterateBand(
+    const Callback& update,
+    ArrayAccessor3<double> output) {
+    // Jacobi-style update: all the new values are computed from the current
+    // ones before writing back, same as the full grid iteration.
+    parallelFor(kZeroSize, _band.size(), [&](size_t n) {
+        const Point3UI& idx = _band[n];
+        _bandValues[n] = update(idx.x, idx.y, idx.z);
+    });
+
+    parallelFor(kZeroSize, _band.size(), [&](size_t n) {
+        output(_band[n]) = _bandValues[n];
+    });
+}
@@ -3,20 +3,117 @@
 #include <pch.h>
 #include <jet/array_utils.h>
 #include <jet/eno_level_set_solver3.h>
-#include <jet/fmm_level_set_solver3.h>
+#include <jet/fdm_utils.h>
 #include <jet/level_set_liquid_solver3.h>
 #include <jet/level_set_utils.h>
+#include <jet/parallel.h>
 #include <jet/timer.h>
 
 #include <algorithm>
+#include <vector>
 
 using namespace jet;
 
+namespace {
+
+// Extrapolates the liquid velocity component to the air within the narrow band
+// of maxDistance and clamps the rest of the air to zero. Same as
+// FmmLevelSetSolver3, the weights of the neighbors are the upwind normal
+// components. Since a point only reads the neighbors with smaller SDF, the
+// band points can be solved in the increasing order of SDF, which replaces the
+// full-grid markers and the priority queue with a sort of the band.
+void extrapolateToNarrowBand(
+    const ScalarField3& sdf,
+    const Grid3::DataPositionFunc& pos,
+    const Vector3D& gridSpacing,
+    double maxDistance,
+    ArrayAccessor3<double> data) {
+    const Size3 size = data.size();
+    const Vector3D invGridSpacing = 1.0 / gridSpacing;
+
+    Array3<double> phi(size);
+    phi.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        phi(i, j, k) = sdf.sample(pos(i, j, k));
+        if (!isInsideSdf(phi(i, j, k))) {
+            data(i, j, k) = 0.0;
+        }
+    });
+
+    std::vector<Point3UI> band;
+    phi.forEachIndex([&](size_t i, size_t j, size_t k) {
+        if (!isInsideSdf(phi(i, j, k)) && phi(i, j, k) < maxDistance) {
+            band.push_back(Point3UI(i, j, k));
+        }
+    });
+
+    parallelSort(
+        band.begin(),
+        band.end(),
+        [&](const Point3UI& a, const Point3UI& b) {
+            return phi(a) < phi(b);
+        });
+
+    for (const Point3UI& idx : band) {
+        const size_t i = idx.x;
+        const size_t j = idx.y;
+        const size_t k = idx.z;
+        const double phi0 = phi(i, j, k);
+
+        Vector3D normal = gradient3(phi, gridSpacing, i, j, k);
+        const double length = normal.length();
+        if (length > 0.0) {
+            normal /= length;
+        }
+
+        double sum = 0.0;
+        double weightSum = 0.0;
+
+        auto addValue = [&](size_t ni, size_t nj, size_t nk, double weight) {
+            if (phi(ni, nj, nk) < phi0) {
+                // If gradient is zero, then just assign 1 to weight
+                if (weight < kEpsilonD) {
+                    weight = 1.0;
+                }
+
+                sum += weight * data(ni, nj, nk);
+                weightSum += weight;
+            }
+        };
+
+        if (i > 0) {
+            addValue(i - 1, j, k, std::max(normal.x, 0.0) * invGridSpacing.x);
+        }
+        if (i + 1 < size.x) {
+            addValue(i + 1, j, k, -std::min(normal.x, 0.0) * invGridSpacing.x);
+        }
+        if (j > 0) {
+            addValue(i, j - 1, k, std::max(normal.y, 0.0) * invGridSpacing.y);
+        }
+        if (j + 1 < size.y) {
+            addValue(i, j + 1, k, -std::min(normal.y, 0.0) * invGridSpacing.y);
+        }
+        if (k > 0) {
+            addValue(i, j, k - 1, std::max(normal.z, 0.0) * invGridSpacing.z);
+        }
+        if (k + 1 < size.z) {
+            addValue(i, j, k + 1, -std::min(normal.z, 0.0) * invGridSpacing.z);
+        }
+
+        if (weightSum > 0.0) {
+            data(i, j, k) = sum / weightSum;
+        }
+    }
+}
+
+}  // namespace
+
 LevelSetLiquidSolver3::LevelSetLiquidSolver3() {
     auto grids = gridSystemData();
     _signedDistanceFieldId = grids->addAdvectableScalarData(
         CellCenteredScalarGrid3::builder(), kMaxD);
-    _levelSetSolver = std::make_shared<EnoLevelSetSolver3>();
+    auto levelSetSolver = std::make_shared<EnoLevelSetSolver3>();
+    levelSetSolver->setIsUsingNarrowBand(true);
+    _levelSetSolver = levelSetSolver;
 }
 
 LevelSetLiquidSolver3::~LevelSetLiquidSolver3() {
@@ -101,7 +198,8 @@ ScalarField3Ptr LevelSetLiquidSolver3::fluidSdf() const {
 void LevelSetLiquidSolver3::reinitialize(double currentCfl) {
     if (_levelSetSolver != nullptr) {
         auto sdf = signedDistanceField();
-        auto sdf0 = sdf->clone();
+        auto sdf1 = gridSystemData()->advectableScalarDataBackBufferAt(
+            _signedDistanceFieldId);
 
         const Vector3D gridSpacing = sdf->gridSpacing();
         const double h = max3(gridSpacing.x, gridSpacing.y, gridSpacing.z);
@@ -109,7 +207,9 @@ void LevelSetLiquidSolver3::reinitialize(double currentCfl) {
             = std::max(2.0 * currentCfl, _minReinitializeDistance) * h;
 
         _levelSetSolver->reinitialize(
-            *sdf0, maxReinitDist, sdf.get());
+            *sdf, maxReinitDist, sdf1.get());
+        gridSystemData()->swapAdvectableScalarDataBuffersAt(
+            _signedDistanceFieldId);
         extrapolateIntoCollider(sdf.get());
     }
 }
@@ -118,44 +218,6 @@ void LevelSetLiquidSolver3::extrapolateVelocityToAir(double currentCfl) {
     auto sdf = signedDistanceField();
     auto vel = gridSystemData()->velocity();
 
-    auto u = vel->uAccessor();
-    auto v = vel->vAccessor();
-    auto w = vel->wAccessor();
-    auto uPos = vel->uPosition();
-    auto vPos = vel->vPosition();
-    auto wPos = vel->wPosition();
-
-    Array3<char> uMarker(u.size());
-    Array3<char> vMarker(v.size());
-    Array3<char> wMarker(w.size());
-
-    uMarker.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        if (isInsideSdf(sdf->sample(uPos(i, j, k)))) {
-            uMarker(i, j, k) = 1;
-        } else {
-            uMarker(i, j, k) = 0;
-            u(i, j, k) = 0;
-        }
-    });
-
-    vMarker.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        if (isInsideSdf(sdf->sample(vPos(i, j, k)))) {
-            vMarker(i, j, k) = 1;
-        } else {
-            vMarker(i, j, k) = 0;
-            v(i, j, k) = 0;
-        }
-    });
-
-    wMarker.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        if (isInsideSdf(sdf->sample(wPos(i, j, k)))) {
-            wMarker(i, j, k) = 1;
-        } else {
-            wMarker(i, j, k) = 0;
-            w(i, j, k) = 0;
-        }
-    });
-
     const Vector3D gridSpacing = sdf->gridSpacing();
     const double h = max3(gridSpacing.x, gridSpacing.y, gridSpacing.z);
     const double maxDist
@@ -163,8 +225,12 @@ void LevelSetLiquidSolver3::extrapolateVelocityToAir(double currentCfl) {
 
     JET_INFO << "Max velocity extrapolation distance: " << maxDist;
 
-    FmmLevelSetSolver3 fmmSolver;
-    fmmSolver.extrapolate(*vel, *sdf, maxDist, vel.get());
+    extrapolateToNarrowBand(
+        *sdf, vel->uPosition(), gridSpacing, maxDist, vel->uAccessor());
+    extrapolateToNarrowBand(
+        *sdf, vel->vPosition(), gridSpacing, maxDist, vel->vAccessor());
+    extrapolateToNarrowBand(
+        *sdf, vel->wPosition(), gridSpacing, maxDist, vel->wAccessor());
 
     applyBoundaryCondition();
 }
@@ -0,0 +1,271 @@
+// Copyright (c) 2016 Doyub Kim
+
+#include <pch.h>
+#include <advection_helpers.h>
+#include <jet/array3.h>
+#include <jet/array_samplers3.h>
+#include <jet/mac_cormack3.h>
+#include <jet/math_utils.h>
+#include <jet/parallel.h>
+#include <algorithm>
+#include <array>
+
+using namespace jet;
+
+namespace {
+
+inline double elementMin(double a, double b) {
+    return std::min(a, b);
+}
+
+inline Vector3D elementMin(const Vector3D& a, const Vector3D& b) {
+    return min(a, b);
+}
+
+inline double elementMax(double a, double b) {
+    return std::max(a, b);
+}
+
+inline Vector3D elementMax(const Vector3D& a, const Vector3D& b) {
+    return max(a, b);
+}
+
+inline double limit(
+    double value,
+    double lower,
+    double upper,
+    double fallback,
+    MacCormack3::Limiter limiter) {
+    if (limiter == MacCormack3::kClampLimiter) {
+        return clamp(value, lower, upper);
+    } else if (limiter == MacCormack3::kRevertLimiter
+        && (value < lower || value > upper)) {
+        return fallback;
+    } else {
+        return value;
+    }
+}
+
+inline Vector3D limit(
+    const Vector3D& value,
+    const Vector3D& lower,
+    const Vector3D& upper,
+    const Vector3D& fallback,
+    MacCormack3::Limiter limiter) {
+    return Vector3D(
+        limit(value.x, lower.x, upper.x, fallback.x, limiter),
+        limit(value.y, lower.y, upper.y, fallback.y, limiter),
+        limit(value.z, lower.z, upper.z, fallback.z, limiter));
+}
+
+}  // namespace
+
+MacCormack3::MacCormack3() {
+}
+
+MacCormack3::MacCormack3(bool isUsingBfecc) : _isUsingBfecc(isUsingBfecc) {
+}
+
+MacCormack3::~MacCormack3() {
+}
+
+MacCormack3::Limiter MacCormack3::limiter() const {
+    return _limiter;
+}
+
+void MacCormack3::setLimiter(Limiter limiter) {
+    _limiter = limiter;
+}
+
+void MacCormack3::advect(
+    const ScalarGrid3& input,
+    const VectorField3& flow,
+    double dt,
+    ScalarGrid3* output,
+    const ScalarField3& boundarySdf) {
+    JET_THROW_INVALID_ARG_IF(!input.hasSameShape(*output));
+
+    advectData(
+        input.constDataAccessor(),
+        input.dataOrigin(),
+        input.gridSpacing(),
+        flow,
+        dt,
+        output->dataAccessor(),
+        boundarySdf,
+        &_scalarBuffers);
+}
+
+void MacCormack3::advect(
+    const CollocatedVectorGrid3& input,
+    const VectorField3& flow,
+    double dt,
+    CollocatedVectorGrid3* output,
+    const ScalarField3& boundarySdf) {
+    JET_THROW_INVALID_ARG_IF(!input.hasSameShape(*output));
+
+    advectData(
+        input.constDataAccessor(),
+        input.dataOrigin(),
+        input.gridSpacing(),
+        flow,
+        dt,
+        output->dataAccessor(),
+        boundarySdf,
+        &_vectorBuffers);
+}
+
+void MacCormack3::advect(
+    const FaceCenteredGrid3& input,
+    const VectorField3& flow,
+    double dt,
+    FaceCenteredGrid3* output,
+    const ScalarField3& boundarySdf) {
+    JET_THROW_INVALID_ARG_IF(!input.hasSameShape(*output));
+
+    advectData(
+        input.uConstAccessor(),
+        input.uOrigin(),
+        input.gridSpacing(),
+        flow,
+        dt,
+        output->uAccessor(),
+        boundarySdf,
+        &_faceBuffers[0]);
+    advectData(
+        input.vConstAccessor(),
+        input.vOrigin(),
+        input.gridSpacing(),
+        flow,
+        dt,
+        output->vAccessor(),
+        boundarySdf,
+        &_faceBuffers[1]);
+    advectData(
+        input.wConstAccessor(),
+        input.wOrigin(),
+        input.gridSpacing(),
+        flow,
+        dt,
+        output->wAccessor(),
+        boundarySdf,
+        &_faceBuffers[2]);
+}
+
+template <typename T>
+void MacCormack3::advectData(
+    const ConstArrayAccessor3<T>& input,
+    const Vector3D& origin,
+    const Vector3D& gridSpacing,
+    const VectorField3& flow,
+    double dt,
+    ArrayAccessor3<T> output,
+    const ScalarField3& boundarySdf,
+    Buffers<T>* buffers) const {
+    const Size3 size = input.size();
+    const double h = min3(gridSpacing.x, gridSpacing.y, gridSpacing.z);
+
+    // Every element is overwritten below, so the arrays are only resized
+    if (buffers->points.size() != size) {
+        buffers->points.resize(size);
+        buffers->isTraced.resize(size);
+        buffers->forward.resize(size);
+        buffers->backward.resize(size);
+    }
+
+    Array3<Vector3D>& points = buffers->points;
+    Array3<char>& isTraced = buffers->isTraced;
+    Array3<T>& forward = buffers->forward;
+    Array3<T>& backward = buffers->backward;
+
+    auto pos = [&](size_t i, size_t j, size_t k) {
+        return origin + gridSpacing * Vector3D({i, j, k});
+    };
+
+    // Forward semi-Lagrangian step
+    LinearArraySampler3<T, double> inputSampler(input, gridSpacing, origin);
+    parallelFor(
+        kZeroSize, size.x,
+        kZeroSize, size.y,
+        kZeroSize, size.z,
+        [&](size_t i, size_t j, size_t k) {
+            Vector3D x = pos(i, j, k);
+            if (boundarySdf.sample(x) > 0.0) {
+                points(i, j, k)
+                    = backTraceMidPoint(flow, dt, h, x, boundarySdf);
+                isTraced(i, j, k) = 1;
+                forward(i, j, k) = inputSampler(points(i, j, k));
+            } else {
+                isTraced(i, j, k) = 0;
+                forward(i, j, k) = input(i, j, k);
+            }
+        });
+
+    // Backward semi-Lagrangian step from the forward result
+    LinearArraySampler3<T, double> forwardSampler(
+        forward.constAccessor(), gridSpacing, origin);
+    parallelFor(
+        kZeroSize, size.x,
+        kZeroSize, size.y,
+        kZeroSize, size.z,
+        [&](size_t i, size_t j, size_t k) {
+            if (isTraced(i, j, k)) {
+                Vector3D x = backTraceMidPoint(
+                    flow, -dt, h, pos(i, j, k), boundarySdf);
+                backward(i, j, k) = forwardSampler(x);
+            } else {
+                backward(i, j, k) = forward(i, j, k);
+            }
+        });
+
+    if (_isUsingBfecc) {
+        // Compensate the input with half of the round-trip error, and store
+        // it in place of the backward result.
+        backward.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+            backward(i, j, k)
+                = input(i, j, k) + 0.5 * (input(i, j, k) - backward(i, j, k));
+        });
+    }
+
+    // Error compensation and limiting
+    LinearArraySampler3<T, double> compensatedSampler(
+        backward.constAccessor(), gridSpacing, origin);
+    parallelFor(
+        kZeroSize, size.x,
+        kZeroSize, size.y,
+        kZeroSize, size.z,
+        [&](size_t i, size_t j, size_t k) {
+            if (!isTraced(i, j, k)) {
+                output(i, j, k) = input(i, j, k);
+                return;
+            }
+
+            const Vector3D& x = points(i, j, k);
+
+            T value;
+            if (_isUsingBfecc) {
+                value = compensatedSampler(x);
+            } else {
+                value = forward(i, j, k)
+                    + 0.5 * (input(i, j, k) - backward(i, j, k));
+            }
+
+            if (_limiter != kNoLimiter) {
+                // Range of the input values around the back-traced point
+                std::array<Point3UI, 8> indices;
+                std::array<double, 8> weights;
+                inputSampler.getCoordinatesAndWeights(x, &indices, &weights);
+
+                T lower = input(indices[0]);
+                T upper = lower;
+                for (size_t n = 1; n < 8; ++n) {
+                    lower = elementMin(lower, input(indices[n]));
+                    upper = elementMax(upper, input(indices[n]));
+                }
+
+                value = limit(value, lower, upper, forward(i, j, k), _limiter);
+            }
+
+            output(i, j, k) = value;
+        });
+}
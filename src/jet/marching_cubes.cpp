@@ -22,9 +22,13 @@
 #include <jet/bounding_box3.h>
 #include <jet/level_set_utils.h>
 #include <jet/marching_cubes.h>
+#include <jet/parallel.h>
 
+#include <algorithm>
 #include <array>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace jet {
 
@@ -100,20 +104,19 @@ inline Vector3D safeNormalize(const Vector3D& n) {
 // |----*----|    -->    |-----|-----|
 // i        i+1         2i   2i+1  2i+2
 //
+// See edgeConnection in marching_cubes_table.h for the edge ordering.
+static const int edgeOffset3D[12][3] = {
+    {1, 0, 0}, {2, 0, 1}, {1, 0, 2}, {0, 0, 1},
+    {1, 2, 0}, {2, 2, 1}, {1, 2, 2}, {0, 2, 1},
+    {0, 1, 0}, {2, 1, 0}, {2, 1, 2}, {0, 1, 2}
+};
+
 inline size_t globalEdgeId(
     size_t i,
     size_t j,
     size_t k,
     const Size3& dim,
     size_t localEdgeId) {
-
-    // See edgeConnection in marching_cubes_table.h for the edge ordering.
-    static const int edgeOffset3D[12][3] = {
-        {1, 0, 0}, {2, 0, 1}, {1, 0, 2}, {0, 0, 1},
-        {1, 2, 0}, {2, 2, 1}, {1, 2, 2}, {0, 2, 1},
-        {0, 1, 0}, {2, 1, 0}, {2, 1, 2}, {0, 1, 2}
-    };
-
     return ((2 * k + edgeOffset3D[localEdgeId][2]) * 2 * dim.y
         + (2 * j + edgeOffset3D[localEdgeId][1])) * 2 * dim.x
         + (2 * i + edgeOffset3D[localEdgeId][0]);
@@ -250,38 +253,24 @@ static void singleSquare(
     }
 }
 
-static void singleCube(
+// Computes the iso-surface positions and normals on the edges of the cube
+// that cross the surface. Only the crossing edges of e and n are written.
+static void cubeEdgeVertices(
     const std::array<double, 8>& data,
-    const std::array<size_t, 12>& edgeIds,
     const std::array<Vector3D, 8>& normals,
     const BoundingBox3D& bound,
-    MarchingCubeVertexMap* vertexMap,
-    TriangleMesh3* mesh,
-    double isoValue) {
-    int itrVertex, itrEdge, itrTri;
-    int idxFlagSize = 0, idxEdgeFlags = 0;
+    int idxFlagSize,
+    double isoValue,
+    Vector3D* e,
+    Vector3D* n) {
+    int itrEdge;
+    int idxEdgeFlags = 0;
     int idxVertexOfTheEdge[2];
 
     Vector3D pos, pos0, pos1, normal, normal0, normal1;
     double phi0, phi1;
     double alpha;
-    Vector3D e[12], n[12];
-
-    // Which vertices are inside? If i-th vertex is inside, mark '1' at i-th
-    // bit. of 'idxFlagSize'.
-    for (itrVertex = 0; itrVertex < 8; itrVertex++) {
-        if (data[itrVertex] <= isoValue) {
-            idxFlagSize |= 1 << itrVertex;
-        }
-    }
-
-    // If the cube is entirely inside or outside of the surface, there is no job
-    // to be done in t1his marching-cube cell.
-    if (idxFlagSize == 0 || idxFlagSize == 255) {
-        return;
-    }
 
-    // If there are vertices which is inside the surface...
     // Which edges intersect the surface? If i-th edge intersects the surface,
     // mark '1' at i-th bit of 'itrEdgeFlags'
     idxEdgeFlags = cubeEdgeFlags[idxFlagSize];
@@ -322,36 +311,284 @@ static void singleCube(
             n[itrEdge] = normal;
         }
     }
+}
 
-    // Make triangles
-    for (itrTri = 0; itrTri < 5; ++itrTri) {
-        // If there isn't any triangle to be made, escape this loop.
-        if (triangleConnectionTable3D[idxFlagSize][3 * itrTri] < 0) {
-            break;
+// Which vertices are inside? If i-th vertex is inside, mark '1' at i-th bit.
+static int cubeVertexFlags(
+    const ConstArrayAccessor3<double>& grid,
+    size_t i,
+    size_t j,
+    size_t k,
+    double isoValue) {
+    int idxFlagSize = 0;
+    if (grid(i, j, k) <= isoValue) idxFlagSize |= 1 << 0;
+    if (grid(i + 1, j, k) <= isoValue) idxFlagSize |= 1 << 1;
+    if (grid(i + 1, j, k + 1) <= isoValue) idxFlagSize |= 1 << 2;
+    if (grid(i, j, k + 1) <= isoValue) idxFlagSize |= 1 << 3;
+    if (grid(i, j + 1, k) <= isoValue) idxFlagSize |= 1 << 4;
+    if (grid(i + 1, j + 1, k) <= isoValue) idxFlagSize |= 1 << 5;
+    if (grid(i + 1, j + 1, k + 1) <= isoValue) idxFlagSize |= 1 << 6;
+    if (grid(i, j + 1, k + 1) <= isoValue) idxFlagSize |= 1 << 7;
+    return idxFlagSize;
+}
+
+// A slab is a layer of cells between two x-y planes of the grid. Each edge
+// of a slab lies either on its bottom plane, on its top plane, or in between.
+// The edges on a plane are indexed as j * dim.x + i for x-edges and
+// (dim.y + j) * dim.x + i for y-edges, and the edges in between as
+// j * dim.x + i.
+enum MarchingCubesSlabEdgePlane {
+    kSlabEdgeBottom = 0,
+    kSlabEdgeMiddle = 1,
+    kSlabEdgeTop = 2
+};
+
+inline size_t slabEdgeIndex(
+    size_t i,
+    size_t j,
+    const Size3& dim,
+    size_t localEdgeId,
+    int* plane) {
+    const int* offset = edgeOffset3D[localEdgeId];
+    size_t ii = i + offset[0] / 2;
+    size_t jj = j + offset[1] / 2;
+    *plane = offset[2];
+    if (offset[2] != kSlabEdgeMiddle && offset[1] == 1) {
+        return (dim.y + jj) * dim.x + ii;
+    }
+    return jj * dim.x + ii;
+}
+
+struct MarchingCubesSlab {
+    std::vector<Vector3D> points;
+    std::vector<Vector3D> normals;
+
+    // Three corners per triangle. A corner is the index of the point in this
+    // slab, or the bottom plane edge index if the vertex belongs to the
+    // previous slab.
+    std::vector<size_t> faces;
+    std::vector<char> isSharedCorner;
+
+    // Pairs of the top plane edge index and the point index, sorted by the
+    // edge index.
+    std::vector<std::pair<size_t, size_t>> topVertices;
+};
+
+// Blocks of cells that the surface may cross. If all the grid points of a
+// block are on the same side of the iso-surface, none of its cells produce
+// triangles, so they are skipped without being classified one by one.
+class MarchingCubesActiveBlocks {
+ public:
+    static const size_t kBlockSize = 8;
+
+    MarchingCubesActiveBlocks(
+        const ConstArrayAccessor3<double>& grid,
+        double isoValue) {
+        const Size3 dim = grid.size();
+        _numberOfCells = Size3(dim.x - 1, dim.y - 1, dim.z - 1);
+        _numberOfBlocks = Size3(
+            (_numberOfCells.x + kBlockSize - 1) / kBlockSize,
+            (_numberOfCells.y + kBlockSize - 1) / kBlockSize,
+            (_numberOfCells.z + kBlockSize - 1) / kBlockSize);
+        _activeBlocks.resize(_numberOfBlocks.y * _numberOfBlocks.z);
+
+        parallelFor(kZeroSize, _activeBlocks.size(), [&](size_t row) {
+            const size_t bj = row % _numberOfBlocks.y;
+            const size_t bk = row / _numberOfBlocks.y;
+            for (size_t bi = 0; bi < _numberOfBlocks.x; ++bi) {
+                if (isActive(grid, isoValue, bi, bj, bk)) {
+                    _activeBlocks[row].push_back(bi);
+                }
+            }
+        });
+    }
+
+    // Calls the callback for the cells (i, j, k) in the active blocks, in the
+    // same order as the full traversal.
+    template <typename Callback>
+    void forEachActiveCell(size_t k, const Callback& callback) const {
+        const size_t bk = k / kBlockSize;
+        for (size_t j = 0; j < _numberOfCells.y; ++j) {
+            const size_t bj = j / kBlockSize;
+            for (size_t bi : _activeBlocks[bk * _numberOfBlocks.y + bj]) {
+                const size_t iEnd
+                    = std::min((bi + 1) * kBlockSize, _numberOfCells.x);
+                for (size_t i = bi * kBlockSize; i < iEnd; ++i) {
+                    callback(i, j);
+                }
+            }
         }
+    }
 
-        Point3UI face;
+ private:
+    Size3 _numberOfCells;
+    Size3 _numberOfBlocks;
+
+    // Indices of the active blocks along x for each row of blocks (bj, bk)
+    std::vector<std::vector<size_t>> _activeBlocks;
+
+    bool isActive(
+        const ConstArrayAccessor3<double>& grid,
+        double isoValue,
+        size_t bi,
+        size_t bj,
+        size_t bk) const {
+        const size_t iBegin = bi * kBlockSize;
+        const size_t jBegin = bj * kBlockSize;
+        const size_t kBegin = bk * kBlockSize;
+        const size_t iEnd = std::min(iBegin + kBlockSize, _numberOfCells.x);
+        const size_t jEnd = std::min(jBegin + kBlockSize, _numberOfCells.y);
+        const size_t kEnd = std::min(kBegin + kBlockSize, _numberOfCells.z);
+
+        bool hasInside = false;
+        bool hasOutside = false;
+        for (size_t k = kBegin; k <= kEnd; ++k) {
+            for (size_t j = jBegin; j <= jEnd; ++j) {
+                for (size_t i = iBegin; i <= iEnd; ++i) {
+                    if (grid(i, j, k) <= isoValue) {
+                        hasInside = true;
+                    } else {
+                        hasOutside = true;
+                    }
+                }
+                if (hasInside && hasOutside) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+};
 
-        for (int j = 0; j < 3; j++) {
-            int k = 3 * itrTri + j;
-            MarchingCubeVertexHashKey vKey
-                = edgeIds[triangleConnectionTable3D[idxFlagSize][k]];
-            MarchingCubeVertexId vId;
-            if (queryVertexId(*vertexMap, vKey, &vId)) {
-                face[j] = vId;
-            } else {
-                // If vertex does not exist from the map
-                face[j] = mesh->numberOfPoints();
-                mesh->addNormal(
-                    safeNormalize(
-                        n[triangleConnectionTable3D[idxFlagSize][k]]));
-                mesh->addPoint(
-                    e[triangleConnectionTable3D[idxFlagSize][k]]);
-                mesh->addUv(Vector2D());
-                vertexMap->insert(std::make_pair(vKey, face[j]));
+// Extracts the triangles of the slabs in [kBegin, kEnd). Vertices are created
+// at their first use in the cell order, same as the serial traversal, so that
+// the output does not depend on how the slabs are distributed.
+static void marchingCubesSlabs(
+    const ConstArrayAccessor3<double>& grid,
+    const Vector3D& gridSize,
+    const Vector3D& origin,
+    double isoValue,
+    const MarchingCubesActiveBlocks& blocks,
+    size_t kBegin,
+    size_t kEnd,
+    std::vector<MarchingCubesSlab>* slabs) {
+    const Size3 dim = grid.size();
+    const Vector3D invGridSize = 1.0 / gridSize;
+    const size_t planeSize = 2 * dim.x * dim.y;
+
+    auto pos = [origin, gridSize](size_t i, size_t j, size_t k) {
+        return origin + gridSize * Vector3D({i, j, k});
+    };
+
+    // Point indices of the edges for the bottom, middle, and top planes
+    std::vector<size_t> pointIds[3] = {
+        std::vector<size_t>(planeSize, kMaxSize),
+        std::vector<size_t>(dim.x * dim.y, kMaxSize),
+        std::vector<size_t>(planeSize, kMaxSize)
+    };
+    std::vector<std::pair<int, size_t>> usedEdges;
+
+    // Bottom plane edges that are already used by the previous slab
+    std::vector<char> isSharedEdge(planeSize, 0);
+    std::vector<size_t> sharedEdges;
+
+    for (size_t k = kBegin; k < kEnd; ++k) {
+        MarchingCubesSlab& slab = (*slabs)[k];
+
+        if (k > 0) {
+            blocks.forEachActiveCell(k - 1, [&](size_t i, size_t j) {
+                int idxFlagSize = cubeVertexFlags(grid, i, j, k - 1, isoValue);
+                const int* triangles = triangleConnectionTable3D[idxFlagSize];
+                for (int c = 0; c < 15 && triangles[c] >= 0; ++c) {
+                    int plane;
+                    size_t index = slabEdgeIndex(
+                        i, j, dim, triangles[c], &plane);
+                    if (plane == kSlabEdgeTop && !isSharedEdge[index]) {
+                        isSharedEdge[index] = 1;
+                        sharedEdges.push_back(index);
+                    }
+                }
+            });
+        }
+
+        blocks.forEachActiveCell(k, [&](size_t i, size_t j) {
+            // If the cube is entirely inside or outside of the surface,
+            // there is no job to be done in this marching-cube cell.
+            int idxFlagSize = cubeVertexFlags(grid, i, j, k, isoValue);
+            if (idxFlagSize == 0 || idxFlagSize == 255) {
+                return;
+            }
+
+            std::array<double, 8> data;
+            std::array<Vector3D, 8> normals;
+            BoundingBox3D bound;
+
+            data[0] = grid(i, j, k);
+            data[1] = grid(i + 1, j, k);
+            data[4] = grid(i, j + 1, k);
+            data[5] = grid(i + 1, j + 1, k);
+            data[3] = grid(i, j, k + 1);
+            data[2] = grid(i + 1, j, k + 1);
+            data[7] = grid(i, j + 1, k + 1);
+            data[6] = grid(i + 1, j + 1, k + 1);
+
+            normals[0] = grad(grid, i, j, k, invGridSize);
+            normals[1] = grad(grid, i + 1, j, k, invGridSize);
+            normals[4] = grad(grid, i, j + 1, k, invGridSize);
+            normals[5] = grad(grid, i + 1, j + 1, k, invGridSize);
+            normals[3] = grad(grid, i, j, k + 1, invGridSize);
+            normals[2] = grad(grid, i + 1, j, k + 1, invGridSize);
+            normals[7] = grad(grid, i, j + 1, k + 1, invGridSize);
+            normals[6] = grad(grid, i + 1, j + 1, k + 1, invGridSize);
+
+            bound.lowerCorner = pos(i, j, k);
+            bound.upperCorner = pos(i + 1, j + 1, k + 1);
+
+            Vector3D e[12], n[12];
+            cubeEdgeVertices(data, normals, bound, idxFlagSize, isoValue, e, n);
+
+            // Make triangles
+            const int* triangles = triangleConnectionTable3D[idxFlagSize];
+            for (int c = 0; c < 15 && triangles[c] >= 0; ++c) {
+                int plane;
+                size_t index = slabEdgeIndex(i, j, dim, triangles[c], &plane);
+
+                if (plane == kSlabEdgeBottom && isSharedEdge[index]) {
+                    slab.faces.push_back(index);
+                    slab.isSharedCorner.push_back(1);
+                    continue;
+                }
+
+                size_t& pointId = pointIds[plane][index];
+                if (pointId == kMaxSize) {
+                    pointId = slab.points.size();
+                    slab.points.push_back(e[triangles[c]]);
+                    slab.normals.push_back(safeNormalize(n[triangles[c]]));
+                    usedEdges.push_back(std::make_pair(plane, index));
+                }
+
+                slab.faces.push_back(pointId);
+                slab.isSharedCorner.push_back(0);
             }
+        });
+
+        // Keep the top plane vertices for the next slab and reset the
+        // buffers for the next iteration.
+        for (const auto& edge : usedEdges) {
+            size_t& pointId = pointIds[edge.first][edge.second];
+            if (edge.first == kSlabEdgeTop) {
+                slab.topVertices.push_back(
+                    std::make_pair(edge.second, pointId));
+            }
+            pointId = kMaxSize;
         }
-        mesh->addPointNormalUvTriangle(face, face, face);
+        std::sort(slab.topVertices.begin(), slab.topVertices.end());
+        usedEdges.clear();
+
+        for (size_t index : sharedEdges) {
+            isSharedEdge[index] = 0;
+        }
+        sharedEdges.clear();
     }
 }
 
@@ -365,7 +602,6 @@ void marchingCubes(
     MarchingCubeVertexMap vertexMap;
 
     const Size3 dim = grid.size();
-    const Vector3D invGridSize = 1.0 / gridSize;
 
     auto pos = [origin, gridSize](ssize_t i, ssize_t j, ssize_t k) {
         return origin + gridSize * Vector3D({i, j, k});
@@ -375,50 +611,73 @@ void marchingCubes(
     ssize_t dimy = static_cast<ssize_t>(dim.y);
     ssize_t dimz = static_cast<ssize_t>(dim.z);
 
-    for (ssize_t k = 0; k < dimz - 1; ++k) {
-        for (ssize_t j = 0; j < dimy - 1; ++j) {
-            for (ssize_t i = 0; i < dimx - 1; ++i) {
-                std::array<double, 8> data;
-                std::array<size_t, 12> edgeIds;
-                std::array<Vector3D, 8>  normals;
-                BoundingBox3D bound;
+    if (dim.x > 1 && dim.y > 1 && dim.z > 1) {
+        const size_t numberOfSlabs = dim.z - 1;
+        std::vector<MarchingCubesSlab> slabs(numberOfSlabs);
+
+        MarchingCubesActiveBlocks blocks(grid, isoValue);
+
+        // Make twice as many chunks of slabs as the threads to balance the
+        // load, since the surface is rarely spread evenly along z.
+        size_t numThreads = maxNumberOfThreads();
+        size_t numberOfChunks = std::min(2 * numThreads, numberOfSlabs);
+        size_t chunkSize
+            = (numberOfSlabs + numberOfChunks - 1) / numberOfChunks;
+
+        parallelFor(kZeroSize, numberOfChunks, [&](size_t c) {
+            marchingCubesSlabs(
+                grid,
+                gridSize,
+                origin,
+                isoValue,
+                blocks,
+                std::min(c * chunkSize, numberOfSlabs),
+                std::min((c + 1) * chunkSize, numberOfSlabs),
+                &slabs);
+        });
+
+        // Prefix sum of the number of points gives the offset of each slab.
+        std::vector<size_t> pointOffsets(numberOfSlabs);
+        size_t numberOfPoints = mesh->numberOfPoints();
+        for (size_t k = 0; k < numberOfSlabs; ++k) {
+            pointOffsets[k] = numberOfPoints;
+            numberOfPoints += slabs[k].points.size();
+        }
 
-                data[0] = grid(i, j, k);
-                data[1] = grid(i + 1, j, k);
-                data[4] = grid(i, j + 1, k);
-                data[5] = grid(i + 1, j + 1, k);
-                data[3] = grid(i, j, k + 1);
-                data[2] = grid(i + 1, j, k + 1);
-                data[7] = grid(i, j + 1, k + 1);
-                data[6] = grid(i + 1, j + 1, k + 1);
-
-                normals[0] = grad(grid, i, j, k, invGridSize);
-                normals[1] = grad(grid, i + 1, j, k, invGridSize);
-                normals[4] = grad(grid, i, j + 1, k, invGridSize);
-                normals[5] = grad(grid, i + 1, j + 1, k, invGridSize);
-                normals[3] = grad(grid, i, j, k + 1, invGridSize);
-                normals[2] = grad(grid, i + 1, j, k + 1, invGridSize);
-                normals[7] = grad(grid, i, j + 1, k + 1, invGridSize);
-                normals[6] = grad(grid, i + 1, j + 1, k + 1, invGridSize);
-
-                for (int e = 0; e < 12; e++) {
-                    edgeIds[e] = globalEdgeId(i, j, k, dim, e);
+        parallelFor(kZeroSize, numberOfSlabs, [&](size_t k) {
+            MarchingCubesSlab& slab = slabs[k];
+            for (size_t c = 0; c < slab.faces.size(); ++c) {
+                if (slab.isSharedCorner[c]) {
+                    const auto& topVertices = slabs[k - 1].topVertices;
+                    auto itr = std::lower_bound(
+                        topVertices.begin(),
+                        topVertices.end(),
+                        std::make_pair(slab.faces[c], kZeroSize));
+                    JET_ASSERT(itr != topVertices.end()
+                        && itr->first == slab.faces[c]);
+                    slab.faces[c] = pointOffsets[k - 1] + itr->second;
+                } else {
+                    slab.faces[c] += pointOffsets[k];
                 }
+            }
+        });
 
-                bound.lowerCorner = pos(i, j, k);
-                bound.upperCorner = pos(i + 1, j + 1, k + 1);
-
-                singleCube(
-                    data,
-                    edgeIds,
-                    normals,
-                    bound,
-                    &vertexMap,
-                    mesh,
-                    isoValue);
-            }  // i
-        }  // j
-    }  // k
+        for (const MarchingCubesSlab& slab : slabs) {
+            for (size_t v = 0; v < slab.points.size(); ++v) {
+                mesh->addNormal(slab.normals[v]);
+                mesh->addPoint(slab.points[v]);
+                mesh->addUv(Vector2D());
+            }
+        }
+
+        for (const MarchingCubesSlab& slab : slabs) {
+            for (size_t c = 0; c < slab.faces.size(); c += 3) {
+                Point3UI face(
+                    slab.faces[c], slab.faces[c + 1], slab.faces[c + 2]);
+                mesh->addPointNormalUvTriangle(face, face, face);
+            }
+        }
+    }
 
     // Construct boundaries parallel to x-y plane
     vertexMap.clear();
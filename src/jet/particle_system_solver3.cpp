@@ -130,19 +130,11 @@ void ParticleSystemSolver3::resolveCollision(
     ArrayAccessor1<Vector3D> newPositions,
     ArrayAccessor1<Vector3D> newVelocities) {
     if (_collider != nullptr) {
-        size_t numberOfParticles = _particleSystemData->numberOfParticles();
-        const double radius = _particleSystemData->radius();
-
-        parallelFor(
-            kZeroSize,
-            numberOfParticles,
-            [&] (size_t i) {
-                _collider->resolveCollision(
-                    radius,
-                    _restitutionCoefficient,
-                    &newPositions[i],
-                    &newVelocities[i]);
-            });
+        _collider->resolveCollisions(
+            _particleSystemData->radius(),
+            _restitutionCoefficient,
+            newPositions,
+            newVelocities);
     }
 }
 
@@ -0,0 +1,738 @@
+// Copyright (c) 2016 Doyub Kim
+
+#include <pch.h>
+#include <jet/array1.h>
+#include <jet/bounding_box3.h>
+#include <jet/matrix3x3.h>
+#include <jet/parallel.h>
+#include <jet/particles_to_sdf3.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace jet;
+
+namespace {
+
+// Tiles span at least this many data points along each axis.
+const size_t kMinTileSize = 16;
+
+// The cells of the neighbor search grid are widened so that their number
+// does not exceed this many per particle.
+const double kMaxNumberOfCellsPerParticle = 2.0;
+
+// Parameters of the anisotropic kernels. The positions are smoothed by the
+// factor, particles with fewer neighbors than the threshold keep the
+// isotropic kernel, and the principal axes of a kernel differ by at most the
+// stretch ratio (lambda, N_epsilon, and k_r in Yu and Turk's paper).
+const double kAnisotropicSmoothingFactor = 0.9;
+const size_t kAnisotropicMinNumberOfNeighbors = 25;
+const double kAnisotropicMaxStretch = 4.0;
+
+// Maximum number of sweeps of the Jacobi eigenvalue method.
+const unsigned int kMaxJacobiSweeps = 16;
+
+struct TileLayout {
+    Vector3D origin;
+    Vector3D gridSpacing;
+    Size3 dataSize;
+    Size3 tileSize;
+    Size3 numberOfTiles;
+
+    size_t totalNumberOfTiles() const {
+        return numberOfTiles.x * numberOfTiles.y * numberOfTiles.z;
+    }
+
+    size_t tileIndex(size_t i, size_t j, size_t k) const {
+        return i + numberOfTiles.x * (j + numberOfTiles.y * k);
+    }
+
+    // Returns the range of the data points [begin, end) covered by the tile.
+    void tileBounds(size_t tile, Size3* begin, Size3* end) const {
+        Size3 index(
+            tile % numberOfTiles.x,
+            (tile / numberOfTiles.x) % numberOfTiles.y,
+            tile / (numberOfTiles.x * numberOfTiles.y));
+        for (size_t a = 0; a < 3; ++a) {
+            (*begin)[a] = index[a] * tileSize[a];
+            (*end)[a] = std::min((*begin)[a] + tileSize[a], dataSize[a]);
+        }
+    }
+
+    // Returns the range of the data points [begin, end) along the axis within
+    // the given distance from the center.
+    void pointRange(
+        size_t axis,
+        double center,
+        double radius,
+        size_t* begin,
+        size_t* end) const {
+        const double n = static_cast<double>(dataSize[axis]);
+        double lower = std::ceil(
+            (center - radius - origin[axis]) / gridSpacing[axis]);
+        double upper = std::floor(
+            (center + radius - origin[axis]) / gridSpacing[axis]) + 1.0;
+        lower = std::min(std::max(lower, 0.0), n);
+        upper = std::min(std::max(upper, lower), n);
+        *begin = static_cast<size_t>(lower);
+        *end = static_cast<size_t>(upper);
+    }
+};
+
+// Tiles are twice as wide as the support of the largest kernel, so most of
+// the particles touch only one or two tiles along each axis.
+TileLayout makeTileLayout(const ScalarGrid3& sdf, double maxSupport) {
+    TileLayout layout;
+    layout.origin = sdf.dataOrigin();
+    layout.gridSpacing = sdf.gridSpacing();
+    layout.dataSize = sdf.dataSize();
+
+    for (size_t a = 0; a < 3; ++a) {
+        double size = std::ceil(4.0 * maxSupport / layout.gridSpacing[a]);
+        size = std::max(size, static_cast<double>(kMinTileSize));
+        size = std::min(size, static_cast<double>(layout.dataSize[a]));
+
+        layout.tileSize[a] = static_cast<size_t>(size);
+        layout.numberOfTiles[a]
+            = (layout.dataSize[a] + layout.tileSize[a] - 1)
+            / layout.tileSize[a];
+    }
+
+    return layout;
+}
+
+template <typename Callback>
+void forEachOverlappingTile(
+    const TileLayout& layout,
+    const Vector3D& center,
+    double support,
+    const Callback& callback) {
+    Size3 begin, end;
+    for (size_t a = 0; a < 3; ++a) {
+        layout.pointRange(a, center[a], support, &begin[a], &end[a]);
+        if (begin[a] == end[a]) {
+            return;
+        }
+        begin[a] /= layout.tileSize[a];
+        end[a] = (end[a] - 1) / layout.tileSize[a] + 1;
+    }
+
+    for (size_t k = begin.z; k < end.z; ++k) {
+        for (size_t j = begin.y; j < end.y; ++j) {
+            for (size_t i = begin.x; i < end.x; ++i) {
+                callback(layout.tileIndex(i, j, k));
+            }
+        }
+    }
+}
+
+// Bins the particles into the tiles that their supports overlap. The
+// particles of tile t are stored from items[tileBegin[t]] to
+// items[tileBegin[t + 1] - 1] in ascending order. The particles are split into
+// contiguous chunks which are counted and scattered in parallel, and the
+// offsets are laid out tile by tile, then chunk by chunk, so the order does
+// not depend on the scheduling.
+template <typename SupportFunc>
+void binParticles(
+    const TileLayout& layout,
+    const ConstArrayAccessor1<Vector3D>& centers,
+    const SupportFunc& supportFunc,
+    std::vector<size_t>* tileBegin,
+    std::vector<size_t>* items) {
+    const size_t n = centers.size();
+    const size_t numberOfTiles = layout.totalNumberOfTiles();
+
+    const size_t numberOfChunks = maxNumberOfThreads();
+
+    auto chunkBegin = [&](size_t c) {
+        return c * n / numberOfChunks;
+    };
+
+    std::vector<size_t> offsets(numberOfChunks * numberOfTiles, 0);
+    parallelFor(kZeroSize, numberOfChunks, [&](size_t c) {
+        size_t* counts = offsets.data() + c * numberOfTiles;
+        for (size_t p = chunkBegin(c); p < chunkBegin(c + 1); ++p) {
+            forEachOverlappingTile(
+                layout, centers[p], supportFunc(p), [&](size_t t) {
+                    ++counts[t];
+                });
+        }
+    });
+
+    tileBegin->resize(numberOfTiles + 1);
+    size_t sum = 0;
+    for (size_t t = 0; t < numberOfTiles; ++t) {
+        (*tileBegin)[t] = sum;
+        for (size_t c = 0; c < numberOfChunks; ++c) {
+            size_t& offset = offsets[c * numberOfTiles + t];
+            size_t count = offset;
+            offset = sum;
+            sum += count;
+        }
+    }
+    (*tileBegin)[numberOfTiles] = sum;
+
+    items->resize(sum);
+    parallelFor(kZeroSize, numberOfChunks, [&](size_t c) {
+        size_t* next = offsets.data() + c * numberOfTiles;
+        for (size_t p = chunkBegin(c); p < chunkBegin(c + 1); ++p) {
+            forEachOverlappingTile(
+                layout, centers[p], supportFunc(p), [&](size_t t) {
+                    (*items)[next[t]++] = p;
+                });
+        }
+    });
+}
+
+// Scatters the particles to the data points of the grid tile by tile. For
+// each data point within the support of particle p, splatFunc(p, pt, values)
+// accumulates the particle to the values of the point, which start from zero.
+// Once all the particles of the tile are splatted, finalizeFunc(pt, values)
+// returns the output of the point.
+template <typename SupportFunc, typename SplatFunc, typename FinalizeFunc>
+void rasterize(
+    const ConstArrayAccessor1<Vector3D>& centers,
+    double maxSupport,
+    const SupportFunc& supportFunc,
+    size_t numberOfValues,
+    const SplatFunc& splatFunc,
+    const FinalizeFunc& finalizeFunc,
+    ScalarGrid3* sdf) {
+    const TileLayout layout = makeTileLayout(*sdf, maxSupport);
+
+    std::vector<size_t> tileBegin;
+    std::vector<size_t> items;
+    binParticles(layout, centers, supportFunc, &tileBegin, &items);
+
+    const Vector3D& o = layout.origin;
+    const Vector3D& h = layout.gridSpacing;
+    auto data = sdf->dataAccessor();
+
+    parallelFor(kZeroSize, layout.totalNumberOfTiles(), [&](size_t t) {
+        Size3 begin, end;
+        layout.tileBounds(t, &begin, &end);
+
+        const size_t sizeX = end.x - begin.x;
+        const size_t sizeY = end.y - begin.y;
+        const size_t sizeZ = end.z - begin.z;
+        std::vector<double> buffer(
+            numberOfValues * sizeX * sizeY * sizeZ, 0.0);
+
+        // Returns the values of the first data point of the row in the tile.
+        auto row = [&](size_t j, size_t k) {
+            return buffer.data() + numberOfValues
+                * sizeX * ((j - begin.y) + sizeY * (k - begin.z));
+        };
+
+        for (size_t q = tileBegin[t]; q < tileBegin[t + 1]; ++q) {
+            const size_t p = items[q];
+            const Vector3D& c = centers[p];
+            const double support = supportFunc(p);
+            const double support2 = support * support;
+
+            size_t kBegin, kEnd;
+            layout.pointRange(2, c.z, support, &kBegin, &kEnd);
+            kBegin = std::max(kBegin, begin.z);
+            kEnd = std::min(kEnd, end.z);
+
+            size_t jBegin, jEnd;
+            layout.pointRange(1, c.y, support, &jBegin, &jEnd);
+            jBegin = std::max(jBegin, begin.y);
+            jEnd = std::min(jEnd, end.y);
+
+            size_t iBegin, iEnd;
+            layout.pointRange(0, c.x, support, &iBegin, &iEnd);
+            iBegin = std::max(iBegin, begin.x);
+            iEnd = std::min(iEnd, end.x);
+
+            for (size_t k = kBegin; k < kEnd; ++k) {
+                const double z = o.z + h.z * k;
+                const double remainderZ = support2 - (z - c.z) * (z - c.z);
+                if (remainderZ < 0.0) {
+                    continue;
+                }
+
+                for (size_t j = jBegin; j < jEnd; ++j) {
+                    const double y = o.y + h.y * j;
+                    // Skip the rows that miss the bounding sphere.
+                    if (remainderZ < (y - c.y) * (y - c.y)) {
+                        continue;
+                    }
+
+                    double* values
+                        = row(j, k) + numberOfValues * (iBegin - begin.x);
+                    for (size_t i = iBegin; i < iEnd; ++i) {
+                        splatFunc(p, Vector3D(o.x + h.x * i, y, z), values);
+                        values += numberOfValues;
+                    }
+                }
+            }
+        }
+
+        for (size_t k = begin.z; k < end.z; ++k) {
+            for (size_t j = begin.y; j < end.y; ++j) {
+                const double* values = row(j, k);
+                for (size_t i = begin.x; i < end.x; ++i) {
+                    data(i, j, k) = finalizeFunc(
+                        Vector3D(o.x + h.x * i, o.y + h.y * j, o.z + h.z * k),
+                        values);
+                    values += numberOfValues;
+                }
+            }
+        }
+    });
+}
+
+// Dense grid of cells which are at least as wide as the search radius, so
+// the neighbors of a point are in the 3 x 3 x 3 cells around it. The points
+// are sorted by the cells, and the callback is inlined into the search.
+class NeighborGrid {
+ public:
+    NeighborGrid(
+        const ConstArrayAccessor1<Vector3D>& points,
+        double radius) {
+        const size_t n = points.size();
+
+        BoundingBox3D bound;
+        for (size_t i = 0; i < n; ++i) {
+            bound.merge(points[i]);
+        }
+        if (n == 0) {
+            bound = BoundingBox3D(Vector3D(), Vector3D());
+        }
+
+        _origin = bound.lowerCorner;
+        _cellSize = radius;
+
+        // Sparse particles would end up in a huge grid of empty cells.
+        const double maxNumberOfCells
+            = kMaxNumberOfCellsPerParticle * static_cast<double>(n) + 1.0;
+        while (true) {
+            double numberOfCells = 1.0;
+            for (size_t a = 0; a < 3; ++a) {
+                numberOfCells *= std::floor(
+                    (bound.upperCorner[a] - _origin[a]) / _cellSize) + 1.0;
+            }
+            if (numberOfCells <= maxNumberOfCells) {
+                break;
+            }
+            _cellSize *= std::max(
+                std::cbrt(numberOfCells / maxNumberOfCells), 1.01);
+        }
+
+        for (size_t a = 0; a < 3; ++a) {
+            _resolution[a] = static_cast<size_t>(std::floor(
+                (bound.upperCorner[a] - _origin[a]) / _cellSize)) + 1;
+        }
+
+        std::vector<size_t> cells(n);
+        parallelFor(kZeroSize, n, [&](size_t i) {
+            cells[i] = cellIndex(points[i]);
+        });
+
+        // Counting sort by the cells
+        const size_t numberOfCells
+            = _resolution.x * _resolution.y * _resolution.z;
+        _cellBegin.assign(numberOfCells + 1, 0);
+        for (size_t i = 0; i < n; ++i) {
+            ++_cellBegin[cells[i] + 1];
+        }
+        for (size_t c = 0; c < numberOfCells; ++c) {
+            _cellBegin[c + 1] += _cellBegin[c];
+        }
+
+        std::vector<size_t> next(_cellBegin.begin(), _cellBegin.end() - 1);
+        _items.resize(n);
+        _sortedPoints.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            const size_t q = next[cells[i]]++;
+            _items[q] = i;
+            _sortedPoints[q] = points[i];
+        }
+    }
+
+    // Invokes callback(i, point) for the points in the cells around the
+    // origin, which include all the points within the search radius.
+    template <typename Callback>
+    void forEachNearbyPoint(
+        const Vector3D& origin,
+        const Callback& callback) const {
+        Size3 begin, end;
+        for (size_t a = 0; a < 3; ++a) {
+            const size_t c = cellIndex(origin, a);
+            begin[a] = (c > 0) ? c - 1 : 0;
+            end[a] = std::min(c + 2, _resolution[a]);
+        }
+
+        for (size_t k = begin.z; k < end.z; ++k) {
+            for (size_t j = begin.y; j < end.y; ++j) {
+                // Cells along the x-axis are stored contiguously.
+                const size_t first = _cellBegin[cellIndex(begin.x, j, k)];
+                const size_t last = _cellBegin[cellIndex(end.x, j, k)];
+                for (size_t q = first; q < last; ++q) {
+                    callback(_items[q], _sortedPoints[q]);
+                }
+            }
+        }
+    }
+
+ private:
+    Vector3D _origin;
+    double _cellSize;
+    Size3 _resolution;
+    std::vector<size_t> _cellBegin;
+    std::vector<size_t> _items;
+    std::vector<Vector3D> _sortedPoints;
+
+    size_t cellIndex(const Vector3D& pt, size_t axis) const {
+        double c = std::floor((pt[axis] - _origin[axis]) / _cellSize);
+        c = std::min(
+            std::max(c, 0.0), static_cast<double>(_resolution[axis] - 1));
+        return static_cast<size_t>(c);
+    }
+
+    size_t cellIndex(size_t i, size_t j, size_t k) const {
+        return i + _resolution.x * (j + _resolution.y * k);
+    }
+
+    size_t cellIndex(const Vector3D& pt) const {
+        return cellIndex(cellIndex(pt, 0), cellIndex(pt, 1), cellIndex(pt, 2));
+    }
+};
+
+// Returns (1 - q^2)^3 for q < 1 and zero otherwise, which is the standard SPH
+// kernel up to the normalization constant.
+inline double stdKernelShape(double q2) {
+    const double t = 1.0 - q2;
+    return (t > 0.0) ? t * t * t : 0.0;
+}
+
+// Computes the SPH weight m / rho of each particle relative to the kernel
+// normalization. The interpolated value at x is then the sum of
+// weights[i] * stdKernelShape(|x - x_i|^2 / h^2), the same as SphSystemData3.
+void computeSphWeights(
+    const ConstArrayAccessor1<Vector3D>& positions,
+    const NeighborGrid& neighbors,
+    double kernelRadius,
+    ArrayAccessor1<double> weights) {
+    const double invH2 = 1.0 / (kernelRadius * kernelRadius);
+
+    parallelFor(kZeroSize, positions.size(), [&](size_t i) {
+        const Vector3D& origin = positions[i];
+        double sum = 0.0;
+        neighbors.forEachNearbyPoint(
+            origin,
+            [&](size_t, const Vector3D& neighborPosition) {
+                sum += stdKernelShape(
+                    origin.distanceSquaredTo(neighborPosition) * invH2);
+            });
+        weights[i] = 1.0 / sum;
+    });
+}
+
+// Computes the eigenvalues and the eigenvectors (columns of the matrix) of
+// the given symmetric matrix with the cyclic Jacobi method.
+void symmetricEigen(
+    Matrix3x3D a,
+    Vector3D* eigenvalues,
+    Matrix3x3D* eigenvectors) {
+    Matrix3x3D v = Matrix3x3D::makeIdentity();
+
+    for (unsigned int sweep = 0; sweep < kMaxJacobiSweeps; ++sweep) {
+        const double offDiagonal
+            = a(0, 1) * a(0, 1) + a(0, 2) * a(0, 2) + a(1, 2) * a(1, 2);
+        const double diagonal
+            = a(0, 0) * a(0, 0) + a(1, 1) * a(1, 1) + a(2, 2) * a(2, 2);
+        if (offDiagonal <= kEpsilonD * kEpsilonD * diagonal) {
+            break;
+        }
+
+        for (size_t p = 0; p < 2; ++p) {
+            for (size_t q = p + 1; q < 3; ++q) {
+                if (a(p, q) == 0.0) {
+                    continue;
+                }
+
+                // Rotation that zeros out a(p, q)
+                const double theta = (a(q, q) - a(p, p)) / (2.0 * a(p, q));
+                const double t = (theta >= 0.0 ? 1.0 : -1.0)
+                    / (std::fabs(theta) + std::sqrt(theta * theta + 1.0));
+                const double c = 1.0 / std::sqrt(t * t + 1.0);
+                const double s = t * c;
+
+                for (size_t k = 0; k < 3; ++k) {
+                    const double akp = a(k, p);
+                    const double akq = a(k, q);
+                    a(k, p) = c * akp - s * akq;
+                    a(k, q) = s * akp + c * akq;
+                }
+                for (size_t k = 0; k < 3; ++k) {
+                    const double apk = a(p, k);
+                    const double aqk = a(q, k);
+                    a(p, k) = c * apk - s * aqk;
+                    a(q, k) = s * apk + c * aqk;
+                }
+                for (size_t k = 0; k < 3; ++k) {
+                    const double vkp = v(k, p);
+                    const double vkq = v(k, q);
+                    v(k, p) = c * vkp - s * vkq;
+                    v(k, q) = s * vkp + c * vkq;
+                }
+            }
+        }
+    }
+
+    *eigenvalues = Vector3D(a(0, 0), a(1, 1), a(2, 2));
+    *eigenvectors = v;
+}
+
+// Computes the smoothed centers, the SPH weights, and the anisotropic kernel
+// matrices G of the particles as in Yu and Turk's paper. The kernel of a
+// particle at offset r from its center is det(G) W(|Gr|), where W is the
+// standard kernel with the unit radius. Since det(G) is kept at 1 / h^3, the
+// interpolated value at x is the sum of weights[i] * stdKernelShape(|Gr|^2).
+// The support of the kernel is the ellipsoid |Gr| < 1, and supports[i] is the
+// radius of its bounding sphere.
+void computeAnisotropicKernels(
+    const ConstArrayAccessor1<Vector3D>& positions,
+    const NeighborGrid& neighbors,
+    double kernelRadius,
+    ArrayAccessor1<Vector3D> centers,
+    ArrayAccessor1<double> weights,
+    ArrayAccessor1<Matrix3x3D> gs,
+    ArrayAccessor1<double> supports) {
+    const double invH = 1.0 / kernelRadius;
+    const double invH2 = invH * invH;
+
+    parallelFor(kZeroSize, positions.size(), [&](size_t i) {
+        const Vector3D& origin = positions[i];
+
+        double density = 0.0;
+        double weightSum = 0.0;
+        Vector3D weightedPosition;
+        size_t numberOfNeighbors = 0;
+        neighbors.forEachNearbyPoint(
+            origin,
+            [&](size_t, const Vector3D& neighborPosition) {
+                const double q2
+                    = origin.distanceSquaredTo(neighborPosition) * invH2;
+                if (q2 < 1.0) {
+                    const double s = std::sqrt(q2);
+                    const double weight = 1.0 - s * s * s;
+                    density += stdKernelShape(q2);
+                    weightSum += weight;
+                    weightedPosition += weight * neighborPosition;
+                    ++numberOfNeighbors;
+                }
+            });
+
+        weights[i] = 1.0 / density;
+        gs[i] = Matrix3x3D::makeScaleMatrix(invH, invH, invH);
+        supports[i] = kernelRadius;
+
+        if (numberOfNeighbors == 0) {
+            centers[i] = origin;
+            return;
+        }
+
+        const Vector3D mean = weightedPosition / weightSum;
+        centers[i] = (1.0 - kAnisotropicSmoothingFactor) * origin
+            + kAnisotropicSmoothingFactor * mean;
+
+        if (numberOfNeighbors < kAnisotropicMinNumberOfNeighbors) {
+            return;
+        }
+
+        // Weighted covariance of the neighbors around the mean
+        double cxx = 0.0, cyy = 0.0, czz = 0.0;
+        double cxy = 0.0, cxz = 0.0, cyz = 0.0;
+        neighbors.forEachNearbyPoint(
+            origin,
+            [&](size_t, const Vector3D& neighborPosition) {
+                const double q2
+                    = origin.distanceSquaredTo(neighborPosition) * invH2;
+                if (q2 < 1.0) {
+                    const double s = std::sqrt(q2);
+                    const double weight = 1.0 - s * s * s;
+                    const Vector3D r = neighborPosition - mean;
+                    cxx += weight * r.x * r.x;
+                    cyy += weight * r.y * r.y;
+                    czz += weight * r.z * r.z;
+                    cxy += weight * r.x * r.y;
+                    cxz += weight * r.x * r.z;
+                    cyz += weight * r.y * r.z;
+                }
+            });
+
+        const Matrix3x3D covariance
+            = Matrix3x3D(
+                cxx, cxy, cxz,
+                cxy, cyy, cyz,
+                cxz, cyz, czz) / weightSum;
+
+        Vector3D sigma;
+        Matrix3x3D rotation;
+        symmetricEigen(covariance, &sigma, &rotation);
+
+        const double maxSigma = sigma.max();
+        if (!(maxSigma > 0.0)) {
+            return;
+        }
+
+        // Limit the stretch and preserve the volume of the isotropic kernel,
+        // so that det(G) stays 1 / h^3.
+        for (size_t a = 0; a < 3; ++a) {
+            sigma[a] = std::max(sigma[a], maxSigma / kAnisotropicMaxStretch);
+        }
+        sigma /= std::cbrt(sigma.x * sigma.y * sigma.z);
+
+        gs[i] = rotation
+            * Matrix3x3D::makeScaleMatrix(invH / sigma.x,
+                                          invH / sigma.y,
+                                          invH / sigma.z)
+            * rotation.transposed();
+        supports[i] = kernelRadius * sigma.max();
+    });
+}
+
+}  // namespace
+
+ParticlesToSdf3::ParticlesToSdf3(double kernelRadius, Kernel kernel) :
+    _kernelRadius(kernelRadius),
+    _kernel(kernel) {
+    JET_THROW_INVALID_ARG_IF(kernelRadius <= 0.0);
+}
+
+double ParticlesToSdf3::kernelRadius() const {
+    return _kernelRadius;
+}
+
+void ParticlesToSdf3::setKernelRadius(double kernelRadius) {
+    JET_THROW_INVALID_ARG_IF(kernelRadius <= 0.0);
+    _kernelRadius = kernelRadius;
+}
+
+ParticlesToSdf3::Kernel ParticlesToSdf3::kernel() const {
+    return _kernel;
+}
+
+void ParticlesToSdf3::setKernel(Kernel kernel) {
+    _kernel = kernel;
+}
+
+double ParticlesToSdf3::cutOffDensity() const {
+    return _cutOffDensity;
+}
+
+void ParticlesToSdf3::setCutOffDensity(double cutOffDensity) {
+    _cutOffDensity = cutOffDensity;
+}
+
+double ParticlesToSdf3::relativeParticleRadius() const {
+    return _relativeParticleRadius;
+}
+
+void ParticlesToSdf3::setRelativeParticleRadius(double relativeRadius) {
+    _relativeParticleRadius = relativeRadius;
+}
+
+void ParticlesToSdf3::convert(
+    const ConstArrayAccessor1<Vector3D>& positions,
+    ScalarGrid3* sdf) const {
+    const Size3 size = sdf->dataSize();
+    if (size.x == 0 || size.y == 0 || size.z == 0) {
+        return;
+    }
+
+    const size_t n = positions.size();
+    const double h = _kernelRadius;
+
+    if (_kernel == ZhuBridson) {
+        const double invH2 = 1.0 / (h * h);
+        const double particleRadius = _relativeParticleRadius * h;
+
+        rasterize(
+            positions,
+            h,
+            [h](size_t) {
+                return h;
+            },
+            4,
+            [&](size_t p, const Vector3D& pt, double* values) {
+                const Vector3D& x = positions[p];
+                const double weight
+                    = stdKernelShape(pt.distanceSquaredTo(x) * invH2);
+                values[0] += weight;
+                values[1] += weight * x.x;
+                values[2] += weight * x.y;
+                values[3] += weight * x.z;
+            },
+            [&](const Vector3D& pt, const double* values) {
+                if (values[0] > 0.0) {
+                    Vector3D mean(values[1], values[2], values[3]);
+                    return pt.distanceTo(mean / values[0]) - particleRadius;
+                }
+                return h - particleRadius;
+            },
+            sdf);
+        return;
+    }
+
+    NeighborGrid neighbors(positions, h);
+    Array1<double> weights(n);
+    auto finalizeFunc = [&](const Vector3D&, const double* values) {
+        return _cutOffDensity - values[0];
+    };
+
+    if (_kernel == Anisotropic) {
+        Array1<Vector3D> centers(n);
+        Array1<Matrix3x3D> gs(n);
+        Array1<double> supports(n);
+        computeAnisotropicKernels(
+            positions,
+            neighbors,
+            h,
+            centers.accessor(),
+            weights.accessor(),
+            gs.accessor(),
+            supports.accessor());
+
+        double maxSupport = h;
+        for (size_t i = 0; i < n; ++i) {
+            maxSupport = std::max(maxSupport, supports[i]);
+        }
+
+        rasterize(
+            centers.constAccessor(),
+            maxSupport,
+            [&](size_t p) {
+                return supports[p];
+            },
+            1,
+            [&](size_t p, const Vector3D& pt, double* values) {
+                const Vector3D r = gs[p] * (pt - centers[p]);
+                values[0] += weights[p] * stdKernelShape(r.lengthSquared());
+            },
+            finalizeFunc,
+            sdf);
+    } else {
+        computeSphWeights(positions, neighbors, h, weights.accessor());
+
+        const double invH2 = 1.0 / (h * h);
+
+        rasterize(
+            positions,
+            h,
+            [h](size_t) {
+                return h;
+            },
+            1,
+            [&](size_t p, const Vector3D& pt, double* values) {
+                values[0] += weights[p] * stdKernelShape(
+                    pt.distanceSquaredTo(positions[p]) * invH2);
+            },
+            finalizeFunc,
+            sdf);
+    }
+}
@@ -159,11 +159,8 @@ void PicSolver3::transferFromGridsToParticles() {
     auto flow = gridSystemData()->velocity();
     auto positions = _particles->positions();
     auto velocities = _particles->velocities();
-    size_t numberOfParticles = _particles->numberOfParticles();
 
-    parallelFor(kZeroSize, numberOfParticles, [&](size_t i) {
-        velocities[i] = flow->sample(positions[i]);
-    });
+    flow->sample(ConstArrayAccessor1<Vector3D>(positions), velocities);
 }
 
 void PicSolver3::moveParticles(double timeIntervalInSeconds) {
@@ -231,16 +228,7 @@ void PicSolver3::moveParticles(double timeIntervalInSeconds) {
 
     Collider3Ptr col = collider();
     if (col != nullptr) {
-        parallelFor(
-            kZeroSize,
-            numberOfParticles,
-            [&](size_t i) {
-                col->resolveCollision(
-                    0.0,
-                    0.0,
-                    &positions[i],
-                    &velocities[i]);
-            });
+        col->resolveCollisions(0.0, 0.0, positions, velocities);
     }
 }
 
@@ -43,6 +43,15 @@ Vector3D Plane3::actualClosestNormal(const Vector3D& otherPoint) const {
     return normal;
 }
 
+SurfaceClosestQueryResult3 Plane3::actualClosestQuery(
+    const Vector3D& otherPoint) const {
+    SurfaceClosestQueryResult3 result;
+    result.point = closestPoint(otherPoint);
+    result.normal = normal;
+    result.distance = (otherPoint - result.point).length();
+    return result;
+}
+
 bool Plane3::intersects(const Ray3D& ray) const {
     return std::fabs(ray.direction.dot(normal)) > 0;
 }
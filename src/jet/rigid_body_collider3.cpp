@@ -12,3 +12,12 @@ RigidBodyCollider3::RigidBodyCollider3(const Surface3Ptr& surface) {
 Vector3D RigidBodyCollider3::velocityAt(const Vector3D& point) const {
     return linearVelocity + angularVelocity.cross(point - origin);
 }
+
+void RigidBodyCollider3::updateSurface() {
+    if (linearVelocity.lengthSquared() > 0.0
+        || angularVelocity.lengthSquared() > 0.0) {
+        invalidateSignedDistanceGrid();
+    }
+
+    Collider3::updateSurface();
+}
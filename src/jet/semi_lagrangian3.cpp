@@ -1,13 +1,53 @@
 // Copyright (c) 2016 Doyub Kim
 
 #include <pch.h>
+#include <advection_helpers.h>
 #include <jet/array_samplers3.h>
 #include <jet/parallel.h>
 #include <jet/semi_lagrangian3.h>
 #include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
 
 using namespace jet;
 
+namespace {
+
+// Set of channels whose data points are located at the same positions, so
+// a single back-trace per data point serves all of them.
+struct BackTraceLayout {
+    Size3 size;
+    Vector3D origin;
+    Vector3D spacing;
+    std::vector<size_t> scalarChannels;
+    std::vector<size_t> collocatedChannels;
+    std::vector<std::pair<size_t, size_t>> faceChannels;  // (grid, axis)
+};
+
+BackTraceLayout* findOrAddLayout(
+    const Size3& size,
+    const Vector3D& origin,
+    const Vector3D& spacing,
+    std::vector<BackTraceLayout>* layouts) {
+    for (auto& layout : *layouts) {
+        if (layout.size == size
+            && layout.origin == origin
+            && layout.spacing == spacing) {
+            return &layout;
+        }
+    }
+
+    layouts->emplace_back();
+    BackTraceLayout* layout = &layouts->back();
+    layout->size = size;
+    layout->origin = origin;
+    layout->spacing = spacing;
+    return layout;
+}
+
+}  // namespace
+
 SemiLagrangian3::SemiLagrangian3() {
 }
 
@@ -24,6 +64,7 @@ void SemiLagrangian3::advect(
     auto outputDataAcc = output->dataAccessor();
     auto inputSamplerFunc = getScalarSamplerFunc(input);
     auto inputDataPos = input.dataPosition();
+    auto inputDataAcc = input.constDataAccessor();
 
     double h = min3(
         output->gridSpacing().x,
@@ -35,6 +76,8 @@ void SemiLagrangian3::advect(
             Vector3D pt = backTrace(
                 flow, dt, h, outputDataPos(i, j, k), boundarySdf);
             outputDataAcc(i, j, k) = inputSamplerFunc(pt);
+        } else {
+            outputDataAcc(i, j, k) = inputDataAcc(i, j, k);
         }
     });
 }
@@ -55,12 +98,15 @@ void SemiLagrangian3::advect(
     auto outputDataPos = output->dataPosition();
     auto outputDataAcc = output->dataAccessor();
     auto inputDataPos = input.dataPosition();
+    auto inputDataAcc = input.constDataAccessor();
 
     output->parallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
         if (boundarySdf.sample(inputDataPos(i, j, k)) > 0.0) {
             Vector3D pt = backTrace(
                 flow, dt, h, outputDataPos(i, j, k), boundarySdf);
             outputDataAcc(i, j, k) = inputSamplerFunc(pt);
+        } else {
+            outputDataAcc(i, j, k) = inputDataAcc(i, j, k);
         }
     });
 }
@@ -81,78 +127,180 @@ void SemiLagrangian3::advect(
     auto uTargetDataPos = output->uPosition();
     auto uTargetDataAcc = output->uAccessor();
     auto uSourceDataPos = input.uPosition();
+    auto uSourceDataAcc = input.uConstAccessor();
 
     output->parallelForEachUIndex([&](size_t i, size_t j, size_t k) {
         if (boundarySdf.sample(uSourceDataPos(i, j, k)) > 0.0) {
             Vector3D pt = backTrace(
                 flow, dt, h, uTargetDataPos(i, j, k), boundarySdf);
             uTargetDataAcc(i, j, k) = inputSamplerFunc(pt).x;
+        } else {
+            uTargetDataAcc(i, j, k) = uSourceDataAcc(i, j, k);
         }
     });
 
     auto vTargetDataPos = output->vPosition();
     auto vTargetDataAcc = output->vAccessor();
     auto vSourceDataPos = input.vPosition();
+    auto vSourceDataAcc = input.vConstAccessor();
 
     output->parallelForEachVIndex([&](size_t i, size_t j, size_t k) {
         if (boundarySdf.sample(vSourceDataPos(i, j, k)) > 0.0) {
             Vector3D pt = backTrace(
                 flow, dt, h, vTargetDataPos(i, j, k), boundarySdf);
             vTargetDataAcc(i, j, k) = inputSamplerFunc(pt).y;
+        } else {
+            vTargetDataAcc(i, j, k) = vSourceDataAcc(i, j, k);
         }
     });
 
     auto wTargetDataPos = output->wPosition();
     auto wTargetDataAcc = output->wAccessor();
     auto wSourceDataPos = input.wPosition();
+    auto wSourceDataAcc = input.wConstAccessor();
 
     output->parallelForEachWIndex([&](size_t i, size_t j, size_t k) {
         if (boundarySdf.sample(wSourceDataPos(i, j, k)) > 0.0) {
             Vector3D pt = backTrace(
                 flow, dt, h, wTargetDataPos(i, j, k), boundarySdf);
             wTargetDataAcc(i, j, k) = inputSamplerFunc(pt).z;
+        } else {
+            wTargetDataAcc(i, j, k) = wSourceDataAcc(i, j, k);
         }
     });
 }
 
-Vector3D SemiLagrangian3::backTrace(
+void SemiLagrangian3::advectBatch(
+    const std::vector<const ScalarGrid3*>& scalarInputs,
+    const std::vector<const CollocatedVectorGrid3*>& collocatedInputs,
+    const std::vector<const FaceCenteredGrid3*>& faceCenteredInputs,
     const VectorField3& flow,
     double dt,
-    double h,
-    const Vector3D& startPt,
+    const std::vector<ScalarGrid3*>& scalarOutputs,
+    const std::vector<CollocatedVectorGrid3*>& collocatedOutputs,
+    const std::vector<FaceCenteredGrid3*>& faceCenteredOutputs,
     const ScalarField3& boundarySdf) {
+    JET_THROW_INVALID_ARG_IF(scalarInputs.size() != scalarOutputs.size());
+    JET_THROW_INVALID_ARG_IF(
+        collocatedInputs.size() != collocatedOutputs.size());
+    JET_THROW_INVALID_ARG_IF(
+        faceCenteredInputs.size() != faceCenteredOutputs.size());
 
-    double remainingT = dt;
-    Vector3D pt0 = startPt;
-    Vector3D pt1 = startPt;
-
-    while (remainingT > kEpsilonD) {
-        // Adaptive time-stepping
-        Vector3D vel0 = flow.sample(pt0);
-        double numSubSteps
-            = std::max(std::ceil(vel0.length() * remainingT / h), 1.0);
-        dt = remainingT / numSubSteps;
-
-        // Mid-point rule
-        Vector3D midPt = pt0 - 0.5 * dt * vel0;
-        Vector3D midVel = flow.sample(midPt);
-        pt1 = pt0 - dt * midVel;
-
-        // Boundary handling
-        double phi0 = boundarySdf.sample(pt0);
-        double phi1 = boundarySdf.sample(pt1);
-
-        if (phi0 * phi1 < 0.0) {
-            double w = std::fabs(phi1) / (std::fabs(phi0) + std::fabs(phi1));
-            pt1 = w * pt0 + (1.0 - w) * pt1;
-            break;
-        }
+    std::vector<BackTraceLayout> layouts;
+
+    // Scalar channels
+    std::vector<std::function<double(const Vector3D&)>> scalarSamplers;
+    std::vector<ConstArrayAccessor3<double>> scalarSrc;
+    std::vector<ArrayAccessor3<double>> scalarDst;
+
+    for (size_t n = 0; n < scalarInputs.size(); ++n) {
+        const ScalarGrid3& input = *scalarInputs[n];
+        JET_THROW_INVALID_ARG_IF(!input.hasSameShape(*scalarOutputs[n]));
+
+        scalarSamplers.push_back(getScalarSamplerFunc(input));
+        scalarSrc.push_back(input.constDataAccessor());
+        scalarDst.push_back(scalarOutputs[n]->dataAccessor());
 
-        remainingT -= dt;
-        pt0 = pt1;
+        findOrAddLayout(
+            input.dataSize(), input.dataOrigin(), input.gridSpacing(), &layouts)
+            ->scalarChannels.push_back(n);
     }
 
-    return pt1;
+    // Collocated vector channels
+    std::vector<std::function<Vector3D(const Vector3D&)>> collocatedSamplers;
+    std::vector<ConstArrayAccessor3<Vector3D>> collocatedSrc;
+    std::vector<ArrayAccessor3<Vector3D>> collocatedDst;
+
+    for (size_t n = 0; n < collocatedInputs.size(); ++n) {
+        const CollocatedVectorGrid3& input = *collocatedInputs[n];
+        JET_THROW_INVALID_ARG_IF(!input.hasSameShape(*collocatedOutputs[n]));
+
+        collocatedSamplers.push_back(getVectorSamplerFunc(input));
+        collocatedSrc.push_back(input.constDataAccessor());
+        collocatedDst.push_back(collocatedOutputs[n]->dataAccessor());
+
+        findOrAddLayout(
+            input.dataSize(), input.dataOrigin(), input.gridSpacing(), &layouts)
+            ->collocatedChannels.push_back(n);
+    }
+
+    // Face-centered channels, one per axis
+    std::vector<std::function<Vector3D(const Vector3D&)>> faceSamplers;
+    std::vector<ConstArrayAccessor3<double>> faceSrc[3];
+    std::vector<ArrayAccessor3<double>> faceDst[3];
+
+    for (size_t n = 0; n < faceCenteredInputs.size(); ++n) {
+        const FaceCenteredGrid3& input = *faceCenteredInputs[n];
+        FaceCenteredGrid3* output = faceCenteredOutputs[n];
+        JET_THROW_INVALID_ARG_IF(!input.hasSameShape(*output));
+
+        faceSamplers.push_back(getVectorSamplerFunc(input));
+        faceSrc[0].push_back(input.uConstAccessor());
+        faceSrc[1].push_back(input.vConstAccessor());
+        faceSrc[2].push_back(input.wConstAccessor());
+        faceDst[0].push_back(output->uAccessor());
+        faceDst[1].push_back(output->vAccessor());
+        faceDst[2].push_back(output->wAccessor());
+
+        findOrAddLayout(
+            input.uSize(), input.uOrigin(), input.gridSpacing(), &layouts)
+            ->faceChannels.push_back(std::make_pair(n, 0));
+        findOrAddLayout(
+            input.vSize(), input.vOrigin(), input.gridSpacing(), &layouts)
+            ->faceChannels.push_back(std::make_pair(n, 1));
+        findOrAddLayout(
+            input.wSize(), input.wOrigin(), input.gridSpacing(), &layouts)
+            ->faceChannels.push_back(std::make_pair(n, 2));
+    }
+
+    for (const BackTraceLayout& layout : layouts) {
+        const Vector3D& o = layout.origin;
+        const Vector3D& gs = layout.spacing;
+        double h = min3(gs.x, gs.y, gs.z);
+
+        parallelFor(
+            kZeroSize, layout.size.x,
+            kZeroSize, layout.size.y,
+            kZeroSize, layout.size.z,
+            [&](size_t i, size_t j, size_t k) {
+                Vector3D pos = o + gs * Vector3D({i, j, k});
+
+                if (boundarySdf.sample(pos) > 0.0) {
+                    Vector3D pt = backTrace(flow, dt, h, pos, boundarySdf);
+
+                    for (size_t n : layout.scalarChannels) {
+                        scalarDst[n](i, j, k) = scalarSamplers[n](pt);
+                    }
+                    for (size_t n : layout.collocatedChannels) {
+                        collocatedDst[n](i, j, k) = collocatedSamplers[n](pt);
+                    }
+                    for (const auto& ch : layout.faceChannels) {
+                        faceDst[ch.second][ch.first](i, j, k)
+                            = faceSamplers[ch.first](pt)[ch.second];
+                    }
+                } else {
+                    for (size_t n : layout.scalarChannels) {
+                        scalarDst[n](i, j, k) = scalarSrc[n](i, j, k);
+                    }
+                    for (size_t n : layout.collocatedChannels) {
+                        collocatedDst[n](i, j, k) = collocatedSrc[n](i, j, k);
+                    }
+                    for (const auto& ch : layout.faceChannels) {
+                        faceDst[ch.second][ch.first](i, j, k)
+                            = faceSrc[ch.second][ch.first](i, j, k);
+                    }
+                }
+            });
+    }
+}
+
+Vector3D SemiLagrangian3::backTrace(
+    const VectorField3& flow,
+    double dt,
+    double h,
+    const Vector3D& startPt,
+    const ScalarField3& boundarySdf) {
+    return backTraceMidPoint(flow, dt, h, startPt, boundarySdf);
 }
 
 std::function<double(const Vector3D&)>
@@ -22,7 +22,7 @@ Sphere3::Sphere3(const Sphere3& other) :
 }
 
 Vector3D Sphere3::closestPoint(const Vector3D& otherPoint) const {
-    return radius * closestNormal(otherPoint) + center;
+    return radius * actualClosestNormal(otherPoint) + center;
 }
 
 double Sphere3::closestDistance(const Vector3D& otherPoint) const {
@@ -37,6 +37,15 @@ Vector3D Sphere3::actualClosestNormal(const Vector3D& otherPoint) const {
     }
 }
 
+SurfaceClosestQueryResult3 Sphere3::actualClosestQuery(
+    const Vector3D& otherPoint) const {
+    SurfaceClosestQueryResult3 result;
+    result.normal = actualClosestNormal(otherPoint);
+    result.point = radius * result.normal + center;
+    result.distance = std::fabs(center.distanceTo(otherPoint) - radius);
+    return result;
+}
+
 bool Sphere3::intersects(
     const Ray3D& ray) const {
     Vector3D r = ray.origin - center;
@@ -99,3 +108,7 @@ BoundingBox3D Sphere3::boundingBox() const {
     Vector3D r(radius, radius, radius);
     return BoundingBox3D(center - r, center + r);
 }
+
+bool Sphere3::isClosed() const {
+    return true;
+}
@@ -29,6 +29,20 @@ Vector3D Surface3::closestNormal(const Vector3D& otherPoint) const {
     return (isNormalFlipped) ? -normal : normal;
 }
 
+SurfaceClosestQueryResult3 Surface3::closestQuery(
+    const Vector3D& otherPoint) const {
+    SurfaceClosestQueryResult3 result = actualClosestQuery(otherPoint);
+    result.normal = (isNormalFlipped) ? -result.normal : result.normal;
+    return result;
+}
+
+bool Surface3::isClosed() const {
+    return false;
+}
+
+void Surface3::updateQueryEngine() {
+}
+
 SurfaceRayIntersection3 Surface3::closestIntersection(
     const Ray3D& ray) const {
     SurfaceRayIntersection3 intersection = actualClosestIntersection(ray);
@@ -36,3 +50,12 @@ SurfaceRayIntersection3 Surface3::closestIntersection(
         = (isNormalFlipped) ? -intersection.normal : intersection.normal;
     return intersection;
 }
+
+SurfaceClosestQueryResult3 Surface3::actualClosestQuery(
+    const Vector3D& otherPoint) const {
+    SurfaceClosestQueryResult3 result;
+    result.point = closestPoint(otherPoint);
+    result.normal = actualClosestNormal(otherPoint);
+    result.distance = closestDistance(otherPoint);
+    return result;
+}
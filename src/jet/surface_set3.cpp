@@ -26,92 +26,89 @@ const Surface3Ptr& SurfaceSet3::surfaceAt(size_t i) const {
 
 void SurfaceSet3::addSurface(const Surface3Ptr& surface) {
     _surfaces.push_back(surface);
+    invalidateBvh();
 }
 
-Vector3D SurfaceSet3::closestPoint(const Vector3D& otherPoint) const {
-    Vector3D result(
-        std::numeric_limits<double>::max(),
-        std::numeric_limits<double>::max(),
-        std::numeric_limits<double>::max());
-
-    double minimumDistance = std::numeric_limits<double>::max();
-
-    for (const auto& surface : _surfaces) {
-        Vector3D localClosestPoint = surface->closestPoint(otherPoint);
-        double localDistance = surface->closestDistance(otherPoint);
+void SurfaceSet3::invalidateBvh() {
+    _surfaceBvh.invalidate();
+}
 
-        if (localDistance < minimumDistance) {
-            result = localClosestPoint;
-            minimumDistance = localDistance;
-        }
+Vector3D SurfaceSet3::closestPoint(const Vector3D& otherPoint) const {
+    double distance;
+    size_t i = _surfaceBvh.closestSurface(_surfaces, otherPoint, &distance);
+    if (i == kMaxSize) {
+        return Vector3D(kMaxD, kMaxD, kMaxD);
     }
 
-    return result;
+    return _surfaces[i]->closestPoint(otherPoint);
 }
 
 Vector3D SurfaceSet3::actualClosestNormal(const Vector3D& otherPoint) const {
-    Vector3D result(1, 0, 0);
-
-    double minimumDistance = std::numeric_limits<double>::max();
+    double distance;
+    size_t i = _surfaceBvh.closestSurface(_surfaces, otherPoint, &distance);
+    if (i == kMaxSize) {
+        return Vector3D(1, 0, 0);
+    }
 
-    for (const auto& surface : _surfaces) {
-        Vector3D localClosestNormal = surface->closestNormal(otherPoint);
-        double localDistance = surface->closestDistance(otherPoint);
+    return _surfaces[i]->closestNormal(otherPoint);
+}
 
-        if (localDistance < minimumDistance) {
-            result = localClosestNormal;
-            minimumDistance = localDistance;
-        }
+SurfaceClosestQueryResult3 SurfaceSet3::actualClosestQuery(
+    const Vector3D& otherPoint) const {
+    double distance;
+    size_t i = _surfaceBvh.closestSurface(_surfaces, otherPoint, &distance);
+    if (i == kMaxSize) {
+        return SurfaceClosestQueryResult3();
     }
 
+    SurfaceClosestQueryResult3 result = _surfaces[i]->closestQuery(otherPoint);
+    result.distance = distance;
     return result;
 }
 
 double SurfaceSet3::closestDistance(const Vector3D& otherPoint) const {
-    double minimumDistance = std::numeric_limits<double>::max();
+    double distance;
+    _surfaceBvh.closestSurface(_surfaces, otherPoint, &distance);
+    return distance;
+}
 
-    for (const auto& surface : _surfaces) {
-        double localDistance = surface->closestDistance(otherPoint);
+bool SurfaceSet3::intersects(const Ray3D& ray) const {
+    return _surfaceBvh.intersects(_surfaces, ray);
+}
 
-        minimumDistance = std::min(minimumDistance, localDistance);
+SurfaceRayIntersection3 SurfaceSet3::actualClosestIntersection(
+    const Ray3D& ray) const {
+    size_t i = _surfaceBvh.closestIntersection(_surfaces, ray);
+    if (i == kMaxSize) {
+        return SurfaceRayIntersection3();
     }
 
-    return minimumDistance;
+    return _surfaces[i]->closestIntersection(ray);
 }
 
-bool SurfaceSet3::intersects(const Ray3D& ray) const {
+BoundingBox3D SurfaceSet3::boundingBox() const {
+    BoundingBox3D bbox;
     for (const auto& surface : _surfaces) {
-        if (surface->intersects(ray)) {
-            return true;
-        }
+        bbox.merge(surface->boundingBox());
     }
 
-    return false;
+    return bbox;
 }
 
-SurfaceRayIntersection3 SurfaceSet3::actualClosestIntersection(
-    const Ray3D& ray) const {
-    SurfaceRayIntersection3 intersection;
-    double tMin = std::numeric_limits<double>::max();
-
+bool SurfaceSet3::isClosed() const {
     for (const auto& surface : _surfaces) {
-        SurfaceRayIntersection3 localResult =
-            surface->closestIntersection(ray);
-
-        if (localResult.isIntersecting && localResult.t < tMin) {
-            intersection = localResult;
-            tMin = localResult.t;
+        if (surface->isNormalFlipped || !surface->isClosed()) {
+            return false;
         }
     }
 
-    return intersection;
+    return true;
 }
 
-BoundingBox3D SurfaceSet3::boundingBox() const {
-    BoundingBox3D bbox;
+void SurfaceSet3::updateQueryEngine() {
     for (const auto& surface : _surfaces) {
-        bbox.merge(surface->boundingBox());
+        surface->updateQueryEngine();
     }
 
-    return bbox;
+    _surfaceBvh.update(_surfaces);
 }
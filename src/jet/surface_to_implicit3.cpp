@@ -28,6 +28,11 @@ Vector3D SurfaceToImplicit3::actualClosestNormal(
     return _surface->closestNormal(otherPoint);
 }
 
+SurfaceClosestQueryResult3 SurfaceToImplicit3::actualClosestQuery(
+    const Vector3D& otherPoint) const {
+    return _surface->closestQuery(otherPoint);
+}
+
 double SurfaceToImplicit3::closestDistance(
     const Vector3D& otherPoint) const {
     return _surface->closestDistance(otherPoint);
@@ -46,14 +51,20 @@ BoundingBox3D SurfaceToImplicit3::boundingBox() const {
     return _surface->boundingBox();
 }
 
+bool SurfaceToImplicit3::isClosed() const {
+    return !_surface->isNormalFlipped && _surface->isClosed();
+}
+
+void SurfaceToImplicit3::updateQueryEngine() {
+    _surface->updateQueryEngine();
+}
+
 double SurfaceToImplicit3::signedDistance(
     const Vector3D& otherPoint) const {
-    Vector3D x = _surface->closestPoint(otherPoint);
-    Vector3D n = _surface->closestNormal(otherPoint);
-    n = (isNormalFlipped) ? -n : n;
-    if (n.dot(otherPoint - x) < 0.0) {
-        return -x.distanceTo(otherPoint);
+    SurfaceClosestQueryResult3 query = closestQuery(otherPoint);
+    if (query.normal.dot(otherPoint - query.point) < 0.0) {
+        return -query.point.distanceTo(otherPoint);
     } else {
-        return x.distanceTo(otherPoint);
+        return query.point.distanceTo(otherPoint);
     }
 }
@@ -106,19 +106,19 @@ Vector3D Triangle3::actualClosestNormal(const Vector3D& otherPoint) const {
     Vector3D q = t * n + otherPoint;
 
     Vector3D q01 = (points[1] - points[0]).cross(q - points[0]);
-    if (n.dot(q01)) {
+    if (n.dot(q01) < 0) {
         return closestNormalOnLine(
             points[0], points[1], normals[0], normals[1], q);
     }
 
     Vector3D q12 = (points[2] - points[1]).cross(q - points[1]);
-    if (n.dot(q12)) {
+    if (n.dot(q12) < 0) {
         return closestNormalOnLine(
             points[1], points[2], normals[1], normals[2], q);
     }
 
     Vector3D q02 = (points[0] - points[2]).cross(q - points[2]);
-    if (n.dot(q02)) {
+    if (n.dot(q02) < 0) {
         return closestNormalOnLine(
             points[0], points[2], normals[0], normals[2], q);
     }
@@ -131,6 +131,48 @@ Vector3D Triangle3::actualClosestNormal(const Vector3D& otherPoint) const {
     return (b0 * normals[0] + b1 * normals[1] + b2 * normals[2]).normalized();
 }
 
+SurfaceClosestQueryResult3 Triangle3::actualClosestQuery(
+    const Vector3D& otherPoint) const {
+    Vector3D n = faceNormal();
+    double nd = n.dot(n);
+    double d = n.dot(points[0]);
+    double t = (d - n.dot(otherPoint)) / nd;
+
+    Vector3D q = t * n + otherPoint;
+
+    SurfaceClosestQueryResult3 result;
+
+    Vector3D q01 = (points[1] - points[0]).cross(q - points[0]);
+    Vector3D q12 = (points[2] - points[1]).cross(q - points[1]);
+    Vector3D q02 = (points[0] - points[2]).cross(q - points[2]);
+    if (n.dot(q01) < 0) {
+        result.point = closestPointOnLine(points[0], points[1], q);
+        result.normal = closestNormalOnLine(
+            points[0], points[1], normals[0], normals[1], q);
+    } else if (n.dot(q12) < 0) {
+        result.point = closestPointOnLine(points[1], points[2], q);
+        result.normal = closestNormalOnLine(
+            points[1], points[2], normals[1], normals[2], q);
+    } else if (n.dot(q02) < 0) {
+        result.point = closestPointOnLine(points[0], points[2], q);
+        result.normal = closestNormalOnLine(
+            points[0], points[2], normals[0], normals[2], q);
+    } else {
+        double a = area();
+        double b0 = 0.5 * q12.length() / a;
+        double b1 = 0.5 * q02.length() / a;
+        double b2 = 0.5 * q01.length() / a;
+
+        result.point = b0 * points[0] + b1 * points[1] + b2 * points[2];
+        result.normal
+            = (b0 * normals[0] + b1 * normals[1] + b2 * normals[2])
+                .normalized();
+    }
+
+    result.distance = otherPoint.distanceTo(result.point);
+    return result;
+}
+
 bool Triangle3::intersects(const Ray3D& ray) const {
     Vector3D n = faceNormal();
     double nd = n.dot(ray.direction);
@@ -149,17 +191,17 @@ bool Triangle3::intersects(const Ray3D& ray) const {
     Vector3D q = ray.pointAt(t);
 
     Vector3D q01 = (points[1] - points[0]).cross(q - points[0]);
-    if (n.dot(q01)) {
+    if (n.dot(q01) < 0) {
         return false;
     }
 
     Vector3D q12 = (points[2] - points[1]).cross(q - points[1]);
-    if (n.dot(q12)) {
+    if (n.dot(q12) < 0) {
         return false;
     }
 
     Vector3D q02 = (points[0] - points[2]).cross(q - points[2]);
-    if (n.dot(q02)) {
+    if (n.dot(q02) < 0) {
         return false;
     }
 
@@ -188,19 +230,19 @@ SurfaceRayIntersection3 Triangle3::actualClosestIntersection(
     Vector3D q = ray.pointAt(t);
 
     Vector3D q01 = (points[1] - points[0]).cross(q - points[0]);
-    if (n.dot(q01)) {
+    if (n.dot(q01) < 0) {
         intersection.isIntersecting = false;
         return intersection;
     }
 
     Vector3D q12 = (points[2] - points[1]).cross(q - points[1]);
-    if (n.dot(q12)) {
+    if (n.dot(q12) < 0) {
         intersection.isIntersecting = false;
         return intersection;
     }
 
     Vector3D q02 = (points[0] - points[2]).cross(q - points[2]);
-    if (n.dot(q02)) {
+    if (n.dot(q02) < 0) {
         intersection.isIntersecting = false;
         return intersection;
     }
@@ -7,9 +7,11 @@
 #include <obj/obj_parser.hpp>
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <string>
 #include <utility>  // just make cpplint happy..
+#include <vector>
 
 using namespace jet;
 
@@ -23,70 +25,91 @@ inline std::ostream& operator<<(std::ostream& strm, const Vector3D& v) {
     return strm;
 }
 
-TriangleMesh3::TriangleMesh3() {
+namespace {
+
+// Returns the i-th triangle without the normals and the UVs, which is enough
+// for the distance and the ray tests.
+Triangle3 trianglePoints(const TriangleMesh3& mesh, size_t i) {
+    const Point3UI& face = mesh.pointIndex(i);
+    Triangle3 tri;
+    tri.points[0] = mesh.point(face[0]);
+    tri.points[1] = mesh.point(face[1]);
+    tri.points[2] = mesh.point(face[2]);
+    return tri;
+}
+
+}  // namespace
+
+TriangleMesh3::TriangleMesh3() : _isBvhInvalid(true) {
 }
 
-TriangleMesh3::TriangleMesh3(const TriangleMesh3& other) : Surface3(other) {
+TriangleMesh3::TriangleMesh3(const TriangleMesh3& other) :
+    Surface3(other),
+    _isBvhInvalid(true) {
     set(other);
 }
 
 Vector3D TriangleMesh3::closestPoint(const Vector3D& otherPoint) const {
-    static const double m = std::numeric_limits<double>::max();
-    Vector3D minDistPt(m, m, m);
-    double minDistSquared = m;
+    BvhNearestQueryResult3 result = bvh().nearest(
+        otherPoint,
+        [this](size_t i, const Vector3D& pt) {
+            return pt.distanceTo(trianglePoints(*this, i).closestPoint(pt));
+        });
 
-    size_t n = numberOfTriangles();
-    for (size_t i = 0; i < n; ++i) {
-        Triangle3 tri = triangle(i);
-        Vector3D pt = tri.closestPoint(otherPoint);
-        double distSquared = (otherPoint - pt).lengthSquared();
-        if (distSquared < minDistSquared) {
-            minDistSquared = distSquared;
-            minDistPt = pt;
-        }
+    if (result.item == kMaxSize) {
+        return Vector3D(kMaxD, kMaxD, kMaxD);
     }
 
-    return minDistPt;
+    return trianglePoints(*this, result.item).closestPoint(otherPoint);
 }
 
 Vector3D TriangleMesh3::actualClosestNormal(const Vector3D& otherPoint) const {
-    static const double m = std::numeric_limits<double>::max();
-    Vector3D minDistPt(m, m, m);
-    Vector3D minDistNormal(1, 0, 0);
-    double minDistSquared = m;
+    BvhNearestQueryResult3 result = bvh().nearest(
+        otherPoint,
+        [this](size_t i, const Vector3D& pt) {
+            return pt.distanceTo(trianglePoints(*this, i).closestPoint(pt));
+        });
 
-    size_t n = numberOfTriangles();
-    for (size_t i = 0; i < n; ++i) {
-        Triangle3 tri = triangle(i);
-        Vector3D pt = tri.closestPoint(otherPoint);
-        double distSquared = (otherPoint - pt).lengthSquared();
-        if (distSquared < minDistSquared) {
-            minDistSquared = distSquared;
-            minDistPt = pt;
-            minDistNormal = tri.closestNormal(otherPoint);
-        }
+    if (result.item == kMaxSize) {
+        return Vector3D(1, 0, 0);
+    }
+
+    return triangle(result.item).closestNormal(otherPoint);
+}
+
+SurfaceClosestQueryResult3 TriangleMesh3::actualClosestQuery(
+    const Vector3D& otherPoint) const {
+    BvhNearestQueryResult3 result = bvh().nearest(
+        otherPoint,
+        [this](size_t i, const Vector3D& pt) {
+            return pt.distanceTo(trianglePoints(*this, i).closestPoint(pt));
+        });
+
+    if (result.item == kMaxSize) {
+        return SurfaceClosestQueryResult3();
     }
 
-    return minDistNormal;
+    SurfaceClosestQueryResult3 query
+        = triangle(result.item).closestQuery(otherPoint);
+    query.distance = result.distance;
+    return query;
 }
 
 SurfaceRayIntersection3 TriangleMesh3::actualClosestIntersection(
     const Ray3D& ray) const {
-    SurfaceRayIntersection3 intersection;
+    BvhRayIntersection3 result = bvh().closestIntersection(
+        ray,
+        [this](size_t i, const Ray3D& r) {
+            SurfaceRayIntersection3 intersection
+                = trianglePoints(*this, i).closestIntersection(r);
+            return intersection.isIntersecting ? intersection.t : kMaxD;
+        });
 
-    size_t n = numberOfTriangles();
-    double t = std::numeric_limits<double>::max();
-    for (size_t i = 0; i < n; ++i) {
-        Triangle3 tri = triangle(i);
-        SurfaceRayIntersection3 tmpIntersection
-            = tri.closestIntersection(ray);
-        if (tmpIntersection.t < t) {
-            t = tmpIntersection.t;
-            intersection = tmpIntersection;
-        }
+    if (!result.isIntersecting) {
+        return SurfaceRayIntersection3();
     }
 
-    return intersection;
+    return triangle(result.item).closestIntersection(ray);
 }
 
 BoundingBox3D TriangleMesh3::boundingBox() const {
@@ -102,29 +125,25 @@ BoundingBox3D TriangleMesh3::boundingBox() const {
 }
 
 bool TriangleMesh3::intersects(const Ray3D& ray) const {
-    size_t n = numberOfTriangles();
-    for (size_t i = 0; i < n; ++i) {
-        Triangle3 tri = triangle(i);
-        if (tri.intersects(ray)) {
-            return true;
-        }
-    }
-    return false;
+    return bvh().intersects(
+        ray,
+        [this](size_t i, const Ray3D& r) {
+            return trianglePoints(*this, i).intersects(r);
+        });
 }
 
 double TriangleMesh3::closestDistance(const Vector3D& otherPoint) const {
-    double minDist = std::numeric_limits<double>::max();
-
-    size_t n = numberOfTriangles();
-    for (size_t i = 0; i < n; ++i) {
-        Triangle3 tri = triangle(i);
-        minDist = std::min(minDist, tri.closestDistance(otherPoint));
-    }
+    BvhNearestQueryResult3 result = bvh().nearest(
+        otherPoint,
+        [this](size_t i, const Vector3D& pt) {
+            return pt.distanceTo(trianglePoints(*this, i).closestPoint(pt));
+        });
 
-    return minDist;
+    return result.distance;
 }
 
 void TriangleMesh3::clear() {
+    invalidateBvh();
     _points.clear();
     _normals.clear();
     _uvs.clear();
@@ -134,6 +153,7 @@ void TriangleMesh3::clear() {
 }
 
 void TriangleMesh3::set(const TriangleMesh3& other) {
+    invalidateBvh();
     _points.set(other._points);
     _normals.set(other._normals);
     _uvs.set(other._uvs);
@@ -143,6 +163,8 @@ void TriangleMesh3::set(const TriangleMesh3& other) {
 }
 
 void TriangleMesh3::swap(TriangleMesh3& other) {
+    invalidateBvh();
+    other.invalidateBvh();
     _points.swap(other._points);
     _normals.swap(other._normals);
     _uvs.swap(other._uvs);
@@ -174,6 +196,7 @@ const Vector3D& TriangleMesh3::point(size_t i) const {
 }
 
 Vector3D& TriangleMesh3::point(size_t i) {
+    invalidateBvh();
     return _points[i];
 }
 
@@ -198,6 +221,7 @@ const Point3UI& TriangleMesh3::pointIndex(size_t i) const {
 }
 
 Point3UI& TriangleMesh3::pointIndex(size_t i) {
+    invalidateBvh();
     return _pointIndices[i];
 }
 
@@ -264,6 +288,7 @@ bool TriangleMesh3::hasUvs() const {
 }
 
 void TriangleMesh3::addPoint(const Vector3D& pt) {
+    invalidateBvh();
     _points.append(pt);
 }
 
@@ -276,12 +301,14 @@ void TriangleMesh3::addUv(const Vector2D& t) {
 }
 
 void TriangleMesh3::addPointTriangle(const Point3UI& newPointIndices) {
+    invalidateBvh();
     _pointIndices.append(newPointIndices);
 }
 
 void TriangleMesh3::addPointNormalTriangle(
     const Point3UI& newPointIndices,
     const Point3UI& newNormalIndices) {
+    invalidateBvh();
     // Number of normal indicies must match with number of point indices once
     // you decided to add normal indicies. Same for the uvs as well.
     JET_ASSERT(_pointIndices.size() == _normalIndices.size());
@@ -294,6 +321,7 @@ void TriangleMesh3::addPointNormalUvTriangle(
     const Point3UI& newPointIndices,
     const Point3UI& newNormalIndices,
     const Point3UI& newUvIndices) {
+    invalidateBvh();
     // Number of normal indicies must match with number of point indices once
     // you decided to add normal indicies. Same for the uvs as well.
     JET_ASSERT(_pointIndices.size() == _normalIndices.size());
@@ -306,6 +334,7 @@ void TriangleMesh3::addPointNormalUvTriangle(
 void TriangleMesh3::addPointUvTriangle(
     const Point3UI& newPointIndices,
     const Point3UI& newUvIndices) {
+    invalidateBvh();
     // Number of normal indicies must match with number of point indices once
     // you decided to add normal indicies. Same for the uvs as well.
     JET_ASSERT(_pointIndices.size() == _uvs.size());
@@ -314,6 +343,7 @@ void TriangleMesh3::addPointUvTriangle(
 }
 
 void TriangleMesh3::addTriangle(const Triangle3& tri) {
+    invalidateBvh();
     size_t vStart = _points.size();
     size_t nStart = _normals.size();
     size_t tStart = _uvs.size();
@@ -419,6 +449,7 @@ void TriangleMesh3::setAngleWeightedVertexNormal() {
 }
 
 void TriangleMesh3::scale(double factor) {
+    invalidateBvh();
     parallelFor(
         kZeroSize,
         numberOfPoints(),
@@ -428,6 +459,7 @@ void TriangleMesh3::scale(double factor) {
 }
 
 void TriangleMesh3::translate(const Vector3D& t) {
+    invalidateBvh();
     parallelFor(
         kZeroSize,
         numberOfPoints(),
@@ -437,6 +469,7 @@ void TriangleMesh3::translate(const Vector3D& t) {
 }
 
 void TriangleMesh3::rotate(const Quaternion<double>& q) {
+    invalidateBvh();
     parallelFor(
         kZeroSize,
         numberOfPoints(),
@@ -642,3 +675,25 @@ TriangleMesh3& TriangleMesh3::operator=(const TriangleMesh3& other) {
     set(other);
     return *this;
 }
+
+const Bvh3& TriangleMesh3::bvh() const {
+    if (_isBvhInvalid) {
+        std::lock_guard<std::mutex> lock(_bvhMutex);
+        if (_isBvhInvalid) {
+            size_t n = numberOfTriangles();
+            std::vector<BoundingBox3D> bounds(n);
+            parallelFor(kZeroSize, n, [this, &bounds](size_t i) {
+                bounds[i] = Bvh3::paddedBound(
+                    trianglePoints(*this, i).boundingBox());
+            });
+
+            _bvh.build(bounds);
+            _isBvhInvalid = false;
+        }
+    }
+    return _bvh;
+}
+
+void TriangleMesh3::invalidateBvh() {
+    _isBvhInvalid = true;
+}
@@ -24,106 +24,37 @@
 // SOFTWARE.
 
 #include <pch.h>
+#include <block_sweeper3.h>
 #include <jet/array_utils.h>
 #include <jet/array3.h>
+#include <jet/parallel.h>
 #include <jet/triangle_mesh_to_sdf.h>
 #include <algorithm>
+#include <cmath>
+#include <numeric>
 #include <vector>
 
 using namespace jet;
 
 namespace jet {
 
-static void checkNeighbor(
-    const TriangleMesh3& mesh,
-    const Vector3D& gx,
-    ssize_t i0,
-    ssize_t j0,
-    ssize_t k0,
-    ssize_t i1,
-    ssize_t j1,
-    ssize_t k1,
-    ScalarGrid3* sdf,
-    Array3<size_t>* closestTri) {
-    if ((*closestTri)(i1, j1, k1) != kMaxSize) {
-        size_t t = (*closestTri)(i1, j1, k1);
-        Triangle3 tri = mesh.triangle(t);
-
-        double d = tri.closestDistance(gx);
-
-        if (d < (*sdf)(i0, j0, k0)) {
-            (*sdf)(i0, j0, k0) = d;
-            (*closestTri)(i0, j0, k0) = (*closestTri)(i1, j1, k1);
-        }
-    }
-}
-
-static void sweep(
-    const TriangleMesh3& mesh,
-    int di,
-    int dj,
-    int dk,
-    ScalarGrid3* sdf,
-    Array3<size_t>* closestTri) {
-    Size3 size = sdf->dataSize();
-    Vector3D h = sdf->gridSpacing();
-    Vector3D origin = sdf->dataOrigin();
+// Sweep orderings in the same sequence as SDFGen: (+++), (---), (++-), (--+),
+// (+-+), (-+-), (+--), and (-++). The bits flip the direction along x, y, and z.
+static const int kSweepOrderings[8] = { 0, 7, 4, 3, 2, 5, 6, 1 };
 
-    ssize_t ni = static_cast<ssize_t>(size.x);
-    ssize_t nj = static_cast<ssize_t>(size.y);
-    ssize_t nk = static_cast<ssize_t>(size.z);
+// Grid index ranges that a triangle touches, which are inclusive and clamped
+// to the grid.
+struct TriangleIndexRange {
+    // Points that get the exact distance
+    ssize_t i0, i1, j0, j1, k0, k1;
 
-    ssize_t i0, i1;
-    if (di > 0) {
-        i0 = 1;
-        i1 = ni;
-    } else {
-        i0 = ni - 2;
-        i1 = -1;
-    }
+    // Rows along x that may intersect with the triangle
+    ssize_t cj0, cj1, ck0, ck1;
+};
 
-    ssize_t j0, j1;
-    if (dj > 0) {
-        j0 = 1;
-        j1 = nj;
-    } else {
-        j0 = nj - 2;
-        j1 = -1;
-    }
-
-    ssize_t k0, k1;
-    if (dk > 0) {
-        k0 = 1;
-        k1 = nk;
-    } else {
-        k0 = nk - 2;
-        k1 = -1;
-    }
-
-    for (ssize_t k = k0; k != k1; k += dk) {
-        for (ssize_t j = j0; j != j1; j += dj) {
-            for (ssize_t i = i0; i != i1; i += di) {
-                Vector3D gx({ i, j, k });
-                gx *= h;
-                gx += origin;
-
-                checkNeighbor(
-                    mesh, gx, i, j, k, i - di, j, k, sdf, closestTri);
-                checkNeighbor(
-                    mesh, gx, i, j, k, i, j - dj, k, sdf, closestTri);
-                checkNeighbor(
-                    mesh, gx, i, j, k, i - di, j - dj, k, sdf, closestTri);
-                checkNeighbor(
-                    mesh, gx, i, j, k, i, j, k - dk, sdf, closestTri);
-                checkNeighbor(
-                    mesh, gx, i, j, k, i - di, j, k - dk, sdf, closestTri);
-                checkNeighbor(
-                    mesh, gx, i, j, k, i, j - dj, k - dk, sdf, closestTri);
-                checkNeighbor(
-                    mesh, gx, i, j, k, i - di, j - dj, k - dk, sdf, closestTri);
-            }
-        }
-    }
+static ssize_t clampIndex(double x, size_t n) {
+    return clamp(
+        static_cast<ssize_t>(x), kZeroSSize, static_cast<ssize_t>(n) - 1);
 }
 
 // calculate twice signed area of triangle (0,0)-(x1,y1)-(x2,y2)
@@ -198,82 +129,119 @@ static bool pointInTriangle2D(
 void triangleMeshToSdf(
     const TriangleMesh3& mesh,
     ScalarGrid3* sdf,
-    const unsigned int exactBand) {
+    const unsigned int exactBand,
+    const unsigned int narrowBand) {
     Size3 size = sdf->dataSize();
     if (size.x * size.y * size.z == 0) {
         return;
     }
 
-    // Upper bound on distance
-    sdf->fill(sdf->boundingBox().diagonalLength());
     Vector3D h = sdf->gridSpacing();
     Vector3D origin = sdf->dataOrigin();
 
+    // Upper bound on distance, which also clamps the narrow band
+    const double maxDistance = std::min(
+        sdf->boundingBox().diagonalLength(),
+        narrowBand * std::max(std::max(h.x, h.y), h.z));
+    sdf->fill(maxDistance);
+
+    auto sdfAcc = sdf->dataAccessor();
+
     Array3<size_t> closestTri(size, kMaxSize);
 
     // Intersection_count(i,j,k) is # of tri intersections in (i-1,i]x{j}x{k}
     Array3<unsigned int> intersectionCount(size, 0);
 
     // We begin by initializing distances near the mesh, and figuring out
-    // intersection counts
-    Vector3D ijkmin, ijkmax;
-
+    // intersection counts. The triangles are binned by the z-layers they
+    // touch, and each layer is processed by a single thread in the order of
+    // the triangle indices. So the min-updates are race-free, and the result
+    // is the same as the serial loop over the triangles.
     size_t nTri = mesh.numberOfTriangles();
-    for (size_t t = 0; t < nTri; ++t) {
+    std::vector<TriangleIndexRange> ranges(nTri);
+    const double band = static_cast<double>(exactBand);
+
+    parallelFor(kZeroSize, nTri, [&](size_t t) {
         Point3UI indices = mesh.pointIndex(t);
 
-        Triangle3 tri = mesh.triangle(t);
+        // Normalize coordinates
+        Vector3D f1 = (mesh.point(indices.x) - origin) / h;
+        Vector3D f2 = (mesh.point(indices.y) - origin) / h;
+        Vector3D f3 = (mesh.point(indices.z) - origin) / h;
+
+        Vector3D fMin(
+            min3(f1.x, f2.x, f3.x),
+            min3(f1.y, f2.y, f3.y),
+            min3(f1.z, f2.z, f3.z));
+        Vector3D fMax(
+            max3(f1.x, f2.x, f3.x),
+            max3(f1.y, f2.y, f3.y),
+            max3(f1.z, f2.z, f3.z));
+
+        TriangleIndexRange& r = ranges[t];
+        r.i0 = clampIndex(std::floor(fMin.x) - band, size.x);
+        r.i1 = clampIndex(std::floor(fMax.x) + band + 1.0, size.x);
+        r.j0 = clampIndex(std::floor(fMin.y) - band, size.y);
+        r.j1 = clampIndex(std::floor(fMax.y) + band + 1.0, size.y);
+        r.k0 = clampIndex(std::floor(fMin.z) - band, size.z);
+        r.k1 = clampIndex(std::floor(fMax.z) + band + 1.0, size.z);
+
+        r.cj0 = clampIndex(std::ceil(fMin.y), size.y);
+        r.cj1 = clampIndex(std::floor(fMax.y), size.y);
+        r.ck0 = clampIndex(std::ceil(fMin.z), size.z);
+        r.ck1 = clampIndex(std::floor(fMax.z), size.z);
+    });
+
+    std::vector<size_t> layerOffsets(size.z + 1, 0);
+    for (size_t t = 0; t < nTri; ++t) {
+        for (ssize_t k = ranges[t].k0; k <= ranges[t].k1; ++k) {
+            ++layerOffsets[k + 1];
+        }
+    }
+    std::partial_sum(
+        layerOffsets.begin(), layerOffsets.end(), layerOffsets.begin());
+
+    std::vector<size_t> layerTriangles(layerOffsets.back());
+    std::vector<size_t> layerEnds(layerOffsets.begin(), layerOffsets.end() - 1);
+    for (size_t t = 0; t < nTri; ++t) {
+        for (ssize_t k = ranges[t].k0; k <= ranges[t].k1; ++k) {
+            layerTriangles[layerEnds[k]++] = t;
+        }
+    }
+
+    parallelFor(kZeroSize, size.z, [&](size_t k) {
+        const ssize_t kS = static_cast<ssize_t>(k);
 
-        Vector3D pt1 = mesh.point(indices.x);
-        Vector3D pt2 = mesh.point(indices.y);
-        Vector3D pt3 = mesh.point(indices.z);
+        for (size_t n = layerOffsets[k]; n < layerOffsets[k + 1]; ++n) {
+            const size_t t = layerTriangles[n];
+            const TriangleIndexRange& r = ranges[t];
 
-        // Normalize coordinates
-        Vector3D f1 = (pt1 - origin) / h;
-        Vector3D f2 = (pt2 - origin) / h;
-        Vector3D f3 = (pt3 - origin) / h;
-
-        // Do distances nearby
-        size_t i0 = clamp(static_cast<size_t>(
-            min3(f1.x, f2.x, f3.x)) - exactBand, kZeroSize, size.x - 1);
-        size_t i1 = clamp(static_cast<size_t>(
-            max3(f1.x, f2.x, f3.x)) + exactBand + 1, kZeroSize, size.x - 1);
-        size_t j0 = clamp(static_cast<size_t>(
-            min3(f1.y, f2.y, f3.y)) - exactBand, kZeroSize, size.y - 1);
-        size_t j1 = clamp(static_cast<size_t>(
-            max3(f1.y, f2.y, f3.y)) + exactBand + 1, kZeroSize, size.y - 1);
-        size_t k0 = clamp(static_cast<size_t>(
-            min3(f1.z, f2.z, f3.z)) - exactBand, kZeroSize, size.z - 1);
-        size_t k1 = clamp(static_cast<size_t>(
-            max3(f1.z, f2.z, f3.z)) + exactBand + 1, kZeroSize, size.z - 1);
-
-        for (size_t k = k0; k <= k1; ++k) {
-            for (size_t j = j0; j <= j1; ++j) {
-                for (size_t i = i0; i <= i1; ++i) {
-                    Vector3D gx({ i, j, k });
+            // Do distances nearby
+            Triangle3 tri = mesh.triangle(t);
+            for (ssize_t j = r.j0; j <= r.j1; ++j) {
+                for (ssize_t i = r.i0; i <= r.i1; ++i) {
+                    Vector3D gx({ i, j, kS });
                     gx *= h;
                     gx += origin;
                     double d = tri.closestDistance(gx);
-                    if (d < (*sdf)(i, j, k)) {
-                        (*sdf)(i, j, k) = d;
+                    if (d < sdfAcc(i, j, k)) {
+                        sdfAcc(i, j, k) = d;
                         closestTri(i, j, k) = t;
                     }
                 }
             }
-        }
 
-        // Do intersection counts
-        j0 = clamp(static_cast<size_t>(
-            std::ceil(min3(f1.y, f2.y, f3.y))), kZeroSize, size.y - 1);
-        j1 = clamp(static_cast<size_t>(
-            std::floor(max3(f1.y, f2.y, f3.y))), kZeroSize, size.y - 1);
-        k0 = clamp(static_cast<size_t>(
-            std::ceil(min3(f1.z, f2.z, f3.z))), kZeroSize, size.z - 1);
-        k1 = clamp(static_cast<size_t>(
-            std::floor(max3(f1.z, f2.z, f3.z))), kZeroSize, size.z - 1);
-
-        for (size_t k = k0; k <= k1; ++k) {
-            for (size_t j = j0; j <= j1; ++j) {
+            // Do intersection counts
+            if (kS < r.ck0 || kS > r.ck1) {
+                continue;
+            }
+
+            Point3UI indices = mesh.pointIndex(t);
+            Vector3D f1 = (mesh.point(indices.x) - origin) / h;
+            Vector3D f2 = (mesh.point(indices.y) - origin) / h;
+            Vector3D f3 = (mesh.point(indices.z) - origin) / h;
+
+            for (ssize_t j = r.cj0; j <= r.cj1; ++j) {
                 double a, b, c;
                 double jD = static_cast<double>(j);
                 double kD = static_cast<double>(k);
@@ -296,22 +264,71 @@ void triangleMeshToSdf(
                 }
             }
         }
-    }
+    });
+
+    // and now we fill in the rest of the distances with fast sweeping. Each
+    // point takes the closest triangle of its upwind neighbors if that is
+    // closer. The blocks on a hyperplane are swept in parallel, and only the
+    // blocks near the changed ones are revisited, so the fronts stop at the
+    // narrow band. The sweeps are repeated until nothing changes.
+    const ssize_t ni = static_cast<ssize_t>(size.x);
+    const ssize_t nj = static_cast<ssize_t>(size.y);
+    const ssize_t nk = static_cast<ssize_t>(size.z);
+
+    BlockSweeper3 sweeper(size, true);
+    sweeper.markSeedBlocks([&](size_t i, size_t j, size_t k) {
+        return closestTri(i, j, k) != kMaxSize;
+    });
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int ordering : kSweepOrderings) {
+            const ssize_t di = (ordering & 1) ? -1 : 1;
+            const ssize_t dj = (ordering & 2) ? -1 : 1;
+            const ssize_t dk = (ordering & 4) ? -1 : 1;
+
+            auto update = [&](size_t i, size_t j, size_t k) -> bool {
+                Vector3D gx({ i, j, k });
+                gx *= h;
+                gx += origin;
+
+                bool updated = false;
+
+                // Visits (i-di,j,k), (i,j-dj,k), (i-di,j-dj,k), (i,j,k-dk),
+                // and so on.
+                for (int n = 1; n < 8; ++n) {
+                    const ssize_t i1 = i - ((n & 1) ? di : 0);
+                    const ssize_t j1 = j - ((n & 2) ? dj : 0);
+                    const ssize_t k1 = k - ((n & 4) ? dk : 0);
+                    if (i1 < 0 || i1 >= ni || j1 < 0 || j1 >= nj
+                        || k1 < 0 || k1 >= nk) {
+                        continue;
+                    }
+
+                    // The same triangle gives the same distance.
+                    const size_t t = closestTri(i1, j1, k1);
+                    if (t == kMaxSize || t == closestTri(i, j, k)) {
+                        continue;
+                    }
 
-    // and now we fill in the rest of the distances with fast sweeping
-    for (unsigned int pass = 0; pass < 2; ++pass) {
-        sweep(mesh, +1, +1, +1, sdf, &closestTri);
-        sweep(mesh, -1, -1, -1, sdf, &closestTri);
-        sweep(mesh, +1, +1, -1, sdf, &closestTri);
-        sweep(mesh, -1, -1, +1, sdf, &closestTri);
-        sweep(mesh, +1, -1, +1, sdf, &closestTri);
-        sweep(mesh, -1, +1, -1, sdf, &closestTri);
-        sweep(mesh, +1, -1, -1, sdf, &closestTri);
-        sweep(mesh, -1, +1, +1, sdf, &closestTri);
+                    double d = mesh.triangle(t).closestDistance(gx);
+                    if (d < sdfAcc(i, j, k)) {
+                        sdfAcc(i, j, k) = d;
+                        closestTri(i, j, k) = t;
+                        updated = true;
+                    }
+                }
+
+                return updated;
+            };
+
+            changed |= sweeper.sweep(ordering, update);
+        }
     }
 
     // then figure out signs (inside/outside) from intersection counts
-    for (size_t k = 0; k < size.z; ++k) {
+    parallelFor(kZeroSize, size.z, [&](size_t k) {
         for (size_t j = 0; j < size.y; ++j) {
             unsigned int totalCount = 0U;
             for (size_t i = 0; i < size.x; ++i) {
@@ -319,11 +336,11 @@ void triangleMeshToSdf(
                 // if parity of intersections so far is odd,
                 if (totalCount % 2 == 1) {
                     // we are inside the mesh
-                    (*sdf)(i, j, k) = -(*sdf)(i, j, k);
+                    sdfAcc(i, j, k) = -sdfAcc(i, j, k);
                 }
             }
         }
-    }
+    });
 }
 
 }  // namespace jet
@@ -0,0 +1,190 @@
+// Copyright (c) 2016 Doyub Kim
+
+#include <perf_tests.h>
+#include <jet/fdm_cg_solver3.h>
+#include <jet/fdm_gauss_seidel_solver3.h>
+#include <jet/fdm_iccg_solver3.h>
+#include <jet/fdm_mgpcg_solver3.h>
+#include <jet/fdm_mixed_precision_cg_solver3.h>
+#include <jet/fdm_parallel_iccg_solver3.h>
+#include <jet/timer.h>
+#include <gtest/gtest.h>
+#include <cmath>
+
+using namespace jet;
+
+// Poisson equation with the upper half of the domain filled with air
+static void buildPoissonSystem(FdmLinearSystem3* system, size_t n) {
+    Size3 size(n, n, n);
+    system->A.resize(size);
+    system->x.resize(size);
+    system->b.resize(size);
+
+    auto isFluid = [n](size_t, size_t j, size_t) {
+        return j < n / 2;
+    };
+
+    system->A.forEachIndex([&](size_t i, size_t j, size_t k) {
+        FdmMatrixRow3& row = system->A(i, j, k);
+        row = FdmMatrixRow3();
+        system->b(i, j, k) = 0.0;
+
+        if (!isFluid(i, j, k)) {
+            row.center = 1.0;
+            return;
+        }
+
+        system->b(i, j, k) = std::sin(0.3 * i) * std::cos(0.2 * j + 0.1 * k);
+
+        if (i > 0) {
+            row.center += 1.0;
+        }
+        if (i + 1 < n) {
+            row.center += 1.0;
+            if (isFluid(i + 1, j, k)) {
+                row.right = -1.0;
+            }
+        }
+        if (j > 0) {
+            row.center += 1.0;
+        }
+        if (j + 1 < n) {
+            row.center += 1.0;
+            if (isFluid(i, j + 1, k)) {
+                row.up = -1.0;
+            }
+        }
+        if (k > 0) {
+            row.center += 1.0;
+        }
+        if (k + 1 < n) {
+            row.center += 1.0;
+            if (isFluid(i, j, k + 1)) {
+                row.front = -1.0;
+            }
+        }
+    });
+}
+
+template <typename SolverType>
+static void benchmarkSolver(
+    const char* name, SolverType* solver, size_t resolution = 128) {
+    FdmLinearSystem3 system;
+    buildPoissonSystem(&system, resolution);
+
+    Timer timer;
+
+    solver->solve(&system);
+
+    JET_PRINT_INFO(
+        "%s::solve %f sec. (%u iterations)\n",
+        name,
+        timer.durationInSeconds(),
+        solver->lastNumberOfIterations());
+}
+
+template <typename SolverType>
+static void benchmarkCompressedSolver(const char* name, SolverType* solver) {
+    FdmLinearSystem3 system;
+    buildPoissonSystem(&system, 128);
+
+    FdmCompressedLinearSystem3 compSystem;
+    compSystem.build(
+        system.A.size(),
+        [&](size_t, size_t j, size_t) {
+            return j < 64;
+        },
+        [&](size_t i, size_t j, size_t k, FdmMatrixRow3* row, double* rhs) {
+            *row = system.A(i, j, k);
+            *rhs = system.b(i, j, k);
+        });
+
+    Timer timer;
+
+    solver->solveCompressed(&compSystem);
+
+    JET_PRINT_INFO(
+        "%s::solveCompressed %f sec. (%u iterations)\n",
+        name,
+        timer.durationInSeconds(),
+        solver->lastNumberOfIterations());
+}
+
+TEST(FdmCgSolver3, Solve) {
+    FdmCgSolver3 solver(1000, 1e-6);
+    benchmarkSolver("FdmCgSolver3", &solver);
+}
+
+TEST(FdmCgSolver3, SolveMatrixFree) {
+    FdmLinearSystem3 system;
+    buildPoissonSystem(&system, 128);
+
+    FdmMatrixFreeSystem3 mfSystem;
+    mfSystem.A.markers.resize(system.A.size());
+    mfSystem.A.markers.forEachIndex([&](size_t i, size_t j, size_t k) {
+        mfSystem.A.markers(i, j, k) = (j < 64)
+            ? FdmMatrixFreeMatrix3::Fluid : FdmMatrixFreeMatrix3::Air;
+    });
+    mfSystem.x.resize(system.A.size());
+    mfSystem.b.set(system.b);
+
+    FdmCgSolver3 solver(1000, 1e-6);
+
+    Timer timer;
+
+    solver.solveMatrixFree(&mfSystem);
+
+    JET_PRINT_INFO(
+        "FdmCgSolver3::solveMatrixFree %f sec. (%u iterations)\n",
+        timer.durationInSeconds(),
+        solver.lastNumberOfIterations());
+}
+
+TEST(FdmMixedPrecisionCgSolver3, Solve) {
+    FdmMixedPrecisionCgSolver3 solver(1000, 1e-6);
+    benchmarkSolver("FdmMixedPrecisionCgSolver3", &solver);
+}
+
+// Stationary solvers converge much slower, so use a smaller grid
+TEST(FdmGaussSeidelSolver3, Solve) {
+    FdmGaussSeidelSolver3 solver(100000, 10, 1e-6);
+    benchmarkSolver("FdmGaussSeidelSolver3", &solver, 32);
+}
+
+TEST(FdmGaussSeidelSolver3, SolveRedBlack) {
+    FdmGaussSeidelSolver3 solver(
+        100000, 10, 1e-6, 1.0, FdmGaussSeidelSolver3::RedBlack);
+    benchmarkSolver("FdmGaussSeidelSolver3 (red-black)", &solver, 32);
+}
+
+TEST(FdmGaussSeidelSolver3, SolveRedBlackSor) {
+    FdmGaussSeidelSolver3 solver(
+        100000, 10, 1e-6, 1.8, FdmGaussSeidelSolver3::RedBlack);
+    benchmarkSolver("FdmGaussSeidelSolver3 (red-black SOR)", &solver, 32);
+}
+
+TEST(FdmGaussSeidelSolver3, SolveMultiColorSor) {
+    FdmGaussSeidelSolver3 solver(
+        100000, 10, 1e-6, 1.8, FdmGaussSeidelSolver3::MultiColor);
+    benchmarkSolver("FdmGaussSeidelSolver3 (multi-color SOR)", &solver, 32);
+}
+
+TEST(FdmIccgSolver3, Solve) {
+    FdmIccgSolver3 solver(1000, 1e-6);
+    benchmarkSolver("FdmIccgSolver3", &solver);
+}
+
+TEST(FdmIccgSolver3, SolveCompressed) {
+    FdmIccgSolver3 solver(1000, 1e-6);
+    benchmarkCompressedSolver("FdmIccgSolver3", &solver);
+}
+
+TEST(FdmParallelIccgSolver3, Solve) {
+    FdmParallelIccgSolver3 solver(1000, 1e-6);
+    benchmarkSolver("FdmParallelIccgSolver3", &solver);
+}
+
+TEST(FdmMgpcgSolver3, Solve) {
+    FdmMgpcgSolver3 solver(1000, 1e-6);
+    benchmarkSolver("FdmMgpcgSolver3", &solver);
+}
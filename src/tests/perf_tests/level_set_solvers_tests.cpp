@@ -0,0 +1,108 @@
+// Copyright (c) 2016 Doyub Kim
+
+#include <perf_tests.h>
+#include <jet/cell_centered_scalar_grid3.h>
+#include <jet/eno_level_set_solver3.h>
+#include <jet/face_centered_grid3.h>
+#include <jet/fast_sweeping_level_set_solver3.h>
+#include <jet/fmm_level_set_solver3.h>
+#include <jet/timer.h>
+#include <jet/upwind_level_set_solver3.h>
+#include <gtest/gtest.h>
+#include <cmath>
+
+using namespace jet;
+
+// Distorted SDF of a sphere, which is the typical input after advection
+static void buildDistortedSdf(CellCenteredScalarGrid3* sdf, size_t n) {
+    const double h = 1.0 / n;
+    sdf->resize(Size3(n, n, n), Vector3D(h, h, h));
+    sdf->fill([](const Vector3D& x) {
+        double phi = (x - Vector3D(0.5, 0.5, 0.5)).length() - 0.3;
+        return phi * (1.5 + 0.5 * std::sin(10.0 * x.x));
+    });
+}
+
+static void benchmarkReinitialize(
+    const char* name, LevelSetSolver3* solver, size_t resolution = 128) {
+    CellCenteredScalarGrid3 sdf, output;
+    buildDistortedSdf(&sdf, resolution);
+    output.resize(sdf.resolution(), sdf.gridSpacing());
+
+    // Same band as LevelSetLiquidSolver3 with CFL 5
+    const double maxDistance = 10.0 / resolution;
+
+    Timer timer;
+
+    solver->reinitialize(sdf, maxDistance, &output);
+
+    JET_PRINT_INFO(
+        "%s::reinitialize %f sec.\n", name, timer.durationInSeconds());
+}
+
+static void benchmarkExtrapolate(
+    const char* name, LevelSetSolver3* solver, size_t resolution = 128) {
+    CellCenteredScalarGrid3 sdf;
+    buildDistortedSdf(&sdf, resolution);
+
+    FaceCenteredGrid3 vel(sdf.resolution(), sdf.gridSpacing());
+    vel.fill([](const Vector3D& x) {
+        return Vector3D(std::sin(x.y), std::cos(x.z), x.x);
+    });
+
+    const double maxDistance = 10.0 / resolution;
+
+    Timer timer;
+
+    solver->extrapolate(vel, sdf, maxDistance, &vel);
+
+    JET_PRINT_INFO(
+        "%s::extrapolate %f sec.\n", name, timer.durationInSeconds());
+}
+
+TEST(UpwindLevelSetSolver3, Reinitialize) {
+    UpwindLevelSetSolver3 solver;
+    benchmarkReinitialize("UpwindLevelSetSolver3", &solver);
+}
+
+TEST(EnoLevelSetSolver3, Reinitialize) {
+    EnoLevelSetSolver3 solver;
+    benchmarkReinitialize("EnoLevelSetSolver3", &solver);
+}
+
+TEST(EnoLevelSetSolver3, ReinitializeNarrowBand) {
+    EnoLevelSetSolver3 solver;
+    solver.setIsUsingNarrowBand(true);
+    benchmarkReinitialize("EnoLevelSetSolver3 (narrow band)", &solver);
+}
+
+TEST(FmmLevelSetSolver3, Reinitialize) {
+    FmmLevelSetSolver3 solver;
+    benchmarkReinitialize("FmmLevelSetSolver3", &solver);
+}
+
+TEST(FastSweepingLevelSetSolver3, Reinitialize) {
+    FastSweepingLevelSetSolver3 solver;
+    benchmarkReinitialize("FastSweepingLevelSetSolver3", &solver);
+}
+
+TEST(EnoLevelSetSolver3, Extrapolate) {
+    EnoLevelSetSolver3 solver;
+    benchmarkExtrapolate("EnoLevelSetSolver3", &solver);
+}
+
+TEST(EnoLevelSetSolver3, ExtrapolateNarrowBand) {
+    EnoLevelSetSolver3 solver;
+    solver.setIsUsingNarrowBand(true);
+    benchmarkExtrapolate("EnoLevelSetSolver3 (narrow band)", &solver);
+}
+
+TEST(FmmLevelSetSolver3, Extrapolate) {
+    FmmLevelSetSolver3 solver;
+    benchmarkExtrapolate("FmmLevelSetSolver3", &solver);
+}
+
+TEST(FastSweepingLevelSetSolver3, Extrapolate) {
+    FastSweepingLevelSetSolver3 solver;
+    benchmarkExtrapolate("FastSweepingLevelSetSolver3", &solver);
+}
@@ -0,0 +1,103 @@
+// Copyright (c) 2016 Doyub Kim
+
+#include <perf_tests.h>
+#include <jet/constants.h>
+#include <jet/parallel.h>
+#include <jet/timer.h>
+#include <jet/triangle_mesh3.h>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace jet;
+
+// Latitude-longitude sphere with 2 * nu * nv triangles
+static void buildSphere(TriangleMesh3* mesh, size_t nu, size_t nv) {
+    const Vector3D c(0.5, 0.5, 0.5);
+    for (size_t j = 0; j <= nv; ++j) {
+        double theta = kPiD * (j + 0.5) / (nv + 1);
+        for (size_t i = 0; i < nu; ++i) {
+            double phi = 2.0 * kPiD * i / nu;
+            mesh->addPoint(c + 0.4 * Vector3D(
+                std::sin(theta) * std::cos(phi),
+                std::cos(theta),
+                std::sin(theta) * std::sin(phi)));
+        }
+    }
+
+    for (size_t j = 0; j < nv; ++j) {
+        for (size_t i = 0; i < nu; ++i) {
+            size_t i1 = (i + 1) % nu;
+            size_t a = j * nu + i, b = j * nu + i1;
+            size_t c0 = (j + 1) * nu + i, d = (j + 1) * nu + i1;
+            mesh->addPointTriangle(Point3UI(a, b, d));
+            mesh->addPointTriangle(Point3UI(a, d, c0));
+        }
+    }
+}
+
+TEST(TriangleMesh3, ClosestDistance) {
+    TriangleMesh3 mesh;
+    buildSphere(&mesh, 1000, 250);
+
+    std::mt19937 rng;
+    std::uniform_real_distribution<> d(-1.0, 1.0);
+
+    // Points near the surface, such as the particles that hit the collider
+    std::vector<Vector3D> points(1 << 16);
+    for (auto& pt : points) {
+        Vector3D dir = Vector3D(d(rng), d(rng), d(rng)).normalized();
+        pt = Vector3D(0.5, 0.5, 0.5) + (0.4 + 0.05 * d(rng)) * dir;
+    }
+    std::vector<double> dists(points.size());
+
+    Timer timer;
+
+    // The first query builds the hierarchy.
+    mesh.closestDistance(points[0]);
+
+    JET_PRINT_INFO(
+        "TriangleMesh3::build (%zu triangles) %f sec.\n",
+        mesh.numberOfTriangles(),
+        timer.durationInSeconds());
+
+    timer.reset();
+
+    parallelFor(kZeroSize, points.size(), [&](size_t i) {
+        dists[i] = mesh.closestDistance(points[i]);
+    });
+
+    JET_PRINT_INFO(
+        "TriangleMesh3::closestDistance (%zu queries) %f sec.\n",
+        points.size(),
+        timer.durationInSeconds());
+}
+
+TEST(TriangleMesh3, ClosestIntersection) {
+    TriangleMesh3 mesh;
+    buildSphere(&mesh, 1000, 250);
+    mesh.closestDistance(Vector3D());
+
+    std::mt19937 rng;
+    std::uniform_real_distribution<> d(-1.0, 1.0);
+
+    std::vector<Ray3D> rays(1 << 20);
+    for (auto& ray : rays) {
+        ray.origin = Vector3D(0.5, 0.5, 0.5)
+            + 0.2 * Vector3D(d(rng), d(rng), d(rng));
+        ray.direction = Vector3D(d(rng), d(rng), d(rng)).normalized();
+    }
+    std::vector<double> ts(rays.size());
+
+    Timer timer;
+
+    parallelFor(kZeroSize, rays.size(), [&](size_t i) {
+        ts[i] = mesh.closestIntersection(rays[i]).t;
+    });
+
+    JET_PRINT_INFO(
+        "TriangleMesh3::closestIntersection (%zu queries) %f sec.\n",
+        rays.size(),
+        timer.durationInSeconds());
+}
@@ -0,0 +1,67 @@
+// Copyright (c) 2016 Doyub Kim
+
+#include <jet/bfecc3.h>
+#include <jet/cell_centered_scalar_grid3.h>
+#include <jet/cell_centered_vector_grid3.h>
+#include <jet/constant_vector_field3.h>
+#include <jet/semi_lagrangian3.h>
+#include <gtest/gtest.h>
+#include <cmath>
+
+using namespace jet;
+
+static double blob(const Vector3D& x) {
+    return std::exp(-square(x.x - 0.5) / 0.01);
+}
+
+TEST(Bfecc3, LessDissipative) {
+    ConstantVectorField3 flow(Vector3D(1.0, 0.0, 0.0));
+    SemiLagrangian3 semiLagrangian;
+    Bfecc3 bfecc;
+    EXPECT_EQ(MacCormack3::kClampLimiter, bfecc.limiter());
+
+    double errors[2];
+    AdvectionSolver3* solvers[2] = { &semiLagrangian, &bfecc };
+    for (int n = 0; n < 2; ++n) {
+        CellCenteredVectorGrid3 grid(
+            Size3(60, 2, 2), Vector3D(0.02, 0.02, 0.02));
+        CellCenteredVectorGrid3 grid1(grid.resolution(), grid.gridSpacing());
+        grid.fill([](const Vector3D& x) {
+            return Vector3D(blob(x + Vector3D(0.25, 0, 0)), 0, 1);
+        });
+
+        for (int i = 0; i < 50; ++i) {
+            solvers[n]->advect(grid, flow, 0.01, &grid1);
+            grid.swap(&grid1);
+        }
+
+        errors[n] = 0.0;
+        auto pos = grid.dataPosition();
+        grid.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+            Vector3D x = pos(i, j, k) - Vector3D(0.25, 0, 0);
+            errors[n] += std::fabs(grid(i, j, k).x - blob(x));
+            EXPECT_NEAR(1.0, grid(i, j, k).z, 1e-12);
+        });
+    }
+
+    EXPECT_LT(errors[1], 0.5 * errors[0]);
+}
+
+TEST(Bfecc3, Limiter) {
+    CellCenteredScalarGrid3 grid(Size3(20, 20, 2), Vector3D(0.05, 0.05, 0.05));
+    CellCenteredScalarGrid3 grid1(grid.resolution(), grid.gridSpacing());
+    grid.fill([](const Vector3D& x) { return (x.x < 0.5) ? 1.0 : 0.0; });
+
+    ConstantVectorField3 flow(Vector3D(0.7, 0.3, 0.0));
+    Bfecc3 solver;
+
+    for (int i = 0; i < 10; ++i) {
+        solver.advect(grid, flow, 0.03, &grid1);
+        grid.swap(&grid1);
+    }
+
+    grid.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_LE(-1e-12, grid(i, j, k));
+        EXPECT_GE(1.0 + 1e-12, grid(i, j, k));
+    });
+}
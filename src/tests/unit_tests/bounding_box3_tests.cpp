@@ -177,6 +177,23 @@ TEST(BoundingBox3, DiagonalLengthSquared) {
     EXPECT_DOUBLE_EQ(6.0*6.0 + 5.0*5.0 + 4.0*4.0, diagLenSqr);
 }
 
+TEST(BoundingBox3, IsBounded) {
+    BoundingBox3D box(Vector3D(-2.0, -2.0, 1.0), Vector3D(4.0, 3.0, 5.0));
+    EXPECT_TRUE(box.isBounded());
+
+    box.reset();
+    EXPECT_FALSE(box.isBounded());
+
+    box.merge(Vector3D(1.0, 2.0, 3.0));
+    EXPECT_TRUE(box.isBounded());
+
+    box.upperCorner.y = std::numeric_limits<double>::max();
+    EXPECT_FALSE(box.isBounded());
+
+    box.upperCorner.y = std::numeric_limits<double>::infinity();
+    EXPECT_FALSE(box.isBounded());
+}
+
 TEST(BoundingBox3, Reset) {
     BoundingBox3D box(Vector3D(-2.0, -2.0, 1.0), Vector3D(4.0, 3.0, 5.0));
     box.reset();
@@ -169,3 +169,20 @@ TEST(Box3, ClosestNormal) {
     Vector3D result5 = box.closestNormal(Vector3D(4, 2, 9));
     EXPECT_EQ(Vector3D(0, 0, -1), result5);
 }
+
+TEST(Box3, ClosestQuery) {
+    Box3 box(Vector3D(-1, 2, 3), Vector3D(5, 3, 4));
+    box.isNormalFlipped = true;
+
+    Vector3D pts[4] = {
+        Vector3D(-2, 4, 5), Vector3D(1, 2.2, 3.4), Vector3D(6, 2.5, 3.5),
+        Vector3D(4.9, 2.5, 3.5)
+    };
+
+    for (const Vector3D& pt : pts) {
+        SurfaceClosestQueryResult3 result = box.closestQuery(pt);
+        EXPECT_EQ(box.closestPoint(pt), result.point);
+        EXPECT_EQ(box.closestNormal(pt), result.normal);
+        EXPECT_DOUBLE_EQ(box.closestDistance(pt), result.distance);
+    }
+}
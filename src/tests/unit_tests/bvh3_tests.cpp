@@ -0,0 +1,178 @@
+// Copyright (c) 2016 Doyub Kim
+
+#include <jet/bvh3.h>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+using namespace jet;
+
+namespace {
+
+// Random points as items, each with a small box around it
+std::vector<Vector3D> makeRandomPoints(size_t n) {
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<> d(0.0, 1.0);
+
+    std::vector<Vector3D> points(n);
+    for (auto& pt : points) {
+        pt = Vector3D(d(rng), d(rng), d(rng));
+    }
+    return points;
+}
+
+std::vector<BoundingBox3D> makeBounds(const std::vector<Vector3D>& points) {
+    std::vector<BoundingBox3D> bounds;
+    for (const auto& pt : points) {
+        BoundingBox3D box(pt, pt);
+        box.expand(0.01);
+        bounds.push_back(box);
+    }
+    return bounds;
+}
+
+}  // namespace
+
+TEST(Bvh3, Constructors) {
+    Bvh3 bvh;
+    EXPECT_EQ(0u, bvh.numberOfItems());
+    EXPECT_EQ(0u, bvh.numberOfNodes());
+
+    BvhNearestQueryResult3 nearest = bvh.nearest(
+        Vector3D(),
+        [](size_t, const Vector3D&) {
+            return 0.0;
+        });
+    EXPECT_EQ(kMaxSize, nearest.item);
+    EXPECT_EQ(kMaxD, nearest.distance);
+}
+
+TEST(Bvh3, Build) {
+    std::vector<Vector3D> points = makeRandomPoints(5000);
+    std::vector<BoundingBox3D> bounds = makeBounds(points);
+
+    Bvh3 bvh;
+    bvh.build(bounds);
+
+    EXPECT_EQ(5000u, bvh.numberOfItems());
+    EXPECT_LT(1u, bvh.numberOfNodes());
+    EXPECT_GT(2 * 5000u, bvh.numberOfNodes());
+
+    BoundingBox3D box;
+    for (const auto& b : bounds) {
+        box.merge(b);
+    }
+    EXPECT_EQ(box.lowerCorner, bvh.boundingBox().lowerCorner);
+    EXPECT_EQ(box.upperCorner, bvh.boundingBox().upperCorner);
+
+    // Every item should be reachable exactly once.
+    std::vector<int> visits(points.size(), 0);
+    bvh.intersects(
+        Ray3D(Vector3D(0.5, 0.5, -1.0), Vector3D(0, 0, 1)),
+        [&](size_t i, const Ray3D&) {
+            ++visits[i];
+            return false;
+        });
+    for (int v : visits) {
+        EXPECT_GE(1, v);
+    }
+
+    bvh.clear();
+    EXPECT_EQ(0u, bvh.numberOfItems());
+    EXPECT_EQ(0u, bvh.numberOfNodes());
+}
+
+TEST(Bvh3, Nearest) {
+    std::vector<Vector3D> points = makeRandomPoints(5000);
+
+    Bvh3 bvh;
+    bvh.build(makeBounds(points));
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<> d(-0.5, 1.5);
+
+    size_t numberOfCalls = 0;
+    auto distanceFunc = [&](size_t i, const Vector3D& pt) {
+        ++numberOfCalls;
+        return pt.distanceTo(points[i]);
+    };
+
+    for (int iter = 0; iter < 100; ++iter) {
+        Vector3D pt(d(rng), d(rng), d(rng));
+
+        size_t answer = 0;
+        for (size_t i = 1; i < points.size(); ++i) {
+            if (pt.distanceTo(points[i]) < pt.distanceTo(points[answer])) {
+                answer = i;
+            }
+        }
+
+        BvhNearestQueryResult3 result = bvh.nearest(pt, distanceFunc);
+        EXPECT_EQ(answer, result.item);
+        EXPECT_EQ(pt.distanceTo(points[answer]), result.distance);
+    }
+
+    // Pruning should skip most of the items.
+    EXPECT_GT(100u * points.size() / 10, numberOfCalls);
+}
+
+TEST(Bvh3, NearestTie) {
+    // Identical items should resolve to the smallest index.
+    std::vector<Vector3D> points(100, Vector3D(1, 2, 3));
+
+    Bvh3 bvh;
+    bvh.build(makeBounds(points));
+
+    BvhNearestQueryResult3 result = bvh.nearest(
+        Vector3D(),
+        [&](size_t i, const Vector3D& pt) {
+            return pt.distanceTo(points[i]);
+        });
+    EXPECT_EQ(0u, result.item);
+}
+
+TEST(Bvh3, ClosestIntersection) {
+    std::vector<Vector3D> points = makeRandomPoints(5000);
+    std::vector<BoundingBox3D> bounds = makeBounds(points);
+
+    Bvh3 bvh;
+    bvh.build(bounds);
+
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<> d(-1.0, 1.0);
+
+    // Boxes themselves are the items.
+    auto intersectionFunc = [&](size_t i, const Ray3D& ray) {
+        BoundingBoxRayIntersection3D intersection;
+        bounds[i].getClosestIntersection(ray, &intersection);
+        return intersection.isIntersecting ? intersection.tNear : kMaxD;
+    };
+
+    auto intersectsFunc = [&](size_t i, const Ray3D& ray) {
+        return bounds[i].intersects(ray);
+    };
+
+    for (int iter = 0; iter < 100; ++iter) {
+        Ray3D ray(
+            Vector3D(0.5, 0.5, 0.5) + 2.0 * Vector3D(d(rng), d(rng), d(rng)),
+            Vector3D(d(rng), d(rng), d(rng)).normalized());
+
+        BvhRayIntersection3 answer;
+        for (size_t i = 0; i < bounds.size(); ++i) {
+            double t = intersectionFunc(i, ray);
+            if (t < answer.t) {
+                answer.isIntersecting = true;
+                answer.t = t;
+                answer.item = i;
+            }
+        }
+
+        BvhRayIntersection3 result = bvh.closestIntersection(
+            ray, intersectionFunc);
+        EXPECT_EQ(answer.isIntersecting, result.isIntersecting);
+        EXPECT_EQ(answer.item, result.item);
+        EXPECT_EQ(answer.t, result.t);
+
+        EXPECT_EQ(answer.isIntersecting, bvh.intersects(ray, intersectsFunc));
+    }
+}
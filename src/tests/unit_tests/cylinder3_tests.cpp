@@ -149,3 +149,19 @@ TEST(Cylinder3, ClosestNormal) {
     EXPECT_DOUBLE_EQ(1.0, result4.y);
     EXPECT_DOUBLE_EQ(0.0, result4.z);
 }
+
+TEST(Cylinder3, ClosestQuery) {
+    Cylinder3 cyl(Vector3D(1, 2, 3), 4.0, 6.0);
+
+    Vector3D pts[4] = {
+        Vector3D(7, 2, 3), Vector3D(1, 6, 2), Vector3D(6, -5, 3),
+        Vector3D(2, 3, 4)
+    };
+
+    for (const Vector3D& pt : pts) {
+        SurfaceClosestQueryResult3 result = cyl.closestQuery(pt);
+        EXPECT_EQ(cyl.closestPoint(pt), result.point);
+        EXPECT_EQ(cyl.closestNormal(pt), result.normal);
+        EXPECT_DOUBLE_EQ(cyl.closestDistance(pt), result.distance);
+    }
+}
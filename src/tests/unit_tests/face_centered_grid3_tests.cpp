@@ -2,6 +2,7 @@
 
 #include <jet/face_centered_grid3.h>
 #include <gtest/gtest.h>
+#include <cmath>
 
 using namespace jet;
 
@@ -263,6 +264,39 @@ TEST(FaceCenteredGrid3, Sample) {
     });
 }
 
+TEST(FaceCenteredGrid3, SampleMatchesComponentSamplers) {
+    FaceCenteredGrid3 grid(5, 8, 6, 2.0, 3.0, 1.5, -1.0, 0.5, 2.0);
+    grid.fill([&](const Vector3D& x) {
+        return Vector3D(std::sin(x.y), std::cos(x.z + x.x), x.x * x.y);
+    });
+
+    LinearArraySampler3<double, double> uSampler(
+        grid.uConstAccessor(), grid.gridSpacing(), grid.uOrigin());
+    LinearArraySampler3<double, double> vSampler(
+        grid.vConstAccessor(), grid.gridSpacing(), grid.vOrigin());
+    LinearArraySampler3<double, double> wSampler(
+        grid.wConstAccessor(), grid.gridSpacing(), grid.wOrigin());
+
+    // Includes the points outside of the grid
+    Array1<Vector3D> points;
+    for (int i = 0; i < 200; ++i) {
+        points.append(Vector3D(
+            -3.0 + 0.083 * i, -1.0 + 0.137 * i, 1.0 + 0.051 * i));
+    }
+
+    Array1<Vector3D> results(points.size());
+    grid.sample(points.constAccessor(), results.accessor());
+
+    auto sampler = grid.sampler();
+    for (size_t i = 0; i < points.size(); ++i) {
+        Vector3D expected(
+            uSampler(points[i]), vSampler(points[i]), wSampler(points[i]));
+        EXPECT_EQ(expected, grid.sample(points[i]));
+        EXPECT_EQ(expected, sampler(points[i]));
+        EXPECT_EQ(expected, results[i]);
+    }
+}
+
 TEST(FaceCenteredGrid3, Builder) {
     auto builder = FaceCenteredGrid3::builder();
     FaceCenteredGridBuilder3* faceCenteredBuilder
@@ -47,3 +47,90 @@ TEST(FdmCgSolver3, Constructors) {
 
     EXPECT_GT(solver.tolerance(), solver.lastResidual());
 }
+
+TEST(FdmCgSolver3, Stats) {
+    FdmLinearSystem3 system;
+    system.A.resize(4, 4, 4);
+    system.x.resize(4, 4, 4);
+    system.b.resize(4, 4, 4);
+
+    system.A.forEachIndex([&](size_t i, size_t j, size_t k) {
+        system.A(i, j, k).center = 6.0;
+        if (i < system.A.width() - 1) {
+            system.A(i, j, k).right = -1.0;
+        }
+        if (j < system.A.height() - 1) {
+            system.A(i, j, k).up = -1.0;
+        }
+        if (k < system.A.depth() - 1) {
+            system.A(i, j, k).front = -1.0;
+        }
+        system.b(i, j, k) = static_cast<double>(i + j + k);
+    });
+
+    FdmCgSolver3 solver(100, 1e-9);
+    EXPECT_FALSE(solver.isCollectingStats());
+    solver.solve(&system);
+    EXPECT_EQ(
+        solver.lastNumberOfIterations(), solver.stats().numberOfIterations);
+    EXPECT_TRUE(solver.stats().residualHistory.empty());
+
+    solver.setIsCollectingStats(true);
+    solver.solve(&system);
+
+    const FdmLinearSystemSolverStats3& stats = solver.stats();
+    EXPECT_EQ(solver.lastNumberOfIterations(), stats.numberOfIterations);
+    EXPECT_DOUBLE_EQ(solver.lastResidual(), stats.residual);
+    ASSERT_EQ(stats.numberOfIterations + 1, stats.residualHistory.size());
+    EXPECT_DOUBLE_EQ(stats.residual, stats.residualHistory.back());
+    EXPECT_GT(stats.residualHistory.front(), stats.residualHistory.back());
+    EXPECT_LE(0.0, stats.setupTime);
+    EXPECT_LE(0.0, stats.preconditionerBuildTime);
+    EXPECT_LE(0.0, stats.iterationTime);
+    EXPECT_FALSE(stats.isStagnated);
+}
+
+TEST(FdmCgSolver3, Stagnation) {
+    // Pure Neumann problem with a right-hand side that is slightly off the
+    // range, so the residual cannot go below the tolerance
+    FdmLinearSystem3 system;
+    system.A.resize(4, 4, 4);
+    system.x.resize(4, 4, 4);
+    system.b.resize(4, 4, 4);
+
+    system.A.forEachIndex([&](size_t i, size_t j, size_t k) {
+        system.b(i, j, k) = static_cast<double>(i) - 1.5 + 0.01;
+
+        if (i > 0) {
+            system.A(i, j, k).center += 1.0;
+        }
+        if (i < system.A.width() - 1) {
+            system.A(i, j, k).center += 1.0;
+            system.A(i, j, k).right -= 1.0;
+        }
+        if (j > 0) {
+            system.A(i, j, k).center += 1.0;
+        }
+        if (j < system.A.height() - 1) {
+            system.A(i, j, k).center += 1.0;
+            system.A(i, j, k).up -= 1.0;
+        }
+        if (k > 0) {
+            system.A(i, j, k).center += 1.0;
+        }
+        if (k < system.A.depth() - 1) {
+            system.A(i, j, k).center += 1.0;
+            system.A(i, j, k).front -= 1.0;
+        }
+    });
+
+    FdmCgSolver3 solver(1000, 1e-9);
+    solver.setStagnationWindow(10);
+    EXPECT_EQ(10u, solver.stagnationWindow());
+    EXPECT_DOUBLE_EQ(0.99, solver.stagnationRatio());
+
+    EXPECT_FALSE(solver.solve(&system));
+    EXPECT_TRUE(solver.stats().isStagnated);
+    EXPECT_GT(1000u, solver.lastNumberOfIterations());
+    EXPECT_LT(solver.tolerance(), solver.lastResidual());
+}
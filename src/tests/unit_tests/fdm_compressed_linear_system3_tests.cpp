@@ -0,0 +1,220 @@
+// Copyright (c) 2016 Doyub Kim
+
+#include <jet/fdm_cg_solver3.h>
+#include <jet/fdm_compressed_linear_system3.h>
+#include <jet/fdm_gauss_seidel_solver3.h>
+#include <jet/fdm_iccg_solver3.h>
+#include <jet/fdm_jacobi_solver3.h>
+#include <jet/fdm_mgpcg_solver3.h>
+#include <jet/fdm_parallel_iccg_solver3.h>
+#include <gtest/gtest.h>
+
+using namespace jet;
+
+static bool isTestPointActive(size_t i, size_t j, size_t k) {
+    // Lower half of the domain except for a solid column in the middle
+    return j < 4 && !(i == 3 && k == 3);
+}
+
+static void buildTestRow(
+    const Size3& size,
+    size_t i,
+    size_t j,
+    size_t k,
+    FdmMatrixRow3* row,
+    double* rhs) {
+    row->center = row->right = row->up = row->front = 0.0;
+    *rhs = 0.0;
+
+    if (!isTestPointActive(i, j, k)) {
+        row->center = 1.0;
+        return;
+    }
+
+    if (i + 1 < size.x) {
+        row->center += 1.0;
+        if (isTestPointActive(i + 1, j, k)) {
+            row->right -= 1.0;
+        }
+    }
+    if (i > 0) {
+        row->center += 1.0;
+    }
+
+    if (j + 1 < size.y) {
+        row->center += 1.0;
+        if (isTestPointActive(i, j + 1, k)) {
+            row->up -= 1.0;
+        }
+    }
+    if (j > 0) {
+        row->center += 1.0;
+    } else {
+        *rhs += 1.0;
+    }
+
+    if (k + 1 < size.z) {
+        row->center += 1.0;
+        if (isTestPointActive(i, j, k + 1)) {
+            row->front -= 1.0;
+        }
+    }
+    if (k > 0) {
+        row->center += 1.0;
+    }
+}
+
+static void buildTestLinearSystems(
+    const Size3& size,
+    FdmLinearSystem3* system,
+    FdmCompressedLinearSystem3* compSystem) {
+    system->A.resize(size);
+    system->x.resize(size);
+    system->b.resize(size);
+    system->A.forEachIndex([&](size_t i, size_t j, size_t k) {
+        buildTestRow(
+            size, i, j, k, &system->A(i, j, k), &system->b(i, j, k));
+    });
+
+    compSystem->build(
+        size,
+        isTestPointActive,
+        [&](size_t i, size_t j, size_t k, FdmMatrixRow3* row, double* rhs) {
+            buildTestRow(size, i, j, k, row, rhs);
+        });
+}
+
+template <typename SolverType>
+static void testSolveCompressed(SolverType* solver, double tolerance) {
+    Size3 size(8, 8, 8);
+    FdmLinearSystem3 system;
+    FdmCompressedLinearSystem3 compSystem;
+    buildTestLinearSystems(size, &system, &compSystem);
+
+    EXPECT_TRUE(solver->isSupportingCompressedSystem());
+    EXPECT_TRUE(solver->solve(&system));
+    EXPECT_TRUE(solver->solveCompressed(&compSystem));
+
+    FdmVector3 x;
+    compSystem.decompressSolution(&x);
+
+    EXPECT_EQ(size, x.size());
+    x.forEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(system.x(i, j, k), x(i, j, k), tolerance);
+    });
+}
+
+TEST(FdmCompressedLinearSystem3, Build) {
+    Size3 size(8, 8, 8);
+    FdmLinearSystem3 system;
+    FdmCompressedLinearSystem3 compSystem;
+    buildTestLinearSystems(size, &system, &compSystem);
+
+    const size_t numberOfActivePoints = 8 * 4 * 8 - 4;
+    EXPECT_EQ(numberOfActivePoints, compSystem.A.rows());
+    EXPECT_EQ(numberOfActivePoints, compSystem.x.size());
+    EXPECT_EQ(numberOfActivePoints, compSystem.b.size());
+    EXPECT_EQ(numberOfActivePoints, compSystem.indexToCoord.size());
+
+    const auto& A = compSystem.A;
+    for (size_t row = 0; row < A.rows(); ++row) {
+        const Point3UI& pt = compSystem.indexToCoord[row];
+        EXPECT_EQ(row, compSystem.coordToIndex(pt.x, pt.y, pt.z));
+        EXPECT_EQ(system.b(pt.x, pt.y, pt.z), compSystem.b[row]);
+
+        for (size_t n = A.rowPointers[row]; n < A.rowPointers[row + 1]; ++n) {
+            size_t col = A.columnIndices[n];
+
+            // Columns are sorted
+            if (n > A.rowPointers[row]) {
+                EXPECT_LT(A.columnIndices[n - 1], col);
+            }
+
+            // Symmetric
+            bool found = false;
+            for (size_t m = A.rowPointers[col]; m < A.rowPointers[col + 1];
+                 ++m) {
+                if (A.columnIndices[m] == row) {
+                    EXPECT_EQ(A.nonZeros[n], A.nonZeros[m]);
+                    found = true;
+                }
+            }
+            EXPECT_TRUE(found);
+        }
+    }
+
+    // Matches the full system on the active points
+    FdmVector3 x(size);
+    x.forEachIndex([&](size_t i, size_t j, size_t k) {
+        x(i, j, k) = isTestPointActive(i, j, k) ? 0.1 * i + j - 0.3 * k : 0.0;
+    });
+    FdmVector3 ax(size);
+    FdmBlas3::mvm(system.A, x, &ax);
+
+    FdmCompressedVector3 xComp(numberOfActivePoints);
+    xComp.forEachIndex([&](size_t idx) {
+        const Point3UI& pt = compSystem.indexToCoord[idx];
+        xComp[idx] = x(pt.x, pt.y, pt.z);
+    });
+    FdmCompressedVector3 axComp(numberOfActivePoints);
+    FdmCompressedBlas3::mvm(A, xComp, &axComp);
+
+    axComp.forEachIndex([&](size_t idx) {
+        const Point3UI& pt = compSystem.indexToCoord[idx];
+        EXPECT_NEAR(ax(pt.x, pt.y, pt.z), axComp[idx], 1e-12);
+    });
+}
+
+TEST(FdmCompressedLinearSystem3, DecompressSolution) {
+    FdmCompressedLinearSystem3 compSystem;
+    compSystem.buildIndexMap(
+        Size3(2, 3, 4),
+        [](size_t i, size_t, size_t) {
+            return i == 1;
+        });
+    EXPECT_EQ(12u, compSystem.indexToCoord.size());
+
+    compSystem.x.resize(12);
+    compSystem.x.forEachIndex([&](size_t idx) {
+        compSystem.x[idx] = static_cast<double>(idx);
+    });
+
+    FdmVector3 x;
+    compSystem.decompressSolution(&x, -1.0);
+    EXPECT_EQ(Size3(2, 3, 4), x.size());
+    x.forEachIndex([&](size_t i, size_t j, size_t k) {
+        if (i == 1) {
+            EXPECT_EQ(static_cast<double>(j + 3 * k), x(i, j, k));
+        } else {
+            EXPECT_EQ(-1.0, x(i, j, k));
+        }
+    });
+}
+
+TEST(FdmCompressedLinearSystem3, SolveWithCg) {
+    FdmCgSolver3 solver(100, 1e-9);
+    testSolveCompressed(&solver, 1e-6);
+}
+
+TEST(FdmCompressedLinearSystem3, SolveWithIccg) {
+    FdmIccgSolver3 solver(100, 1e-9);
+    testSolveCompressed(&solver, 1e-6);
+}
+
+TEST(FdmCompressedLinearSystem3, SolveWithJacobi) {
+    FdmJacobiSolver3 solver(10000, 10, 1e-9);
+    testSolveCompressed(&solver, 1e-5);
+}
+
+TEST(FdmCompressedLinearSystem3, SolveWithGaussSeidel) {
+    FdmGaussSeidelSolver3 solver(10000, 10, 1e-9);
+    testSolveCompressed(&solver, 1e-5);
+}
+
+TEST(FdmCompressedLinearSystem3, UnsupportedSolvers) {
+    FdmMgpcgSolver3 mgpcgSolver(100, 1e-9);
+    FdmParallelIccgSolver3 parallelIccgSolver(100, 1e-9);
+
+    EXPECT_FALSE(mgpcgSolver.isSupportingCompressedSystem());
+    EXPECT_FALSE(parallelIccgSolver.isSupportingCompressedSystem());
+}
@@ -5,6 +5,44 @@
 
 using namespace jet;
 
+static void buildTestLinearSystem(
+    FdmLinearSystem3* system, const Size3& size) {
+    system->A.resize(size);
+    system->x.resize(size);
+    system->b.resize(size);
+
+    system->A.forEachIndex([&](size_t i, size_t j, size_t k) {
+        if (i > 0) {
+            system->A(i, j, k).center += 1.0;
+        }
+        if (i < system->A.width() - 1) {
+            system->A(i, j, k).center += 1.0;
+            system->A(i, j, k).right -= 1.0;
+        }
+
+        if (j > 0) {
+            system->A(i, j, k).center += 1.0;
+        } else {
+            system->b(i, j, k) += 1.0;
+        }
+
+        if (j < system->A.height() - 1) {
+            system->A(i, j, k).center += 1.0;
+            system->A(i, j, k).up -= 1.0;
+        } else {
+            system->b(i, j, k) -= 1.0;
+        }
+
+        if (k > 0) {
+            system->A(i, j, k).center += 1.0;
+        }
+        if (k < system->A.depth() - 1) {
+            system->A(i, j, k).center += 1.0;
+            system->A(i, j, k).front -= 1.0;
+        }
+    });
+}
+
 TEST(FdmGaussSeidelSolver3, Constructors) {
     FdmLinearSystem3 system;
     system.A.resize(3, 3, 3);
@@ -47,3 +85,66 @@ TEST(FdmGaussSeidelSolver3, Constructors) {
 
     EXPECT_GT(solver.tolerance(), solver.lastResidual());
 }
+
+TEST(FdmGaussSeidelSolver3, SolveRedBlack) {
+    FdmLinearSystem3 system;
+    buildTestLinearSystem(&system, Size3(7, 6, 5));
+
+    FdmGaussSeidelSolver3 solver(
+        1000, 10, 1e-9, 1.0, FdmGaussSeidelSolver3::RedBlack);
+    EXPECT_EQ(FdmGaussSeidelSolver3::RedBlack, solver.ordering());
+    EXPECT_DOUBLE_EQ(1.0, solver.sorFactor());
+    EXPECT_TRUE(solver.solve(&system));
+
+    EXPECT_GT(solver.tolerance(), solver.lastResidual());
+}
+
+TEST(FdmGaussSeidelSolver3, SolveMultiColor) {
+    FdmLinearSystem3 system;
+    buildTestLinearSystem(&system, Size3(7, 6, 5));
+
+    FdmGaussSeidelSolver3 solver(
+        1000, 10, 1e-9, 1.0, FdmGaussSeidelSolver3::MultiColor);
+    EXPECT_TRUE(solver.solve(&system));
+
+    EXPECT_GT(solver.tolerance(), solver.lastResidual());
+}
+
+TEST(FdmGaussSeidelSolver3, SolveSor) {
+    FdmLinearSystem3 system;
+    buildTestLinearSystem(&system, Size3(8, 8, 8));
+    FdmLinearSystem3 system2 = system;
+
+    FdmGaussSeidelSolver3 solver(1000, 1, 1e-9);
+    solver.solve(&system);
+
+    FdmGaussSeidelSolver3 sorSolver(
+        1000, 1, 1e-9, 1.5, FdmGaussSeidelSolver3::RedBlack);
+    EXPECT_TRUE(sorSolver.solve(&system2));
+
+    EXPECT_GT(sorSolver.tolerance(), sorSolver.lastResidual());
+    EXPECT_LT(
+        sorSolver.lastNumberOfIterations(), solver.lastNumberOfIterations());
+}
+
+TEST(FdmGaussSeidelSolver3, SolveCompressedRedBlack) {
+    FdmLinearSystem3 system;
+    buildTestLinearSystem(&system, Size3(7, 6, 5));
+
+    FdmCompressedLinearSystem3 compSystem;
+    compSystem.build(
+        system.A.size(),
+        [](size_t, size_t, size_t) {
+            return true;
+        },
+        [&](size_t i, size_t j, size_t k, FdmMatrixRow3* row, double* rhs) {
+            *row = system.A(i, j, k);
+            *rhs = system.b(i, j, k);
+        });
+
+    FdmGaussSeidelSolver3 solver(
+        1000, 10, 1e-9, 1.2, FdmGaussSeidelSolver3::RedBlack);
+    EXPECT_TRUE(solver.solveCompressed(&compSystem));
+
+    EXPECT_GT(solver.tolerance(), solver.lastResidual());
+}
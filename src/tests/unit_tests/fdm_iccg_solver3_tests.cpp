@@ -2,9 +2,48 @@
 
 #include <jet/fdm_iccg_solver3.h>
 #include <gtest/gtest.h>
+#include <cmath>
 
 using namespace jet;
 
+static void buildTestLinearSystem(
+    FdmLinearSystem3* system, const Size3& size) {
+    system->A.resize(size);
+    system->x.resize(size);
+    system->b.resize(size);
+
+    system->A.forEachIndex([&](size_t i, size_t j, size_t k) {
+        if (i > 0) {
+            system->A(i, j, k).center += 1.0;
+        }
+        if (i < system->A.width() - 1) {
+            system->A(i, j, k).center += 1.0;
+            system->A(i, j, k).right -= 1.0;
+        }
+
+        if (j > 0) {
+            system->A(i, j, k).center += 1.0;
+        } else {
+            system->b(i, j, k) += 1.0;
+        }
+
+        if (j < system->A.height() - 1) {
+            system->A(i, j, k).center += 1.0;
+            system->A(i, j, k).up -= 1.0;
+        } else {
+            system->b(i, j, k) -= 1.0;
+        }
+
+        if (k > 0) {
+            system->A(i, j, k).center += 1.0;
+        }
+        if (k < system->A.depth() - 1) {
+            system->A(i, j, k).center += 1.0;
+            system->A(i, j, k).front -= 1.0;
+        }
+    });
+}
+
 TEST(FdmIccgSolver3, Constructors) {
     FdmLinearSystem3 system;
     system.A.resize(3, 3, 3);
@@ -47,3 +86,60 @@ TEST(FdmIccgSolver3, Constructors) {
 
     EXPECT_GT(solver.tolerance(), solver.lastResidual());
 }
+
+TEST(FdmIccgSolver3, WarmStart) {
+    FdmLinearSystem3 system;
+    buildTestLinearSystem(&system, Size3(8, 8, 8));
+
+    FdmIccgSolver3 solver(100, 1e-9);
+    solver.solve(&system);
+    EXPECT_LT(0u, solver.lastNumberOfIterations());
+
+    // Starting from the solution should converge immediately
+    solver.setIsUsingWarmStart(true);
+    solver.solve(&system);
+    EXPECT_EQ(0u, solver.lastNumberOfIterations());
+    EXPECT_GT(solver.tolerance(), solver.lastResidual());
+}
+
+TEST(FdmIccgSolver3, ReuseMatrix) {
+    FdmLinearSystem3 system;
+    buildTestLinearSystem(&system, Size3(8, 8, 8));
+
+    FdmIccgSolver3 solver(100, 1e-9);
+    solver.solve(&system);
+
+    // Same matrix with different right-hand side
+    system.b.forEachIndex([&](size_t i, size_t j, size_t k) {
+        system.b(i, j, k) = std::sin(0.1 * i + 0.2 * j + 0.3 * k);
+    });
+    FdmLinearSystem3 system2 = system;
+
+    solver.setIsReusingMatrix(true);
+    solver.solve(&system);
+
+    FdmIccgSolver3 solver2(100, 1e-9);
+    solver2.solve(&system2);
+
+    EXPECT_EQ(
+        solver2.lastNumberOfIterations(), solver.lastNumberOfIterations());
+    system.x.forEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(system2.x(i, j, k), system.x(i, j, k));
+    });
+}
+
+TEST(FdmIccgSolver3, Stats) {
+    FdmLinearSystem3 system;
+    buildTestLinearSystem(&system, Size3(8, 8, 8));
+
+    FdmIccgSolver3 solver(100, 1e-9);
+    solver.setIsCollectingStats(true);
+    solver.solve(&system);
+
+    const FdmLinearSystemSolverStats3& stats = solver.stats();
+    EXPECT_EQ(solver.lastNumberOfIterations(), stats.numberOfIterations);
+    ASSERT_EQ(stats.numberOfIterations + 1, stats.residualHistory.size());
+    EXPECT_DOUBLE_EQ(solver.lastResidual(), stats.residualHistory.back());
+    EXPECT_LT(0.0, stats.preconditionerBuildTime);
+    EXPECT_LT(0.0, stats.iterationTime);
+}
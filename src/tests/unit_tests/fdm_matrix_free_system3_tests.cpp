@@ -0,0 +1,148 @@
+// Copyright (c) 2016 Doyub Kim
+
+#include <jet/cg.h>
+#include <jet/fdm_cg_solver3.h>
+#include <jet/fdm_iccg_solver3.h>
+#include <jet/fdm_matrix_free_system3.h>
+#include <gtest/gtest.h>
+#include <cmath>
+
+using namespace jet;
+
+static void buildTestMatrixFreeSystem(
+    FdmMatrixFreeSystem3* system, const Size3& size) {
+    system->A.markers.resize(size);
+    system->A.coefficients = Vector3D(1.0, 4.0, 2.0);
+    system->x.resize(size, 0.0);
+    system->b.resize(size, 0.0);
+
+    system->A.markers.forEachIndex([&](size_t i, size_t j, size_t k) {
+        if (i == 2 && k == 3) {
+            system->A.markers(i, j, k) = FdmMatrixFreeMatrix3::Boundary;
+        } else if (j >= size.y / 2) {
+            system->A.markers(i, j, k) = FdmMatrixFreeMatrix3::Air;
+        } else {
+            system->A.markers(i, j, k) = FdmMatrixFreeMatrix3::Fluid;
+            system->b(i, j, k) = std::sin(0.5 * i) + std::cos(0.3 * j + k);
+        }
+    });
+}
+
+static void buildFullMatrix(const FdmMatrixFreeMatrix3& A, FdmMatrix3* m) {
+    m->resize(A.size());
+    m->forEachIndex([&](size_t i, size_t j, size_t k) {
+        (*m)(i, j, k) = A.row(i, j, k);
+    });
+}
+
+TEST(FdmMatrixFreeBlas3, Mvm) {
+    FdmMatrixFreeSystem3 system;
+    buildTestMatrixFreeSystem(&system, Size3(6, 8, 7));
+
+    FdmMatrix3 m;
+    buildFullMatrix(system.A, &m);
+
+    FdmVector3 v(6, 8, 7);
+    v.forEachIndex([&](size_t i, size_t j, size_t k) {
+        v(i, j, k) = 0.1 * i - 0.2 * j + 0.3 * k;
+    });
+
+    FdmVector3 expected(6, 8, 7);
+    FdmVector3 actual(6, 8, 7);
+    FdmBlas3::mvm(m, v, &expected);
+    FdmMatrixFreeBlas3::mvm(system.A, v, &actual);
+    expected.forEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(expected(i, j, k), actual(i, j, k), 1e-12);
+    });
+
+    double dot = FdmMatrixFreeBlas3::mvmAndDot(system.A, v, &actual);
+    EXPECT_NEAR(FdmBlas3::dot(v, expected), dot, 1e-9);
+    expected.forEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(expected(i, j, k), actual(i, j, k), 1e-12);
+    });
+
+    FdmBlas3::residual(m, v, system.b, &expected);
+    FdmMatrixFreeBlas3::residual(system.A, v, system.b, &actual);
+    expected.forEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(expected(i, j, k), actual(i, j, k), 1e-12);
+    });
+}
+
+TEST(FdmMatrixFreeBlas3, AxpyAndSquaredL2Norm) {
+    FdmVector3 x(4, 5, 6);
+    FdmVector3 y(4, 5, 6);
+    x.forEachIndex([&](size_t i, size_t j, size_t k) {
+        x(i, j, k) = static_cast<double>(i + j);
+        y(i, j, k) = static_cast<double>(k);
+    });
+
+    FdmVector3 expected(4, 5, 6);
+    FdmVector3 actual(4, 5, 6);
+    FdmBlas3::axpy(-0.5, x, y, &expected);
+    double norm2 = FdmMatrixFreeBlas3::axpyAndSquaredL2Norm(
+        -0.5, x, y, &actual);
+
+    EXPECT_NEAR(FdmBlas3::dot(expected, expected), norm2, 1e-9);
+    expected.forEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(expected(i, j, k), actual(i, j, k));
+    });
+}
+
+TEST(FdmMatrixFreeBlas3, FusedCg) {
+    FdmMatrixFreeSystem3 system;
+    buildTestMatrixFreeSystem(&system, Size3(8, 8, 8));
+    Size3 size = system.A.size();
+
+    FdmVector3 r(size), d(size), q(size), s(size);
+    unsigned int numIter;
+    double residualNorm;
+
+    cg<FdmMatrixFreeBlas3>(
+        system.A, system.b, 100, 1e-9, &system.x,
+        &r, &d, &q, &s, &numIter, &residualNorm);
+
+    FdmVector3 xFused(size, 0.0);
+    unsigned int numIterFused;
+    double residualNormFused;
+
+    fusedCg<FdmMatrixFreeBlas3>(
+        system.A, system.b, 100, 1e-9, &xFused,
+        &r, &d, &q, &numIterFused, &residualNormFused);
+
+    EXPECT_GT(1e-9, residualNorm);
+    EXPECT_GT(1e-9, residualNormFused);
+    EXPECT_EQ(numIter, numIterFused);
+    xFused.forEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(system.x(i, j, k), xFused(i, j, k), 1e-9);
+    });
+}
+
+TEST(FdmCgSolver3, SolveMatrixFree) {
+    FdmMatrixFreeSystem3 system;
+    buildTestMatrixFreeSystem(&system, Size3(8, 8, 8));
+
+    FdmLinearSystem3 fullSystem;
+    buildFullMatrix(system.A, &fullSystem.A);
+    fullSystem.x.resize(system.A.size());
+    fullSystem.b.set(system.b);
+
+    FdmCgSolver3 solver(100, 1e-9);
+    EXPECT_TRUE(solver.isSupportingMatrixFreeSystem());
+    EXPECT_TRUE(solver.solveMatrixFree(&system));
+    EXPECT_GT(solver.tolerance(), solver.lastResidual());
+
+    EXPECT_TRUE(solver.solve(&fullSystem));
+    system.x.forEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(fullSystem.x(i, j, k), system.x(i, j, k), 1e-9);
+    });
+}
+
+TEST(FdmIccgSolver3, SolveMatrixFree) {
+    FdmMatrixFreeSystem3 system;
+    buildTestMatrixFreeSystem(&system, Size3(4, 4, 4));
+
+    // The preconditioner needs the assembled matrix
+    FdmIccgSolver3 solver(100, 1e-9);
+    EXPECT_FALSE(solver.isSupportingMatrixFreeSystem());
+    EXPECT_FALSE(solver.solveMatrixFree(&system));
+}
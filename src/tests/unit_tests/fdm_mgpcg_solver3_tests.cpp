@@ -0,0 +1,85 @@
+// Copyright (c) 2016 Doyub Kim
+
+#include <jet/fdm_iccg_solver3.h>
+#include <jet/fdm_mgpcg_solver3.h>
+#include <gtest/gtest.h>
+
+using namespace jet;
+
+static void buildTestLinearSystem(
+    FdmLinearSystem3* system, const Size3& size) {
+    system->A.resize(size);
+    system->x.resize(size);
+    system->b.resize(size);
+
+    system->A.forEachIndex([&](size_t i, size_t j, size_t k) {
+        if (i > 0) {
+            system->A(i, j, k).center += 1.0;
+        }
+        if (i < system->A.width() - 1) {
+            system->A(i, j, k).center += 1.0;
+            system->A(i, j, k).right -= 1.0;
+        }
+
+        if (j > 0) {
+            system->A(i, j, k).center += 1.0;
+        } else {
+            system->b(i, j, k) += 1.0;
+        }
+
+        if (j < system->A.height() - 1) {
+            system->A(i, j, k).center += 1.0;
+            system->A(i, j, k).up -= 1.0;
+        } else {
+            system->b(i, j, k) -= 1.0;
+        }
+
+        if (k > 0) {
+            system->A(i, j, k).center += 1.0;
+        }
+        if (k < system->A.depth() - 1) {
+            system->A(i, j, k).center += 1.0;
+            system->A(i, j, k).front -= 1.0;
+        }
+    });
+}
+
+TEST(FdmMgpcgSolver3, Constructors) {
+    FdmLinearSystem3 system;
+    buildTestLinearSystem(&system, Size3(3, 3, 3));
+
+    FdmMgpcgSolver3 solver(100, 1e-9);
+    solver.solve(&system);
+
+    EXPECT_GT(solver.tolerance(), solver.lastResidual());
+}
+
+TEST(FdmMgpcgSolver3, SolveWithAirCells) {
+    FdmLinearSystem3 system;
+    buildTestLinearSystem(&system, Size3(32, 32, 32));
+
+    // Turn the upper half into air cells (Dirichlet boundary)
+    system.A.forEachIndex([&](size_t i, size_t j, size_t k) {
+        if (j >= 16) {
+            system.A(i, j, k).center = 1.0;
+            system.A(i, j, k).right = 0.0;
+            system.A(i, j, k).up = 0.0;
+            system.A(i, j, k).front = 0.0;
+            system.b(i, j, k) = 0.0;
+        } else if (j == 15) {
+            system.A(i, j, k).up = 0.0;
+        }
+    });
+
+    FdmMgpcgSolver3 mgpcg(100, 1e-9);
+    EXPECT_TRUE(mgpcg.solve(&system));
+    EXPECT_GT(mgpcg.tolerance(), mgpcg.lastResidual());
+
+    FdmVector3 residual(system.x.size());
+    FdmBlas3::residual(system.A, system.x, system.b, &residual);
+    EXPECT_GT(1e-6, FdmBlas3::l2Norm(residual));
+
+    FdmIccgSolver3 iccg(100, 1e-9);
+    iccg.solve(&system);
+    EXPECT_GT(iccg.lastNumberOfIterations(), mgpcg.lastNumberOfIterations());
+}
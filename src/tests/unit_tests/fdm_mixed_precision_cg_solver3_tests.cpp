@@ -0,0 +1,166 @@
+// Copyright (c) 2016 Doyub Kim
+
+#include <jet/fdm_cg_solver3.h>
+#include <jet/fdm_mixed_precision_cg_solver3.h>
+#include <gtest/gtest.h>
+#include <cmath>
+
+using namespace jet;
+
+static void buildTestLinearSystem(
+    FdmLinearSystem3* system, const Size3& size) {
+    system->A.resize(size);
+    system->x.resize(size);
+    system->b.resize(size);
+
+    system->A.forEachIndex([&](size_t i, size_t j, size_t k) {
+        if (i > 0) {
+            system->A(i, j, k).center += 1.0;
+        }
+        if (i < system->A.width() - 1) {
+            system->A(i, j, k).center += 1.0;
+            system->A(i, j, k).right -= 1.0;
+        }
+
+        if (j > 0) {
+            system->A(i, j, k).center += 1.0;
+        } else {
+            system->b(i, j, k) += 1.0;
+        }
+
+        if (j < system->A.height() - 1) {
+            system->A(i, j, k).center += 1.0;
+            system->A(i, j, k).up -= 1.0;
+        } else {
+            system->b(i, j, k) -= 1.0;
+        }
+
+        if (k > 0) {
+            system->A(i, j, k).center += 1.0;
+        }
+        if (k < system->A.depth() - 1) {
+            system->A(i, j, k).center += 1.0;
+            system->A(i, j, k).front -= 1.0;
+        }
+    });
+}
+
+TEST(FdmPrecisionBlas3, Mvm) {
+    typedef FdmPrecisionBlas3<FdmMixedPrecisionPolicy> BlasType;
+
+    FdmLinearSystem3 system;
+    buildTestLinearSystem(&system, Size3(5, 6, 7));
+
+    FdmVector3 v(5, 6, 7);
+    v.forEachIndex([&](size_t i, size_t j, size_t k) {
+        v(i, j, k) = 0.1 * i - 0.2 * j + 0.3 * k;
+    });
+
+    BlasType::MatrixType m;
+    BlasType::VectorType vf, resultf(5, 6, 7);
+    BlasType::convert(system.A, &m);
+    BlasType::convert(v, &vf);
+
+    FdmVector3 expected(5, 6, 7);
+    FdmBlas3::mvm(system.A, v, &expected);
+    BlasType::mvm(m, vf, &resultf);
+    expected.forEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(expected(i, j, k), resultf(i, j, k), 1e-5);
+    });
+
+    EXPECT_NEAR(FdmBlas3::dot(v, v), BlasType::dot(vf, vf), 1e-4);
+    EXPECT_NEAR(FdmBlas3::l2Norm(v), BlasType::l2Norm(vf), 1e-5);
+    EXPECT_NEAR(FdmBlas3::lInfNorm(v), BlasType::lInfNorm(vf), 1e-6);
+}
+
+TEST(FdmMixedPrecisionCgSolver3, Constructors) {
+    FdmMixedPrecisionCgSolver3 solver(100, 1e-9);
+    EXPECT_EQ(100u, solver.maxNumberOfIterations());
+    EXPECT_DOUBLE_EQ(1e-9, solver.tolerance());
+    EXPECT_DOUBLE_EQ(1e-4, solver.innerTolerance());
+}
+
+TEST(FdmMixedPrecisionCgSolver3, Solve) {
+    FdmLinearSystem3 system;
+    buildTestLinearSystem(&system, Size3(8, 8, 8));
+
+    // Dirichlet boundary at j = 0 so that the solution is unique
+    system.A.forEachIndex([&](size_t i, size_t j, size_t k) {
+        if (j == 0) {
+            system.A(i, j, k).center += 1.0;
+        }
+        system.b(i, j, k) += std::sin(0.1 * i + 0.2 * j + 0.3 * k);
+    });
+    FdmLinearSystem3 system2 = system;
+
+    // The tolerance is far below the single precision
+    FdmMixedPrecisionCgSolver3 solver(200, 1e-10);
+    EXPECT_TRUE(solver.solve(&system));
+    EXPECT_GT(solver.tolerance(), solver.lastResidual());
+    EXPECT_LT(1u, solver.lastNumberOfRefinements());
+
+    // The residual is measured in double precision
+    FdmVector3 r(8, 8, 8);
+    FdmBlas3::residual(system.A, system.x, system.b, &r);
+    EXPECT_DOUBLE_EQ(FdmBlas3::l2Norm(r), solver.lastResidual());
+
+    FdmCgSolver3 solver2(200, 1e-10);
+    solver2.solve(&system2);
+    system.x.forEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(system2.x(i, j, k), system.x(i, j, k), 1e-9);
+    });
+}
+
+TEST(FdmMixedPrecisionCgSolver3, WarmStart) {
+    FdmLinearSystem3 system;
+    buildTestLinearSystem(&system, Size3(8, 8, 8));
+
+    FdmMixedPrecisionCgSolver3 solver(200, 1e-9);
+    solver.solve(&system);
+    EXPECT_LT(0u, solver.lastNumberOfIterations());
+
+    // Starting from the solution should converge immediately
+    solver.setIsUsingWarmStart(true);
+    solver.setIsReusingMatrix(true);
+    solver.solve(&system);
+    EXPECT_EQ(0u, solver.lastNumberOfIterations());
+    EXPECT_EQ(0u, solver.lastNumberOfRefinements());
+    EXPECT_GT(solver.tolerance(), solver.lastResidual());
+}
+
+TEST(FdmMixedPrecisionCgSolver3, Stall) {
+    FdmLinearSystem3 system;
+    buildTestLinearSystem(&system, Size3(8, 8, 8));
+
+    // Dirichlet boundary at j = 0 so that the solution is unique
+    system.A.forEachIndex([&](size_t i, size_t j, size_t k) {
+        if (j == 0) {
+            system.A(i, j, k).center += 1.0;
+        }
+    });
+
+    // The tolerance is below what even the double-precision residual reaches
+    FdmMixedPrecisionCgSolver3 solver(1000, 1e-30);
+    EXPECT_FALSE(solver.solve(&system));
+    EXPECT_GT(1000u, solver.lastNumberOfIterations());
+    EXPECT_LT(solver.tolerance(), solver.lastResidual());
+}
+
+TEST(FdmMixedPrecisionCgSolver3, Stats) {
+    FdmLinearSystem3 system;
+    buildTestLinearSystem(&system, Size3(8, 8, 8));
+
+    FdmMixedPrecisionCgSolver3 solver(200, 1e-10);
+    solver.setIsCollectingStats(true);
+    EXPECT_TRUE(solver.solve(&system));
+
+    const auto& stats = solver.stats();
+    EXPECT_EQ(solver.lastNumberOfIterations(), stats.numberOfIterations);
+    EXPECT_DOUBLE_EQ(solver.lastResidual(), stats.residual);
+    EXPECT_FALSE(stats.isStagnated);
+
+    // One residual per refinement step
+    EXPECT_EQ(
+        solver.lastNumberOfRefinements(), stats.residualHistory.size());
+    EXPECT_DOUBLE_EQ(solver.lastResidual(), stats.residualHistory.back());
+}
@@ -0,0 +1,83 @@
+// Copyright (c) 2016 Doyub Kim
+
+#include <jet/fdm_iccg_solver3.h>
+#include <jet/fdm_parallel_iccg_solver3.h>
+#include <gtest/gtest.h>
+
+using namespace jet;
+
+static void buildTestLinearSystem(
+    FdmLinearSystem3* system, const Size3& size) {
+    system->A.resize(size);
+    system->x.resize(size);
+    system->b.resize(size);
+
+    system->A.forEachIndex([&](size_t i, size_t j, size_t k) {
+        if (i > 0) {
+            system->A(i, j, k).center += 1.0;
+        }
+        if (i < system->A.width() - 1) {
+            system->A(i, j, k).center += 1.0;
+            system->A(i, j, k).right -= 1.0;
+        }
+
+        if (j > 0) {
+            system->A(i, j, k).center += 1.0;
+        } else {
+            system->b(i, j, k) += 1.0;
+        }
+
+        if (j < system->A.height() - 1) {
+            system->A(i, j, k).center += 1.0;
+            system->A(i, j, k).up -= 1.0;
+        } else {
+            system->b(i, j, k) -= 1.0;
+        }
+
+        if (k > 0) {
+            system->A(i, j, k).center += 1.0;
+        }
+        if (k < system->A.depth() - 1) {
+            system->A(i, j, k).center += 1.0;
+            system->A(i, j, k).front -= 1.0;
+        }
+    });
+}
+
+TEST(FdmParallelIccgSolver3, Constructors) {
+    FdmLinearSystem3 system;
+    buildTestLinearSystem(&system, Size3(3, 3, 3));
+
+    FdmParallelIccgSolver3 solver(100, 1e-9);
+    solver.solve(&system);
+
+    EXPECT_GT(solver.tolerance(), solver.lastResidual());
+}
+
+TEST(FdmParallelIccgSolver3, MatchesSerialIccg) {
+    FdmLinearSystem3 system;
+    buildTestLinearSystem(&system, Size3(13, 37, 29));
+    system.b.forEachIndex([&](size_t i, size_t j, size_t k) {
+        system.b(i, j, k) += std::sin(0.3 * i + 0.2 * j) * std::cos(0.1 * k);
+        if (i == 0) {
+            system.A(i, j, k).center += 1.0;
+        }
+    });
+
+    FdmLinearSystem3 system2 = system;
+
+    FdmIccgSolver3 serialSolver(200, 1e-9);
+    serialSolver.solve(&system);
+
+    FdmParallelIccgSolver3 parallelSolver(200, 1e-9);
+    parallelSolver.solve(&system2);
+
+    EXPECT_GT(parallelSolver.tolerance(), parallelSolver.lastResidual());
+    EXPECT_EQ(
+        serialSolver.lastNumberOfIterations(),
+        parallelSolver.lastNumberOfIterations());
+
+    system.x.forEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(system.x(i, j, k), system2.x(i, j, k), 1e-12);
+    });
+}
@@ -1,6 +1,7 @@
 // Copyright (c) 2016 Doyub Kim
 
 #include <jet/cell_centered_scalar_grid3.h>
+#include <jet/face_centered_grid3.h>
 #include <jet/grid_backward_euler_diffusion_solver3.h>
 #include <gtest/gtest.h>
 
@@ -37,3 +38,39 @@ TEST(GridBackwardEulerDiffusionSolver3, Solve) {
         EXPECT_NEAR(solution(i, j, k), dst(i, j, k), 1e-6);
     });
 }
+
+TEST(GridBackwardEulerDiffusionSolver3, SolveCompressed) {
+    FaceCenteredGrid3 src(6, 6, 6, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0);
+    FaceCenteredGrid3 dst(6, 6, 6, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0);
+    FaceCenteredGrid3 dstComp(6, 6, 6, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0);
+
+    src.fill([](const Vector3D& x) {
+        return Vector3D(x.y, std::sin(x.x), x.x * x.z);
+    });
+
+    CellCenteredScalarGrid3 boundarySdf(6, 6, 6, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0);
+    boundarySdf.fill([](const Vector3D& x) {
+        return x.x - 1.0;
+    });
+    CellCenteredScalarGrid3 fluidSdf(6, 6, 6, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0);
+    fluidSdf.fill([](const Vector3D& x) {
+        return x.y - 3.5;
+    });
+
+    GridBackwardEulerDiffusionSolver3 diffusionSolver;
+    diffusionSolver.solve(src, 0.1, 1.0, &dst, boundarySdf, fluidSdf);
+
+    diffusionSolver.setIsUsingCompressedLinearSystem(true);
+    EXPECT_TRUE(diffusionSolver.isUsingCompressedLinearSystem());
+    diffusionSolver.solve(src, 0.1, 1.0, &dstComp, boundarySdf, fluidSdf);
+
+    dst.forEachUIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(dst.u(i, j, k), dstComp.u(i, j, k), 1e-6);
+    });
+    dst.forEachVIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(dst.v(i, j, k), dstComp.v(i, j, k), 1e-6);
+    });
+    dst.forEachWIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(dst.w(i, j, k), dstComp.w(i, j, k), 1e-6);
+    });
+}
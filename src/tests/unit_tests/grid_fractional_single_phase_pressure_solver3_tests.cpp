@@ -4,6 +4,7 @@
 #include <jet/face_centered_grid3.h>
 #include <jet/grid_fractional_single_phase_pressure_solver3.h>
 #include <gtest/gtest.h>
+#include <cmath>
 
 using namespace jet;
 
@@ -66,3 +67,101 @@ TEST(GridFractionalSinglePhasePressureSolver3, SolveFreeSurface) {
         }
     }
 }
+
+TEST(GridFractionalSinglePhasePressureSolver3, SolveFreeSurfaceCompressed) {
+    FaceCenteredGrid3 vel(3, 3, 3);
+    CellCenteredScalarGrid3 fluidSdf(3, 3, 3);
+
+    vel.fill(Vector3D());
+
+    for (size_t k = 0; k < 3; ++k) {
+        for (size_t j = 0; j < 4; ++j) {
+            for (size_t i = 0; i < 3; ++i) {
+                if (j == 0 || j == 3) {
+                    vel.v(i, j, k) = 0.0;
+                } else {
+                    vel.v(i, j, k) = 1.0;
+                }
+            }
+        }
+    }
+
+    fluidSdf.fill([&](const Vector3D& x) {
+        return x.y - 2.0;
+    });
+
+    GridFractionalSinglePhasePressureSolver3 solver;
+    solver.setIsUsingCompressedLinearSystem(true);
+    solver.solve(vel, 1.0, &vel, ConstantScalarField3(kMaxD), fluidSdf);
+
+    for (size_t k = 0; k < 3; ++k) {
+        for (size_t j = 0; j < 3; ++j) {
+            for (size_t i = 0; i < 4; ++i) {
+                EXPECT_NEAR(0.0, vel.u(i, j, k), 1e-6);
+            }
+        }
+    }
+
+    for (size_t k = 0; k < 3; ++k) {
+        for (size_t j = 0; j < 4; ++j) {
+            for (size_t i = 0; i < 3; ++i) {
+                EXPECT_NEAR(0.0, vel.v(i, j, k), 1e-6);
+            }
+        }
+    }
+
+    for (size_t k = 0; k < 4; ++k) {
+        for (size_t j = 0; j < 3; ++j) {
+            for (size_t i = 0; i < 3; ++i) {
+                EXPECT_NEAR(0.0, vel.w(i, j, k), 1e-6);
+            }
+        }
+    }
+
+    const auto& pressure = solver.pressure();
+    for (size_t k = 0; k < 3; ++k) {
+        for (size_t j = 0; j < 2; ++j) {
+            for (size_t i = 0; i < 3; ++i) {
+                double p = static_cast<double>(1.5 - j);
+                EXPECT_NEAR(p, pressure(i, j, k), 1e-6);
+            }
+        }
+    }
+}
+
+TEST(GridFractionalSinglePhasePressureSolver3, ReuseUnchangedMatrix) {
+    FaceCenteredGrid3 vel(8, 8, 8);
+    CellCenteredScalarGrid3 fluidSdf(8, 8, 8);
+
+    fluidSdf.fill([&](const Vector3D& x) {
+        return x.y - 4.5;
+    });
+
+    GridFractionalSinglePhasePressureSolver3 solver;
+    solver.setIsUsingWarmStart(true);
+    solver.setIsReusingUnchangedMatrix(true);
+    EXPECT_TRUE(solver.isUsingWarmStart());
+    EXPECT_TRUE(solver.isReusingUnchangedMatrix());
+
+    GridFractionalSinglePhasePressureSolver3 refSolver;
+
+    for (int frame = 0; frame < 3; ++frame) {
+        vel.fill([&](const Vector3D& x) {
+            return Vector3D(
+                std::sin(x.y + frame), std::cos(x.z), x.x * frame);
+        });
+        FaceCenteredGrid3 output(vel);
+        FaceCenteredGrid3 refOutput(vel);
+
+        solver.solve(
+            vel, 1.0, &output, ConstantScalarField3(kMaxD), fluidSdf);
+        refSolver.solve(
+            vel, 1.0, &refOutput, ConstantScalarField3(kMaxD), fluidSdf);
+
+        const auto& pressure = solver.pressure();
+        const auto& refPressure = refSolver.pressure();
+        pressure.forEachIndex([&](size_t i, size_t j, size_t k) {
+            EXPECT_NEAR(refPressure(i, j, k), pressure(i, j, k), 1e-4);
+        });
+    }
+}
@@ -2,6 +2,8 @@
 
 #include <jet/cell_centered_scalar_grid3.h>
 #include <jet/face_centered_grid3.h>
+#include <jet/fdm_cg_solver3.h>
+#include <jet/fdm_parallel_iccg_solver3.h>
 #include <jet/grid_single_phase_pressure_solver3.h>
 #include <gtest/gtest.h>
 
@@ -255,3 +257,294 @@ TEST(GridSinglePhasePressureSolver3, SolveFreeSurfaceWithBoundary) {
         }
     }
 }
+
+TEST(GridSinglePhasePressureSolver3, SolveFreeSurfaceWithBoundaryCompressed) {
+    FaceCenteredGrid3 vel(3, 3, 3);
+    CellCenteredScalarGrid3 fluidSdf(3, 3, 3);
+    CellCenteredScalarGrid3 boundarySdf(3, 3, 3);
+
+    vel.fill(Vector3D());
+
+    for (size_t k = 0; k < 3; ++k) {
+        for (size_t j = 0; j < 4; ++j) {
+            for (size_t i = 0; i < 3; ++i) {
+                if (j == 0 || j == 3) {
+                    vel.v(i, j, k) = 0.0;
+                } else {
+                    vel.v(i, j, k) = 1.0;
+                }
+            }
+        }
+    }
+
+    // Wall on the right-most column
+    boundarySdf.fill([&](const Vector3D& x) {
+        return -x.x + 2.0;
+    });
+    fluidSdf.fill([&](const Vector3D& x) {
+        return x.y - 2.0;
+    });
+
+    GridSinglePhasePressureSolver3 solver;
+    solver.setIsUsingCompressedLinearSystem(true);
+    solver.solve(vel, 1.0, &vel, boundarySdf, fluidSdf);
+
+    for (size_t k = 0; k < 3; ++k) {
+        for (size_t j = 0; j < 3; ++j) {
+            for (size_t i = 0; i < 4; ++i) {
+                EXPECT_NEAR(0.0, vel.u(i, j, k), 1e-6);
+            }
+        }
+    }
+
+    for (size_t k = 0; k < 3; ++k) {
+        for (size_t j = 0; j < 4; ++j) {
+            for (size_t i = 0; i < 3; ++i) {
+                if (i == 2 && (j == 1 || j == 2)) {
+                    EXPECT_NEAR(1.0, vel.v(i, j, k), 1e-6);
+                } else {
+                    EXPECT_NEAR(0.0, vel.v(i, j, k), 1e-6);
+                }
+            }
+        }
+    }
+
+    for (size_t k = 0; k < 4; ++k) {
+        for (size_t j = 0; j < 3; ++j) {
+            for (size_t i = 0; i < 3; ++i) {
+                EXPECT_NEAR(0.0, vel.w(i, j, k), 1e-6);
+            }
+        }
+    }
+
+    const auto& pressure = solver.pressure();
+    for (size_t k = 0; k < 3; ++k) {
+        for (size_t j = 0; j < 2; ++j) {
+            for (size_t i = 0; i < 2; ++i) {
+                double p = static_cast<double>(2 - j);
+                EXPECT_NEAR(p, pressure(i, j, k), 1e-6);
+            }
+        }
+    }
+}
+
+TEST(GridSinglePhasePressureSolver3, SolveFreeSurfaceWithBoundaryCompressedFallback) {
+    FaceCenteredGrid3 vel(3, 3, 3);
+    CellCenteredScalarGrid3 fluidSdf(3, 3, 3);
+    CellCenteredScalarGrid3 boundarySdf(3, 3, 3);
+
+    vel.fill(Vector3D());
+
+    for (size_t k = 0; k < 3; ++k) {
+        for (size_t j = 0; j < 4; ++j) {
+            for (size_t i = 0; i < 3; ++i) {
+                if (j == 0 || j == 3) {
+                    vel.v(i, j, k) = 0.0;
+                } else {
+                    vel.v(i, j, k) = 1.0;
+                }
+            }
+        }
+    }
+
+    // Wall on the right-most column
+    boundarySdf.fill([&](const Vector3D& x) {
+        return -x.x + 2.0;
+    });
+    fluidSdf.fill([&](const Vector3D& x) {
+        return x.y - 2.0;
+    });
+
+    // FdmParallelIccgSolver3 does not support the compressed system
+    GridSinglePhasePressureSolver3 solver;
+    solver.setLinearSystemSolver(
+        std::make_shared<FdmParallelIccgSolver3>(100, 1e-9));
+    solver.setIsUsingCompressedLinearSystem(true);
+    solver.solve(vel, 1.0, &vel, boundarySdf, fluidSdf);
+
+    for (size_t k = 0; k < 3; ++k) {
+        for (size_t j = 0; j < 3; ++j) {
+            for (size_t i = 0; i < 4; ++i) {
+                EXPECT_NEAR(0.0, vel.u(i, j, k), 1e-6);
+            }
+        }
+    }
+
+    for (size_t k = 0; k < 3; ++k) {
+        for (size_t j = 0; j < 4; ++j) {
+            for (size_t i = 0; i < 3; ++i) {
+                if (i == 2 && (j == 1 || j == 2)) {
+                    EXPECT_NEAR(1.0, vel.v(i, j, k), 1e-6);
+                } else {
+                    EXPECT_NEAR(0.0, vel.v(i, j, k), 1e-6);
+                }
+            }
+        }
+    }
+
+    for (size_t k = 0; k < 4; ++k) {
+        for (size_t j = 0; j < 3; ++j) {
+            for (size_t i = 0; i < 3; ++i) {
+                EXPECT_NEAR(0.0, vel.w(i, j, k), 1e-6);
+            }
+        }
+    }
+
+    const auto& pressure = solver.pressure();
+    for (size_t k = 0; k < 3; ++k) {
+        for (size_t j = 0; j < 2; ++j) {
+            for (size_t i = 0; i < 2; ++i) {
+                double p = static_cast<double>(2 - j);
+                EXPECT_NEAR(p, pressure(i, j, k), 1e-6);
+            }
+        }
+    }
+}
+
+TEST(GridSinglePhasePressureSolver3, SolveFreeSurfaceWithBoundaryMatrixFree) {
+    FaceCenteredGrid3 vel(3, 3, 3);
+    CellCenteredScalarGrid3 fluidSdf(3, 3, 3);
+    CellCenteredScalarGrid3 boundarySdf(3, 3, 3);
+
+    vel.fill(Vector3D());
+
+    for (size_t k = 0; k < 3; ++k) {
+        for (size_t j = 0; j < 4; ++j) {
+            for (size_t i = 0; i < 3; ++i) {
+                if (j == 0 || j == 3) {
+                    vel.v(i, j, k) = 0.0;
+                } else {
+                    vel.v(i, j, k) = 1.0;
+                }
+            }
+        }
+    }
+
+    // Wall on the right-most column
+    boundarySdf.fill([&](const Vector3D& x) {
+        return -x.x + 2.0;
+    });
+    fluidSdf.fill([&](const Vector3D& x) {
+        return x.y - 2.0;
+    });
+
+    auto cgSolver = std::make_shared<FdmCgSolver3>(100, 1e-9);
+    GridSinglePhasePressureSolver3 solver;
+    solver.setLinearSystemSolver(cgSolver);
+    solver.setIsUsingMatrixFreeSystem(true);
+    solver.solve(vel, 1.0, &vel, boundarySdf, fluidSdf);
+
+    EXPECT_LT(0u, cgSolver->stats().numberOfIterations);
+    EXPECT_EQ(
+        cgSolver->lastNumberOfIterations(),
+        cgSolver->stats().numberOfIterations);
+
+    for (size_t k = 0; k < 3; ++k) {
+        for (size_t j = 0; j < 3; ++j) {
+            for (size_t i = 0; i < 4; ++i) {
+                EXPECT_NEAR(0.0, vel.u(i, j, k), 1e-6);
+            }
+        }
+    }
+
+    for (size_t k = 0; k < 3; ++k) {
+        for (size_t j = 0; j < 4; ++j) {
+            for (size_t i = 0; i < 3; ++i) {
+                if (i == 2 && (j == 1 || j == 2)) {
+                    EXPECT_NEAR(1.0, vel.v(i, j, k), 1e-6);
+                } else {
+                    EXPECT_NEAR(0.0, vel.v(i, j, k), 1e-6);
+                }
+            }
+        }
+    }
+
+    for (size_t k = 0; k < 4; ++k) {
+        for (size_t j = 0; j < 3; ++j) {
+            for (size_t i = 0; i < 3; ++i) {
+                EXPECT_NEAR(0.0, vel.w(i, j, k), 1e-6);
+            }
+        }
+    }
+
+    const auto& pressure = solver.pressure();
+    for (size_t k = 0; k < 3; ++k) {
+        for (size_t j = 0; j < 2; ++j) {
+            for (size_t i = 0; i < 2; ++i) {
+                double p = static_cast<double>(2 - j);
+                EXPECT_NEAR(p, pressure(i, j, k), 1e-6);
+            }
+        }
+    }
+}
+
+TEST(GridSinglePhasePressureSolver3, SolveFreeSurfaceWithBoundaryMatrixFreeFallback) {
+    FaceCenteredGrid3 vel(3, 3, 3);
+    CellCenteredScalarGrid3 fluidSdf(3, 3, 3);
+    CellCenteredScalarGrid3 boundarySdf(3, 3, 3);
+
+    vel.fill(Vector3D());
+
+    for (size_t k = 0; k < 3; ++k) {
+        for (size_t j = 0; j < 4; ++j) {
+            for (size_t i = 0; i < 3; ++i) {
+                if (j == 0 || j == 3) {
+                    vel.v(i, j, k) = 0.0;
+                } else {
+                    vel.v(i, j, k) = 1.0;
+                }
+            }
+        }
+    }
+
+    // Wall on the right-most column
+    boundarySdf.fill([&](const Vector3D& x) {
+        return -x.x + 2.0;
+    });
+    fluidSdf.fill([&](const Vector3D& x) {
+        return x.y - 2.0;
+    });
+
+    // The default solver does not support the matrix-free system
+    GridSinglePhasePressureSolver3 solver;
+    solver.setIsUsingMatrixFreeSystem(true);
+    solver.solve(vel, 1.0, &vel, boundarySdf, fluidSdf);
+
+    for (size_t k = 0; k < 3; ++k) {
+        for (size_t j = 0; j < 3; ++j) {
+            for (size_t i = 0; i < 4; ++i) {
+                EXPECT_NEAR(0.0, vel.u(i, j, k), 1e-6);
+            }
+        }
+    }
+
+    for (size_t k = 0; k < 3; ++k) {
+        for (size_t j = 0; j < 4; ++j) {
+            for (size_t i = 0; i < 3; ++i) {
+                if (i == 2 && (j == 1 || j == 2)) {
+                    EXPECT_NEAR(1.0, vel.v(i, j, k), 1e-6);
+                } else {
+                    EXPECT_NEAR(0.0, vel.v(i, j, k), 1e-6);
+                }
+            }
+        }
+    }
+
+    for (size_t k = 0; k < 4; ++k) {
+        for (size_t j = 0; j < 3; ++j) {
+            for (size_t i = 0; i < 3; ++i) {
+                EXPECT_NEAR(0.0, vel.w(i, j, k), 1e-6);
+            }
+        }
+    }
+
+    const auto& pressure = solver.pressure();
+    for (size_t k = 0; k < 3; ++k) {
+        for (size_t j = 0; j < 2; ++j) {
+            for (size_t i = 0; i < 2; ++i) {
+                double p = static_cast<double>(2 - j);
+                EXPECT_NEAR(p, pressure(i, j, k), 1e-6);
+            }
+        }
+    }
+}
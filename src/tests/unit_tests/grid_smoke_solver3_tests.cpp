@@ -0,0 +1,118 @@
+// Copyright (c) 2016 Doyub Kim
+
+#include <jet/grid_smoke_solver3.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+
+using namespace jet;
+
+static void fillSource(GridSmokeSolver3* solver) {
+    BoundingBox3D source(Vector3D(0.4, 0.1, 0.4), Vector3D(0.6, 0.3, 0.6));
+    auto func = [&](const Vector3D& x) {
+        return source.contains(x) ? 1.0 : 0.0;
+    };
+    solver->smokeDensity()->fill(func);
+    solver->temperature()->fill(func);
+}
+
+TEST(GridSmokeSolver3, ActiveRegion) {
+    GridSmokeSolver3 solver;
+    solver.setIsUsingActiveRegion(true);
+    solver.setMaxCfl(2.0);
+    EXPECT_TRUE(solver.isUsingActiveRegion());
+    EXPECT_DOUBLE_EQ(1e-4, solver.activeRegionThreshold());
+    EXPECT_DOUBLE_EQ(1e-2, solver.activeRegionSpeedThreshold());
+
+    double dx = 1.0 / 32.0;
+    solver.resizeGrid(Size3(32, 32, 32), Vector3D(dx, dx, dx), Vector3D());
+    fillSource(&solver);
+
+    Frame frame(1, 1.0 / 60.0);
+    solver.update(frame);
+
+    // The region covers the source dilated by ceil(maxCfl) + 2 cells
+    BoundingBox3D region = solver.activeRegion();
+    BoundingBox3D source(Vector3D(0.4, 0.1, 0.4), Vector3D(0.6, 0.3, 0.6));
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_LE(region.lowerCorner[i], source.lowerCorner[i] - 3 * dx);
+        EXPECT_GE(region.lowerCorner[i], source.lowerCorner[i] - 6 * dx);
+        EXPECT_GE(region.upperCorner[i], source.upperCorner[i] + 3 * dx);
+        EXPECT_LE(region.upperCorner[i], source.upperCorner[i] + 6 * dx);
+    }
+
+    // The flow outside of the region is untouched
+    auto vel = solver.velocity();
+    EXPECT_DOUBLE_EQ(0.0, vel->v(16, 28, 16));
+    EXPECT_DOUBLE_EQ(0.0, vel->u(2, 16, 16));
+    EXPECT_LT(0.0, vel->v(16, 8, 16));
+}
+
+TEST(GridSmokeSolver3, ActiveRegionMatchesFullDomain) {
+    double dx = 1.0 / 32.0;
+    GridSmokeSolver3 solver;
+    solver.setIsUsingActiveRegion(true);
+    solver.setActiveRegionSpeedThreshold(0.03);
+    solver.resizeGrid(Size3(32, 32, 32), Vector3D(dx, dx, dx), Vector3D());
+    fillSource(&solver);
+
+    GridSmokeSolver3 solver2;
+    solver2.resizeGrid(Size3(32, 32, 32), Vector3D(dx, dx, dx), Vector3D());
+    fillSource(&solver2);
+
+    for (Frame frame(0, 1.0 / 60.0); frame.index < 5; frame.advance()) {
+        solver.update(frame);
+        solver2.update(frame);
+    }
+
+    // The region has grown with the induced flow, but not to the whole grid
+    BoundingBox3D domain = solver2.gridSystemData()->boundingBox();
+    EXPECT_EQ(domain.upperCorner, solver2.activeRegion().upperCorner);
+    EXPECT_GT(solver.activeRegion().width(), 0.5);
+    EXPECT_LT(solver.activeRegion().width(), domain.width());
+
+    auto den = solver.smokeDensity();
+    auto den2 = solver2.smokeDensity();
+    double sum = 0.0;
+    double sum2 = 0.0;
+    den->forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        sum += (*den)(i, j, k);
+        sum2 += (*den2)(i, j, k);
+    });
+    EXPECT_NEAR(sum2, sum, 0.01 * sum2);
+
+    // The flow through the region faces is not blocked, so the velocity
+    // matches the full-domain simulation everywhere
+    auto vel = solver.velocity();
+    auto vel2 = solver2.velocity();
+    double maxSpeed = 0.0;
+    double maxDiff = 0.0;
+    vel->forEachVIndex([&](size_t i, size_t j, size_t k) {
+        maxSpeed = std::max(maxSpeed, std::fabs(vel2->v(i, j, k)));
+        maxDiff = std::max(
+            maxDiff, std::fabs(vel->v(i, j, k) - vel2->v(i, j, k)));
+    });
+    vel->forEachUIndex([&](size_t i, size_t j, size_t k) {
+        maxDiff = std::max(
+            maxDiff, std::fabs(vel->u(i, j, k) - vel2->u(i, j, k)));
+    });
+    EXPECT_LT(0.0, maxSpeed);
+    EXPECT_LT(maxDiff, 0.05 * maxSpeed);
+}
+
+TEST(GridSmokeSolver3, EmptyActiveRegion) {
+    GridSmokeSolver3 solver;
+    solver.setIsUsingActiveRegion(true);
+
+    solver.resizeGrid(Size3(16, 16, 16), Vector3D(0.1, 0.1, 0.1), Vector3D());
+
+    Frame frame(1, 1.0 / 60.0);
+    solver.update(frame);
+
+    EXPECT_GT(solver.activeRegion().lowerCorner.x,
+        solver.activeRegion().upperCorner.x);
+    auto vel = solver.velocity();
+    vel->forEachVIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(0.0, vel->v(i, j, k));
+    });
+}
@@ -0,0 +1,69 @@
+// Copyright (c) 2016 Doyub Kim
+
+#include <jet/cell_centered_scalar_grid3.h>
+#include <jet/cell_centered_vector_grid3.h>
+#include <jet/grid_system_data3.h>
+#include <gtest/gtest.h>
+
+using namespace jet;
+
+TEST(GridSystemData3, SwapVelocityBuffers) {
+    GridSystemData3 grids;
+    grids.resize(Size3(4, 5, 6), Vector3D(1, 1, 1), Vector3D());
+
+    auto vel = grids.velocity();
+    auto vel1 = grids.velocityBackBuffer();
+    EXPECT_NE(vel, vel1);
+    EXPECT_TRUE(vel->hasSameShape(*vel1));
+
+    vel->fill(Vector3D(1, 2, 3));
+    vel1->fill(Vector3D(4, 5, 6));
+    const double* u1 = vel1->uAccessor().data();
+
+    grids.swapVelocityBuffers();
+
+    // The pointers stay the same, and the contents are exchanged without copy
+    EXPECT_EQ(vel, grids.velocity());
+    EXPECT_EQ(u1, vel->uAccessor().data());
+    EXPECT_EQ(Vector3D(4, 5, 6), vel->sample(Vector3D(2, 2, 2)));
+    EXPECT_EQ(Vector3D(1, 2, 3), vel1->sample(Vector3D(2, 2, 2)));
+
+    // The back buffer follows the front buffer when resized directly
+    vel->resize(Size3(2, 3, 4), Vector3D(0.5, 0.5, 0.5), Vector3D(1, 1, 1));
+    EXPECT_TRUE(grids.velocityBackBuffer()->hasSameShape(*vel));
+}
+
+TEST(GridSystemData3, SwapAdvectableDataBuffers) {
+    GridSystemData3 grids;
+    grids.resize(Size3(4, 5, 6), Vector3D(1, 1, 1), Vector3D());
+
+    size_t s = grids.addAdvectableScalarData(
+        CellCenteredScalarGrid3::builder(), 1.0);
+    size_t v = grids.addAdvectableVectorData(
+        CellCenteredVectorGrid3::builder(), Vector3D(1, 2, 3));
+
+    auto scalar = grids.advectableScalarDataAt(s);
+    auto scalar1 = grids.advectableScalarDataBackBufferAt(s);
+    EXPECT_TRUE(scalar->hasSameShape(*scalar1));
+    EXPECT_DOUBLE_EQ(1.0, (*scalar1)(1, 2, 3));
+
+    scalar1->fill(7.0);
+    grids.swapAdvectableScalarDataBuffersAt(s);
+    EXPECT_DOUBLE_EQ(7.0, (*scalar)(1, 2, 3));
+    EXPECT_DOUBLE_EQ(1.0, (*scalar1)(1, 2, 3));
+
+    auto vector = grids.advectableVectorDataAt(v);
+    auto vector1 = grids.advectableVectorDataBackBufferAt(v);
+    EXPECT_TRUE(vector->hasSameShape(*vector1));
+
+    vector1->fill(Vector3D(4, 5, 6));
+    grids.swapAdvectableVectorDataBuffersAt(v);
+    EXPECT_EQ(Vector3D(4, 5, 6), vector->sample(Vector3D(2, 2, 2)));
+    EXPECT_EQ(Vector3D(1, 2, 3), vector1->sample(Vector3D(2, 2, 2)));
+
+    grids.resize(Size3(2, 3, 4), Vector3D(1, 1, 1), Vector3D());
+    EXPECT_TRUE(
+        scalar->hasSameShape(*grids.advectableScalarDataBackBufferAt(s)));
+    EXPECT_TRUE(
+        vector->hasSameShape(*grids.advectableVectorDataBackBufferAt(v)));
+}
@@ -2,8 +2,12 @@
 
 #include <jet/box3.h>
 #include <jet/implicit_surface_set3.h>
+#include <jet/plane3.h>
+#include <jet/sphere3.h>
+#include <jet/surface_set3.h>
 #include <jet/surface_to_implicit3.h>
 #include <gtest/gtest.h>
+#include <random>
 
 using namespace jet;
 
@@ -195,3 +199,104 @@ TEST(ImplicitSurfaceSet3, ClosestNormal) {
     EXPECT_DOUBLE_EQ(boxNormal.y, setNormal.y);
     EXPECT_DOUBLE_EQ(boxNormal.z, setNormal.z);
 }
+
+TEST(ImplicitSurfaceSet3, ManySurfaces) {
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<> d(0.0, 1.0);
+
+    // Overlapping spheres and an oblique plane that has no finite bound
+    ImplicitSurfaceSet3 sset;
+    for (int i = 0; i < 200; ++i) {
+        sset.addExplicitSurface(std::make_shared<Sphere3>(
+            Vector3D(d(rng), d(rng), d(rng)), 0.02 + 0.05 * d(rng)));
+    }
+    sset.addExplicitSurface(std::make_shared<Plane3>(
+        Vector3D(1, 1, 1).normalized(), Vector3D(-1, -1, -1)));
+
+    for (int iter = 0; iter < 100; ++iter) {
+        Vector3D pt(
+            2.0 * d(rng) - 0.5, 2.0 * d(rng) - 0.5, 2.0 * d(rng) - 0.5);
+
+        size_t answer = 0;
+        double minDist = kMaxD;
+        double minSdf = kMaxD;
+        for (size_t i = 0; i < sset.numberOfSurfaces(); ++i) {
+            double dist = sset.surfaceAt(i)->closestDistance(pt);
+            if (dist < minDist) {
+                minDist = dist;
+                answer = i;
+            }
+            minSdf = std::min(minSdf, sset.surfaceAt(i)->signedDistance(pt));
+        }
+
+        const auto& surface = sset.surfaceAt(answer);
+        EXPECT_EQ(minDist, sset.closestDistance(pt));
+        EXPECT_EQ(surface->closestPoint(pt), sset.closestPoint(pt));
+        EXPECT_EQ(surface->closestNormal(pt), sset.closestNormal(pt));
+        EXPECT_EQ(minSdf, sset.signedDistance(pt));
+
+        SurfaceClosestQueryResult3 result = sset.closestQuery(pt);
+        EXPECT_EQ(surface->closestPoint(pt), result.point);
+        EXPECT_EQ(surface->closestNormal(pt), result.normal);
+        EXPECT_EQ(minDist, result.distance);
+
+        Ray3D ray(pt, Vector3D(d(rng) - 0.5, d(rng) - 0.5, d(rng) - 0.5)
+            .normalized());
+        SurfaceRayIntersection3 expected;
+        bool expectedHit = false;
+        for (size_t i = 0; i < sset.numberOfSurfaces(); ++i) {
+            auto local = sset.surfaceAt(i)->closestIntersection(ray);
+            if (local.isIntersecting && local.t < expected.t) {
+                expected = local;
+            }
+            expectedHit |= sset.surfaceAt(i)->intersects(ray);
+        }
+
+        SurfaceRayIntersection3 actual = sset.closestIntersection(ray);
+        EXPECT_EQ(expected.isIntersecting, actual.isIntersecting);
+        EXPECT_EQ(expected.t, actual.t);
+        EXPECT_EQ(expected.point, actual.point);
+        EXPECT_EQ(expectedHit, sset.intersects(ray));
+    }
+}
+
+TEST(ImplicitSurfaceSet3, InvalidateBvh) {
+    auto sphere = std::make_shared<Sphere3>(Vector3D(), 1.0);
+
+    ImplicitSurfaceSet3 sset;
+    sset.addExplicitSurface(sphere);
+    EXPECT_DOUBLE_EQ(1.0, sset.closestDistance(Vector3D(2, 0, 0)));
+
+    sphere->center = Vector3D(5, 0, 0);
+    sset.invalidateBvh();
+    EXPECT_DOUBLE_EQ(2.0, sset.closestDistance(Vector3D(2, 0, 0)));
+}
+
+TEST(ImplicitSurfaceSet3, UpdateQueryEngine) {
+    auto sphere = std::make_shared<Sphere3>(Vector3D(), 1.0);
+    auto innerSet = std::make_shared<SurfaceSet3>();
+    innerSet->addSurface(sphere);
+
+    ImplicitSurfaceSet3 sset;
+    sset.addExplicitSurface(innerSet);
+    EXPECT_DOUBLE_EQ(1.0, sset.closestDistance(Vector3D(2, 0, 0)));
+
+    // Moving the sphere changes the boxes of both sets
+    sphere->center = Vector3D(5, 0, 0);
+    sset.updateQueryEngine();
+    EXPECT_DOUBLE_EQ(2.0, sset.closestDistance(Vector3D(2, 0, 0)));
+    EXPECT_DOUBLE_EQ(2.0, innerSet->closestDistance(Vector3D(2, 0, 0)));
+    EXPECT_DOUBLE_EQ(-1.0, sset.signedDistance(Vector3D(5, 0, 0)));
+}
+
+TEST(ImplicitSurfaceSet3, IsClosed) {
+    ImplicitSurfaceSet3 surfaceSet;
+    surfaceSet.addExplicitSurface(
+        std::make_shared<Sphere3>(Vector3D(0, 0, 0), 1.0));
+    EXPECT_TRUE(surfaceSet.isClosed());
+
+    // The open surfaces stay open when they are converted to implicit ones.
+    surfaceSet.addExplicitSurface(
+        std::make_shared<Plane3>(Vector3D(0, 1, 0), Vector3D(0, 0, 0)));
+    EXPECT_FALSE(surfaceSet.isClosed());
+}
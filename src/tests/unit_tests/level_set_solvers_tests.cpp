@@ -5,12 +5,15 @@
 #include <jet/cell_centered_scalar_grid3.h>
 #include <jet/eno_level_set_solver2.h>
 #include <jet/eno_level_set_solver3.h>
+#include <jet/face_centered_grid3.h>
+#include <jet/fast_sweeping_level_set_solver3.h>
 #include <jet/fdm_utils.h>
 #include <jet/fmm_level_set_solver2.h>
 #include <jet/fmm_level_set_solver3.h>
 #include <jet/upwind_level_set_solver2.h>
 #include <jet/upwind_level_set_solver3.h>
 #include <gtest/gtest.h>
+#include <cmath>
 
 using namespace jet;
 
@@ -172,6 +175,75 @@ TEST(EnoLevelSetSolver3, Extrapolate) {
 }
 
 
+TEST(EnoLevelSetSolver3, ReinitializeNarrowBand) {
+    CellCenteredScalarGrid3 sdf(40, 30, 50);
+    CellCenteredScalarGrid3 distorted(40, 30, 50), temp(40, 30, 50);
+
+    sdf.fill([](const Vector3D& x) {
+        return (x - Vector3D(20, 20, 20)).length() - 8.0;
+    });
+    distorted.fill([](const Vector3D& x) {
+        return 1.5 * ((x - Vector3D(20, 20, 20)).length() - 8.0);
+    });
+
+    EnoLevelSetSolver3 solver;
+    solver.setIsUsingNarrowBand(true);
+    EXPECT_TRUE(solver.isUsingNarrowBand());
+
+    solver.reinitialize(distorted, 5.0, &temp);
+
+    for (size_t k = 0; k < 50; ++k) {
+        for (size_t j = 0; j < 30; ++j) {
+            for (size_t i = 0; i < 40; ++i) {
+                if (std::fabs(distorted(i, j, k)) >= 5.0) {
+                    // Clamped
+                    EXPECT_DOUBLE_EQ(
+                        (distorted(i, j, k) < 0.0) ? -5.0 : 5.0,
+                        temp(i, j, k)) << i << ", " << j << ", " << k;
+                } else if (std::fabs(sdf(i, j, k)) < 2.0) {
+                    EXPECT_NEAR(sdf(i, j, k), temp(i, j, k), 0.5)
+                        << i << ", " << j << ", " << k;
+                }
+            }
+        }
+    }
+}
+
+TEST(EnoLevelSetSolver3, ExtrapolateNarrowBand) {
+    CellCenteredScalarGrid3 sdf(40, 30, 50), field(40, 30, 50);
+    CellCenteredScalarGrid3 fullResult(40, 30, 50), bandResult(40, 30, 50);
+
+    sdf.fill([](const Vector3D& x) {
+        return (x - Vector3D(20, 20, 20)).length() - 8.0;
+    });
+    field.fill([&](const Vector3D& x) {
+        return ((x - Vector3D(20, 20, 20)).length() < 8.0) ? 5.0 : -1.0;
+    });
+
+    EnoLevelSetSolver3 fullSolver;
+    fullSolver.extrapolate(field, sdf, 5.0, &fullResult);
+
+    EnoLevelSetSolver3 bandSolver;
+    bandSolver.setIsUsingNarrowBand(true);
+    bandSolver.extrapolate(field, sdf, 5.0, &bandResult);
+
+    for (size_t k = 0; k < 50; ++k) {
+        for (size_t j = 0; j < 30; ++j) {
+            for (size_t i = 0; i < 40; ++i) {
+                if (sdf(i, j, k) >= 5.0) {
+                    // Out of the band
+                    EXPECT_DOUBLE_EQ(-1.0, bandResult(i, j, k))
+                        << i << ", " << j << ", " << k;
+                } else if (sdf(i, j, k) < 2.0) {
+                    // Far enough from the band boundary
+                    EXPECT_NEAR(fullResult(i, j, k), bandResult(i, j, k), 1e-4)
+                        << i << ", " << j << ", " << k;
+                }
+            }
+        }
+    }
+}
+
 TEST(FmmLevelSetSolver2, Reinitialize) {
     CellCenteredScalarGrid2 sdf(40, 30), temp(40, 30);
 
@@ -249,3 +321,149 @@ TEST(FmmLevelSetSolver3, Extrapolate) {
         }
     }
 }
+
+TEST(FastSweepingLevelSetSolver3, Reinitialize) {
+    CellCenteredScalarGrid3 sdf(40, 30, 50), temp(40, 30, 50);
+
+    sdf.fill([](const Vector3D& x) {
+        return (x - Vector3D(20, 20, 20)).length() - 8.0;
+    });
+
+    FastSweepingLevelSetSolver3 solver;
+    solver.reinitialize(sdf, 5.0, &temp);
+
+    for (size_t k = 0; k < 50; ++k) {
+        for (size_t j = 0; j < 30; ++j) {
+            for (size_t i = 0; i < 40; ++i) {
+                EXPECT_NEAR(sdf(i, j, k), temp(i, j, k), 0.9)
+                    << i << ", " << j << ", " << k;
+            }
+        }
+    }
+}
+
+TEST(FastSweepingLevelSetSolver3, ReinitializeDistorted) {
+    CellCenteredScalarGrid3 sdf(32, 32, 32, 0.5, 0.5, 0.5);
+    CellCenteredScalarGrid3 distorted(32, 32, 32, 0.5, 0.5, 0.5);
+    CellCenteredScalarGrid3 temp(32, 32, 32, 0.5, 0.5, 0.5);
+
+    sdf.fill([](const Vector3D& x) {
+        return (x - Vector3D(8, 8, 8)).length() - 4.0;
+    });
+
+    // Same zero level set with non-unit gradient
+    distorted.fill([](const Vector3D& x) {
+        double phi = (x - Vector3D(8, 8, 8)).length() - 4.0;
+        return phi * (2.0 + std::sin(x.x));
+    });
+
+    FastSweepingLevelSetSolver3 solver;
+    solver.reinitialize(distorted, 3.0, &temp);
+
+    EXPECT_LE(solver.lastNumberOfIterations(), solver.maxNumberOfIterations());
+
+    for (size_t k = 0; k < 32; ++k) {
+        for (size_t j = 0; j < 32; ++j) {
+            for (size_t i = 0; i < 32; ++i) {
+                if (std::fabs(sdf(i, j, k)) < 2.5) {
+                    EXPECT_NEAR(sdf(i, j, k), temp(i, j, k), 0.25)
+                        << i << ", " << j << ", " << k;
+                } else if (std::fabs(sdf(i, j, k)) > 3.5) {
+                    // Out of the band
+                    EXPECT_DOUBLE_EQ(distorted(i, j, k), temp(i, j, k))
+                        << i << ", " << j << ", " << k;
+                }
+            }
+        }
+    }
+}
+
+TEST(FastSweepingLevelSetSolver3, Extrapolate) {
+    CellCenteredScalarGrid3 sdf(40, 30, 50), temp(40, 30, 50);
+    CellCenteredScalarGrid3 field(40, 30, 50);
+
+    sdf.fill([](const Vector3D& x) {
+        return (x - Vector3D(20, 20, 20)).length() - 8.0;
+    });
+    field.fill(5.0);
+
+    FastSweepingLevelSetSolver3 solver;
+    solver.extrapolate(field, sdf, 5.0, &temp);
+
+    for (size_t k = 0; k < 50; ++k) {
+        for (size_t j = 0; j < 30; ++j) {
+            for (size_t i = 0; i < 40; ++i) {
+                EXPECT_DOUBLE_EQ(5.0, temp(i, j, k))
+                    << i << ", " << j << ", " << k;
+            }
+        }
+    }
+}
+
+TEST(FastSweepingLevelSetSolver3, ExtrapolateMatchesFmm) {
+    CellCenteredScalarGrid3 sdf(30, 30, 30), field(30, 30, 30);
+    CellCenteredScalarGrid3 fmmResult(30, 30, 30), fsmResult(30, 30, 30);
+
+    sdf.fill([](const Vector3D& x) {
+        return (x - Vector3D(15.3, 14.6, 15.1)).length() - 6.0;
+    });
+    field.fill([](const Vector3D& x) {
+        return std::sin(0.3 * x.x) + std::cos(0.2 * x.y) * x.z;
+    });
+
+    FmmLevelSetSolver3 fmmSolver;
+    fmmSolver.extrapolate(field, sdf, 5.0, &fmmResult);
+
+    FastSweepingLevelSetSolver3 fsmSolver;
+    fsmSolver.extrapolate(field, sdf, 5.0, &fsmResult);
+
+    for (size_t k = 0; k < 30; ++k) {
+        for (size_t j = 0; j < 30; ++j) {
+            for (size_t i = 0; i < 30; ++i) {
+                EXPECT_NEAR(fmmResult(i, j, k), fsmResult(i, j, k), 1e-12)
+                    << i << ", " << j << ", " << k;
+            }
+        }
+    }
+}
+
+TEST(FastSweepingLevelSetSolver3, ExtrapolateFaceCentered) {
+    FaceCenteredGrid3 field(20, 20, 20), temp(20, 20, 20);
+    CellCenteredScalarGrid3 sdf(20, 20, 20);
+
+    // Lower half is inside
+    sdf.fill([](const Vector3D& x) {
+        return x.y - 8.0;
+    });
+
+    // Inside values only vary along x and z, so the extrapolation along the
+    // normal (y) keeps them. Outside values are garbage.
+    auto expected = [](const Vector3D& x) {
+        return Vector3D(x.x, 2.0 * x.z, x.x + x.z);
+    };
+    field.fill([&](const Vector3D& x) {
+        return (x.y < 8.0) ? expected(x) : Vector3D(100.0, -100.0, 100.0);
+    });
+
+    FastSweepingLevelSetSolver3 solver;
+    solver.extrapolate(field, sdf, 5.0, &temp);
+
+    auto uPos = temp.uPosition();
+    temp.forEachUIndex([&](size_t i, size_t j, size_t k) {
+        Vector3D x = uPos(i, j, k);
+        double ans = (x.y - 8.0 > 5.0) ? field.u(i, j, k) : expected(x).x;
+        EXPECT_DOUBLE_EQ(ans, temp.u(i, j, k)) << i << ", " << j << ", " << k;
+    });
+    auto vPos = temp.vPosition();
+    temp.forEachVIndex([&](size_t i, size_t j, size_t k) {
+        Vector3D x = vPos(i, j, k);
+        double ans = (x.y - 8.0 > 5.0) ? field.v(i, j, k) : expected(x).y;
+        EXPECT_DOUBLE_EQ(ans, temp.v(i, j, k)) << i << ", " << j << ", " << k;
+    });
+    auto wPos = temp.wPosition();
+    temp.forEachWIndex([&](size_t i, size_t j, size_t k) {
+        Vector3D x = wPos(i, j, k);
+        double ans = (x.y - 8.0 > 5.0) ? field.w(i, j, k) : expected(x).z;
+        EXPECT_DOUBLE_EQ(ans, temp.w(i, j, k)) << i << ", " << j << ", " << k;
+    });
+}
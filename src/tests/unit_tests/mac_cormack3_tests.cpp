@@ -0,0 +1,117 @@
+// Copyright (c) 2016 Doyub Kim
+
+#include <jet/cell_centered_scalar_grid3.h>
+#include <jet/constant_vector_field3.h>
+#include <jet/mac_cormack3.h>
+#include <jet/semi_lagrangian3.h>
+#include <gtest/gtest.h>
+#include <cmath>
+
+using namespace jet;
+
+static double blob(const Vector3D& x) {
+    return std::exp(-square(x.x - 0.5) / 0.01);
+}
+
+static double advectBlob(AdvectionSolver3* solver) {
+    // Moves the blob by 0.5 with 50 steps of CFL 0.6 and returns the L1 error
+    CellCenteredScalarGrid3 grid(Size3(60, 2, 2), Vector3D(0.02, 0.02, 0.02));
+    CellCenteredScalarGrid3 grid1(grid.resolution(), grid.gridSpacing());
+    grid.fill([](const Vector3D& x) { return blob(x + Vector3D(0.25, 0, 0)); });
+
+    ConstantVectorField3 flow(Vector3D(1.0, 0.0, 0.0));
+    for (int i = 0; i < 50; ++i) {
+        solver->advect(grid, flow, 0.01, &grid1);
+        grid.swap(&grid1);
+    }
+
+    double error = 0.0;
+    auto pos = grid.dataPosition();
+    grid.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        Vector3D x = pos(i, j, k) - Vector3D(0.25, 0, 0);
+        error += std::fabs(grid(i, j, k) - blob(x));
+    });
+    return error;
+}
+
+TEST(MacCormack3, LessDissipative) {
+    SemiLagrangian3 semiLagrangian;
+    MacCormack3 macCormack;
+    EXPECT_EQ(MacCormack3::kClampLimiter, macCormack.limiter());
+
+    double errorSl = advectBlob(&semiLagrangian);
+    double errorMc = advectBlob(&macCormack);
+    EXPECT_LT(errorMc, 0.5 * errorSl);
+
+    macCormack.setLimiter(MacCormack3::kNoLimiter);
+    EXPECT_LT(advectBlob(&macCormack), 0.5 * errorSl);
+}
+
+TEST(MacCormack3, Limiter) {
+    CellCenteredScalarGrid3 grid(Size3(20, 20, 2), Vector3D(0.05, 0.05, 0.05));
+    CellCenteredScalarGrid3 grid1(grid.resolution(), grid.gridSpacing());
+    grid.fill([](const Vector3D& x) { return (x.x < 0.5) ? 1.0 : 0.0; });
+
+    ConstantVectorField3 flow(Vector3D(0.7, 0.3, 0.0));
+    MacCormack3 solver;
+
+    for (int i = 0; i < 10; ++i) {
+        solver.advect(grid, flow, 0.03, &grid1);
+        grid.swap(&grid1);
+    }
+
+    grid.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_LE(-1e-12, grid(i, j, k));
+        EXPECT_GE(1.0 + 1e-12, grid(i, j, k));
+    });
+
+    solver.setLimiter(MacCormack3::kRevertLimiter);
+    EXPECT_EQ(MacCormack3::kRevertLimiter, solver.limiter());
+    solver.advect(grid, flow, 0.03, &grid1);
+    grid1.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_LE(-1e-12, grid1(i, j, k));
+        EXPECT_GE(1.0 + 1e-12, grid1(i, j, k));
+    });
+}
+
+TEST(MacCormack3, FaceCentered) {
+    FaceCenteredGrid3 grid(Size3(8, 8, 8), Vector3D(0.125, 0.125, 0.125));
+    FaceCenteredGrid3 grid1(grid.resolution(), grid.gridSpacing());
+    grid.fill(Vector3D(1.0, 2.0, 3.0));
+
+    // Constant fields are preserved
+    MacCormack3 solver;
+    solver.advect(grid, grid, 0.01, &grid1);
+    grid1.forEachUIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(1.0, grid1.u(i, j, k), 1e-12);
+    });
+    grid1.forEachVIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(2.0, grid1.v(i, j, k), 1e-12);
+    });
+    grid1.forEachWIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(3.0, grid1.w(i, j, k), 1e-12);
+    });
+}
+
+TEST(MacCormack3, ReuseForDifferentSizes) {
+    // The temporary arrays are kept between the calls, so advecting grids of
+    // different sizes with the same solver should match fresh solvers.
+    ConstantVectorField3 flow(Vector3D(0.7, 0.3, 0.2));
+    MacCormack3 solver;
+
+    for (size_t n : {8, 12, 8}) {
+        double h = 1.0 / static_cast<double>(n);
+        CellCenteredScalarGrid3 grid(Size3(n, n, n), Vector3D(h, h, h));
+        CellCenteredScalarGrid3 grid1(grid.resolution(), grid.gridSpacing());
+        CellCenteredScalarGrid3 grid2(grid.resolution(), grid.gridSpacing());
+        grid.fill([](const Vector3D& x) { return blob(x); });
+
+        MacCormack3 freshSolver;
+        solver.advect(grid, flow, 0.05, &grid1);
+        freshSolver.advect(grid, flow, 0.05, &grid2);
+
+        grid1.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+            EXPECT_DOUBLE_EQ(grid2(i, j, k), grid1(i, j, k));
+        });
+    }
+}
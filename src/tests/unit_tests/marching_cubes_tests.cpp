@@ -0,0 +1,123 @@
+// Copyright (c) 2016 Doyub Kim
+
+#include <jet/array3.h>
+#include <jet/marching_cubes.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <utility>
+
+using namespace jet;
+
+TEST(MarchingCubes, Sphere) {
+    const size_t n = 40;
+    const double h = 1.0 / n;
+    const Vector3D center(0.5, 0.45, 0.55);
+    const double radius = 0.3;
+
+    Array3<double> sdf(n + 1, n + 1, n + 1);
+    sdf.forEachIndex([&](size_t i, size_t j, size_t k) {
+        sdf(i, j, k) = Vector3D(i * h, j * h, k * h).distanceTo(center)
+            - radius;
+    });
+
+    TriangleMesh3 mesh;
+    marchingCubes(sdf.constAccessor(), Vector3D(h, h, h), Vector3D(), &mesh);
+
+    EXPECT_LT(0u, mesh.numberOfTriangles());
+
+    for (size_t i = 0; i < mesh.numberOfPoints(); ++i) {
+        EXPECT_NEAR(radius, mesh.point(i).distanceTo(center), 0.1 * h);
+    }
+
+    // Every edge should be shared by exactly two triangles, which also means
+    // that the vertices on the shared edges are merged.
+    std::map<std::pair<size_t, size_t>, int> edgeCounts;
+    for (size_t i = 0; i < mesh.numberOfTriangles(); ++i) {
+        const Point3UI& face = mesh.pointIndex(i);
+        for (int j = 0; j < 3; ++j) {
+            size_t a = face[j];
+            size_t b = face[(j + 1) % 3];
+            ++edgeCounts[std::make_pair(std::min(a, b), std::max(a, b))];
+        }
+    }
+    for (const auto& edgeCount : edgeCounts) {
+        EXPECT_EQ(2, edgeCount.second);
+    }
+
+    // Each vertex is used.
+    std::vector<bool> isUsed(mesh.numberOfPoints(), false);
+    for (size_t i = 0; i < mesh.numberOfTriangles(); ++i) {
+        for (int j = 0; j < 3; ++j) {
+            isUsed[mesh.pointIndex(i)[j]] = true;
+        }
+    }
+    EXPECT_EQ(mesh.numberOfPoints(),
+        static_cast<size_t>(std::count(isUsed.begin(), isUsed.end(), true)));
+}
+
+TEST(MarchingCubes, AppendToMesh) {
+    Array3<double> sdf(4, 4, 4);
+    sdf.forEachIndex([&](size_t i, size_t j, size_t k) {
+        sdf(i, j, k) = Vector3D(i, j, k).distanceTo({1.5, 1.5, 1.5}) - 1.0;
+    });
+
+    TriangleMesh3 mesh;
+    marchingCubes(
+        sdf.constAccessor(),
+        Vector3D(1, 1, 1),
+        Vector3D(),
+        &mesh,
+        0.0,
+        kMarchingCubesBoundaryFlagNone);
+
+    const size_t numberOfPoints = mesh.numberOfPoints();
+    const size_t numberOfTriangles = mesh.numberOfTriangles();
+    EXPECT_LT(0u, numberOfTriangles);
+
+    // The second mesh should be appended after the first one.
+    marchingCubes(
+        sdf.constAccessor(),
+        Vector3D(1, 1, 1),
+        Vector3D(10, 0, 0),
+        &mesh,
+        0.0,
+        kMarchingCubesBoundaryFlagNone);
+
+    EXPECT_EQ(2 * numberOfPoints, mesh.numberOfPoints());
+    EXPECT_EQ(2 * numberOfTriangles, mesh.numberOfTriangles());
+    for (size_t i = 0; i < numberOfPoints; ++i) {
+        EXPECT_NEAR(0.0, mesh.point(i + numberOfPoints).distanceTo(
+            mesh.point(i) + Vector3D(10, 0, 0)), 1e-12);
+    }
+    for (size_t i = 0; i < numberOfTriangles; ++i) {
+        EXPECT_EQ(mesh.pointIndex(i) + Point3UI(numberOfPoints,
+            numberOfPoints, numberOfPoints),
+            mesh.pointIndex(i + numberOfTriangles));
+    }
+}
+
+TEST(MarchingCubes, PlaneOnBlockBoundary) {
+    // The grid points on the plane are inside, so only the cells above them
+    // cross the surface.
+    Array3<double> sdf(20, 20, 20);
+    sdf.forEachIndex([&](size_t i, size_t j, size_t k) {
+        sdf(i, j, k) = static_cast<double>(j) - 8.0;
+    });
+
+    TriangleMesh3 mesh;
+    marchingCubes(
+        sdf.constAccessor(),
+        Vector3D(1, 1, 1),
+        Vector3D(),
+        &mesh,
+        0.0,
+        kMarchingCubesBoundaryFlagNone);
+
+    EXPECT_EQ(2u * 19 * 19, mesh.numberOfTriangles());
+    EXPECT_EQ(20u * 20, mesh.numberOfPoints());
+    for (size_t i = 0; i < mesh.numberOfPoints(); ++i) {
+        EXPECT_NEAR(8.0, mesh.point(i).y, 1e-5);
+    }
+}
@@ -15,6 +15,11 @@ using namespace jet;
 
 static unsigned int sNumCores = std::thread::hardware_concurrency();
 
+TEST(Parallel, MaxNumberOfThreads) {
+    unsigned int expected = (sNumCores == 0u) ? 8u : sNumCores;
+    EXPECT_EQ(expected, maxNumberOfThreads());
+}
+
 TEST(Parallel, Fill) {
     size_t N = std::max(20u, (3 * sNumCores) / 2);
     std::vector<double> a(N);
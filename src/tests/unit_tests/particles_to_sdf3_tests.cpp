@@ -0,0 +1,128 @@
+// Copyright (c) 2016 Doyub Kim
+
+#include <jet/bcc_lattice_point_generator.h>
+#include <jet/particles_to_sdf3.h>
+#include <jet/sph_system_data3.h>
+#include <jet/vertex_centered_scalar_grid3.h>
+#include <gtest/gtest.h>
+#include <cmath>
+
+using namespace jet;
+
+namespace {
+
+void buildBlock(double spacing, Array1<Vector3D>* positions) {
+    BccLatticePointGenerator generator;
+    generator.generate(
+        BoundingBox3D(Vector3D(0.3, 0.3, 0.3), Vector3D(0.7, 0.7, 0.7)),
+        spacing,
+        positions);
+}
+
+}  // namespace
+
+TEST(ParticlesToSdf3, Sph) {
+    Array1<Vector3D> positions;
+    buildBlock(0.05, &positions);
+
+    const double kernelRadius = 0.1;
+
+    SphSystemData3 sphParticles;
+    sphParticles.addParticles(positions.constAccessor());
+    sphParticles.setRelativeKernelRadius(2.0);
+    sphParticles.setTargetSpacing(kernelRadius / 2.0);
+    sphParticles.buildNeighborSearcher();
+    sphParticles.updateDensities();
+
+    VertexCenteredScalarGrid3 sdf(40, 40, 40, 0.025, 0.025, 0.025);
+
+    ParticlesToSdf3 converter(kernelRadius);
+    converter.convert(positions.constAccessor(), &sdf);
+
+    Array1<double> constData(positions.size(), 1.0);
+    auto pos = sdf.dataPosition();
+    sdf.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        double d = sphParticles.interpolate(pos(i, j, k), constData);
+        EXPECT_NEAR(0.5 - d, sdf(i, j, k), 1e-9);
+    });
+
+    EXPECT_GT(0.0, sdf(20, 20, 20));
+    EXPECT_DOUBLE_EQ(0.5, sdf(0, 0, 0));
+}
+
+TEST(ParticlesToSdf3, ZhuBridson) {
+    Array1<Vector3D> positions(1, Vector3D(0.51, 0.49, 0.5));
+
+    VertexCenteredScalarGrid3 sdf(20, 20, 20, 0.05, 0.05, 0.05);
+
+    ParticlesToSdf3 converter(0.2, ParticlesToSdf3::ZhuBridson);
+    EXPECT_EQ(ParticlesToSdf3::ZhuBridson, converter.kernel());
+    EXPECT_DOUBLE_EQ(0.5, converter.relativeParticleRadius());
+
+    converter.convert(positions.constAccessor(), &sdf);
+
+    // A single particle gives the exact distance to the sphere within the
+    // kernel radius.
+    auto pos = sdf.dataPosition();
+    sdf.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        double dist = pos(i, j, k).distanceTo(positions[0]);
+        if (dist < 0.2) {
+            EXPECT_NEAR(dist - 0.1, sdf(i, j, k), 1e-12);
+        } else {
+            EXPECT_DOUBLE_EQ(0.1, sdf(i, j, k));
+        }
+    });
+}
+
+TEST(ParticlesToSdf3, AnisotropicIsolatedParticles) {
+    // Particles without enough neighbors keep the isotropic kernel.
+    Array1<Vector3D> positions;
+    positions.append(Vector3D(0.2, 0.3, 0.4));
+    positions.append(Vector3D(0.7, 0.6, 0.5));
+
+    VertexCenteredScalarGrid3 sph(30, 30, 30, 0.03, 0.03, 0.03);
+    VertexCenteredScalarGrid3 anisotropic(30, 30, 30, 0.03, 0.03, 0.03);
+
+    ParticlesToSdf3 converter(0.15);
+    converter.convert(positions.constAccessor(), &sph);
+    converter.setKernel(ParticlesToSdf3::Anisotropic);
+    converter.convert(positions.constAccessor(), &anisotropic);
+
+    sph.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(sph(i, j, k), anisotropic(i, j, k), 1e-9);
+    });
+}
+
+TEST(ParticlesToSdf3, Anisotropic) {
+    Array1<Vector3D> positions;
+    buildBlock(0.02, &positions);
+
+    VertexCenteredScalarGrid3 sdf(41, 41, 41, 0.025, 0.025, 0.025);
+
+    ParticlesToSdf3 converter(0.06, ParticlesToSdf3::Anisotropic);
+    converter.convert(positions.constAccessor(), &sdf);
+
+    auto pos = sdf.dataPosition();
+    sdf.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        Vector3D pt = pos(i, j, k);
+        double dist = std::fabs((pt - Vector3D(0.5, 0.5, 0.5)).absmax());
+        if (dist < 0.15) {
+            EXPECT_GT(0.0, sdf(i, j, k));
+        } else if (dist > 0.25) {
+            EXPECT_DOUBLE_EQ(0.5, sdf(i, j, k));
+        }
+    });
+}
+
+TEST(ParticlesToSdf3, Empty) {
+    Array1<Vector3D> positions;
+    VertexCenteredScalarGrid3 sdf(10, 10, 10);
+
+    ParticlesToSdf3 converter(0.1);
+    converter.setCutOffDensity(0.25);
+    converter.convert(positions.constAccessor(), &sdf);
+
+    sdf.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(0.25, sdf(i, j, k));
+    });
+}
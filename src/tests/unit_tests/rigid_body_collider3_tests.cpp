@@ -1,8 +1,15 @@
 // Copyright (c) 2016 Doyub Kim
 
+#include <jet/array1.h>
+#include <jet/box3.h>
+#include <jet/collider_set3.h>
 #include <jet/rigid_body_collider3.h>
 #include <jet/plane3.h>
+#include <jet/sphere3.h>
+#include <jet/triangle_mesh3.h>
 #include <gtest/gtest.h>
+#include <random>
+#include <vector>
 
 using namespace jet;
 
@@ -127,6 +134,95 @@ TEST(RigidBodyCollider3, ResolveCollision) {
     }
 }
 
+TEST(RigidBodyCollider3, ResolveCollisions) {
+    auto container = std::make_shared<Box3>(
+        Vector3D(0, 0, 0), Vector3D(1, 1, 1));
+    container->isNormalFlipped = true;
+
+    // Open sheet whose back side is treated as the inside
+    auto sheet = std::make_shared<TriangleMesh3>();
+    sheet->addPoint({0, 0.5, 0});
+    sheet->addPoint({1, 0.5, 0});
+    sheet->addPoint({1, 0.5, 1});
+    sheet->addPoint({0, 0.5, 1});
+    sheet->addPointTriangle({0, 2, 1});
+    sheet->addPointTriangle({0, 3, 2});
+
+    std::vector<Surface3Ptr> surfaces = {
+        std::make_shared<Sphere3>(Vector3D(0.5, 0.5, 0.5), 0.25),
+        container,
+        std::make_shared<Plane3>(Vector3D(0, 1, 0), Vector3D(0, 0.5, 0)),
+        sheet
+    };
+
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<> d(-0.5, 1.5);
+
+    Array1<Vector3D> positions(1000);
+    Array1<Vector3D> velocities(1000);
+    for (size_t i = 0; i < positions.size(); ++i) {
+        positions[i] = Vector3D(d(rng), d(rng), d(rng));
+        velocities[i] = Vector3D(d(rng), d(rng), d(rng));
+    }
+
+    const double radius = 0.05;
+    const double restitutionCoefficient = 0.5;
+
+    // The batched call should match the point-by-point results exactly,
+    // including the points skipped by the bounding box.
+    for (const auto& surface : surfaces) {
+        RigidBodyCollider3 collider(surface);
+        collider.linearVelocity = {0.1, -0.2, 0.3};
+        collider.setFrictionCoefficient(0.1);
+
+        Array1<Vector3D> newPositions(positions);
+        Array1<Vector3D> newVelocities(velocities);
+        collider.resolveCollisions(
+            radius,
+            restitutionCoefficient,
+            newPositions.accessor(),
+            newVelocities.accessor());
+
+        for (size_t i = 0; i < positions.size(); ++i) {
+            Vector3D position = positions[i];
+            Vector3D velocity = velocities[i];
+            collider.resolveCollision(
+                radius, restitutionCoefficient, &position, &velocity);
+
+            EXPECT_EQ(position, newPositions[i]);
+            EXPECT_EQ(velocity, newVelocities[i]);
+        }
+    }
+}
+
+TEST(RigidBodyCollider3, ResolveCollisionsOpenMesh) {
+    // Ground sheet at y = 0 facing up
+    auto sheet = std::make_shared<TriangleMesh3>();
+    sheet->addPoint({-1, 0, -1});
+    sheet->addPoint({1, 0, -1});
+    sheet->addPoint({1, 0, 1});
+    sheet->addPoint({-1, 0, 1});
+    sheet->addPointTriangle({0, 2, 1});
+    sheet->addPointTriangle({0, 3, 2});
+
+    RigidBodyCollider3 collider(sheet);
+
+    // The point below the sheet is outside of the padded bounding box, but
+    // it is on the back side of the sheet.
+    Array1<Vector3D> positions(1, Vector3D(0, -0.5, 0));
+    Array1<Vector3D> velocities(1, Vector3D(0, 0, 0));
+    collider.resolveCollisions(
+        0.01, 0.0, positions.accessor(), velocities.accessor());
+
+    Vector3D position(0, -0.5, 0);
+    Vector3D velocity(0, 0, 0);
+    collider.resolveCollision(0.01, 0.0, &position, &velocity);
+
+    EXPECT_DOUBLE_EQ(0.01, position.y);
+    EXPECT_EQ(position, positions[0]);
+    EXPECT_EQ(velocity, velocities[0]);
+}
+
 TEST(RigidBodyCollider3, VelocityAt) {
     RigidBodyCollider3 collider(
         std::make_shared<Plane3>(Vector3D(0, 1, 0), Vector3D(0, 0, 0)));
@@ -140,3 +236,117 @@ TEST(RigidBodyCollider3, VelocityAt) {
     EXPECT_DOUBLE_EQ(27.0, result.y);
     EXPECT_DOUBLE_EQ(-2.0, result.z);
 }
+
+TEST(RigidBodyCollider3, SignedDistanceGrid) {
+    auto sphere = std::make_shared<Sphere3>(Vector3D(0.5, 0.5, 0.5), 0.25);
+    RigidBodyCollider3 collider(sphere);
+
+    const Size3 res(8, 8, 8);
+    const Vector3D h(0.125, 0.125, 0.125);
+
+    const CellCenteredScalarGrid3& sdf
+        = collider.signedDistanceGrid(res, h, Vector3D());
+    EXPECT_EQ(res, sdf.resolution());
+
+    auto pos = sdf.dataPosition();
+    sdf.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        Vector3D pt = pos(i, j, k);
+        EXPECT_NEAR(
+            pt.distanceTo(sphere->center) - 0.25, sdf(i, j, k), 1e-12);
+    });
+
+    // The cache is kept while the collider is at rest.
+    sphere->radius = 0.125;
+    collider.updateSurface();
+    const CellCenteredScalarGrid3& sdf2
+        = collider.signedDistanceGrid(res, h, Vector3D());
+    EXPECT_NEAR(
+        pos(0, 0, 0).distanceTo(sphere->center) - 0.25, sdf2(0, 0, 0), 1e-12);
+
+    // Invalidating the field rasterizes it again.
+    size_t stamp = collider.surfaceStamp();
+    collider.invalidateSignedDistanceGrid();
+    EXPECT_LT(stamp, collider.surfaceStamp());
+    const CellCenteredScalarGrid3& sdf3
+        = collider.signedDistanceGrid(res, h, Vector3D());
+    EXPECT_NEAR(
+        pos(0, 0, 0).distanceTo(sphere->center) - 0.125, sdf3(0, 0, 0), 1e-12);
+
+    // Changing the grid layout rasterizes again.
+    const CellCenteredScalarGrid3& sdf4
+        = collider.signedDistanceGrid(res, h, Vector3D(0.5, 0.5, 0.5));
+    EXPECT_EQ(Vector3D(0.5, 0.5, 0.5), sdf4.origin());
+    EXPECT_NEAR(
+        sdf4.dataPosition()(0, 0, 0).distanceTo(sphere->center) - 0.125,
+        sdf4(0, 0, 0),
+        1e-12);
+}
+
+TEST(RigidBodyCollider3, SignedDistanceGridColliderSet) {
+    auto sphere = std::make_shared<Sphere3>(Vector3D(0.25, 0.5, 0.5), 0.125);
+    auto box = std::make_shared<Box3>(
+        Vector3D(0.625, 0.375, 0.375), Vector3D(0.875, 0.625, 0.625));
+    auto sphereCollider = std::make_shared<RigidBodyCollider3>(sphere);
+    auto boxCollider = std::make_shared<RigidBodyCollider3>(box);
+
+    ColliderSet3 colliderSet;
+    colliderSet.addCollider(sphereCollider);
+    colliderSet.addCollider(boxCollider);
+
+    const Size3 res(8, 8, 8);
+    const Vector3D h(0.125, 0.125, 0.125);
+
+    auto expected = [&](const Vector3D& pt) {
+        return std::min(
+            pt.distanceTo(sphere->center) - sphere->radius,
+            box->closestPoint(pt).distanceTo(pt)
+                * (box->bound.contains(pt) ? -1.0 : 1.0));
+    };
+
+    const CellCenteredScalarGrid3& sdf
+        = colliderSet.signedDistanceGrid(res, h, Vector3D());
+    auto pos = sdf.dataPosition();
+    EXPECT_NEAR(expected(pos(0, 4, 4)), sdf(0, 4, 4), 1e-12);
+
+    // Moving a child collider rasterizes the set again.
+    sphere->center = Vector3D(0.375, 0.5, 0.5);
+    sphereCollider->linearVelocity = Vector3D(1, 0, 0);
+    colliderSet.updateSurface();
+    const CellCenteredScalarGrid3& sdf2
+        = colliderSet.signedDistanceGrid(res, h, Vector3D());
+    EXPECT_NEAR(expected(pos(0, 4, 4)), sdf2(0, 4, 4), 1e-12);
+
+    // So does invalidating a child collider.
+    sphereCollider->linearVelocity = Vector3D();
+    colliderSet.updateSurface();
+    size_t stamp = colliderSet.surfaceStamp();
+    colliderSet.updateSurface();
+    EXPECT_EQ(stamp, colliderSet.surfaceStamp());
+
+    boxCollider->invalidateSignedDistanceGrid();
+    colliderSet.updateSurface();
+    EXPECT_LT(stamp, colliderSet.surfaceStamp());
+}
+
+TEST(RigidBodyCollider3, SignedDistanceGridMovingPlane) {
+    // Planes have unbounded boxes, so the motion is told by the velocity.
+    auto plane = std::make_shared<Plane3>(
+        Vector3D(0, 1, 0), Vector3D(0, 0.25, 0));
+    RigidBodyCollider3 collider(plane);
+
+    const Size3 res(4, 4, 4);
+    const Vector3D h(0.25, 0.25, 0.25);
+
+    collider.updateSurface();
+    const CellCenteredScalarGrid3& sdf
+        = collider.signedDistanceGrid(res, h, Vector3D());
+    EXPECT_NEAR(-0.125, sdf(0, 0, 0), 1e-12);
+
+    plane->point = Vector3D(0, 0.5, 0);
+    collider.linearVelocity = Vector3D(0, 1, 0);
+    collider.updateSurface();
+    const CellCenteredScalarGrid3& sdf2
+        = collider.signedDistanceGrid(res, h, Vector3D());
+    EXPECT_NEAR(-0.375, sdf2(0, 0, 0), 1e-12);
+
+}
@@ -0,0 +1,110 @@
+// Copyright (c) 2016 Doyub Kim
+
+#include <jet/cell_centered_scalar_grid3.h>
+#include <jet/cell_centered_vector_grid3.h>
+#include <jet/cubic_semi_lagrangian3.h>
+#include <jet/custom_scalar_field3.h>
+#include <jet/vertex_centered_scalar_grid3.h>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+using namespace jet;
+
+static double testFunc(const Vector3D& x) {
+    return std::sin(3.0 * x.x) * std::cos(2.0 * x.y) + x.z;
+}
+
+static void testAdvectBatch(SemiLagrangian3* solver) {
+    Size3 res(10, 12, 8);
+    Vector3D h(0.1, 0.1, 0.1);
+
+    FaceCenteredGrid3 flow(res, h);
+    flow.fill([](const Vector3D& x) {
+        return Vector3D(-x.y + 0.5, x.x - 0.5, 0.3 * x.z);
+    });
+
+    CellCenteredScalarGrid3 den(res, h);
+    CellCenteredScalarGrid3 temp(res, h);
+    VertexCenteredScalarGrid3 phi(res, h);
+    CellCenteredVectorGrid3 col(res, h);
+    FaceCenteredGrid3 face(res, h);
+    den.fill(testFunc);
+    temp.fill([](const Vector3D& x) { return 2.0 * testFunc(x); });
+    phi.fill(testFunc);
+    col.fill([](const Vector3D& x) { return Vector3D(testFunc(x), 1, 2); });
+    face.set(flow);
+
+    CustomScalarField3 boundarySdf([](const Vector3D& x) {
+        return 0.9 - x.x;
+    });
+
+    // Reference solution, one grid at a time
+    CellCenteredScalarGrid3 den0(res, h), temp0(res, h);
+    VertexCenteredScalarGrid3 phi0(res, h);
+    CellCenteredVectorGrid3 col0(res, h);
+    FaceCenteredGrid3 face0(res, h), flow0(res, h);
+    double dt = 0.05;
+    solver->advect(den, flow, dt, &den0, boundarySdf);
+    solver->advect(temp, flow, dt, &temp0, boundarySdf);
+    solver->advect(phi, flow, dt, &phi0, boundarySdf);
+    solver->advect(col, flow, dt, &col0, boundarySdf);
+    solver->advect(face, flow, dt, &face0, boundarySdf);
+    solver->advect(flow, flow, dt, &flow0, boundarySdf);
+
+    CellCenteredScalarGrid3 den1(res, h), temp1(res, h);
+    VertexCenteredScalarGrid3 phi1(res, h);
+    CellCenteredVectorGrid3 col1(res, h);
+    FaceCenteredGrid3 face1(res, h), flow1(res, h);
+    solver->advectBatch(
+        {&den, &temp, &phi},
+        {&col},
+        {&face, &flow},
+        flow,
+        dt,
+        {&den1, &temp1, &phi1},
+        {&col1},
+        {&face1, &flow1},
+        boundarySdf);
+
+    den0.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(den0(i, j, k), den1(i, j, k));
+        EXPECT_EQ(temp0(i, j, k), temp1(i, j, k));
+        EXPECT_EQ(col0(i, j, k), col1(i, j, k));
+    });
+    phi0.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(phi0(i, j, k), phi1(i, j, k));
+    });
+    face0.forEachUIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(face0.u(i, j, k), face1.u(i, j, k));
+        EXPECT_EQ(flow0.u(i, j, k), flow1.u(i, j, k));
+    });
+    face0.forEachVIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(face0.v(i, j, k), face1.v(i, j, k));
+        EXPECT_EQ(flow0.v(i, j, k), flow1.v(i, j, k));
+    });
+    face0.forEachWIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(face0.w(i, j, k), face1.w(i, j, k));
+        EXPECT_EQ(flow0.w(i, j, k), flow1.w(i, j, k));
+    });
+}
+
+TEST(SemiLagrangian3, AdvectBatch) {
+    SemiLagrangian3 solver;
+    testAdvectBatch(&solver);
+}
+
+TEST(CubicSemiLagrangian3, AdvectBatch) {
+    CubicSemiLagrangian3 solver;
+    testAdvectBatch(&solver);
+}
+
+TEST(SemiLagrangian3, AdvectBatchSizeMismatch) {
+    SemiLagrangian3 solver;
+    FaceCenteredGrid3 flow(Size3(2, 2, 2));
+    CellCenteredScalarGrid3 den(Size3(2, 2, 2));
+
+    EXPECT_THROW(
+        solver.advectBatch({&den}, {}, {}, flow, 0.1, {}, {}, {}),
+        std::invalid_argument);
+}
@@ -136,3 +136,23 @@ TEST(Sphere3, ClosestNormal) {
     EXPECT_DOUBLE_EQ(-1.0, result3.y);
     EXPECT_DOUBLE_EQ(0.0, result3.z);
 }
+
+TEST(Sphere3, ClosestQuery) {
+    Sphere3 sph({3.0, -1.0, 2.0}, 5.0);
+    sph.isNormalFlipped = true;
+
+    // Flipping the normal does not move the closest point.
+    auto result1 = sph.closestQuery({10.0, -1.0, 2.0});
+    EXPECT_DOUBLE_EQ(8.0, result1.point.x);
+    EXPECT_DOUBLE_EQ(-1.0, result1.point.y);
+    EXPECT_DOUBLE_EQ(2.0, result1.point.z);
+    EXPECT_DOUBLE_EQ(-1.0, result1.normal.x);
+    EXPECT_DOUBLE_EQ(0.0, result1.normal.y);
+    EXPECT_DOUBLE_EQ(0.0, result1.normal.z);
+    EXPECT_DOUBLE_EQ(2.0, result1.distance);
+
+    Vector3D result2 = sph.closestPoint({3.0, 3.0, 2.0});
+    EXPECT_DOUBLE_EQ(3.0, result2.x);
+    EXPECT_DOUBLE_EQ(4.0, result2.y);
+    EXPECT_DOUBLE_EQ(2.0, result2.z);
+}
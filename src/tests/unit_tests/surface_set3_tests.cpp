@@ -0,0 +1,130 @@
+// Copyright (c) 2016 Doyub Kim
+
+#include <jet/box3.h>
+#include <jet/plane3.h>
+#include <jet/sphere3.h>
+#include <jet/surface_set3.h>
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace jet;
+
+TEST(SurfaceSet3, Constructor) {
+    SurfaceSet3 sset;
+    EXPECT_EQ(0u, sset.numberOfSurfaces());
+
+    sset.isNormalFlipped = true;
+    auto box = std::make_shared<Box3>(BoundingBox3D({0, 0, 0}, {1, 2, 3}));
+    sset.addSurface(box);
+
+    SurfaceSet3 sset2(sset);
+    EXPECT_EQ(1u, sset2.numberOfSurfaces());
+    EXPECT_TRUE(sset2.isNormalFlipped);
+    EXPECT_EQ(box->closestPoint({3, 3, 3}), sset2.closestPoint({3, 3, 3}));
+}
+
+TEST(SurfaceSet3, ClosestQuery) {
+    SurfaceSet3 sset;
+    sset.isNormalFlipped = true;
+
+    SurfaceClosestQueryResult3 empty = sset.closestQuery(Vector3D());
+    EXPECT_EQ(kMaxD, empty.distance);
+
+    auto box = std::make_shared<Box3>(BoundingBox3D({0, 0, 0}, {1, 2, 3}));
+    sset.addSurface(box);
+
+    Vector3D pt(0.5, 2.5, -1.0);
+    SurfaceClosestQueryResult3 result = sset.closestQuery(pt);
+    EXPECT_EQ(box->closestPoint(pt), result.point);
+    EXPECT_EQ(-box->closestNormal(pt), result.normal);
+    EXPECT_EQ(box->closestDistance(pt), result.distance);
+    EXPECT_EQ(sset.closestNormal(pt), result.normal);
+}
+
+TEST(SurfaceSet3, ManySurfaces) {
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<> d(0.0, 1.0);
+
+    // Boxes and an axis-aligned plane that spans the max double
+    SurfaceSet3 sset;
+    for (int i = 0; i < 200; ++i) {
+        Vector3D lower(d(rng), d(rng), d(rng));
+        sset.addSurface(std::make_shared<Box3>(
+            BoundingBox3D(lower, lower + 0.1 * Vector3D(1, 1, 1))));
+    }
+    sset.addSurface(std::make_shared<Plane3>(
+        Vector3D(0, 1, 0), Vector3D(0, -0.5, 0)));
+
+    for (int iter = 0; iter < 100; ++iter) {
+        Vector3D pt(
+            2.0 * d(rng) - 0.5, 2.0 * d(rng) - 0.5, 2.0 * d(rng) - 0.5);
+
+        size_t answer = 0;
+        double minDist = kMaxD;
+        for (size_t i = 0; i < sset.numberOfSurfaces(); ++i) {
+            double dist = sset.surfaceAt(i)->closestDistance(pt);
+            if (dist < minDist) {
+                minDist = dist;
+                answer = i;
+            }
+        }
+
+        const auto& surface = sset.surfaceAt(answer);
+        EXPECT_EQ(minDist, sset.closestDistance(pt));
+        EXPECT_EQ(surface->closestPoint(pt), sset.closestPoint(pt));
+        EXPECT_EQ(surface->closestNormal(pt), sset.closestNormal(pt));
+
+        Ray3D ray(pt, Vector3D(d(rng) - 0.5, d(rng) - 0.5, d(rng) - 0.5)
+            .normalized());
+        SurfaceRayIntersection3 expected;
+        bool expectedHit = false;
+        for (size_t i = 0; i < sset.numberOfSurfaces(); ++i) {
+            auto local = sset.surfaceAt(i)->closestIntersection(ray);
+            if (local.isIntersecting && local.t < expected.t) {
+                expected = local;
+            }
+            expectedHit |= sset.surfaceAt(i)->intersects(ray);
+        }
+
+        SurfaceRayIntersection3 actual = sset.closestIntersection(ray);
+        EXPECT_EQ(expected.isIntersecting, actual.isIntersecting);
+        EXPECT_EQ(expected.t, actual.t);
+        EXPECT_EQ(expected.point, actual.point);
+        EXPECT_EQ(expectedHit, sset.intersects(ray));
+    }
+}
+
+TEST(SurfaceSet3, UpdateQueryEngine) {
+    auto sphere = std::make_shared<Sphere3>(Vector3D(), 1.0);
+
+    SurfaceSet3 sset;
+    sset.addSurface(sphere);
+    sset.addSurface(std::make_shared<Sphere3>(Vector3D(0, 10, 0), 1.0));
+    EXPECT_DOUBLE_EQ(1.0, sset.closestDistance(Vector3D(2, 0, 0)));
+
+    // The cached box is stale until the query engine is updated
+    sphere->center = Vector3D(5, 0, 0);
+    sset.updateQueryEngine();
+    EXPECT_DOUBLE_EQ(2.0, sset.closestDistance(Vector3D(2, 0, 0)));
+    EXPECT_TRUE(sset.intersects(Ray3D(Vector3D(5, 5, 0), Vector3D(0, -1, 0))));
+}
+
+TEST(SurfaceSet3, IsClosed) {
+    auto sphere = std::make_shared<Sphere3>(Vector3D(0, 0, 0), 1.0);
+    auto box = std::make_shared<Box3>(
+        BoundingBox3D(Vector3D(1, 1, 1), Vector3D(2, 2, 2)));
+
+    SurfaceSet3 surfaceSet;
+    surfaceSet.addSurface(sphere);
+    surfaceSet.addSurface(box);
+    EXPECT_TRUE(surfaceSet.isClosed());
+
+    // A flipped child turns the set inside out.
+    box->isNormalFlipped = true;
+    EXPECT_FALSE(surfaceSet.isClosed());
+    box->isNormalFlipped = false;
+
+    surfaceSet.addSurface(
+        std::make_shared<Plane3>(Vector3D(0, 1, 0), Vector3D(0, 0, 0)));
+    EXPECT_FALSE(surfaceSet.isClosed());
+}
@@ -55,3 +55,23 @@ TEST(Triangle3, Constructors) {
         }
     }
 }
+
+TEST(Triangle3, ClosestQuery) {
+    Triangle3 tri(
+        {{Vector3D(0, 0, 0), Vector3D(2, 0, 0), Vector3D(0, 1, 1)}},
+        {{Vector3D(0, 0, 1), Vector3D(0, 1, 0), Vector3D(1, 0, 0)}},
+        {{Vector2D(), Vector2D(), Vector2D()}});
+
+    // Points closest to the interior, the edges, and the vertices
+    Vector3D pts[5] = {
+        Vector3D(0.5, 0.3, 0.4), Vector3D(1, -1, 0), Vector3D(1.5, 1, 1),
+        Vector3D(-1, 0.5, 0.5), Vector3D(3, 0, 0)
+    };
+
+    for (const Vector3D& pt : pts) {
+        SurfaceClosestQueryResult3 result = tri.closestQuery(pt);
+        EXPECT_EQ(tri.closestPoint(pt), result.point);
+        EXPECT_EQ(tri.closestNormal(pt), result.normal);
+        EXPECT_DOUBLE_EQ(tri.closestDistance(pt), result.distance);
+    }
+}
@@ -1,7 +1,10 @@
 // Copyright (c) 2016 Doyub Kim
 
+#include <jet/constants.h>
 #include <jet/triangle_mesh3.h>
 #include <gtest/gtest.h>
+#include <cmath>
+#include <random>
 
 using namespace jet;
 
@@ -12,3 +15,153 @@ TEST(TriangleMesh3, Constructors) {
     EXPECT_EQ(0u, mesh1.numberOfUvs());
     EXPECT_EQ(0u, mesh1.numberOfTriangles());
 }
+
+namespace {
+
+// Latitude-longitude sphere whose poles are not shared by the triangles
+void buildSphere(TriangleMesh3* mesh, size_t nu, size_t nv) {
+    const double r = 0.4;
+    const Vector3D c(0.5, 0.5, 0.5);
+    for (size_t j = 0; j <= nv; ++j) {
+        double theta = kPiD * (j + 0.5) / (nv + 1);
+        for (size_t i = 0; i < nu; ++i) {
+            double phi = 2.0 * kPiD * i / nu;
+            mesh->addPoint(c + r * Vector3D(
+                std::sin(theta) * std::cos(phi),
+                std::cos(theta),
+                std::sin(theta) * std::sin(phi)));
+        }
+    }
+
+    for (size_t j = 0; j < nv; ++j) {
+        for (size_t i = 0; i < nu; ++i) {
+            size_t i1 = (i + 1) % nu;
+            size_t a = j * nu + i, b = j * nu + i1;
+            size_t c0 = (j + 1) * nu + i, d = (j + 1) * nu + i1;
+            mesh->addPointTriangle(Point3UI(a, b, d));
+            mesh->addPointTriangle(Point3UI(a, d, c0));
+        }
+    }
+}
+
+size_t bruteForceClosestTriangle(
+    const TriangleMesh3& mesh, const Vector3D& pt) {
+    size_t answer = kMaxSize;
+    double minDist = kMaxD;
+    for (size_t i = 0; i < mesh.numberOfTriangles(); ++i) {
+        double dist = pt.distanceTo(mesh.triangle(i).closestPoint(pt));
+        if (dist < minDist) {
+            minDist = dist;
+            answer = i;
+        }
+    }
+    return answer;
+}
+
+SurfaceRayIntersection3 bruteForceClosestIntersection(
+    const TriangleMesh3& mesh, const Ray3D& ray) {
+    SurfaceRayIntersection3 answer;
+    for (size_t i = 0; i < mesh.numberOfTriangles(); ++i) {
+        SurfaceRayIntersection3 intersection
+            = mesh.triangle(i).closestIntersection(ray);
+        if (intersection.isIntersecting && intersection.t < answer.t) {
+            answer = intersection;
+        }
+    }
+    return answer;
+}
+
+}  // namespace
+
+TEST(TriangleMesh3, ClosestPoint) {
+    TriangleMesh3 mesh;
+    buildSphere(&mesh, 40, 20);
+
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<> d(-0.5, 1.5);
+
+    for (int iter = 0; iter < 200; ++iter) {
+        Vector3D pt(d(rng), d(rng), d(rng));
+        size_t answer = bruteForceClosestTriangle(mesh, pt);
+        Triangle3 tri = mesh.triangle(answer);
+
+        EXPECT_EQ(tri.closestPoint(pt), mesh.closestPoint(pt));
+        EXPECT_EQ(tri.closestDistance(pt), mesh.closestDistance(pt));
+        EXPECT_EQ(tri.closestNormal(pt), mesh.closestNormal(pt));
+
+        SurfaceClosestQueryResult3 result = mesh.closestQuery(pt);
+        EXPECT_EQ(tri.closestPoint(pt), result.point);
+        EXPECT_EQ(tri.closestDistance(pt), result.distance);
+        EXPECT_EQ(tri.closestNormal(pt), result.normal);
+    }
+}
+
+TEST(TriangleMesh3, ClosestIntersection) {
+    TriangleMesh3 mesh;
+    buildSphere(&mesh, 40, 20);
+
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<> d(-1.0, 1.0);
+
+    size_t numberOfHits = 0;
+    for (int iter = 0; iter < 200; ++iter) {
+        // Triangles are hit from the inside, where the rays go along the
+        // face normals.
+        Ray3D ray(
+            Vector3D(0.5, 0.5, 0.5) + 0.2 * Vector3D(d(rng), d(rng), d(rng)),
+            Vector3D(d(rng), d(rng), d(rng)).normalized());
+
+        SurfaceRayIntersection3 answer
+            = bruteForceClosestIntersection(mesh, ray);
+        SurfaceRayIntersection3 result = mesh.closestIntersection(ray);
+
+        EXPECT_EQ(answer.isIntersecting, result.isIntersecting);
+        EXPECT_EQ(answer.t, result.t);
+        EXPECT_EQ(answer.point, result.point);
+        EXPECT_EQ(answer.normal, result.normal);
+        EXPECT_EQ(answer.isIntersecting, mesh.intersects(ray));
+
+        if (answer.isIntersecting) {
+            ++numberOfHits;
+        }
+    }
+
+    EXPECT_LT(150u, numberOfHits);
+
+    Ray3D ray(Vector3D(2, 2, 2), Vector3D(1, 0, 0));
+    EXPECT_FALSE(mesh.intersects(ray));
+    EXPECT_FALSE(mesh.closestIntersection(ray).isIntersecting);
+}
+
+TEST(TriangleMesh3, InvalidateOnEdit) {
+    TriangleMesh3 mesh;
+    buildSphere(&mesh, 20, 10);
+
+    const Vector3D pt(2, 0.5, 0.5);
+    EXPECT_NEAR(1.1, mesh.closestDistance(pt), 0.01);
+
+    mesh.translate(Vector3D(1, 0, 0));
+    EXPECT_NEAR(0.1, mesh.closestDistance(pt), 0.01);
+
+    for (size_t i = 0; i < mesh.numberOfPoints(); ++i) {
+        mesh.point(i) -= Vector3D(1, 0, 0);
+    }
+    EXPECT_NEAR(1.1, mesh.closestDistance(pt), 0.01);
+
+    mesh.addTriangle(Triangle3(
+        {{Vector3D(2, 0, 0), Vector3D(2, 1, 0), Vector3D(2, 0, 1)}},
+        {{Vector3D(1, 0, 0), Vector3D(1, 0, 0), Vector3D(1, 0, 0)}},
+        {{Vector2D(), Vector2D(), Vector2D()}}));
+    EXPECT_DOUBLE_EQ(0.0, mesh.closestDistance(pt));
+
+    TriangleMesh3 mesh2(mesh);
+    EXPECT_DOUBLE_EQ(0.0, mesh2.closestDistance(pt));
+
+    mesh.clear();
+    EXPECT_EQ(kMaxD, mesh.closestDistance(pt));
+    EXPECT_FALSE(mesh.intersects(Ray3D(pt, Vector3D(-1, 0, 0))));
+
+    mesh.swap(mesh2);
+    EXPECT_DOUBLE_EQ(0.0, mesh.closestDistance(pt));
+    EXPECT_EQ(kMaxD, mesh2.closestDistance(pt));
+}
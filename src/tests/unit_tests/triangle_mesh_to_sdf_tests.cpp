@@ -0,0 +1,101 @@
+// Copyright (c) 2016 Doyub Kim
+
+#include <jet/triangle_mesh_to_sdf.h>
+#include <jet/vertex_centered_scalar_grid3.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+
+using namespace jet;
+
+namespace {
+
+// Unit cube at the origin
+void buildCube(TriangleMesh3* mesh) {
+    mesh->addPoint({0, 0, 0});
+    mesh->addPoint({0, 0, 1});
+    mesh->addPoint({0, 1, 0});
+    mesh->addPoint({0, 1, 1});
+    mesh->addPoint({1, 0, 0});
+    mesh->addPoint({1, 0, 1});
+    mesh->addPoint({1, 1, 0});
+    mesh->addPoint({1, 1, 1});
+
+    mesh->addPointTriangle({0, 1, 3});
+    mesh->addPointTriangle({0, 3, 2});
+    mesh->addPointTriangle({4, 6, 7});
+    mesh->addPointTriangle({4, 7, 5});
+    mesh->addPointTriangle({0, 4, 5});
+    mesh->addPointTriangle({0, 5, 1});
+    mesh->addPointTriangle({2, 3, 7});
+    mesh->addPointTriangle({2, 7, 6});
+    mesh->addPointTriangle({0, 2, 6});
+    mesh->addPointTriangle({0, 6, 4});
+    mesh->addPointTriangle({1, 5, 7});
+    mesh->addPointTriangle({1, 7, 3});
+}
+
+}  // namespace
+
+TEST(TriangleMeshToSdf, Cube) {
+    TriangleMesh3 mesh;
+    buildCube(&mesh);
+
+    // The grid points are never on the faces.
+    VertexCenteredScalarGrid3 grid(
+        40, 40, 40, 3.0 / 40, 3.0 / 40, 3.0 / 40, -1.01, -1.01, -1.01);
+
+    triangleMeshToSdf(mesh, &grid);
+
+    auto pos = grid.dataPosition();
+    grid.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        Vector3D pt = pos(i, j, k);
+        EXPECT_NEAR(mesh.closestDistance(pt), std::fabs(grid(i, j, k)), 1e-9);
+
+        bool isInside = pt.x > 0.0 && pt.x < 1.0
+            && pt.y > 0.0 && pt.y < 1.0
+            && pt.z > 0.0 && pt.z < 1.0;
+        EXPECT_EQ(isInside, grid(i, j, k) < 0.0);
+    });
+}
+
+TEST(TriangleMeshToSdf, CubeOutsideGrid) {
+    TriangleMesh3 mesh;
+    buildCube(&mesh);
+
+    // The cube sticks out of the low corner of the grid.
+    VertexCenteredScalarGrid3 grid(
+        20, 20, 20, 0.1, 0.1, 0.1, 0.505, 0.505, 0.505);
+
+    triangleMeshToSdf(mesh, &grid);
+
+    auto pos = grid.dataPosition();
+    grid.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        Vector3D pt = pos(i, j, k);
+        EXPECT_NEAR(mesh.closestDistance(pt), std::fabs(grid(i, j, k)), 1e-9);
+
+        bool isInside = pt.x < 1.0 && pt.y < 1.0 && pt.z < 1.0;
+        EXPECT_EQ(isInside, grid(i, j, k) < 0.0);
+    });
+}
+
+TEST(TriangleMeshToSdf, NarrowBand) {
+    TriangleMesh3 mesh;
+    buildCube(&mesh);
+
+    VertexCenteredScalarGrid3 full(
+        40, 40, 40, 3.0 / 40, 3.0 / 40, 3.0 / 40, -1.01, -1.01, -1.01);
+    VertexCenteredScalarGrid3 band(
+        40, 40, 40, 3.0 / 40, 3.0 / 40, 3.0 / 40, -1.01, -1.01, -1.01);
+
+    triangleMeshToSdf(mesh, &full);
+    triangleMeshToSdf(mesh, &band, 1, 3);
+
+    const double maxDistance = 3.0 * 3.0 / 40;
+
+    full.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        double expected = std::min(std::fabs(full(i, j, k)), maxDistance);
+        EXPECT_DOUBLE_EQ(expected, std::fabs(band(i, j, k)));
+        EXPECT_EQ(full(i, j, k) < 0.0, band(i, j, k) < 0.0);
+    });
+}